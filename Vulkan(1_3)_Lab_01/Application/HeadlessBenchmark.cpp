@@ -0,0 +1,236 @@
+#include "HeadlessBenchmark.h"
+#include "SandboxApplication.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    bool IsSelected(const std::string& name, const std::vector<std::string>& filters)
+    {
+        if (filters.empty()) return true;
+        for (const auto& filter : filters) {
+            if (name.find(filter) != std::string::npos) return true;
+        }
+        return false;
+    }
+
+    // Nearest-rank percentile of an ascending sample.
+    double Percentile(const std::vector<double>& sorted, double p)
+    {
+        if (sorted.empty()) return 0.0;
+        const size_t rank = static_cast<size_t>(std::ceil(p * static_cast<double>(sorted.size())));
+        return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+    }
+
+    HeadlessBenchmark::Timing Summarize(const std::string& name, std::vector<double> samples)
+    {
+        HeadlessBenchmark::Timing timing;
+        timing.name = name;
+        if (samples.empty()) return timing;
+
+        std::sort(samples.begin(), samples.end());
+        double sum = 0.0;
+        for (const double ms : samples) sum += ms;
+        timing.meanMs = sum / static_cast<double>(samples.size());
+        timing.p50Ms = Percentile(samples, 0.50);
+        timing.p99Ms = Percentile(samples, 0.99);
+        timing.maxMs = samples.back();
+        return timing;
+    }
+
+    // Quotes a CSV field, doubling any quotes inside it.
+    std::string Quote(const std::string& text)
+    {
+        std::string out = "\"";
+        for (const char c : text) {
+            if (c == '"') out += '"';
+            out += c;
+        }
+        return out + "\"";
+    }
+}
+
+namespace HeadlessBenchmark
+{
+    bool ParseArguments(int argc, char** argv, Settings& out, std::string& error)
+    {
+        bool requested = false;
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            if (arg == "--benchmark" || arg == "--replay" || arg == "--integrators") requested = true;
+        }
+        if (!requested) return false;
+
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            if (arg == "--benchmark") continue;
+            if (arg == "--integrators") {
+                out.integrators = true;
+                continue;
+            }
+
+            if (i + 1 >= argc) {
+                error = "missing value for " + arg;
+                return true;
+            }
+            const std::string value = argv[++i];
+
+            try {
+                if (arg == "--ticks") out.ticks = static_cast<uint32_t>(std::stoul(value));
+                else if (arg == "--warmup") out.warmupTicks = static_cast<uint32_t>(std::stoul(value));
+                else if (arg == "--dt") out.timeStep = std::stof(value);
+                else if (arg == "--scenario") out.scenarios.push_back(value);
+                else if (arg == "--csv") out.csvPath = value;
+                else if (arg == "--replay") out.replayPath = value;
+                else if (arg == "--bodies") out.integrator.bodies = static_cast<uint32_t>(std::stoul(value));
+                else if (arg == "--steps") out.integrator.steps = static_cast<uint32_t>(std::stoul(value));
+                else {
+                    error = "unknown option " + arg;
+                    return true;
+                }
+            }
+            catch (const std::exception&) {
+                error = "bad value '" + value + "' for " + arg;
+                return true;
+            }
+        }
+
+        if (out.ticks == 0) error = "--ticks must be at least 1";
+        else if (!(out.timeStep > 0.0f)) error = "--dt must be positive";
+        else if (out.integrator.bodies == 0 || out.integrator.steps == 0) error = "--bodies and --steps must be at least 1";
+        return true;
+    }
+
+    std::vector<ScenarioResult> Run(SandboxApplication& app, const Settings& settings)
+    {
+        std::vector<ScenarioResult> results;
+
+        for (int index = 0; index < app.GetScenarioCount(); ++index) {
+            const std::string& name = app.GetScenarioName(index);
+            if (!IsSelected(name, settings.scenarios)) continue;
+
+            app.ChangeScenario(index);
+            Scenario* scenario = app.GetCurrentScenario();
+            if (!scenario) continue;
+
+            // A replay sets its own time steps and ends on its last recorded tick
+            const bool replay = !settings.replayPath.empty();
+            if (replay) {
+                std::string error;
+                if (!scenario->StartReplay(settings.replayPath, error)) {
+                    std::cout << "[Benchmark] " << name << ": skipped, " << error << std::endl;
+                    continue;
+                }
+            }
+            else {
+                for (uint32_t t = 0; t < settings.warmupTicks; ++t) {
+                    scenario->OnUpdate(settings.timeStep);
+                }
+            }
+
+            std::vector<double> tickMs;
+            tickMs.reserve(settings.ticks);
+            std::vector<std::string> phaseNames;
+            std::vector<std::vector<double>> phaseMs;
+
+            uint32_t ticks = 0;
+            for (; replay ? scenario->IsReplaying() : ticks < settings.ticks; ++ticks) {
+                const auto start = Clock::now();
+                scenario->OnUpdate(settings.timeStep);
+                tickMs.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+
+                const PhaseTimer* timer = scenario->GetPhaseTimer();
+                if (!timer) continue;
+                for (const auto& phase : timer->GetPhases()) {
+                    auto it = std::find(phaseNames.begin(), phaseNames.end(), phase.name);
+                    size_t slot = static_cast<size_t>(it - phaseNames.begin());
+                    if (it == phaseNames.end()) {
+                        phaseNames.emplace_back(phase.name);
+                        phaseMs.emplace_back();
+                    }
+                    phaseMs[slot].resize(ticks, 0.0);
+                    phaseMs[slot].push_back(phase.ms);
+                }
+            }
+
+            ScenarioResult result;
+            result.scenario = name;
+            result.ticks = ticks;
+
+            double totalMs = 0.0;
+            for (const double ms : tickMs) totalMs += ms;
+            result.ticksPerSecond = totalMs > 0.0 ? 1000.0 * ticks / totalMs : 0.0;
+            result.tick = Summarize("tick", std::move(tickMs));
+
+            for (size_t slot = 0; slot < phaseNames.size(); ++slot) {
+                phaseMs[slot].resize(ticks, 0.0);
+                result.phases.push_back(Summarize(phaseNames[slot], std::move(phaseMs[slot])));
+            }
+
+            std::cout << "[Benchmark] " << name << ": " << result.ticksPerSecond << " ticks/s, p50 "
+                << result.tick.p50Ms << " ms, p99 " << result.tick.p99Ms << " ms" << std::endl;
+            results.push_back(std::move(result));
+        }
+
+        return results;
+    }
+
+    std::vector<SimIntegration::IntegratorBenchmarkResult> RunIntegrators(const Settings& settings)
+    {
+        std::cout << "[Benchmark] Integrators: " << settings.integrator.bodies << " bodies, "
+            << settings.integrator.steps << " steps" << std::endl;
+        auto results = SimIntegration::RunIntegratorBenchmark(settings.integrator);
+
+        for (int s = 0; s < SimIntegration::kBenchmarkSceneCount; ++s) {
+            const auto scene = static_cast<SimIntegration::BenchmarkScene>(s);
+            for (int m = 0; m < kIntegrationMethodCount; ++m) {
+                const auto method = static_cast<IntegrationMethod>(m);
+                const float dt = SimIntegration::LargestStableTimeStep(results, scene, method);
+                std::cout << "[Benchmark] " << SimIntegration::GetBenchmarkSceneName(scene) << ", "
+                    << GetIntegrationMethodName(method) << ": largest stable dt "
+                    << (dt > 0.0f ? "1/" + std::to_string(std::lround(1.0f / dt)) : std::string("none")) << std::endl;
+            }
+        }
+        return results;
+    }
+
+    bool WriteCsv(const std::string& path, const std::vector<ScenarioResult>& results)
+    {
+        std::ofstream file(path);
+        if (!file) return false;
+
+        file << "scenario,phase,ticks,ticks_per_sec,mean_ms,p50_ms,p99_ms,max_ms\n";
+        auto writeRow = [&](const ScenarioResult& result, const Timing& timing)
+        {
+            file << Quote(result.scenario) << ',' << Quote(timing.name) << ',' << result.ticks << ','
+                << result.ticksPerSecond << ',' << timing.meanMs << ',' << timing.p50Ms << ','
+                << timing.p99Ms << ',' << timing.maxMs << '\n';
+        };
+
+        for (const auto& result : results) {
+            writeRow(result, result.tick);
+            for (const auto& phase : result.phases) writeRow(result, phase);
+        }
+        return static_cast<bool>(file);
+    }
+
+    bool WriteIntegratorCsv(const std::string& path, const std::vector<SimIntegration::IntegratorBenchmarkResult>& results)
+    {
+        std::ofstream file(path);
+        if (!file) return false;
+
+        file << "scene,method,dt,final_drift,max_drift,ns_per_body_step,stable\n";
+        for (const auto& r : results) {
+            file << Quote(SimIntegration::GetBenchmarkSceneName(r.scene)) << ',' << Quote(GetIntegrationMethodName(r.method)) << ','
+                << r.timeStep << ',' << r.finalDrift << ',' << r.maxDrift << ',' << r.nsPerBodyStep << ','
+                << (r.stable ? 1 : 0) << '\n';
+        }
+        return static_cast<bool>(file);
+    }
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../SimulationLibrary/IntegratorBenchmark.h"
+
+class SandboxApplication;
+
+// Runs the registered scenarios without a window, Vulkan device or UI and times their updates.
+// Meshes go to the application's null uploader (no device, no buffers), so only the simulation
+// path is measured: OnUpdate() with its collision stages, called once per tick at a fixed step.
+// Started from the command line:
+//   Lab_Tutorial_Template --benchmark [--ticks N] [--warmup N] [--dt SECONDS]
+//                         [--scenario NAME]... [--csv PATH] [--replay PATH]
+// --scenario matches any part of a registered name and may be repeated; none runs them all.
+// --replay (which implies --benchmark) times a recorded session instead of a fixed tick count:
+// each selected scenario that can replay it runs from its first tick to its last, with the
+// recorded time steps; --ticks, --warmup and --dt are ignored.
+// --integrators runs SimIntegration's integrator benchmark instead of the scenarios:
+//   Lab_Tutorial_Template --integrators [--bodies N] [--steps N] [--csv PATH]
+namespace HeadlessBenchmark
+{
+    struct Settings {
+        uint32_t ticks = 1000;
+        uint32_t warmupTicks = 60;       // run before timing starts, not reported
+        float timeStep = 1.0f / 60.0f;
+        std::vector<std::string> scenarios;
+        std::string csvPath = "benchmark.csv";
+        std::string replayPath;          // session recording to replay, empty for none
+        bool integrators = false;        // run the integrator benchmark instead of the scenarios
+        SimIntegration::IntegratorBenchmarkSettings integrator;
+    };
+
+    // One timed span: the whole tick, or one phase reported by the scenario's PhaseTimer.
+    // A phase missing from a tick counts as 0 ms for that tick.
+    struct Timing {
+        std::string name;
+        double meanMs = 0.0;
+        double p50Ms = 0.0;
+        double p99Ms = 0.0;
+        double maxMs = 0.0;
+    };
+
+    struct ScenarioResult {
+        std::string scenario;
+        uint32_t ticks = 0;
+        double ticksPerSecond = 0.0;
+        Timing tick;
+        std::vector<Timing> phases;
+    };
+
+    // False when argv has none of --benchmark, --replay or --integrators. 'error' is set (and the result is true) on a bad option.
+    bool ParseArguments(int argc, char** argv, Settings& out, std::string& error);
+
+    std::vector<ScenarioResult> Run(SandboxApplication& app, const Settings& settings);
+    std::vector<SimIntegration::IntegratorBenchmarkResult> RunIntegrators(const Settings& settings);
+
+    // Columns: scenario, phase, ticks, ticks_per_sec, mean_ms, p50_ms, p99_ms, max_ms.
+    // The first row of each scenario is phase "tick" (the whole update).
+    bool WriteCsv(const std::string& path, const std::vector<ScenarioResult>& results);
+
+    // Columns: scene, method, dt, final_drift, max_drift, ns_per_body_step, stable.
+    bool WriteIntegratorCsv(const std::string& path, const std::vector<SimIntegration::IntegratorBenchmarkResult>& results);
+}
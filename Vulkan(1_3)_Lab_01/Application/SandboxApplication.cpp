@@ -14,6 +14,7 @@
 #include <stdexcept>
 #include <algorithm>
 #include <chrono>
+#include <cstdlib>
 #include <cstring>
 #include <set>
 #include <limits>
@@ -191,6 +192,42 @@ void SandboxApplication::Run() {
     cleanup();
 }
 
+int SandboxApplication::RunBenchmark(const HeadlessBenchmark::Settings& settings) {
+    if (settings.integrators) {
+        const auto results = HeadlessBenchmark::RunIntegrators(settings);
+        if (!HeadlessBenchmark::WriteIntegratorCsv(settings.csvPath, results)) {
+            std::cerr << "[Benchmark] Could not write '" << settings.csvPath << "'." << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::cout << "[Benchmark] Wrote " << settings.csvPath << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    initScenarios();
+
+    const auto results = HeadlessBenchmark::Run(*this, settings);
+
+    {
+        std::lock_guard<std::recursive_mutex> guard(m_ScenarioMutex);
+        if (m_CurrentScenario) {
+            m_CurrentScenario->OnUnload();
+            m_CurrentScenario.reset();
+        }
+    }
+
+    if (results.empty()) {
+        std::cerr << "[Benchmark] No scenario matched." << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (!HeadlessBenchmark::WriteCsv(settings.csvPath, results)) {
+        std::cerr << "[Benchmark] Could not write '" << settings.csvPath << "'." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "[Benchmark] Wrote " << settings.csvPath << std::endl;
+    return EXIT_SUCCESS;
+}
+
 void SandboxApplication::ChangeScenario(int index) {
     if (index < 0 || index >= static_cast<int>(m_ScenarioFactories.size())) return;
 
@@ -203,7 +240,7 @@ void SandboxApplication::ChangeScenario(int index) {
     m_CurrentScenarioIndex = index;
     m_CurrentScenario = m_ScenarioFactories[index].second();
     m_CurrentScenario->OnLoad();
-    m_UILayer->SetSelectedScenario(index);
+    if (m_UILayer) m_UILayer->SetSelectedScenario(index);
 }
 
 void SandboxApplication::Stop() {
@@ -216,6 +253,7 @@ void SandboxApplication::Stop() {
     }
 
     m_AccumulatedTime = 0.0f;
+    m_StepController.Reset();
 }
 
 void SandboxApplication::initWindow() {
@@ -317,6 +355,8 @@ void SandboxApplication::initScenarios() {
     for (const auto& [name, factory] : m_ScenarioFactories) {
         names.push_back(name);
     }
+    // Headless runs have no UI and pick their own scenarios
+    if (!m_UILayer) return;
     m_UILayer->SetScenarioNames(names);
 
     if (!m_ScenarioFactories.empty()) {
@@ -324,6 +364,16 @@ void SandboxApplication::initScenarios() {
     }
 }
 
+StepController::Settings SandboxApplication::GetStepControllerSettings() const {
+    std::lock_guard<std::recursive_mutex> guard(m_ScenarioMutex);
+    return m_StepController.GetSettings();
+}
+
+void SandboxApplication::SetStepControllerSettings(const StepController::Settings& settings) {
+    std::lock_guard<std::recursive_mutex> guard(m_ScenarioMutex);
+    m_StepController.GetSettings() = settings;
+}
+
 void SandboxApplication::StepOnce() {
     m_IsPaused.store(true);
     m_StepRequested.store(true);
@@ -465,15 +515,34 @@ void SandboxApplication::SimulationWorkerMain() {
         const float simSpeed = m_SimulationSpeed.load();
 
         if (!m_IsPaused.load()) {
-            m_AccumulatedTime += frameDt * simSpeed;
+            const auto tickStart = clock::now();
+            {
+                std::lock_guard<std::recursive_mutex> guard(m_ScenarioMutex);
+                m_StepController.BeginTick(m_AccumulatedTime, frameDt * simSpeed, timeStep);
+            }
 
+            // Substeps / coarse steps come from the scenario's activity; catch-up stops once
+            // the backlog cap or the wall-clock budget is hit, and the rest is dropped.
             while (m_AccumulatedTime >= timeStep) {
                 std::lock_guard<std::recursive_mutex> guard(m_ScenarioMutex);
+                const StepActivity activity = m_CurrentScenario ? m_CurrentScenario->GetStepActivity() : StepActivity{};
+                const StepController::Plan plan = m_StepController.PlanUpdate(activity, timeStep);
                 if (m_CurrentScenario) {
-                    m_CurrentScenario->OnUpdate(timeStep);
+                    for (uint32_t i = 0; i < plan.substeps; ++i) {
+                        m_CurrentScenario->OnUpdate(plan.substepDt);
+                    }
                 }
-                m_AccumulatedTime -= timeStep;
+
+                const float elapsedMs = std::chrono::duration<float, std::milli>(clock::now() - tickStart).count();
+                if (!m_StepController.EndUpdate(plan, m_AccumulatedTime, timeStep, elapsedMs)) break;
             }
+
+            std::lock_guard<std::recursive_mutex> guard(m_ScenarioMutex);
+            m_StepController.EndTick();
+            m_SimulationSubsteps.store(m_StepController.GetLastSubsteps());
+            m_SimulationCoarseSteps.store(m_StepController.GetLastFixedSteps());
+            m_DroppedSimulationTime.store(static_cast<float>(m_StepController.GetDroppedTime()));
+            m_SimulationTimeDilation.store(m_StepController.GetTimeDilation());
         }
         else if (m_StepRequested.exchange(false)) {
             std::lock_guard<std::recursive_mutex> guard(m_ScenarioMutex);
@@ -1590,6 +1659,7 @@ void SandboxApplication::createDepthResources() {
 SandboxApplication::MeshBuffers SandboxApplication::UploadMesh(const Mesh& mesh) {
     MeshBuffers buffers{};
     buffers.indexCount = static_cast<uint32_t>(mesh.indices.size());
+    if (m_Device == VK_NULL_HANDLE) return buffers;
 
     // Upload vertices
     VkDeviceSize vertexBufferSize = sizeof(MeshVertex) * mesh.vertices.size();
@@ -1633,6 +1703,7 @@ SandboxApplication::MeshBuffers SandboxApplication::UploadMesh(const Mesh& mesh)
 }
 
 void SandboxApplication::DestroyMeshBuffers(const MeshBuffers& buffers) {
+    if (m_Device == VK_NULL_HANDLE) return;
     vkDestroyBuffer(m_Device, buffers.vertexBuffer, nullptr);
     vkFreeMemory(m_Device, buffers.vertexMemory, nullptr);
     vkDestroyBuffer(m_Device, buffers.indexBuffer, nullptr);
@@ -13,7 +13,9 @@
 #include "../Renderer/MeshGenerator.h"
 #include "../Renderer/Camera.h"
 #include "../SimulationLibrary/IntegrationMethod.h"
+#include "../SimulationLibrary/StepController.h"
 #include "../Scene/SceneRuntime.h"
+#include "HeadlessBenchmark.h"
 
 #include <memory>
 #include <vector>
@@ -67,6 +69,10 @@ public:
     void Run();
     ~SandboxApplication();
 
+    // Loads the scenes and scenarios without a window, device or UI and runs the headless
+    // benchmark over them. Returns the process exit code.
+    int RunBenchmark(const HeadlessBenchmark::Settings& settings);
+
     // --- Scenario Management ---
     template<typename T>
     void RegisterScenario(const std::string& name) {
@@ -76,6 +82,8 @@ public:
     }
     void ChangeScenario(int index);
     Scenario* GetCurrentScenario() const { return m_CurrentScenario.get(); }
+    int GetScenarioCount() const { return static_cast<int>(m_ScenarioFactories.size()); }
+    const std::string& GetScenarioName(int index) const { return m_ScenarioFactories[index].first; }
 
     // --- Material ---
     MaterialSettings& GetMaterialSettings() { return m_MaterialSettings; }
@@ -99,6 +107,15 @@ public:
     float GetSimulationTickHz() const { return m_SimulationTickHz.load(); }
     float GetMeasuredSimulationTickHz() const { return m_MeasuredSimulationTickHz.load(); }
 
+    // Step controller (adaptive substeps, bounded catch-up). Settings are copied under the
+    // scenario lock; the stats below are from the worker's last wake.
+    StepController::Settings GetStepControllerSettings() const;
+    void SetStepControllerSettings(const StepController::Settings& settings);
+    uint32_t GetSimulationSubsteps() const { return m_SimulationSubsteps.load(); }
+    uint32_t GetSimulationCoarseSteps() const { return m_SimulationCoarseSteps.load(); }
+    float GetDroppedSimulationTime() const { return m_DroppedSimulationTime.load(); }
+    float GetSimulationTimeDilation() const { return m_SimulationTimeDilation.load(); }
+
     void SetRenderTickHz(float hz) { m_RenderTickHz.store(hz); }
     float GetRenderTickHz() const { return m_RenderTickHz.load(); }
     float GetMeasuredRenderTickHz() const { return m_MeasuredRenderTickHz.load(); }
@@ -127,6 +144,7 @@ public:
         uint32_t indexCount;
     };
 
+    // Without a device (headless benchmark) uploads are skipped and the buffers stay null.
     MeshBuffers UploadMesh(const Mesh& mesh);
     void DestroyMeshBuffers(const MeshBuffers& buffers);
     VkPipelineLayout GetPipelineLayout() const { return m_PipelineLayout; }
@@ -288,6 +306,11 @@ private:
     std::atomic<float> m_RenderTickHz{ 60.0f };
     std::atomic<float> m_MeasuredRenderTickHz{ 0.0f };
     float m_AccumulatedTime = 0.0f;
+    StepController m_StepController;
+    std::atomic<uint32_t> m_SimulationSubsteps{ 1 };
+    std::atomic<uint32_t> m_SimulationCoarseSteps{ 1 };
+    std::atomic<float> m_DroppedSimulationTime{ 0.0f };
+    std::atomic<float> m_SimulationTimeDilation{ 1.0f };
 
     std::thread m_SimulationThread;
     std::atomic<bool> m_RunSimulationThread{ false };
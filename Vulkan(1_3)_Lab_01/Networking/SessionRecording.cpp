@@ -0,0 +1,161 @@
+#include "SessionRecording.h"
+
+#include <fstream>
+
+namespace
+{
+    constexpr char kMagic[4] = { 'S', 'R', 'E', 'C' };
+    constexpr uint32_t kVersion = 1;
+
+    struct FileHeader {
+        char magic[4];
+        uint32_t version;
+        uint32_t tickCount;
+        uint32_t eventCount;
+        uint64_t byteSize;
+    };
+}
+
+void SessionRecording::Clear() {
+    m_Bytes.clear();
+    m_EventCount = 0;
+    m_TickCount = 0;
+    m_LastTick = 0;
+    Rewind();
+}
+
+void SessionRecording::Append(uint32_t tick, EventType type, const void* data, size_t size) {
+    if (size > kMaxPayloadSize) return;
+
+    // Ticks never go backwards, so the delta is small and usually fits in one byte
+    uint32_t delta = tick >= m_LastTick ? tick - m_LastTick : 0;
+    m_LastTick += delta;
+    while (delta >= 0x80) {
+        m_Bytes.push_back(static_cast<uint8_t>(delta | 0x80));
+        delta >>= 7;
+    }
+    m_Bytes.push_back(static_cast<uint8_t>(delta));
+
+    m_Bytes.push_back(static_cast<uint8_t>(type));
+    m_Bytes.push_back(static_cast<uint8_t>(size));
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    m_Bytes.insert(m_Bytes.end(), bytes, bytes + size);
+    ++m_EventCount;
+}
+
+bool SessionRecording::Save(const std::string& path, uint32_t tickCount) const {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) return false;
+
+    FileHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.tickCount = tickCount;
+    header.eventCount = m_EventCount;
+    header.byteSize = m_Bytes.size();
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(m_Bytes.data()), static_cast<std::streamsize>(m_Bytes.size()));
+    return static_cast<bool>(file);
+}
+
+bool SessionRecording::Load(const std::string& path, std::string& error) {
+    Clear();
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        error = "cannot open '" + path + "'";
+        return false;
+    }
+
+    FileHeader header{};
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+        error = "'" + path + "' is not a session recording";
+        return false;
+    }
+    if (header.version != kVersion) {
+        error = "unsupported recording version " + std::to_string(header.version);
+        return false;
+    }
+
+    // Check the header's size against the file before allocating it
+    const std::streampos eventsBegin = file.tellg();
+    file.seekg(0, std::ios::end);
+    const std::streamoff available = file.tellg() - eventsBegin;
+    file.seekg(eventsBegin);
+    if (!file || available < 0 || header.byteSize > static_cast<uint64_t>(available)) {
+        error = "'" + path + "' is truncated";
+        return false;
+    }
+
+    m_Bytes.resize(static_cast<size_t>(header.byteSize));
+    if (!file.read(reinterpret_cast<char*>(m_Bytes.data()), static_cast<std::streamsize>(m_Bytes.size()))) {
+        Clear();
+        error = "'" + path + "' is truncated";
+        return false;
+    }
+
+    // Validate the whole stream once so reading can trust it
+    uint32_t events = 0;
+    Event event;
+    for (size_t offset = 0, next = 0; offset < m_Bytes.size(); offset = next, ++events) {
+        if (!Decode(offset, event, next)) {
+            Clear();
+            error = "'" + path + "' has a corrupt event at byte " + std::to_string(offset);
+            return false;
+        }
+    }
+    if (events != header.eventCount) {
+        Clear();
+        error = "'" + path + "' event count does not match its header";
+        return false;
+    }
+
+    m_EventCount = header.eventCount;
+    m_TickCount = header.tickCount;
+    return true;
+}
+
+void SessionRecording::Rewind() {
+    m_ReadOffset = 0;
+    m_ReadTick = 0;
+}
+
+bool SessionRecording::Peek(Event& out) const {
+    if (m_ReadOffset >= m_Bytes.size()) return false;
+
+    size_t next = 0;
+    if (!Decode(m_ReadOffset, out, next)) return false;
+    out.tick += m_ReadTick;
+    return true;
+}
+
+void SessionRecording::Pop() {
+    Event event;
+    size_t next = 0;
+    if (m_ReadOffset >= m_Bytes.size() || !Decode(m_ReadOffset, event, next)) return;
+    m_ReadTick += event.tick;
+    m_ReadOffset = next;
+}
+
+// Decodes the event at 'offset'; out.tick is the delta from the previous event.
+bool SessionRecording::Decode(size_t offset, Event& out, size_t& next) const {
+    uint32_t delta = 0;
+    for (int shift = 0;; shift += 7) {
+        if (offset >= m_Bytes.size() || shift > 28) return false;
+        const uint8_t byte = m_Bytes[offset++];
+        delta |= static_cast<uint32_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) break;
+    }
+
+    if (offset + 2 > m_Bytes.size()) return false;
+    out.tick = delta;
+    out.type = static_cast<EventType>(m_Bytes[offset]);
+    out.size = m_Bytes[offset + 1];
+    offset += 2;
+
+    if (offset + out.size > m_Bytes.size()) return false;
+    out.data = m_Bytes.data() + offset;
+    next = offset + out.size;
+    return true;
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Tick-stamped log of everything that reaches a simulation from outside its update: remote
+// packets, UI spawns, preset resets, setting and time step changes. A tick is the number of
+// updates run before the event took effect, so replaying the events in order between the same
+// updates reproduces the session without a network or a UI.
+// Stream layout: a header (magic, version, tick count, event count), then per event the tick
+// delta as a varint, the event type, the payload size and the payload. Payloads are plain structs
+// copied byte for byte, so a recording only replays on a build with the same struct layouts.
+class SessionRecording {
+public:
+    enum class EventType : uint8_t {
+        Preset = 1,      // scene rebuilt from a preset, with the settings it was built under
+        Settings = 2,    // simulation settings changed
+        TimeStep = 3,    // update delta time changed
+        RemoteState = 4, // SimStatePacket applied to a replica
+        RemoteSpawn = 5, // SimSpawnPacket from a peer
+        LocalSpawn = 6,  // SimSpawnPacket for a body spawned from the UI
+        Checksum = 7     // state hash after the updates so far, for divergence checks
+    };
+
+    struct Event {
+        uint32_t tick = 0;
+        EventType type = EventType::Preset;
+        const uint8_t* data = nullptr;
+        uint8_t size = 0;
+    };
+
+    static constexpr size_t kMaxPayloadSize = 255;
+
+    void Clear();
+
+    template <typename T>
+    void Append(uint32_t tick, EventType type, const T& payload);
+    void Append(uint32_t tick, EventType type, const void* data, size_t size);
+
+    // 'tickCount' is the number of updates the recording covers.
+    bool Save(const std::string& path, uint32_t tickCount) const;
+    bool Load(const std::string& path, std::string& error);
+
+    // Reading starts at the first event after Load() or Rewind().
+    void Rewind();
+    bool Peek(Event& out) const;
+    void Pop();
+
+    template <typename T>
+    static bool ReadPayload(const Event& event, T& out);
+
+    uint32_t GetTickCount() const { return m_TickCount; }
+    uint32_t GetEventCount() const { return m_EventCount; }
+    size_t GetByteSize() const { return m_Bytes.size(); }
+
+private:
+    bool Decode(size_t offset, Event& out, size_t& next) const;
+
+    std::vector<uint8_t> m_Bytes; // events only; the header is written by Save()
+    uint32_t m_EventCount = 0;
+    uint32_t m_TickCount = 0;
+    uint32_t m_LastTick = 0;      // writer: tick of the last appended event
+
+    size_t m_ReadOffset = 0;
+    uint32_t m_ReadTick = 0;      // reader: tick of the last popped event
+};
+
+template <typename T>
+void SessionRecording::Append(uint32_t tick, EventType type, const T& payload) {
+    static_assert(std::is_trivially_copyable_v<T>, "payloads are copied byte for byte");
+    static_assert(sizeof(T) <= kMaxPayloadSize, "payload too large for the size byte");
+    Append(tick, type, &payload, sizeof(T));
+}
+
+template <typename T>
+bool SessionRecording::ReadPayload(const Event& event, T& out) {
+    static_assert(std::is_trivially_copyable_v<T>, "payloads are copied byte for byte");
+    if (event.size != sizeof(T)) return false;
+    std::memcpy(&out, event.data, sizeof(T));
+    return true;
+}
@@ -1,5 +1,7 @@
 #include "CollisionScenario.h"
+#include "../SimulationLibrary/CollisionDispatch.h"
 #include "../SimulationLibrary/CollisionUtil.h"
+#include "../SimulationLibrary/ContactManifold.h"
 #include <imgui.h>
 #include <algorithm>
 #include <cmath>
@@ -48,6 +50,10 @@ void CollisionScenario::ClearScene() {
     m_Spheres.clear();
     m_Planes.clear();
     m_Boxes.clear();
+    m_StaticWorld.Clear();
+    m_ContactSolver.Clear();
+    m_Islands.Clear();
+    m_IslandMembers.clear();
 }
 
 void CollisionScenario::UpdatePlaneTransform(PlaneInstance& plane, const glm::vec3& position) {
@@ -60,7 +66,7 @@ void CollisionScenario::AddSphere(const glm::vec3& position, const glm::vec3& ve
     SphereInstance instance{};
     instance.color = color;
 
-    instance.body.SetCollider(std::make_unique<SphereCollider>(radius));
+    instance.body.SetCollider(SphereCollider(radius));
     instance.body.SetPosition(position);
     instance.body.SetVelocity(velocity);
     instance.body.SetRadius(radius);
@@ -81,10 +87,13 @@ void CollisionScenario::AddPlane(const glm::vec3& point, const glm::vec3& normal
     glm::vec3 n = glm::normalize(normal);
     instance.orientation = glm::rotation(glm::vec3(0.0f, 1.0f, 0.0f), n);
 
-    instance.body.SetCollider(std::make_unique<PlaneCollider>(n));
+    instance.body.SetCollider(PlaneCollider(n));
     instance.body.SetMass(0.0f);
     UpdatePlaneTransform(instance, point);
 
+    const auto* pCol = instance.body.GetColliderAs<PlaneCollider>();
+    m_StaticWorld.AddPlane(pCol->GetNormal(), pCol->GetPoint(), static_cast<uint32_t>(m_Planes.size()));
+
     instance.mesh = MeshGenerator::GeneratePlane(size.x, size.y, 10, 10, color);
     instance.buffers = m_App->UploadMesh(instance.mesh);
     m_Planes.push_back(std::move(instance));
@@ -96,7 +105,7 @@ void CollisionScenario::AddBox(const glm::vec3& position, const glm::quat& orien
     instance.color = color;
     instance.halfExtents = glm::max(halfExtents, glm::vec3(0.05f));
 
-    instance.body.SetCollider(std::make_unique<BoxCollider>(instance.halfExtents));
+    instance.body.SetCollider(BoxCollider(instance.halfExtents));
     instance.body.SetPosition(position);
     instance.body.SetOrientation(orientation);
     instance.body.SetVelocity(velocity);
@@ -109,68 +118,129 @@ void CollisionScenario::AddBox(const glm::vec3& position, const glm::quat& orien
     m_Boxes.push_back(std::move(instance));
 }
 
-void CollisionScenario::ResolveSpherePlane(SphereInstance& sphere, PlaneInstance& plane) {
-    auto* pCol = plane.body.GetColliderAs<PlaneCollider>();
-    if (!pCol) return;
-
+void CollisionScenario::ResolvePair(PhysicsObject& a, PhysicsObject& b) {
+    // The dispatch table picks the shape test from the two collider tags; normal points a -> b.
     SimCollision::Contact c{};
-    if (SimCollision::SphereVsPlane(sphere.body.GetPosition(), sphere.body.GetRadius(), pCol->GetNormal(), pCol->GetPoint(), c)) {
-        PhysicsObject::ResolveCollision(&sphere.body, &plane.body, c);
+    if (SimCollision::Collide(a.GetCollider(), b.GetCollider(), c)) {
+        PhysicsObject::ResolveCollision(&a, &b, c);
     }
 }
 
-void CollisionScenario::ResolveSphereSphere(SphereInstance& a, SphereInstance& b) {
-    glm::vec3 delta = b.body.GetPosition() - a.body.GetPosition();
-    float dist = glm::length(delta);
-    float radiusSum = a.body.GetRadius() + b.body.GetRadius();
-
-    if (dist > 0.0f && dist < radiusSum) {
-        SimCollision::Contact c{};
-        c.hit = true;
-        c.normal = delta / dist; // Normal points from A to B
-        c.penetration = radiusSum - dist;
-        PhysicsObject::ResolveCollision(&a.body, &b.body, c);
-    }
-}
+void CollisionScenario::GatherContactManifolds() {
+    // Pair keys are (tag|index) for A in the high word and for B in the low word, so every
+    // (shape, shape) combination gets its own range and the solver can find last tick's manifold.
+    constexpr uint32_t kSphereTag = 0x00000000u;
+    constexpr uint32_t kBoxTag = 0x40000000u;
+    constexpr uint32_t kPlaneTag = 0x80000000u;
+    auto pairKey = [](uint32_t tagA, size_t a, uint32_t tagB, size_t b) {
+        return (uint64_t(tagA | uint32_t(a)) << 32) | uint64_t(tagB | uint32_t(b));
+    };
+    auto toOBB = [](const BoxCollider& col) {
+        return SimCollision::OBB{ col.GetCenter(), col.GetOrientation(), col.GetHalfExtents() };
+    };
 
-void CollisionScenario::ResolveSphereBox(SphereInstance& sphere, BoxInstance& box) {
-    auto* bCol = box.body.GetColliderAs<BoxCollider>();
-    if (!bCol) return;
+    // Pairs that cannot move (sleeping or static on both sides) are left out; the solver drops
+    // their manifolds until something wakes them.
+    auto isResting = [](const auto& instance) { return instance.sleep.asleep || instance.body.GetInverseMass() <= 0.0f; };
+    auto link = [&](uint32_t a, uint32_t b) {
+        if (a != kNotInIsland && b != kNotInIsland) m_Islands.AddContact(a, b);
+    };
 
-    SimCollision::OBB obb{ bCol->GetCenter(), bCol->GetOrientation(), bCol->GetHalfExtents() };
-    SimCollision::Contact c{};
+    SimCollision::Manifold manifold;
 
-    if (SimCollision::SphereVsOBB(sphere.body.GetPosition(), sphere.body.GetRadius(), obb, c)) {
-        // SphereVsOBB normal points Box -> Sphere. We need A -> B (Sphere -> Box), so flip it!
-        c.normal = -c.normal;
-        PhysicsObject::ResolveCollision(&sphere.body, &box.body, c);
+    for (size_t i = 0; i < m_Spheres.size(); ++i) {
+        auto& sphere = m_Spheres[i];
+        if (isResting(sphere)) continue;
+        m_StaticWorld.QuerySphere(sphere.body.GetPosition(), sphere.body.GetRadius(), [&](uint32_t j) {
+            auto* pCol = m_Planes[j].body.GetColliderAs<PlaneCollider>();
+            if (pCol && SimCollision::SphereVsPlaneManifold(sphere.body.GetPosition(), sphere.body.GetRadius(), pCol->GetNormal(), pCol->GetPoint(), manifold))
+                m_ContactSolver.AddManifold(pairKey(kSphereTag, i, kPlaneTag, j), &sphere.body, &m_Planes[j].body, manifold);
+        });
     }
-}
 
-void CollisionScenario::ResolveBoxPlane(BoxInstance& box, PlaneInstance& plane) {
-    auto* bCol = box.body.GetColliderAs<BoxCollider>();
-    auto* pCol = plane.body.GetColliderAs<PlaneCollider>();
-    if (!bCol || !pCol) return;
+    for (size_t i = 0; i < m_Boxes.size(); ++i) {
+        auto* bCol = m_Boxes[i].body.GetColliderAs<BoxCollider>();
+        if (!bCol || isResting(m_Boxes[i])) continue;
+        const SimCollision::OBB obb = toOBB(*bCol);
+        m_StaticWorld.Query(SimCollision::OBBBounds(obb), [&](uint32_t j) {
+            auto* pCol = m_Planes[j].body.GetColliderAs<PlaneCollider>();
+            if (pCol && SimCollision::OBBVsPlaneManifold(obb, pCol->GetNormal(), pCol->GetPoint(), manifold))
+                m_ContactSolver.AddManifold(pairKey(kBoxTag, i, kPlaneTag, j), &m_Boxes[i].body, &m_Planes[j].body, manifold);
+        });
+    }
 
-    SimCollision::OBB obb{ bCol->GetCenter(), bCol->GetOrientation(), bCol->GetHalfExtents() };
-    SimCollision::Contact c{};
+    for (size_t i = 0; i < m_Spheres.size(); ++i) {
+        for (size_t j = i + 1; j < m_Spheres.size(); ++j) {
+            if (isResting(m_Spheres[i]) && isResting(m_Spheres[j])) continue;
+            auto& a = m_Spheres[i].body;
+            auto& b = m_Spheres[j].body;
+            if (SimCollision::SphereVsSphereManifold(a.GetPosition(), a.GetRadius(), b.GetPosition(), b.GetRadius(), manifold)) {
+                m_ContactSolver.AddManifold(pairKey(kSphereTag, i, kSphereTag, j), &a, &b, manifold);
+                link(m_Spheres[i].islandIndex, m_Spheres[j].islandIndex);
+            }
+        }
+    }
 
-    if (SimCollision::OBBVsPlane(obb, pCol->GetNormal(), pCol->GetPoint(), c)) {
-        PhysicsObject::ResolveCollision(&box.body, &plane.body, c);
+    for (size_t i = 0; i < m_Spheres.size(); ++i) {
+        auto& sphere = m_Spheres[i].body;
+        for (size_t j = 0; j < m_Boxes.size(); ++j) {
+            if (isResting(m_Spheres[i]) && isResting(m_Boxes[j])) continue;
+            auto* bCol = m_Boxes[j].body.GetColliderAs<BoxCollider>();
+            if (bCol && SimCollision::SphereVsOBBManifold(sphere.GetPosition(), sphere.GetRadius(), toOBB(*bCol), manifold)) {
+                m_ContactSolver.AddManifold(pairKey(kSphereTag, i, kBoxTag, j), &sphere, &m_Boxes[j].body, manifold);
+                link(m_Spheres[i].islandIndex, m_Boxes[j].islandIndex);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < m_Boxes.size(); ++i) {
+        auto* aCol = m_Boxes[i].body.GetColliderAs<BoxCollider>();
+        if (!aCol) continue;
+        for (size_t j = i + 1; j < m_Boxes.size(); ++j) {
+            if (isResting(m_Boxes[i]) && isResting(m_Boxes[j])) continue;
+            auto* bCol = m_Boxes[j].body.GetColliderAs<BoxCollider>();
+            if (bCol && SimCollision::OBBVsOBBManifold(toOBB(*aCol), toOBB(*bCol), manifold)) {
+                m_ContactSolver.AddManifold(pairKey(kBoxTag, i, kBoxTag, j), &m_Boxes[i].body, &m_Boxes[j].body, manifold);
+                link(m_Boxes[i].islandIndex, m_Boxes[j].islandIndex);
+            }
+        }
     }
 }
 
-void CollisionScenario::ResolveBoxBox(BoxInstance& a, BoxInstance& b) {
-    auto* aCol = a.body.GetColliderAs<BoxCollider>();
-    auto* bCol = b.body.GetColliderAs<BoxCollider>();
-    if (!aCol || !bCol) return;
+void CollisionScenario::BeginIslands() {
+    m_IslandMembers.clear();
+    for (uint32_t i = 0; i < static_cast<uint32_t>(m_Spheres.size()); ++i) {
+        auto& s = m_Spheres[i];
+        s.islandIndex = s.body.GetInverseMass() > 0.0f ? static_cast<uint32_t>(m_IslandMembers.size()) : kNotInIsland;
+        if (s.islandIndex != kNotInIsland) m_IslandMembers.push_back(i);
+    }
+    for (uint32_t i = 0; i < static_cast<uint32_t>(m_Boxes.size()); ++i) {
+        auto& b = m_Boxes[i];
+        b.islandIndex = b.body.GetInverseMass() > 0.0f ? static_cast<uint32_t>(m_IslandMembers.size()) : kNotInIsland;
+        if (b.islandIndex != kNotInIsland) m_IslandMembers.push_back(i | kBoxMember);
+    }
+    m_Islands.Begin(m_IslandMembers.size());
+}
 
-    SimCollision::OBB obbA{ aCol->GetCenter(), aCol->GetOrientation(), aCol->GetHalfExtents() };
-    SimCollision::OBB obbB{ bCol->GetCenter(), bCol->GetOrientation(), bCol->GetHalfExtents() };
-    SimCollision::Contact c{};
+void CollisionScenario::UpdateSleeping(float deltaTime) {
+    auto bodyAt = [&](uint32_t member) -> PhysicsObject& {
+        return (member & kBoxMember) ? m_Boxes[member & ~kBoxMember].body : m_Spheres[member].body;
+    };
+    auto stateAt = [&](uint32_t member) -> SleepState& {
+        return (member & kBoxMember) ? m_Boxes[member & ~kBoxMember].sleep : m_Spheres[member].sleep;
+    };
 
-    if (SimCollision::OBBVsOBB(obbA, obbB, c)) {
-        PhysicsObject::ResolveCollision(&a.body, &b.body, c);
+    for (uint32_t i = 0; i < static_cast<uint32_t>(m_IslandMembers.size()); ++i) {
+        const PhysicsObject& body = bodyAt(m_IslandMembers[i]);
+        m_Islands.SetBody(i, &stateAt(m_IslandMembers[i]), body.GetVelocity(), body.GetAngularVelocity());
+    }
+
+    m_Islands.Update(deltaTime);
+
+    for (const uint32_t i : m_Islands.GetFellAsleep()) {
+        PhysicsObject& body = bodyAt(m_IslandMembers[i]);
+        body.SetVelocity(glm::vec3(0.0f));
+        body.SetAngularVelocity(glm::vec3(0.0f));
     }
 }
 
@@ -312,6 +382,25 @@ void CollisionScenario::SetupTestCase(TestCase testCase) {
         AddBox({ 0.0f, 2.2f, 0.0f }, glm::quat(glm::vec3(0.2f, 0.1f, 0.0f)), { 0.6f, 0.4f, 0.7f }, { 0.0f, -1.2f, 0.0f }, 1.0f, { 0.3f, 0.8f, 1.0f });
         m_TargetTime = 1.3f;
         break;
+
+    case TestCase::CuboidStack:
+    {
+        m_TestDescription = "Contact solver: stack of cuboids resting on a plane";
+        m_Gravity = -9.81f;
+        AddPlane({ 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 8.0f, 8.0f }, { 0.4f, 0.4f, 0.4f });
+
+        const int count = 6;
+        for (int i = 0; i < count; ++i) {
+            // Small offsets and gaps so the stack has to settle instead of starting at rest.
+            const float offset = (i % 2 == 0) ? 0.03f : -0.03f;
+            const glm::vec3 color = (i % 2 == 0) ? glm::vec3(0.3f, 0.8f, 1.0f) : glm::vec3(0.9f, 0.6f, 0.2f);
+            AddBox({ offset, 0.5f + 1.02f * i, 0.0f }, glm::quat(glm::vec3(0.0f, 0.1f * i, 0.0f)), { 0.5f, 0.5f, 0.5f }, { 0,0,0 }, 1.0f, color);
+        }
+        m_MovingSphereIndex = -1;
+        m_TargetTime = 3.0f;
+        m_ExpectedPosition = { 0.0f, 0.5f + (count - 1), 0.0f };
+        break;
+    }
     }
 }
 
@@ -319,6 +408,9 @@ void CollisionScenario::ComputeOverlapCount()
 {
     int overlaps = 0;
 
+    // Resting contacts under the solver are allowed to sink by up to the linear slop.
+    const float boxTolerance = m_UseContactSolver ? m_ContactSolver.GetSettings().linearSlop + 1e-3f : 1e-3f;
+
     // Sphere-sphere overlaps
     for (size_t i = 0; i < m_Spheres.size(); ++i)
     {
@@ -347,7 +439,7 @@ void CollisionScenario::ComputeOverlapCount()
 
             SimCollision::OBB obb{ bCol->GetCenter(), bCol->GetOrientation(), bCol->GetHalfExtents() };
             SimCollision::Contact c{};
-            if (SimCollision::SphereVsOBB(sCol->GetCenter(), sCol->GetRadius(), obb, c) && c.penetration > 1e-3f)
+            if (SimCollision::SphereVsOBB(sCol->GetCenter(), sCol->GetRadius(), obb, c) && c.penetration > boxTolerance)
                 overlaps++;
         }
     }
@@ -364,7 +456,7 @@ void CollisionScenario::ComputeOverlapCount()
             SimCollision::OBB A{ aCol->GetCenter(), aCol->GetOrientation(), aCol->GetHalfExtents() };
             SimCollision::OBB B{ bCol->GetCenter(), bCol->GetOrientation(), bCol->GetHalfExtents() };
             SimCollision::Contact c{};
-            if (SimCollision::OBBVsOBB(A, B, c) && c.penetration > 1e-3f)
+            if (SimCollision::OBBVsOBB(A, B, c) && c.penetration > boxTolerance)
                 overlaps++;
         }
     }
@@ -375,39 +467,70 @@ void CollisionScenario::ComputeOverlapCount()
 void CollisionScenario::OnLoad() { SetupTestCase(m_TestCase); }
 
 void CollisionScenario::OnUpdate(float deltaTime) {
+    m_PhaseTimer.Begin();
     const auto method = m_App->GetIntegrationMethod();
 
-    // 1. RESOLVE ALL COLLISIONS FIRST
-    // Dynamic vs planes
-    for (auto& sphere : m_Spheres)
-        for (auto& plane : m_Planes)
-            ResolveSpherePlane(sphere, plane);
+    if (m_UseContactSolver) {
+        BeginIslands();
 
-    for (auto& box : m_Boxes)
-        for (auto& plane : m_Planes)
-            ResolveBoxPlane(box, plane);
+        // Gravity goes into the velocities before the solve so resting contacts cancel it
+        // in the same tick instead of one tick late. Sleeping bodies are left alone.
+        for (auto& sphere : m_Spheres)
+            if (sphere.body.GetInverseMass() > 0.0f && !sphere.sleep.asleep) sphere.body.SetVelocity(sphere.body.GetVelocity() + glm::vec3(0.0f, m_Gravity * deltaTime, 0.0f));
+        for (auto& box : m_Boxes)
+            if (box.body.GetInverseMass() > 0.0f && !box.sleep.asleep) box.body.SetVelocity(box.body.GetVelocity() + glm::vec3(0.0f, m_Gravity * deltaTime, 0.0f));
 
-    // Sphere-sphere
-    for (size_t i = 0; i < m_Spheres.size(); ++i)
-        for (size_t j = i + 1; j < m_Spheres.size(); ++j)
-            ResolveSphereSphere(m_Spheres[i], m_Spheres[j]);
+        GatherContactManifolds();
+        m_PhaseTimer.Mark("gather");
+        m_ContactSolver.Solve(deltaTime);
+        m_PhaseTimer.Mark("solve");
 
-    // Sphere-box
-    for (auto& sphere : m_Spheres)
+        for (auto& sphere : m_Spheres)
+            if (!sphere.sleep.asleep) sphere.body.Update(deltaTime, 0.0f, method);
         for (auto& box : m_Boxes)
-            ResolveSphereBox(sphere, box);
+            if (!box.sleep.asleep) box.body.Update(deltaTime, 0.0f, method);
+        m_PhaseTimer.Mark("integrate");
 
-    // Box-box
-    for (size_t i = 0; i < m_Boxes.size(); ++i)
-        for (size_t j = i + 1; j < m_Boxes.size(); ++j)
-            ResolveBoxBox(m_Boxes[i], m_Boxes[j]);
+        UpdateSleeping(deltaTime);
+        m_PhaseTimer.Mark("sleep");
+    }
+    else {
+        // 1. RESOLVE ALL COLLISIONS FIRST
+        // Dynamic vs planes (only the planes each body reaches)
+        for (auto& sphere : m_Spheres)
+            m_StaticWorld.QuerySphere(sphere.body.GetPosition(), sphere.body.GetRadius(),
+                [&](uint32_t j) { ResolvePair(sphere.body, m_Planes[j].body); });
 
-    // 2. INTEGRATE (Apply forces and move objects)
-    for (auto& sphere : m_Spheres)
-        sphere.body.Update(deltaTime, m_Gravity, method);
+        for (auto& box : m_Boxes)
+            if (auto* bCol = box.body.GetColliderAs<BoxCollider>())
+                m_StaticWorld.Query(SimCollision::OBBBounds({ bCol->GetCenter(), bCol->GetOrientation(), bCol->GetHalfExtents() }),
+                    [&](uint32_t j) { ResolvePair(box.body, m_Planes[j].body); });
+        m_PhaseTimer.Mark("planes");
+
+        // Sphere-sphere
+        for (size_t i = 0; i < m_Spheres.size(); ++i)
+            for (size_t j = i + 1; j < m_Spheres.size(); ++j)
+                ResolvePair(m_Spheres[i].body, m_Spheres[j].body);
+
+        // Sphere-box
+        for (auto& sphere : m_Spheres)
+            for (auto& box : m_Boxes)
+                ResolvePair(sphere.body, box.body);
+
+        // Box-box
+        for (size_t i = 0; i < m_Boxes.size(); ++i)
+            for (size_t j = i + 1; j < m_Boxes.size(); ++j)
+                ResolvePair(m_Boxes[i].body, m_Boxes[j].body);
+        m_PhaseTimer.Mark("pairs");
+
+        // 2. INTEGRATE (Apply forces and move objects)
+        for (auto& sphere : m_Spheres)
+            sphere.body.Update(deltaTime, m_Gravity, method);
 
-    for (auto& box : m_Boxes)
-        box.body.Update(deltaTime, m_Gravity, method);
+        for (auto& box : m_Boxes)
+            box.body.Update(deltaTime, m_Gravity, method);
+        m_PhaseTimer.Mark("integrate");
+    }
 
     // 3. TESTING / RECORDING LOGIC
     m_ElapsedTime += deltaTime;
@@ -417,6 +540,7 @@ void CollisionScenario::OnUpdate(float deltaTime) {
     }
 
     ComputeOverlapCount();
+    m_PhaseTimer.Mark("overlaps");
 }
 
 void CollisionScenario::OnRender(VkCommandBuffer commandBuffer) {
@@ -463,7 +587,8 @@ void CollisionScenario::OnImGui() {
         "Non-spherical: Sphere vs Cuboid (AABB)",
         "Non-spherical: Sphere vs Cuboid (OBB Rotated)",
         "Non-spherical: Cuboid vs Cuboid (OBB)",
-        "Non-spherical: Cuboid vs Tilted Plane"
+        "Non-spherical: Cuboid vs Tilted Plane",
+        "Contact Solver: Cuboid Stack"
     };
 
     int current = std::clamp((int)m_TestCase, 0, IM_ARRAYSIZE(options) - 1);
@@ -477,6 +602,29 @@ void CollisionScenario::OnImGui() {
     for (auto& sphere : m_Spheres) sphere.body.SetRestitution(m_BounceRestitution);
     for (auto& box : m_Boxes) box.body.SetRestitution(m_BounceRestitution);
 
+    ImGui::Separator();
+    auto& solver = m_ContactSolver.GetSettings();
+    if (ImGui::Checkbox("Contact Solver (persistent manifolds)", &m_UseContactSolver)) {
+        m_ContactSolver.Clear();
+        for (auto& sphere : m_Spheres) sphere.sleep = {};
+        for (auto& box : m_Boxes) box.sleep = {};
+    }
+    if (m_UseContactSolver) {
+        ImGui::SliderInt("Solver Iterations", &solver.iterations, 1, 30);
+        ImGui::Checkbox("Warm Starting", &solver.warmStart);
+        ImGui::SameLine();
+        ImGui::Checkbox("Split Impulse", &solver.splitImpulse);
+        ImGui::SliderFloat("Friction", &solver.friction, 0.0f, 1.0f);
+        ImGui::Text("Manifolds: %zu  Contacts: %u  Warm-started: %u",
+            m_ContactSolver.GetManifoldCount(), m_ContactSolver.GetLastContactCount(), m_ContactSolver.GetLastWarmStartedCount());
+
+        auto& sleep = m_Islands.GetSettings();
+        ImGui::Checkbox("Sleeping (islands)", &sleep.enabled);
+        ImGui::SliderFloat("Time To Sleep (s)", &sleep.timeToSleep, 0.05f, 5.0f, "%.2f");
+        ImGui::Text("Dynamic bodies: %zu  Sleeping: %u  Awake islands: %u",
+            m_Islands.GetBodyCount(), m_Islands.GetSleepingCount(), m_Islands.GetIslandCount());
+    }
+
     ImGui::Separator();
     ImGui::TextWrapped("%s", m_TestDescription.c_str());
     ImGui::Text("Elapsed: %.3f s / Target: %.3f s", m_ElapsedTime, m_TargetTime);
@@ -501,6 +649,29 @@ void CollisionScenario::OnImGui() {
 
     if (ImGui::Button("Reset Test")) SetupTestCase(m_TestCase);
 
+    ImGui::Separator();
+    ImGui::SliderInt("Benchmark Bodies", &m_DispatchBenchmarkBodies, 64, 4096);
+    if (ImGui::Button("Run Collider Dispatch Benchmark")) {
+        m_DispatchBenchmark = SimCollision::RunDispatchBenchmark(static_cast<uint32_t>(m_DispatchBenchmarkBodies), 4);
+    }
+    if (m_DispatchBenchmark.pairTests > 0) {
+        const double pairs = static_cast<double>(m_DispatchBenchmark.pairTests);
+        ImGui::Text("Virtual + dynamic_cast: %.2f ms (%.1f ns/pair)", m_DispatchBenchmark.virtualMs, m_DispatchBenchmark.virtualMs * 1e6 / pairs);
+        ImGui::Text("Variant + pair table:   %.2f ms (%.1f ns/pair)", m_DispatchBenchmark.tableMs, m_DispatchBenchmark.tableMs * 1e6 / pairs);
+        ImGui::Text("Speedup: %.2fx  Hits: %llu / %llu", m_DispatchBenchmark.virtualMs / std::max(m_DispatchBenchmark.tableMs, 1e-6),
+            static_cast<unsigned long long>(m_DispatchBenchmark.virtualHits), static_cast<unsigned long long>(m_DispatchBenchmark.tableHits));
+    }
+
+    if (ImGui::Button("Check Batch Kernels vs Scalar")) {
+        m_BatchKernelCheck = SimCollision::RunBatchKernelCheck(4096);
+    }
+    if (m_BatchKernelCheck.comparisons > 0) {
+        ImGui::Text("%s: %llu mismatches in %llu pairs (%d SIMD levels), max error %.2e",
+            m_BatchKernelCheck.mismatches == 0 ? "OK" : "FAILED",
+            static_cast<unsigned long long>(m_BatchKernelCheck.mismatches), static_cast<unsigned long long>(m_BatchKernelCheck.comparisons),
+            m_BatchKernelCheck.levelsChecked, m_BatchKernelCheck.maxError);
+    }
+
     ImGui::End();
 }
 
@@ -526,11 +697,13 @@ void CollisionScenario::GetSelectionItems(std::vector<SceneSelectionItem>& out)
             auto& body = m_Spheres[i].body;
             body.SetPosition(tp.position);
             body.SetOrientation(glm::quat(glm::radians(tp.rotationDeg)));
+            m_Islands.WakeBody(m_Spheres[i].sleep);
             // radius/scale mapping omitted for spheres (leave geometry unchanged)
         };
         item.Delete = [this, i]() {
             m_App->DestroyMeshBuffers(m_Spheres[i].buffers);
             m_Spheres.erase(m_Spheres.begin() + static_cast<int>(i));
+            m_ContactSolver.Clear(); // cached manifolds point at the moved bodies
         };
         out.push_back(std::move(item));
     }
@@ -552,6 +725,7 @@ void CollisionScenario::GetSelectionItems(std::vector<SceneSelectionItem>& out)
             auto& body = m_Boxes[i].body;
             body.SetPosition(tp.position);
             body.SetOrientation(glm::quat(glm::radians(tp.rotationDeg)));
+            m_Islands.WakeBody(m_Boxes[i].sleep);
             // To change collider/mesh size you must update halfExtents + rebuild mesh; omitted here
         };
         // Leave Delete empty if you prefer not to allow deletion for boxes:
@@ -4,6 +4,10 @@
 #include "../Application/SandboxApplication.h"
 #include "../SimulationLibrary/PhysicsObject.h"
 #include "../SimulationLibrary/Collider.h"
+#include "../SimulationLibrary/ContactSolver.h"
+#include "../SimulationLibrary/DispatchBenchmark.h"
+#include "../SimulationLibrary/SleepIslands.h"
+#include "../SimulationLibrary/StaticWorld.h"
 #include <glm/glm.hpp>
 #include <glm/gtx/quaternion.hpp>
 #include <vector>
@@ -27,11 +31,16 @@ private:
         SphereVsCuboidAxisAligned = 11,
         SphereVsCuboidRotated = 12,
         CuboidVsCuboidAxisAligned = 13,
-        CuboidVsPlaneTilted = 14
+        CuboidVsPlaneTilted = 14,
+        CuboidStack = 15
     };
 
+    static constexpr uint32_t kNotInIsland = 0xFFFFFFFFu;
+
     struct SphereInstance {
         PhysicsObject body;
+        SleepState sleep;
+        uint32_t islandIndex = kNotInIsland;
         Mesh mesh;
         SandboxApplication::MeshBuffers buffers{};
         glm::vec3 color{ 1.0f, 0.3f, 0.3f };
@@ -48,6 +57,8 @@ private:
 
     struct BoxInstance {
         PhysicsObject body;
+        SleepState sleep;
+        uint32_t islandIndex = kNotInIsland;
         Mesh mesh;
         SandboxApplication::MeshBuffers buffers{};
         glm::vec3 halfExtents{ 0.5f, 0.5f, 0.5f };
@@ -58,6 +69,9 @@ private:
     std::vector<PlaneInstance> m_Planes;
     std::vector<BoxInstance> m_Boxes;
 
+    // Plane half-spaces (user data = plane index); planes never move once a test case is set up
+    StaticWorld m_StaticWorld;
+
     TestCase m_TestCase = TestCase::SphereVsPlaneTilted;
     float m_Gravity = 0.0f;
 
@@ -73,6 +87,20 @@ private:
     std::string m_TestDescription;
 
     int m_OverlapCount = 0;
+    PhaseTimer m_PhaseTimer;
+
+    bool m_UseContactSolver = true;
+    ContactSolver m_ContactSolver;
+
+    // Sleeping runs with the contact solver. Members are sphere indices, then box indices + kBoxMember.
+    static constexpr uint32_t kBoxMember = 0x80000000u;
+    SleepIslands m_Islands;
+    std::vector<uint32_t> m_IslandMembers;
+
+    // Collider storage/dispatch microbenchmark (virtual + dynamic_cast vs variant + pair table)
+    int m_DispatchBenchmarkBodies = 1024;
+    SimCollision::DispatchBenchmarkResult m_DispatchBenchmark{};
+    SimCollision::BatchKernelCheckResult m_BatchKernelCheck{};
 
     void ClearScene();
     void SetupTestCase(TestCase testCase);
@@ -82,12 +110,11 @@ private:
     void AddPlane(const glm::vec3& point, const glm::vec3& normal, const glm::vec2& size, const glm::vec3& color);
     void AddBox(const glm::vec3& position, const glm::quat& orientation, const glm::vec3& halfExtents, const glm::vec3& velocity, float mass, const glm::vec3& color);
 
-    void ResolveSphereSphere(SphereInstance& a, SphereInstance& b);
-    void ResolveSpherePlane(SphereInstance& sphere, PlaneInstance& plane); // Changed
+    void ResolvePair(PhysicsObject& a, PhysicsObject& b);
 
-    void ResolveSphereBox(SphereInstance& sphere, BoxInstance& box);
-    void ResolveBoxPlane(BoxInstance& box, PlaneInstance& plane);
-    void ResolveBoxBox(BoxInstance& a, BoxInstance& b);
+    void GatherContactManifolds();
+    void BeginIslands();
+    void UpdateSleeping(float deltaTime);
 
     void ComputeOverlapCount();
 
@@ -96,6 +123,7 @@ public:
 
     void OnLoad() override;
     void OnUpdate(float deltaTime) override;
+    const PhaseTimer* GetPhaseTimer() const override { return &m_PhaseTimer; }
     void OnRender(VkCommandBuffer commandBuffer) override;
     void OnImGui() override;
     void OnUnload() override;
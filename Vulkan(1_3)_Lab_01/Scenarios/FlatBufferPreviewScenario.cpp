@@ -174,6 +174,28 @@ namespace
         return obb;
     }
 
+    SimCollision::ConvexShape MakeConvexFromItem(const FlatBufferPreviewScenario::RenderItem& it)
+    {
+        const glm::vec3 center = it.baseTransform.position;
+        const glm::mat3 orientation = glm::mat3_cast(EulerToQuatDeg(it.baseTransform.orientation));
+        const float radius = std::max(0.05f, it.shapeRadius);
+
+        switch (it.shapeType) {
+        case SimRuntime::ShapeType::Sphere:
+            return SimCollision::ConvexShape::Sphere(center, radius);
+        case SimRuntime::ShapeType::Capsule:
+            // shapeHeight is the full height including the caps, as in GenerateCapsule
+            return SimCollision::ConvexShape::Capsule(center, orientation, radius, std::max(0.0f, it.shapeHeight * 0.5f - radius));
+        case SimRuntime::ShapeType::Cylinder:
+            return SimCollision::ConvexShape::Cylinder(center, orientation, radius, std::max(0.05f, it.shapeHeight * 0.5f));
+        case SimRuntime::ShapeType::Cuboid:
+            return SimCollision::ConvexShape::Box(MakeObbFromItem(it));
+        case SimRuntime::ShapeType::Plane:
+        default:
+            return SimCollision::ConvexShape::Sphere(center, std::max(0.05f, it.boundRadius));
+        }
+    }
+
     float SupportDistanceAlongNormalForItem(const FlatBufferPreviewScenario::RenderItem& it, const glm::vec3& nWorld)
     {
         if (it.shapeType == SimRuntime::ShapeType::Cuboid) {
@@ -190,7 +212,8 @@ namespace
         float penetration = 0.0f;
     };
 
-    PairContact ComputePairContact(const FlatBufferPreviewScenario::RenderItem& A, const FlatBufferPreviewScenario::RenderItem& B)
+    PairContact ComputePairContact(const FlatBufferPreviewScenario::RenderItem& A, const FlatBufferPreviewScenario::RenderItem& B,
+                                   SimCollision::GJKSimplex* simplex = nullptr)
     {
         PairContact out{};
 
@@ -238,18 +261,13 @@ namespace
             return sphereVsBox(B, A, false);
         }
 
-        // Fallback (bounding sphere vs bounding sphere) for Sphere/Cylinder/Capsule/etc.
-        const glm::vec3 delta = B.baseTransform.position - A.baseTransform.position;
-        const float minDist = std::max(0.05f, A.boundRadius) + std::max(0.05f, B.boundRadius);
-        const float distSq = glm::length2(delta);
-        if (distSq >= minDist * minDist) return out;
-
-        const float dist = std::sqrt(std::max(distSq, 1e-8f));
-        const glm::vec3 n = (dist > 1e-4f) ? (delta / dist) : glm::vec3(1.0f, 0.0f, 0.0f);
+        // Everything else (sphere/capsule/cylinder pairings) through GJK/EPA
+        SimCollision::Contact c{};
+        if (!SimCollision::ConvexVsConvex(MakeConvexFromItem(A), MakeConvexFromItem(B), c, simplex)) return out;
 
         out.hit = true;
-        out.nAB = n;
-        out.penetration = minDist - dist;
+        out.nAB = c.normal;          // A -> B
+        out.penetration = c.penetration;
         return out;
     }
 }
@@ -261,6 +279,13 @@ void FlatBufferPreviewScenario::Clear() {
     m_Items.clear();
     m_LocalWarnings.clear();
     m_UnsupportedCount = 0;
+    m_Islands.Clear();
+    m_IslandMembers.clear();
+    m_ItemIsland.clear();
+    m_PairSimplices.clear();
+    m_SimTick = 0;
+    ++m_SceneGeneration;
+    m_Snapshots.Clear();
 }
 
 glm::mat4 FlatBufferPreviewScenario::BuildModelMatrix(const SimRuntime::Transform& t) {
@@ -1069,12 +1094,26 @@ void FlatBufferPreviewScenario::OnUpdate(float deltaTime) {
         };
 
     std::lock_guard<std::mutex> lock(m_ItemsMutex);
+    m_PhaseTimer.Begin();
 
     if (const int sceneIndex = m_PendingSceneSwitchIndex.exchange(-1); sceneIndex >= 0) {
         ApplyLoadedSceneSwitch(sceneIndex);
     }
 
     UpdateRuntimeSpawners(deltaTime);
+    m_PhaseTimer.Mark("spawners");
+
+    // Island membership: locally simulated dynamic items. Sleeping ones are skipped below
+    // until a contact with something moving (or a moving animated item) wakes them.
+    m_IslandMembers.clear();
+    m_ItemIsland.assign(m_Items.size(), kNotInIsland);
+    for (uint32_t i = 0; i < static_cast<uint32_t>(m_Items.size()); ++i) {
+        const auto& item = m_Items[i];
+        if (!item.isSimulated || !item.isLocallyOwned || item.inverseMass <= 0.0f) continue;
+        m_ItemIsland[i] = static_cast<uint32_t>(m_IslandMembers.size());
+        m_IslandMembers.push_back(i);
+    }
+    m_Islands.Begin(m_IslandMembers.size());
 
     std::vector<glm::vec3> animatedVelocities(m_Items.size(), glm::vec3(0.0f));
 
@@ -1175,6 +1214,8 @@ void FlatBufferPreviewScenario::OnUpdate(float deltaTime) {
         item.model = BuildModelMatrix(item.baseTransform);
     }
 
+    m_PhaseTimer.Mark("animation");
+
     // Use scene-configured gravity flag (default true when no loaded scene)
     const auto* loadedScene = m_App->GetLoadedScene();
     const bool gravityEnabled = (loadedScene == nullptr) ? true : loadedScene->gravityOn;
@@ -1185,6 +1226,7 @@ void FlatBufferPreviewScenario::OnUpdate(float deltaTime) {
         if (!item.isSimulated || !item.isLocallyOwned || item.inverseMass <= 0.0f) {
             continue; // owner-driven: only local owner simulates
         }
+        if (item.sleep.asleep) continue;
 
         item.linearVelocity.y += gravity * deltaTime;
         item.baseTransform.position += item.linearVelocity * deltaTime;
@@ -1209,6 +1251,8 @@ void FlatBufferPreviewScenario::OnUpdate(float deltaTime) {
         item.model = BuildModelMatrix(item.baseTransform);
     }
 
+    m_PhaseTimer.Mark("integrate");
+
     struct MaterialContactParams {
         float restitution = 0.45f;
         float staticFriction = 0.6f;
@@ -1238,7 +1282,7 @@ void FlatBufferPreviewScenario::OnUpdate(float deltaTime) {
     // Simulated vs Container (container keeps objects inside its boundary)
     for (size_t i = 0; i < m_Items.size(); ++i) {
         auto& a = m_Items[i];
-        if (!a.isSimulated || !a.isLocallyOwned || a.inverseMass <= 0.0f) {
+        if (!a.isSimulated || !a.isLocallyOwned || a.inverseMass <= 0.0f || a.sleep.asleep) {
             continue;
         }
 
@@ -1295,6 +1339,15 @@ void FlatBufferPreviewScenario::OnUpdate(float deltaTime) {
                 continue;
             }
 
+            // A moving animated item wakes whatever it touches; a parked one does not.
+            const float wakeSpeed = m_Islands.GetSettings().linearThreshold;
+            if (glm::length2(animatedVelocities[j]) > wakeSpeed * wakeSpeed) {
+                m_Islands.WakeBody(a.sleep);
+            }
+            else if (a.sleep.asleep) {
+                continue;
+            }
+
             const float dist = std::sqrt(std::max(distSq, 1e-8f));
             const glm::vec3 n = (dist > 1e-4f) ? (delta / dist) : glm::vec3(1.0f, 0.0f, 0.0f);
 
@@ -1324,6 +1377,8 @@ void FlatBufferPreviewScenario::OnUpdate(float deltaTime) {
         }
     }
 
+    m_PhaseTimer.Mark("static contacts");
+
     // Owner-side simulated object vs object collision response
     // Simulated vs Simulated
     for (size_t i = 0; i < m_Items.size(); ++i) {
@@ -1335,6 +1390,7 @@ void FlatBufferPreviewScenario::OnUpdate(float deltaTime) {
             auto& b = m_Items[j];
             if (!b.isSimulated || !b.isLocallyOwned || b.inverseMass <= 0.0f) continue;
             if (b.collisionType == SimRuntime::CollisionType::Container) continue;
+            if (a.sleep.asleep && b.sleep.asleep) continue;
 
             const glm::vec3 delta = b.baseTransform.position - a.baseTransform.position;
             const float minDist = a.boundRadius + b.boundRadius;
@@ -1344,11 +1400,21 @@ void FlatBufferPreviewScenario::OnUpdate(float deltaTime) {
                 continue;
             }
 
-            const float dist = std::sqrt(std::max(distSq, 1e-8f));
-            const glm::vec3 n = (dist > 1e-4f) ? (delta / dist) : glm::vec3(1.0f, 0.0f, 0.0f);
+            // Bounding spheres overlap: narrowphase on the actual shapes, warm-started per pair
+            const uint64_t pairKey = (static_cast<uint64_t>(std::min(a.objectId, b.objectId)) << 32) | std::max(a.objectId, b.objectId);
+            PairSimplex& cached = m_PairSimplices[pairKey];
+            cached.lastTick = m_PairTick;
+            const PairContact pc = ComputePairContact(a, b, &cached.simplex);
+            if (!pc.hit) {
+                continue;
+            }
+
+            m_Islands.AddContact(m_ItemIsland[i], m_ItemIsland[j]);
+
+            const glm::vec3 n = pc.nAB;
 
             // positional correction
-            const float penetration = minDist - dist;
+            const float penetration = pc.penetration;
             if (penetration > 0.0f) {
                 const glm::vec3 correction = n * (penetration * 0.5f);
                 a.baseTransform.position -= correction;
@@ -1428,6 +1494,187 @@ void FlatBufferPreviewScenario::OnUpdate(float deltaTime) {
             b.model = BuildModelMatrix(b.baseTransform);
         }
     }
+
+    m_PhaseTimer.Mark("pair contacts");
+
+    // Forget pairs whose bounding spheres have been apart for a while.
+    ++m_PairTick;
+    std::erase_if(m_PairSimplices, [&](const auto& entry) { return m_PairTick - entry.second.lastTick > kMaxIdlePairTicks; });
+
+    for (uint32_t i = 0; i < static_cast<uint32_t>(m_IslandMembers.size()); ++i) {
+        auto& item = m_Items[m_IslandMembers[i]];
+        m_Islands.SetBody(i, &item.sleep, item.linearVelocity, glm::radians(item.angularVelocityDeg));
+    }
+    m_Islands.Update(deltaTime);
+
+    for (const uint32_t i : m_Islands.GetFellAsleep()) {
+        auto& item = m_Items[m_IslandMembers[i]];
+        item.linearVelocity = glm::vec3(0.0f);
+        item.angularVelocityDeg = glm::vec3(0.0f);
+    }
+    m_PhaseTimer.Mark("sleep");
+
+    ++m_SimTick;
+    if (m_CaptureSnapshots) {
+        const auto start = std::chrono::steady_clock::now();
+        WriteSnapshot(m_Snapshots.Push(m_SimTick));
+        m_LastSnapshotSaveUs = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - start).count();
+        m_PhaseTimer.Mark("snapshot");
+    }
+}
+
+void FlatBufferPreviewScenario::WriteSnapshot(WorldSnapshot& out) {
+    out.Write(kSnapshotTag);
+    out.Write(m_SceneGeneration);
+    out.Write(m_SimTick);
+    out.Write(m_NextObjectId);
+    out.Write(m_TotalSpawnedBySpawners);
+    out.Write(m_SpawnRng);
+
+    m_SnapshotSpawners.resize(m_RuntimeSpawners.size());
+    for (size_t i = 0; i < m_RuntimeSpawners.size(); ++i) {
+        const auto& s = m_RuntimeSpawners[i];
+        m_SnapshotSpawners[i] = { s.singleBurstDone, s.elapsed, s.repeatAccumulator, s.spawnedCount, s.sequentialCursor };
+    }
+    out.Write(static_cast<uint32_t>(m_SnapshotSpawners.size()));
+    out.WriteArray(m_SnapshotSpawners);
+
+    m_SnapshotItems.resize(m_Items.size());
+    for (size_t i = 0; i < m_Items.size(); ++i) {
+        const auto& item = m_Items[i];
+        auto& entry = m_SnapshotItems[i];
+        entry.objectId = item.objectId;
+        entry.owner = item.owner;
+        entry.isLocallyOwned = item.isLocallyOwned;
+        entry.reverse = item.reverse;
+        entry.hasReplicatedState = item.hasReplicatedState;
+        entry.sleepStateSent = item.sleepStateSent;
+        entry.animTime = item.animTime;
+        entry.baseTransform = item.baseTransform;
+        entry.model = item.model;
+        entry.linearVelocity = item.linearVelocity;
+        entry.angularVelocityDeg = item.angularVelocityDeg;
+        entry.replicatedTargetPos = item.replicatedTargetPos;
+        entry.replicatedTargetVel = item.replicatedTargetVel;
+        entry.sleep = item.sleep;
+    }
+    out.Write(static_cast<uint32_t>(m_SnapshotItems.size()));
+    out.WriteArray(m_SnapshotItems);
+}
+
+bool FlatBufferPreviewScenario::ReadSnapshot(const WorldSnapshot& snapshot, std::string& error) {
+    WorldSnapshot::Reader in(snapshot);
+    uint32_t tag = 0, generation = 0, simTick = 0, nextObjectId = 0, totalSpawned = 0, spawnerCount = 0, itemCount = 0;
+    std::mt19937 spawnRng;
+    if (!in.Read(tag) || tag != kSnapshotTag) {
+        error = "not a snapshot of this scenario";
+        return false;
+    }
+    if (!in.Read(generation) || !in.Read(simTick) || !in.Read(nextObjectId) || !in.Read(totalSpawned) || !in.Read(spawnRng)
+        || !in.Read(spawnerCount)) {
+        error = "snapshot is truncated";
+        return false;
+    }
+    if (generation != m_SceneGeneration || spawnerCount != m_RuntimeSpawners.size()) {
+        error = "the scene was rebuilt or reset after this snapshot";
+        return false;
+    }
+
+    m_SnapshotSpawners.resize(spawnerCount);
+    if (!in.ReadArray(m_SnapshotSpawners.data(), spawnerCount) || !in.Read(itemCount)) {
+        error = "snapshot is truncated";
+        return false;
+    }
+
+    // Items are only ever appended within one scene, so the snapshot's must be a prefix of ours
+    if (itemCount > m_Items.size()) {
+        error = "snapshot has items this scene does not";
+        return false;
+    }
+    m_SnapshotItems.resize(itemCount);
+    if (!in.ReadArray(m_SnapshotItems.data(), itemCount)) {
+        error = "snapshot is truncated";
+        return false;
+    }
+    for (uint32_t i = 0; i < itemCount; ++i) {
+        if (m_SnapshotItems[i].objectId != m_Items[i].objectId) {
+            error = "snapshot items do not match the scene";
+            return false;
+        }
+    }
+
+    // Drop what was spawned after the snapshot
+    if (m_Items.size() > itemCount) {
+        for (size_t i = itemCount; i < m_Items.size(); ++i) m_App->DestroyMeshBuffers(m_Items[i].buffers);
+        m_Items.erase(m_Items.begin() + itemCount, m_Items.end());
+        RefreshOwnershipFlagsAndStats();
+    }
+
+    for (uint32_t i = 0; i < itemCount; ++i) {
+        const auto& entry = m_SnapshotItems[i];
+        auto& item = m_Items[i];
+        item.owner = entry.owner;
+        item.isLocallyOwned = entry.isLocallyOwned;
+        item.reverse = entry.reverse;
+        item.hasReplicatedState = entry.hasReplicatedState;
+        item.sleepStateSent = entry.sleepStateSent;
+        item.animTime = entry.animTime;
+        item.baseTransform = entry.baseTransform;
+        item.model = entry.model;
+        item.linearVelocity = entry.linearVelocity;
+        item.angularVelocityDeg = entry.angularVelocityDeg;
+        item.replicatedTargetPos = entry.replicatedTargetPos;
+        item.replicatedTargetVel = entry.replicatedTargetVel;
+        item.sleep = entry.sleep;
+    }
+
+    for (uint32_t i = 0; i < spawnerCount; ++i) {
+        const auto& entry = m_SnapshotSpawners[i];
+        auto& s = m_RuntimeSpawners[i];
+        s.singleBurstDone = entry.singleBurstDone;
+        s.elapsed = entry.elapsed;
+        s.repeatAccumulator = entry.repeatAccumulator;
+        s.spawnedCount = entry.spawnedCount;
+        s.sequentialCursor = entry.sequentialCursor;
+    }
+
+    m_SimTick = simTick;
+    m_NextObjectId = nextObjectId;
+    m_TotalSpawnedBySpawners = totalSpawned;
+    m_SpawnRng = spawnRng;
+
+    // Cached simplices belong to the abandoned future
+    m_PairSimplices.clear();
+    return true;
+}
+
+bool FlatBufferPreviewScenario::Rollback(uint32_t ticks, std::string& error) {
+    const uint32_t target = m_SimTick > ticks ? m_SimTick - ticks : 0;
+    const WorldSnapshot* snapshot = m_Snapshots.FindAtOrBefore(target);
+    if (!snapshot) {
+        error = "no snapshot " + std::to_string(ticks) + " ticks back";
+        return false;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    if (!ReadSnapshot(*snapshot, error)) return false;
+    m_LastSnapshotRestoreUs = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    m_Snapshots.DiscardAfter(m_SimTick);
+    return true;
+}
+
+bool FlatBufferPreviewScenario::SaveSnapshot(WorldSnapshot& out) {
+    std::lock_guard<std::mutex> lock(m_ItemsMutex);
+    out.Clear();
+    out.SetTick(m_SimTick);
+    WriteSnapshot(out);
+    return true;
+}
+
+bool FlatBufferPreviewScenario::RestoreSnapshot(const WorldSnapshot& snapshot, std::string& error) {
+    std::lock_guard<std::mutex> lock(m_ItemsMutex);
+    return ReadSnapshot(snapshot, error);
 }
 
 void FlatBufferPreviewScenario::OnRender(VkCommandBuffer commandBuffer) {
@@ -1574,6 +1821,29 @@ void FlatBufferPreviewScenario::OnImGui() {
      
     ImGui::Text("Local-owned simulated: %d", m_LocalOwnedSimulatedCount);
     ImGui::Text("Remote simulated: %d", m_RemoteSimulatedCount);
+    ImGui::Checkbox("Sleeping (islands)", &m_Islands.GetSettings().enabled);
+    ImGui::Text("Sleeping: %u / %zu, awake islands: %u",
+        m_Islands.GetSleepingCount(), m_Islands.GetBodyCount(), m_Islands.GetIslandCount());
+
+    ImGui::Separator();
+    ImGui::Text("Snapshots / Rollback");
+    {
+        std::lock_guard<std::mutex> lock(m_ItemsMutex);
+        ImGui::Checkbox("Capture Every Update", &m_CaptureSnapshots);
+        if (ImGui::SliderInt("Ring Size", &m_SnapshotCapacity, 1, 600)) {
+            m_Snapshots.SetCapacity(static_cast<size_t>(m_SnapshotCapacity));
+        }
+        ImGui::SliderInt("Rollback Ticks", &m_RollbackTicks, 0, m_SnapshotCapacity);
+        if (ImGui::Button("Rollback")) {
+            std::string error;
+            m_SnapshotStatus = Rollback(static_cast<uint32_t>(m_RollbackTicks), error)
+                ? "Rolled back to tick " + std::to_string(m_SimTick) : "Rollback failed: " + error;
+        }
+        ImGui::Text("Tick %u, %zu / %zu snapshots, %.1f KB", m_SimTick, m_Snapshots.GetCount(), m_Snapshots.GetCapacity(),
+            m_Snapshots.GetByteSize() / 1024.0f);
+        ImGui::Text("Last save: %.1f us, last restore: %.1f us", m_LastSnapshotSaveUs, m_LastSnapshotRestoreUs);
+        if (!m_SnapshotStatus.empty()) ImGui::TextWrapped("%s", m_SnapshotStatus.c_str());
+    }
 
     ImGui::Separator();
     ImGui::Text("Networking (UDP P2P Baseline)");
@@ -1713,6 +1983,7 @@ void FlatBufferPreviewScenario::RefreshOwnershipFlagsAndStats()
     m_RemoteSimulatedCount = 0;
 
     for (auto& item : m_Items) {
+        item.sleep = {};
         if (item.behaviourType == SimRuntime::BehaviourType::Simulated) {
             item.isLocallyOwned = (item.owner == m_LocalPeerOwner);
             if (item.isLocallyOwned) {
@@ -1740,9 +2011,20 @@ void FlatBufferPreviewScenario::SendOwnedSimulatedStates()
 {
     if (!m_NetworkingActive.load()) return;
 
-    for (const auto& item : m_Items) {
+    for (auto& item : m_Items) {
         if (!item.isSimulated || !item.isLocallyOwned) continue;
 
+        // Sleeping items are sent once at rest, then only as a staggered keep-alive.
+        if (!item.sleep.asleep) {
+            item.sleepStateSent = false;
+        }
+        else if (item.sleepStateSent && (m_NetTick + item.objectId) % kSleepingResendTicks != 0) {
+            continue;
+        }
+        else {
+            item.sleepStateSent = true;
+        }
+
         SimStatePacket p{};
         p.objectId = item.objectId;
         p.owner = static_cast<uint8_t>(item.owner);
@@ -1967,4 +2249,7 @@ void FlatBufferPreviewScenario::ResetRuntimeState()
 
     m_DelayedIncomingStates.clear();
     m_NetTick = 0;
+    m_SimTick = 0;
+    ++m_SceneGeneration;
+    m_Snapshots.Clear();
 }
@@ -5,6 +5,8 @@
 #include "../Application/SandboxApplication.h"
 #include "../Scene/SceneRuntime.h"
 #include "../Networking/NetworkPeer.h"
+#include "../SimulationLibrary/ConvexCollision.h"
+#include "../SimulationLibrary/SleepIslands.h"
 
 #include <glm/glm.hpp>
 #include <vector>
@@ -14,6 +16,7 @@
 #include <atomic>
 #include <deque>
 #include <random>
+#include <unordered_map>
 
 class FlatBufferPreviewScenario : public Scenario {
 private:
@@ -72,6 +75,9 @@ public:
 
         bool spawnedBySpawner = false;
 
+        SleepState sleep;
+        bool sleepStateSent = false;
+
         glm::vec3 planeNormal{ 0.0f, 1.0f, 0.0f }; // used when shapeType==Plane
     };
 
@@ -126,11 +132,66 @@ public:
     std::deque<DelayedStatePacket> m_DelayedIncomingStates;
     std::mt19937 m_NetRng{ std::random_device{}() };
 
+    // Sleeping for locally simulated items; islands are rebuilt every tick from item contacts.
+    static constexpr uint32_t kNotInIsland = 0xFFFFFFFFu;
+    static constexpr uint32_t kSleepingResendTicks = 30; // keep-alive for sleeping items (network ticks)
+    SleepIslands m_Islands;
+    std::vector<uint32_t> m_IslandMembers; // island index -> item index
+    std::vector<uint32_t> m_ItemIsland;    // item index -> island index
+
+    // GJK simplex of the last simulated-vs-simulated query, keyed by object id pair.
+    struct PairSimplex {
+        SimCollision::GJKSimplex simplex;
+        uint32_t lastTick = 0;
+    };
+    static constexpr uint32_t kMaxIdlePairTicks = 30;
+    std::unordered_map<uint64_t, PairSimplex> m_PairSimplices;
+    uint32_t m_PairTick = 0;
+    PhaseTimer m_PhaseTimer;
+
     std::vector<SpawnerRuntime> m_RuntimeSpawners;
     std::mt19937 m_SpawnRng{ 1337u };
     bool m_EnableRuntimeSpawners = true;
     uint32_t m_TotalSpawnedBySpawners = 0;
 
+    // Snapshots: per-item motion and animation state, spawner runtimes, the spawn RNG and the id
+    // counter. With capture on, one is pushed to the ring after every update for rollback.
+    struct SnapshotItem {
+        uint32_t objectId = 0;
+        SimRuntime::OwnerType owner = SimRuntime::OwnerType::One;
+        bool isLocallyOwned = true;
+        bool reverse = false;
+        bool hasReplicatedState = false;
+        bool sleepStateSent = false;
+        float animTime = 0.0f;
+        SimRuntime::Transform baseTransform{};
+        glm::mat4 model{ 1.0f };
+        glm::vec3 linearVelocity{ 0.0f };
+        glm::vec3 angularVelocityDeg{ 0.0f };
+        glm::vec3 replicatedTargetPos{ 0.0f };
+        glm::vec3 replicatedTargetVel{ 0.0f };
+        SleepState sleep;
+    };
+    struct SnapshotSpawner {
+        bool singleBurstDone = false;
+        float elapsed = 0.0f;
+        float repeatAccumulator = 0.0f;
+        uint32_t spawnedCount = 0;
+        uint32_t sequentialCursor = 0;
+    };
+    static constexpr uint32_t kSnapshotTag = 0x50424C46u; // "FLBP"
+    uint32_t m_SimTick = 0;             // updates since the scene was built or reset
+    uint32_t m_SceneGeneration = 0;     // bumped by Clear() / ResetRuntimeState(); snapshots never restore across it
+    SnapshotRing m_Snapshots{ 120 };
+    bool m_CaptureSnapshots = false;
+    int m_SnapshotCapacity = 120;
+    int m_RollbackTicks = 30;
+    float m_LastSnapshotSaveUs = 0.0f;
+    float m_LastSnapshotRestoreUs = 0.0f;
+    std::string m_SnapshotStatus;
+    std::vector<SnapshotItem> m_SnapshotItems; // scratch
+    std::vector<SnapshotSpawner> m_SnapshotSpawners;
+
     // NEW: preset scenes (network replicated)
     std::atomic<int> m_PendingPresetSwitchIndex{ -1 };
     int m_ActivePresetIndex = -1; // -1 => using loaded FlatBuffer scene(s)
@@ -177,6 +238,11 @@ public:
 
     void SendResyncSnapshot();
 
+    // Snapshots; the caller holds m_ItemsMutex.
+    void WriteSnapshot(WorldSnapshot& out);
+    bool ReadSnapshot(const WorldSnapshot& snapshot, std::string& error);
+    bool Rollback(uint32_t ticks, std::string& error); // to the newest ring entry that old
+
     std::atomic<int> m_PendingSceneSwitchIndex{ -1 };
     void ApplyLoadedSceneSwitch(int sceneIndex);
 
@@ -185,6 +251,9 @@ public:
 
     void OnLoad() override;
     void OnUpdate(float deltaTime) override;
+    const PhaseTimer* GetPhaseTimer() const override { return &m_PhaseTimer; }
+    bool SaveSnapshot(WorldSnapshot& out) override;
+    bool RestoreSnapshot(const WorldSnapshot& snapshot, std::string& error) override;
     void OnRender(VkCommandBuffer commandBuffer) override;
     void OnUnload() override;
     void OnImGui() override;
@@ -15,6 +15,39 @@
 #include <algorithm>
 #include <cmath>
 #include <chrono>
+#include <numeric>
+
+namespace
+{
+    // The sorted grid doubles its cell size until the flock bounds fit in this many cells.
+    constexpr uint64_t kMaxSortedGridCells = 1u << 18;
+
+    // ParallelFor grains: steering costs a neighbour query per boid, index builds a few loads.
+    constexpr uint32_t kSteeringGrain = 128;
+    constexpr uint32_t kBuildGrain = 4096;
+
+    // Linear octree: 10 bits per axis (30-bit keys), sorted 10 bits per radix pass.
+    constexpr uint32_t kMortonLevels = 10;
+    constexpr uint32_t kMortonCells = 1u << kMortonLevels;
+    constexpr uint32_t kRadixBits = 10;
+    constexpr uint32_t kRadixBuckets = 1u << kRadixBits;
+    // Depth-first query stack: each level pops one node and pushes at most 8.
+    constexpr size_t kOctreeStackSize = 8 * (kMortonLevels + 1);
+    // Leaf ranges this close are merged into one kernel call; the extra boids fail the distance
+    // test, which is cheaper than a scalar tail per leaf.
+    constexpr uint32_t kMaxMergeGap = 16;
+
+    // Spreads the low 10 bits of v to every third bit.
+    uint32_t MortonSpread(uint32_t v)
+    {
+        v &= 0x3FFu;
+        v = (v | (v << 16)) & 0x030000FFu;
+        v = (v | (v << 8)) & 0x0300F00Fu;
+        v = (v | (v << 4)) & 0x030C30C3u;
+        v = (v | (v << 2)) & 0x09249249u;
+        return v;
+    }
+}
 
 #ifdef _WIN32
 namespace
@@ -38,7 +71,10 @@ void FlockingScenario::OnLoad()
 {
     std::lock_guard<std::mutex> lock(m_BoidsMutex);
 
-    m_Boids.clear();
+    m_UpdateThreads = static_cast<int>(std::clamp(std::thread::hardware_concurrency(), 1u, 16u));
+    m_Jobs.SetThreadCount(static_cast<uint32_t>(m_UpdateThreads));
+
+    ClearBoids();
     m_NextBoidId = 1;
     m_NetTick = 0;
     m_LocalOwnedCount = 0;
@@ -66,7 +102,8 @@ void FlockingScenario::OnUnload()
 
     std::lock_guard<std::mutex> lock(m_BoidsMutex);
     m_App->DestroyMeshBuffers(m_BoidBuffers);
-    m_Boids.clear();
+    ClearBoids();
+    m_Jobs.SetThreadCount(1);
 }
 
 void FlockingScenario::BuildFromSceneOrFallback()
@@ -90,29 +127,76 @@ void FlockingScenario::BuildBoids(uint32_t count, const glm::vec3& center, const
     std::uniform_real_distribution<float> dz(-extents.z, extents.z);
     std::uniform_real_distribution<float> vv(-1.0f, 1.0f);
 
-    m_Boids.reserve(count);
+    const size_t total = m_Boids.size() + count;
+    m_Boids.reserve(total);
+    for (auto* stream : { &m_PosX, &m_PosY, &m_PosZ, &m_VelX, &m_VelY, &m_VelZ }) {
+        stream->reserve(total);
+    }
+
     for (uint32_t i = 0; i < count; ++i) {
         Boid b{};
         b.id = m_NextBoidId++;
         b.owner = m_FlockOwner;
-        b.position = center + glm::vec3(dx(m_Rng), dy(m_Rng), dz(m_Rng));
-        b.velocity = glm::normalize(glm::vec3(vv(m_Rng), vv(m_Rng), vv(m_Rng))) * (m_Settings.maxSpeed * 0.35f);
-        b.model = glm::translate(glm::mat4(1.0f), b.position);
-        b.initialPosition = b.position;
-        b.initialVelocity = b.velocity;
+        b.initialPosition = center + glm::vec3(dx(m_Rng), dy(m_Rng), dz(m_Rng));
+        b.initialVelocity = glm::normalize(glm::vec3(vv(m_Rng), vv(m_Rng), vv(m_Rng))) * (m_Settings.maxSpeed * 0.35f);
         m_Boids.push_back(b);
+
+        m_PosX.push_back(b.initialPosition.x);
+        m_PosY.push_back(b.initialPosition.y);
+        m_PosZ.push_back(b.initialPosition.z);
+        m_VelX.push_back(b.initialVelocity.x);
+        m_VelY.push_back(b.initialVelocity.y);
+        m_VelZ.push_back(b.initialVelocity.z);
     }
+
+    for (auto* stream : { &m_NextPosX, &m_NextPosY, &m_NextPosZ, &m_NextVelX, &m_NextVelY, &m_NextVelZ }) {
+        stream->resize(total);
+    }
+    m_ListValid = false;
+}
+
+void FlockingScenario::ClearBoids()
+{
+    m_Boids.clear();
+    for (auto* stream : { &m_PosX, &m_PosY, &m_PosZ, &m_VelX, &m_VelY, &m_VelZ,
+                          &m_NextPosX, &m_NextPosY, &m_NextPosZ, &m_NextVelX, &m_NextVelY, &m_NextVelZ }) {
+        stream->clear();
+    }
+    m_ListValid = false;
+}
+
+void FlockingScenario::SwapBoidBuffers()
+{
+    m_PosX.swap(m_NextPosX);
+    m_PosY.swap(m_NextPosY);
+    m_PosZ.swap(m_NextPosZ);
+    m_VelX.swap(m_NextVelX);
+    m_VelY.swap(m_NextVelY);
+    m_VelZ.swap(m_NextVelZ);
+}
+
+SimFlocking::BoidStreams FlockingScenario::GetBoidStreams() const
+{
+    SimFlocking::BoidStreams s;
+    s.posX = m_PosX.data();
+    s.posY = m_PosY.data();
+    s.posZ = m_PosZ.data();
+    s.velX = m_VelX.data();
+    s.velY = m_VelY.data();
+    s.velZ = m_VelZ.data();
+    s.count = m_Boids.size();
+    return s;
 }
 
 void FlockingScenario::ResetBoids_NoLock()
 {
-    for (auto& b : m_Boids) {
-        b.position = b.initialPosition;
-        b.velocity = b.initialVelocity;
-        b.model = glm::translate(glm::mat4(1.0f), b.position);
+    for (size_t i = 0; i < m_Boids.size(); ++i) {
+        Boid& b = m_Boids[i];
+        SetPosition(i, b.initialPosition);
+        SetVelocity(i, b.initialVelocity);
         b.hasReplicatedState = false;
-        b.replicatedTargetPos = b.position;
-        b.replicatedTargetVel = b.velocity;
+        b.replicatedTargetPos = b.initialPosition;
+        b.replicatedTargetVel = b.initialVelocity;
     }
     m_NetTick = 0;
 }
@@ -134,86 +218,76 @@ void FlockingScenario::RefreshOwnershipFlags()
     }
 }
 
-FlockingScenario::Boid* FlockingScenario::FindBoidById(uint32_t id)
+ptrdiff_t FlockingScenario::FindBoidById(uint32_t id) const
 {
-    for (auto& b : m_Boids) {
-        if (b.id == id) return &b;
+    for (size_t i = 0; i < m_Boids.size(); ++i) {
+        if (m_Boids[i].id == id) return static_cast<ptrdiff_t>(i);
     }
-    return nullptr;
+    return -1;
 }
 
-// REPLACE ComputeSteering with this version
-
-glm::vec3 FlockingScenario::ComputeSteering(size_t i) const
+glm::vec3 FlockingScenario::ComputeSteering(size_t i, SteeringScratch& scratch) const
 {
-    const Boid& self = m_Boids[i];
+    const glm::vec3 position = GetPosition(i);
+    const glm::vec3 velocity = GetVelocity(i);
+    const SimFlocking::BoidStreams streams = GetBoidStreams();
 
-    glm::vec3 cohesion(0.0f), alignment(0.0f), separation(0.0f);
-    int nCohAlign = 0, nSep = 0;
-
-    auto accumulateNeighbor = [&](size_t j) {
-        if (i == j) return;
-        const Boid& other = m_Boids[j];
-
-        const glm::vec3 d = other.position - self.position;
-        const float dist = glm::length(d);
-        if (dist <= 0.0001f) return;
-
-        if (dist < m_Settings.neighborRadius) {
-            cohesion += other.position;
-            alignment += other.velocity;
-            ++nCohAlign;
-        }
-
-        if (dist < m_Settings.separationRadius) {
-            separation -= (d / dist) / std::max(0.1f, dist);
-            ++nSep;
-        }
-        };
+    SimFlocking::NeighbourQuery query;
+    query.self = static_cast<uint32_t>(i);
+    query.position = position;
+    query.neighborRadius = m_Settings.neighborRadius;
+    query.separationRadius = m_Settings.separationRadius;
 
+    SimFlocking::NeighbourSums sums;
     if (m_SearchMode == NeighborSearchMode::UniformGrid) {
-        std::vector<size_t> candidates;
-        CollectUniformGridCandidates(i, candidates);
-        for (size_t j : candidates) {
-            accumulateNeighbor(j);
-        }
+        CollectUniformGridCandidates(i, scratch.candidates);
+        SimFlocking::AccumulateNeighbours(streams, query, scratch.candidates.data(), scratch.candidates.size(), sums, m_SteeringSimdLevel);
     }
     else if (m_SearchMode == NeighborSearchMode::Octree) {
-        std::vector<size_t> candidates;
-        CollectOctreeCandidates(m_OctreeRoot.get(), self.position, m_Settings.neighborRadius, candidates);
-        for (size_t j : candidates) {
-            accumulateNeighbor(j);
-        }
+        scratch.candidates.clear();
+        CollectOctreeCandidates(m_OctreeRoot.get(), position, m_Settings.neighborRadius, scratch.candidates);
+        SimFlocking::AccumulateNeighbours(streams, query, scratch.candidates.data(), scratch.candidates.size(), sums, m_SteeringSimdLevel);
+    }
+    else if (m_SearchMode == NeighborSearchMode::NeighborList) {
+        const uint32_t first = m_ListStart[i];
+        const uint32_t count = m_ListStart[i + 1] - first;
+        SimFlocking::AccumulateNeighbours(streams, query, m_ListItems.data() + first, count, sums, m_SteeringSimdLevel);
+        scratch.listEntries += count;
+        scratch.listNeighbours += sums.neighbourCount;
+    }
+    else if (m_SearchMode == NeighborSearchMode::SortedGrid) {
+        AccumulateSortedGridNeighbours(streams, query, sums);
+    }
+    else if (m_SearchMode == NeighborSearchMode::LinearOctree) {
+        AccumulateLinearOctreeNeighbours(streams, query, sums);
     }
     else {
-        for (size_t j = 0; j < m_Boids.size(); ++j) {
-            accumulateNeighbor(j);
-        }
+        SimFlocking::AccumulateNeighbourRange(streams, query, 0, m_Boids.size(), sums, m_SteeringSimdLevel);
     }
 
     glm::vec3 force(0.0f);
 
-    if (nCohAlign > 0) {
-        cohesion /= static_cast<float>(nCohAlign);
-        glm::vec3 desiredC = cohesion - self.position;
+    if (sums.neighbourCount > 0) {
+        const glm::vec3 cohesion = sums.cohesion / static_cast<float>(sums.neighbourCount);
+        glm::vec3 desiredC = cohesion - position;
         if (glm::length(desiredC) > 0.0001f) {
             desiredC = glm::normalize(desiredC) * m_Settings.maxSpeed;
-            force += (desiredC - self.velocity) * m_Settings.weightCohesion;
+            force += (desiredC - velocity) * m_Settings.weightCohesion;
         }
 
-        alignment /= static_cast<float>(nCohAlign);
+        const glm::vec3 alignment = sums.alignment / static_cast<float>(sums.neighbourCount);
         if (glm::length(alignment) > 0.0001f) {
             glm::vec3 desiredA = glm::normalize(alignment) * m_Settings.maxSpeed;
-            force += (desiredA - self.velocity) * m_Settings.weightAlignment;
+            force += (desiredA - velocity) * m_Settings.weightAlignment;
         }
     }
 
-    if (nSep > 0 && glm::length(separation) > 0.0001f) {
-        glm::vec3 desiredS = glm::normalize(separation) * m_Settings.maxSpeed;
-        force += (desiredS - self.velocity) * m_Settings.weightSeparation;
+    if (sums.separationCount > 0 && glm::length(sums.separation) > 0.0001f) {
+        glm::vec3 desiredS = glm::normalize(sums.separation) * m_Settings.maxSpeed;
+        force += (desiredS - velocity) * m_Settings.weightSeparation;
     }
 
-    const glm::vec3 toCenter = self.position - m_Settings.spawnCenter;
+    const glm::vec3 toCenter = position - m_Settings.spawnCenter;
     glm::vec3 avoidance(0.0f);
     if (std::abs(toCenter.x) > m_Settings.spawnExtents.x - m_Settings.avoidanceRadius) avoidance.x = -toCenter.x;
     if (std::abs(toCenter.y) > m_Settings.spawnExtents.y - m_Settings.avoidanceRadius) avoidance.y = -toCenter.y;
@@ -221,7 +295,7 @@ glm::vec3 FlockingScenario::ComputeSteering(size_t i) const
 
     if (glm::length(avoidance) > 0.0001f) {
         glm::vec3 desiredV = glm::normalize(avoidance) * m_Settings.maxSpeed;
-        force += (desiredV - self.velocity) * m_Settings.weightAvoidance;
+        force += (desiredV - velocity) * m_Settings.weightAvoidance;
     }
 
     const float fLen = glm::length(force);
@@ -236,6 +310,15 @@ void FlockingScenario::OnUpdate(float dt)
 {
     std::lock_guard<std::mutex> lock(m_BoidsMutex);
     const auto t0 = std::chrono::steady_clock::now();
+    m_PhaseTimer.Begin();
+
+    if (m_SearchMode != NeighborSearchMode::NeighborList) {
+        // Other modes may reorder the boids; lists and their stats start over on return
+        m_ListValid = false;
+        m_ListRebuilds = 0;
+        m_ListTicks = 0;
+        m_ListBuildMsTotal = 0.0f;
+    }
 
     if (m_SearchMode == NeighborSearchMode::UniformGrid) {
         const auto g0 = std::chrono::steady_clock::now();
@@ -257,6 +340,46 @@ void FlockingScenario::OnUpdate(float dt)
         m_LastGridCellCount = 0;
         m_LastGridEntryCount = 0;
     }
+    else if (m_SearchMode == NeighborSearchMode::SortedGrid) {
+        const auto g0 = std::chrono::steady_clock::now();
+        BuildSortedGrid();
+        const auto g1 = std::chrono::steady_clock::now();
+        m_LastGridBuildMs = std::chrono::duration<float, std::milli>(g1 - g0).count();
+
+        m_UniformGrid.clear();
+        m_OctreeRoot.reset();
+        m_LastOctreeBuildMs = 0.0f;
+        m_LastOctreeNodeCount = 0;
+    }
+    else if (m_SearchMode == NeighborSearchMode::LinearOctree) {
+        const auto o0 = std::chrono::steady_clock::now();
+        BuildLinearOctree();
+        const auto o1 = std::chrono::steady_clock::now();
+        m_LastOctreeBuildMs = std::chrono::duration<float, std::milli>(o1 - o0).count();
+
+        m_UniformGrid.clear();
+        m_OctreeRoot.reset();
+        m_LastGridBuildMs = 0.0f;
+        m_LastGridCellCount = 0;
+        m_LastGridEntryCount = 0;
+    }
+    else if (m_SearchMode == NeighborSearchMode::NeighborList) {
+        m_LastListBuildMs = 0.0f;
+        if (NeighborListsNeedRebuild()) {
+            const auto l0 = std::chrono::steady_clock::now();
+            BuildNeighborLists();
+            const auto l1 = std::chrono::steady_clock::now();
+            m_LastListBuildMs = std::chrono::duration<float, std::milli>(l1 - l0).count();
+            m_ListBuildMsTotal += m_LastListBuildMs;
+        }
+        ++m_ListTicks;
+
+        m_UniformGrid.clear();
+        m_OctreeRoot.reset();
+        m_LastGridBuildMs = 0.0f;
+        m_LastOctreeBuildMs = 0.0f;
+        m_LastOctreeNodeCount = 0;
+    }
     else {
         m_UniformGrid.clear();
         m_OctreeRoot.reset();
@@ -266,55 +389,79 @@ void FlockingScenario::OnUpdate(float dt)
         m_LastGridEntryCount = 0;
         m_LastOctreeNodeCount = 0;
     }
+    m_PhaseTimer.Mark("neighbour index");
+
+    // local simulation, double buffered: every boid reads last tick's streams and writes only its
+    // own slot of the next ones, so the result does not depend on thread count or order
+    std::atomic<uint64_t> listEntries{ 0 };
+    std::atomic<uint64_t> listNeighbours{ 0 };
+    m_Jobs.ParallelFor(static_cast<uint32_t>(m_Boids.size()), kSteeringGrain, [&](uint32_t begin, uint32_t end) {
+        SteeringScratch scratch;
+        for (uint32_t i = begin; i < end; ++i) {
+            glm::vec3 position = GetPosition(i);
+            glm::vec3 velocity = GetVelocity(i);
+
+            if (m_Boids[i].isLocallyOwned) {
+                velocity += ComputeSteering(i, scratch) * dt;
+
+                const float speed = glm::length(velocity);
+                if (speed > m_Settings.maxSpeed) {
+                    velocity = (velocity / speed) * m_Settings.maxSpeed;
+                }
+                position += velocity * dt;
+            }
 
-    // local simulation
-    for (size_t i = 0; i < m_Boids.size(); ++i) {
-        Boid& b = m_Boids[i];
-        if (!b.isLocallyOwned) continue;
-
-        const glm::vec3 accel = ComputeSteering(i);
-        b.velocity += accel * dt;
-
-        const float speed = glm::length(b.velocity);
-        if (speed > m_Settings.maxSpeed) {
-            b.velocity = (b.velocity / speed) * m_Settings.maxSpeed;
+            m_NextPosX[i] = position.x;
+            m_NextPosY[i] = position.y;
+            m_NextPosZ[i] = position.z;
+            m_NextVelX[i] = velocity.x;
+            m_NextVelY[i] = velocity.y;
+            m_NextVelZ[i] = velocity.z;
         }
 
-        b.position += b.velocity * dt;
-        b.model = glm::translate(glm::mat4(1.0f), b.position);
+        listEntries.fetch_add(scratch.listEntries, std::memory_order_relaxed);
+        listNeighbours.fetch_add(scratch.listNeighbours, std::memory_order_relaxed);
+    });
+    SwapBoidBuffers();
+
+    if (m_SearchMode == NeighborSearchMode::NeighborList) {
+        const uint64_t entries = listEntries.load();
+        m_LastListHitRate = entries ? static_cast<float>(static_cast<double>(listNeighbours.load()) / static_cast<double>(entries)) : 0.0f;
     }
+    m_PhaseTimer.Mark("steering");
 
     // remote smoothing
-    for (auto& b : m_Boids) {
+    for (size_t i = 0; i < m_Boids.size(); ++i) {
+        const Boid& b = m_Boids[i];
         if (b.isLocallyOwned || !b.hasReplicatedState) continue;
 
-        const glm::vec3 delta = b.replicatedTargetPos - b.position;
-        const float dist = glm::length(delta);
+        const glm::vec3 position = GetPosition(i);
+        const float dist = glm::length(b.replicatedTargetPos - position);
         if (dist > m_RemoteSnapDistance) {
-            b.position = b.replicatedTargetPos;
-            b.velocity = b.replicatedTargetVel;
+            SetPosition(i, b.replicatedTargetPos);
+            SetVelocity(i, b.replicatedTargetVel);
         }
         else {
             const float a = 1.0f - std::exp(-m_RemoteInterpRate * dt);
-            b.position = glm::mix(b.position, b.replicatedTargetPos, a);
-            b.velocity = glm::mix(b.velocity, b.replicatedTargetVel, a);
+            SetPosition(i, glm::mix(position, b.replicatedTargetPos, a));
+            SetVelocity(i, glm::mix(GetVelocity(i), b.replicatedTargetVel, a));
         }
-
-        b.model = glm::translate(glm::mat4(1.0f), b.position);
     }
 
+    m_PhaseTimer.Mark("smoothing");
+
     const auto t1 = std::chrono::steady_clock::now();
     m_LastUpdateMs = std::chrono::duration<float, std::milli>(t1 - t0).count();
 }
 
-glm::vec4 FlockingScenario::BoidTint(const Boid& b) const
+glm::vec4 FlockingScenario::BoidTint(size_t i) const
 {
     if (!m_ShowOwnerTint) {
-        const float s = glm::clamp(glm::length(b.velocity) / std::max(0.1f, m_Settings.maxSpeed), 0.0f, 1.0f);
+        const float s = glm::clamp(glm::length(GetVelocity(i)) / std::max(0.1f, m_Settings.maxSpeed), 0.0f, 1.0f);
         return glm::vec4(0.2f + 0.8f * s, 0.9f - 0.5f * s, 1.0f - 0.7f * s, 1.0f);
     }
 
-    switch (b.owner) {
+    switch (m_Boids[i].owner) {
     case SimRuntime::OwnerType::One: return { 1.0f, 0.3f, 0.3f, 1.0f };
     case SimRuntime::OwnerType::Two: return { 0.3f, 1.0f, 0.3f, 1.0f };
     case SimRuntime::OwnerType::Three: return { 0.3f, 0.5f, 1.0f, 1.0f };
@@ -327,11 +474,11 @@ void FlockingScenario::OnRender(VkCommandBuffer commandBuffer)
 {
     std::lock_guard<std::mutex> lock(m_BoidsMutex);
 
-    for (const auto& b : m_Boids) {
+    for (size_t i = 0; i < m_Boids.size(); ++i) {
         PushConstants push{};
-        push.model = b.model;
+        push.model = glm::translate(glm::mat4(1.0f), GetPosition(i));
 
-        const glm::vec4 tint = BoidTint(b);
+        const glm::vec4 tint = BoidTint(i);
         push.checkerColorA = tint;
         push.checkerColorB = glm::mix(tint, glm::vec4(0.08f, 0.08f, 0.08f, 1.0f), 0.65f);
         push.checkerParams = glm::vec4(4.0f, 0, 0, 0);
@@ -352,14 +499,15 @@ void FlockingScenario::SendOwnedBoidStates()
 {
     if (!m_NetworkingActive) return;
 
-    for (const auto& b : m_Boids) {
+    for (size_t i = 0; i < m_Boids.size(); ++i) {
+        const Boid& b = m_Boids[i];
         if (!b.isLocallyOwned) continue;
 
         SimStatePacket p{};
         p.objectId = b.id;
         p.owner = static_cast<uint8_t>(b.owner);
-        p.pos[0] = b.position.x; p.pos[1] = b.position.y; p.pos[2] = b.position.z;
-        p.vel[0] = b.velocity.x; p.vel[1] = b.velocity.y; p.vel[2] = b.velocity.z;
+        p.pos[0] = m_PosX[i]; p.pos[1] = m_PosY[i]; p.pos[2] = m_PosZ[i];
+        p.vel[0] = m_VelX[i]; p.vel[1] = m_VelY[i]; p.vel[2] = m_VelZ[i];
         p.tick = m_NetTick;
         m_Network.SendState(p);
 
@@ -374,8 +522,9 @@ void FlockingScenario::ReceiveRemoteBoidStates(float dt)
     if (!m_NetworkingActive) return;
 
     auto applyPacket = [this](const SimStatePacket& p) {
-        Boid* b = FindBoidById(p.objectId);
-        if (!b || b->isLocallyOwned) return;
+        const ptrdiff_t index = FindBoidById(p.objectId);
+        if (index < 0 || m_Boids[index].isLocallyOwned) return;
+        Boid* b = &m_Boids[index];
         b->replicatedTargetPos = { p.pos[0], p.pos[1], p.pos[2] };
         b->replicatedTargetVel = { p.vel[0], p.vel[1], p.vel[2] };
         b->hasReplicatedState = true;
@@ -509,40 +658,85 @@ void FlockingScenario::OnImGui()
     ImGui::SliderFloat("Weight Avoidance", &m_Settings.weightAvoidance, 0.0f, 5.0f, "%.2f");
     ImGui::Checkbox("Owner Tint", &m_ShowOwnerTint);
 
-    const char* searchModes[] = { "Brute Force", "Uniform Grid", "Octree (WIP)" };
+    const char* searchModes[] = { "Brute Force", "Uniform Grid", "Octree (WIP)", "Sorted Grid", "Linear Octree", "Neighbor Lists" };
     int searchMode = static_cast<int>(m_SearchMode);
     if (ImGui::Combo("Neighbor Search", &searchMode, searchModes, IM_ARRAYSIZE(searchModes))) {
         m_SearchMode = static_cast<NeighborSearchMode>(searchMode);
     }
 
-    ImGui::Text("Update CPU: %.3f ms", m_LastUpdateMs);
-    if (m_SearchMode == NeighborSearchMode::UniformGrid) {
+    {
+        const char* simdLevels[] = { "Scalar", "SSE2 (4-wide)", "AVX2 (8-wide)" };
+        const int maxLevel = static_cast<int>(SimSimd::GetBestSimdLevel());
+        int simdLevel = static_cast<int>(m_SteeringSimdLevel);
+        if (ImGui::Combo("Steering Kernel", &simdLevel, simdLevels, maxLevel + 1)) {
+            m_SteeringSimdLevel = static_cast<SimSimd::SimdLevel>(std::clamp(simdLevel, 0, maxLevel));
+        }
+    }
+
+    if (ImGui::SliderInt("Update Threads", &m_UpdateThreads, 1, 16)) {
+        m_Jobs.SetThreadCount(static_cast<uint32_t>(m_UpdateThreads));
+    }
+    ImGui::Text("Update CPU: %.3f ms (%u threads)", m_LastUpdateMs, m_Jobs.GetThreadCount());
+    if (m_SearchMode == NeighborSearchMode::UniformGrid || m_SearchMode == NeighborSearchMode::SortedGrid) {
         ImGui::Text("Grid Build CPU: %.3f ms", m_LastGridBuildMs);
         ImGui::Text("Grid Cells: %u", m_LastGridCellCount);
         ImGui::Text("Grid Entries: %u", m_LastGridEntryCount);
+        if (m_SearchMode == NeighborSearchMode::SortedGrid) {
+            ImGui::Text("Grid Dims: %d x %d x %d (cell %.2f)", m_SortedGridDims.x, m_SortedGridDims.y, m_SortedGridDims.z, m_SortedGridCellSize);
+        }
     }
-    else if (m_SearchMode == NeighborSearchMode::Octree) {
+    else if (m_SearchMode == NeighborSearchMode::Octree || m_SearchMode == NeighborSearchMode::LinearOctree) {
+        const int maxDepth = m_SearchMode == NeighborSearchMode::LinearOctree ? static_cast<int>(kMortonLevels) : 12;
+        m_OctreeMaxDepth = std::min(m_OctreeMaxDepth, maxDepth);
+        ImGui::SliderInt("Octree Max Depth", &m_OctreeMaxDepth, 1, maxDepth);
+        ImGui::SliderInt("Octree Leaf Capacity", &m_OctreeLeafCapacity, 1, 64);
         ImGui::Text("Octree Build CPU: %.3f ms", m_LastOctreeBuildMs);
         ImGui::Text("Octree Nodes: %u", m_LastOctreeNodeCount);
     }
+    else if (m_SearchMode == NeighborSearchMode::NeighborList) {
+        ImGui::SliderFloat("List Skin", &m_NeighborSkin, 0.0f, 3.0f, "%.2f");
+        const float amortisedMs = m_ListTicks ? m_ListBuildMsTotal / static_cast<float>(m_ListTicks) : 0.0f;
+        const float interval = m_ListRebuilds ? static_cast<float>(m_ListTicks) / static_cast<float>(m_ListRebuilds) : 0.0f;
+        ImGui::Text("List Build CPU: %.3f ms this tick, %.3f ms/tick amortised", m_LastListBuildMs, amortisedMs);
+        ImGui::Text("List Rebuilds: %u in %u ticks (every %.1f ticks)", m_ListRebuilds, m_ListTicks, interval);
+        ImGui::Text("List Entries: %zu, %.1f%% within neighbor radius", m_ListItems.size(), m_LastListHitRate * 100.0f);
+    }
 
     if (ImGui::Button("Capture Sample (Current Mode)")) {
         const int modeIndex = static_cast<int>(m_SearchMode);
         m_ModeSamples[modeIndex].valid = true;
         m_ModeSamples[modeIndex].updateMs = m_LastUpdateMs;
-        m_ModeSamples[modeIndex].buildMs = (m_SearchMode == NeighborSearchMode::UniformGrid) ? m_LastGridBuildMs
-            : (m_SearchMode == NeighborSearchMode::Octree) ? m_LastOctreeBuildMs : 0.0f;
+        const bool gridMode = m_SearchMode == NeighborSearchMode::UniformGrid || m_SearchMode == NeighborSearchMode::SortedGrid;
+        const bool octreeMode = m_SearchMode == NeighborSearchMode::Octree || m_SearchMode == NeighborSearchMode::LinearOctree;
+        const bool listMode = m_SearchMode == NeighborSearchMode::NeighborList;
+        // Lists are not rebuilt every tick, so their build cost is averaged over the ticks run
+        const float listBuildMs = m_ListTicks ? m_ListBuildMsTotal / static_cast<float>(m_ListTicks) : 0.0f;
+        m_ModeSamples[modeIndex].buildMs = gridMode ? m_LastGridBuildMs
+            : octreeMode ? m_LastOctreeBuildMs
+            : listMode ? listBuildMs : 0.0f;
         m_ModeSamples[modeIndex].memoryBytes = EstimateModeMemoryBytes(m_SearchMode);
+        m_ModeSamples[modeIndex].octreeMaxDepth = octreeMode ? m_OctreeMaxDepth : 0;
+        m_ModeSamples[modeIndex].octreeLeafCapacity = octreeMode ? m_OctreeLeafCapacity : 0;
+        m_ModeSamples[modeIndex].listRebuildInterval = (listMode && m_ListRebuilds) ? static_cast<float>(m_ListTicks) / static_cast<float>(m_ListRebuilds) : 0.0f;
+        m_ModeSamples[modeIndex].listHitRate = listMode ? m_LastListHitRate : 0.0f;
     }
 
     ImGui::Separator();
     ImGui::Text("Segmentation Comparison (captured)");
-    const char* modeNames[] = { "BruteForce", "UniformGrid", "Octree" };
-    for (int mi = 0; mi < 3; ++mi) {
+    const char* modeNames[] = { "BruteForce", "UniformGrid", "Octree", "SortedGrid", "LinearOctree", "NeighborList" };
+    for (int mi = 0; mi < static_cast<int>(m_ModeSamples.size()); ++mi) {
         const auto& s = m_ModeSamples[mi];
         if (!s.valid) {
             ImGui::Text("%s: (no sample)", modeNames[mi]);
         }
+        else if (mi == static_cast<int>(NeighborSearchMode::NeighborList)) {
+            ImGui::Text("%s | Update: %.3f ms | Build: %.3f ms/tick | Mem: %u bytes | Rebuild every %.1f ticks, %.0f%% hits",
+                modeNames[mi], s.updateMs, s.buildMs, s.memoryBytes, s.listRebuildInterval, s.listHitRate * 100.0f);
+        }
+        else if (s.octreeMaxDepth > 0) {
+            ImGui::Text("%s | Update: %.3f ms | Build: %.3f ms | Mem: %u bytes | Depth %d, Leaf %d",
+                modeNames[mi], s.updateMs, s.buildMs, s.memoryBytes, s.octreeMaxDepth, s.octreeLeafCapacity);
+        }
         else {
             ImGui::Text("%s | Update: %.3f ms | Build: %.3f ms | Mem: %u bytes",
                 modeNames[mi], s.updateMs, s.buildMs, s.memoryBytes);
@@ -618,18 +812,18 @@ void FlockingScenario::BuildUniformGrid()
     m_UniformGrid.clear();
 
     for (size_t i = 0; i < m_Boids.size(); ++i) {
-        const GridKey key = ToGridKey(m_Boids[i].position);
-        m_UniformGrid[key].push_back(i);
+        const GridKey key = ToGridKey(GetPosition(i));
+        m_UniformGrid[key].push_back(static_cast<uint32_t>(i));
     }
 
     m_LastGridCellCount = static_cast<uint32_t>(m_UniformGrid.size());
     m_LastGridEntryCount = static_cast<uint32_t>(m_Boids.size());
 }
 
-void FlockingScenario::CollectUniformGridCandidates(size_t boidIndex, std::vector<size_t>& outCandidates) const
+void FlockingScenario::CollectUniformGridCandidates(size_t boidIndex, std::vector<uint32_t>& outCandidates) const
 {
     outCandidates.clear();
-    const GridKey center = ToGridKey(m_Boids[boidIndex].position);
+    const GridKey center = ToGridKey(GetPosition(boidIndex));
 
     for (int dz = -1; dz <= 1; ++dz) {
         for (int dy = -1; dy <= 1; ++dy) {
@@ -643,17 +837,222 @@ void FlockingScenario::CollectUniformGridCandidates(size_t boidIndex, std::vecto
     }
 }
 
+glm::ivec3 FlockingScenario::SortedGridCellOf(const glm::vec3& p) const
+{
+    const glm::ivec3 cell(glm::floor((p - m_SortedGridOrigin) / m_SortedGridCellSize));
+    return glm::clamp(cell, glm::ivec3(0), m_SortedGridDims - 1);
+}
+
+// Counting-sorts boid indices by cell into m_SortOrder, over a grid of cells at least
+// 'minCellSize' wide covering the flock.
+void FlockingScenario::BuildCellTable(float minCellSize)
+{
+    const size_t n = m_Boids.size();
+    m_LastGridEntryCount = static_cast<uint32_t>(n);
+    if (n == 0) {
+        m_SortedGridDims = glm::ivec3(0);
+        m_LastGridCellCount = 0;
+        return;
+    }
+
+    const Aabb bounds = ComputeFlockBounds(0.0f);
+    const glm::vec3 extent = bounds.max - bounds.min;
+    m_SortedGridOrigin = bounds.min;
+    m_SortedGridCellSize = minCellSize;
+    for (;;) {
+        m_SortedGridDims = glm::ivec3(extent / m_SortedGridCellSize) + 1;
+        const uint64_t cells = static_cast<uint64_t>(m_SortedGridDims.x) * m_SortedGridDims.y * m_SortedGridDims.z;
+        if (cells <= kMaxSortedGridCells) break;
+        m_SortedGridCellSize *= 2.0f;
+    }
+    const uint32_t cellCount = static_cast<uint32_t>(m_SortedGridDims.x * m_SortedGridDims.y * m_SortedGridDims.z);
+    m_LastGridCellCount = cellCount;
+
+    // Cell of every boid in parallel, then count boids per cell
+    m_BoidCell.resize(n);
+    m_Jobs.ParallelFor(static_cast<uint32_t>(n), kBuildGrain, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            const glm::ivec3 c = SortedGridCellOf(GetPosition(i));
+            m_BoidCell[i] = static_cast<uint32_t>((c.z * m_SortedGridDims.y + c.y) * m_SortedGridDims.x + c.x);
+        }
+    });
+
+    m_CellStart.assign(cellCount + 1, 0);
+    for (size_t i = 0; i < n; ++i) {
+        ++m_CellStart[m_BoidCell[i]];
+    }
+
+    // Exclusive prefix sum: m_CellStart[c] = first slot of cell c
+    uint32_t running = 0;
+    for (uint32_t c = 0; c <= cellCount; ++c) {
+        const uint32_t count = m_CellStart[c];
+        m_CellStart[c] = running;
+        running += count;
+    }
+
+    // Stable scatter. Each cell's start advances to its end (= the next cell's start), so shift
+    // the table back by one afterwards.
+    m_SortOrder.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        m_SortOrder[m_CellStart[m_BoidCell[i]]++] = static_cast<uint32_t>(i);
+    }
+    for (uint32_t c = cellCount; c > 0; --c) {
+        m_CellStart[c] = m_CellStart[c - 1];
+    }
+    m_CellStart[0] = 0;
+}
+
+void FlockingScenario::BuildSortedGrid()
+{
+    // Cells at least neighborRadius wide, so the 27 cells around a boid cover its neighbourhood
+    BuildCellTable(std::max(0.1f, m_Settings.neighborRadius));
+    if (!m_Boids.empty()) PermuteBoids(m_SortOrder);
+}
+
+bool FlockingScenario::NeighborListsNeedRebuild()
+{
+    const size_t n = m_Boids.size();
+    if (!m_ListValid || m_ListStart.size() != n + 1) return true;
+    if (m_ListRadius != m_Settings.neighborRadius || m_ListSkin != m_NeighborSkin) return true;
+
+    const float limitSq = 0.25f * m_NeighborSkin * m_NeighborSkin;
+    std::atomic<bool> moved{ false };
+    m_Jobs.ParallelFor(static_cast<uint32_t>(n), kBuildGrain, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            const float dx = m_PosX[i] - m_ListAnchorX[i];
+            const float dy = m_PosY[i] - m_ListAnchorY[i];
+            const float dz = m_PosZ[i] - m_ListAnchorZ[i];
+            if (dx * dx + dy * dy + dz * dz > limitSq) {
+                moved.store(true, std::memory_order_relaxed);
+                return;
+            }
+        }
+    });
+    return moved.load();
+}
+
+void FlockingScenario::BuildNeighborLists()
+{
+    const uint32_t n = static_cast<uint32_t>(m_Boids.size());
+    const float reach = std::max(0.1f, m_Settings.neighborRadius + m_NeighborSkin);
+    const float reachSq = reach * reach;
+    BuildCellTable(reach);
+
+    // Storing the boids in cell order keeps each list's gathers close together. Indices only
+    // change here, while the lists are being rebuilt anyway.
+    if (n > 0) {
+        PermuteBoids(m_SortOrder);
+        std::iota(m_SortOrder.begin(), m_SortOrder.end(), 0u);
+    }
+
+    // Calls fn(j) for every boid j within 'reach' of boid i, in cell order
+    auto forEachCandidate = [&](uint32_t i, auto&& fn) {
+        const glm::vec3 p = GetPosition(i);
+        const glm::ivec3 c = SortedGridCellOf(p);
+        const glm::ivec3 lo = glm::max(c - 1, glm::ivec3(0));
+        const glm::ivec3 hi = glm::min(c + 1, m_SortedGridDims - 1);
+
+        for (int z = lo.z; z <= hi.z; ++z) {
+            for (int y = lo.y; y <= hi.y; ++y) {
+                const int row = (z * m_SortedGridDims.y + y) * m_SortedGridDims.x;
+                for (uint32_t k = m_CellStart[row + lo.x]; k < m_CellStart[row + hi.x + 1]; ++k) {
+                    const uint32_t j = m_SortOrder[k];
+                    if (j == i) continue;
+                    const glm::vec3 d = GetPosition(j) - p;
+                    if (glm::dot(d, d) < reachSq) fn(j);
+                }
+            }
+        }
+    };
+
+    // Count, prefix sum, fill: each boid writes only its own slice, so the lists are the same for
+    // any thread count
+    m_ListStart.resize(n + 1);
+    m_ListStart[0] = 0;
+    m_Jobs.ParallelFor(n, kSteeringGrain, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            uint32_t count = 0;
+            forEachCandidate(i, [&](uint32_t) { ++count; });
+            m_ListStart[i + 1] = count;
+        }
+    });
+
+    for (uint32_t i = 0; i < n; ++i) {
+        m_ListStart[i + 1] += m_ListStart[i];
+    }
+
+    m_ListItems.resize(m_ListStart[n]);
+    m_Jobs.ParallelFor(n, kSteeringGrain, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            uint32_t slot = m_ListStart[i];
+            forEachCandidate(i, [&](uint32_t j) { m_ListItems[slot++] = j; });
+        }
+    });
+
+    m_ListAnchorX.assign(m_PosX.begin(), m_PosX.end());
+    m_ListAnchorY.assign(m_PosY.begin(), m_PosY.end());
+    m_ListAnchorZ.assign(m_PosZ.begin(), m_PosZ.end());
+    m_ListRadius = m_Settings.neighborRadius;
+    m_ListSkin = m_NeighborSkin;
+    m_ListValid = true;
+    ++m_ListRebuilds;
+}
+
+// Moves boid order[k] to slot k in m_Boids and every SoA stream, gathering into the next-tick
+// buffers and swapping.
+void FlockingScenario::PermuteBoids(const std::vector<uint32_t>& order)
+{
+    const uint32_t n = static_cast<uint32_t>(order.size());
+
+    m_BoidScratch.resize(n);
+    m_Jobs.ParallelFor(n, kBuildGrain, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t k = begin; k < end; ++k) {
+            const uint32_t src = order[k];
+            m_NextPosX[k] = m_PosX[src];
+            m_NextPosY[k] = m_PosY[src];
+            m_NextPosZ[k] = m_PosZ[src];
+            m_NextVelX[k] = m_VelX[src];
+            m_NextVelY[k] = m_VelY[src];
+            m_NextVelZ[k] = m_VelZ[src];
+            m_BoidScratch[k] = m_Boids[src];
+        }
+    });
+
+    SwapBoidBuffers();
+    m_Boids.swap(m_BoidScratch);
+}
+
+void FlockingScenario::AccumulateSortedGridNeighbours(const SimFlocking::BoidStreams& streams, const SimFlocking::NeighbourQuery& query, SimFlocking::NeighbourSums& sums) const
+{
+    if (m_CellStart.empty()) return;
+
+    const glm::ivec3 c = SortedGridCellOf(query.position);
+    const glm::ivec3 lo = glm::max(c - 1, glm::ivec3(0));
+    const glm::ivec3 hi = glm::min(c + 1, m_SortedGridDims - 1);
+
+    // Cells lo.x..hi.x of a row are adjacent in the table, and so are their boids
+    for (int z = lo.z; z <= hi.z; ++z) {
+        for (int y = lo.y; y <= hi.y; ++y) {
+            const int row = (z * m_SortedGridDims.y + y) * m_SortedGridDims.x;
+            const uint32_t begin = m_CellStart[row + lo.x];
+            const uint32_t end = m_CellStart[row + hi.x + 1];
+            SimFlocking::AccumulateNeighbourRange(streams, query, begin, end, sums, m_SteeringSimdLevel);
+        }
+    }
+}
+
 FlockingScenario::Aabb FlockingScenario::ComputeFlockBounds(float padding) const
 {
     Aabb box{};
     if (m_Boids.empty()) return box;
 
-    box.min = m_Boids[0].position;
-    box.max = m_Boids[0].position;
+    box.min = GetPosition(0);
+    box.max = box.min;
 
-    for (const auto& b : m_Boids) {
-        box.min = glm::min(box.min, b.position);
-        box.max = glm::max(box.max, b.position);
+    for (size_t i = 1; i < m_Boids.size(); ++i) {
+        const glm::vec3 p = GetPosition(i);
+        box.min = glm::min(box.min, p);
+        box.max = glm::max(box.max, p);
     }
 
     box.min -= glm::vec3(padding);
@@ -675,7 +1074,7 @@ bool FlockingScenario::AabbIntersectsSphere(const Aabb& box, const glm::vec3& c,
     return glm::dot(d, d) <= (r * r);
 }
 
-std::unique_ptr<FlockingScenario::OctreeNode> FlockingScenario::BuildOctreeNode(const Aabb& box, const std::vector<size_t>& indices, int depth)
+std::unique_ptr<FlockingScenario::OctreeNode> FlockingScenario::BuildOctreeNode(const Aabb& box, const std::vector<uint32_t>& indices, int depth)
 {
     auto node = std::make_unique<OctreeNode>();
     node->bounds = box;
@@ -687,10 +1086,10 @@ std::unique_ptr<FlockingScenario::OctreeNode> FlockingScenario::BuildOctreeNode(
     }
 
     const glm::vec3 c = (box.min + box.max) * 0.5f;
-    std::array<std::vector<size_t>, 8> buckets{};
+    std::array<std::vector<uint32_t>, 8> buckets{};
 
-    for (size_t idx : indices) {
-        const glm::vec3& p = m_Boids[idx].position;
+    for (uint32_t idx : indices) {
+        const glm::vec3 p = GetPosition(idx);
         int oct = 0;
         if (p.x >= c.x) oct |= 1;
         if (p.y >= c.y) oct |= 2;
@@ -722,15 +1121,15 @@ void FlockingScenario::BuildOctree()
 
     if (m_Boids.empty()) return;
 
-    std::vector<size_t> all;
+    std::vector<uint32_t> all;
     all.reserve(m_Boids.size());
-    for (size_t i = 0; i < m_Boids.size(); ++i) all.push_back(i);
+    for (size_t i = 0; i < m_Boids.size(); ++i) all.push_back(static_cast<uint32_t>(i));
 
     const Aabb rootBounds = ComputeFlockBounds(std::max(0.5f, m_Settings.neighborRadius));
     m_OctreeRoot = BuildOctreeNode(rootBounds, all, 0);
 }
 
-void FlockingScenario::CollectOctreeCandidates(const OctreeNode* node, const glm::vec3& p, float radius, std::vector<size_t>& out) const
+void FlockingScenario::CollectOctreeCandidates(const OctreeNode* node, const glm::vec3& p, float radius, std::vector<uint32_t>& out) const
 {
     if (!node) return;
     if (!AabbIntersectsSphere(node->bounds, p, radius)) return;
@@ -750,6 +1149,154 @@ void FlockingScenario::CollectOctreeCandidates(const OctreeNode* node, const glm
     }
 }
 
+void FlockingScenario::BuildLinearOctree()
+{
+    m_LinearNodes.clear();
+    m_LastOctreeNodeCount = 0;
+
+    const size_t n = m_Boids.size();
+    if (n == 0) return;
+
+    // Quantise positions to a 1024^3 lattice over the flock and interleave the bits
+    const Aabb bounds = ComputeFlockBounds(0.0f);
+    const glm::vec3 scale = glm::vec3(static_cast<float>(kMortonCells)) / glm::max(bounds.max - bounds.min, glm::vec3(1e-3f));
+    m_MortonKeys.resize(n);
+    m_SortOrder.resize(n);
+    m_Jobs.ParallelFor(static_cast<uint32_t>(n), kBuildGrain, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            const glm::ivec3 q = glm::clamp(glm::ivec3((GetPosition(i) - bounds.min) * scale), glm::ivec3(0), glm::ivec3(kMortonCells - 1));
+            m_MortonKeys[i] = MortonSpread(q.x) | (MortonSpread(q.y) << 1) | (MortonSpread(q.z) << 2);
+            m_SortOrder[i] = i;
+        }
+    });
+
+    // LSD radix sort. Stable, so a flock already in Morton order from last tick barely moves.
+    m_MortonScratch.resize(n);
+    m_SortOrderScratch.resize(n);
+    for (uint32_t shift = 0; shift < 3 * kMortonLevels; shift += kRadixBits) {
+        std::array<uint32_t, kRadixBuckets> offsets{};
+        for (size_t i = 0; i < n; ++i) {
+            ++offsets[(m_MortonKeys[i] >> shift) & (kRadixBuckets - 1)];
+        }
+
+        uint32_t running = 0;
+        for (uint32_t& offset : offsets) {
+            const uint32_t count = offset;
+            offset = running;
+            running += count;
+        }
+
+        for (size_t i = 0; i < n; ++i) {
+            const uint32_t slot = offsets[(m_MortonKeys[i] >> shift) & (kRadixBuckets - 1)]++;
+            m_MortonScratch[slot] = m_MortonKeys[i];
+            m_SortOrderScratch[slot] = m_SortOrder[i];
+        }
+        m_MortonKeys.swap(m_MortonScratch);
+        m_SortOrder.swap(m_SortOrderScratch);
+    }
+    PermuteBoids(m_SortOrder);
+
+    // Breadth-first split. Keys within a node share their higher bits, so its children are
+    // consecutive runs of its range, found by the next 3 bits.
+    const uint32_t maxLevel = static_cast<uint32_t>(std::clamp(m_OctreeMaxDepth, 0, static_cast<int>(kMortonLevels)));
+    const uint32_t leafCapacity = static_cast<uint32_t>(std::max(1, m_OctreeLeafCapacity));
+    const uint32_t* keys = m_MortonKeys.data();
+
+    LinearOctreeNode root{};
+    root.end = static_cast<uint32_t>(n);
+    m_LinearNodes.push_back(root);
+
+    for (size_t ni = 0; ni < m_LinearNodes.size(); ++ni) {
+        const LinearOctreeNode node = m_LinearNodes[ni];
+        if (node.level >= maxLevel || node.end - node.begin <= leafCapacity) continue;
+
+        const uint32_t shift = 3 * (kMortonLevels - 1 - node.level);
+        const uint32_t firstChild = static_cast<uint32_t>(m_LinearNodes.size());
+        uint32_t begin = node.begin;
+        for (uint32_t octant = 0; octant < 8 && begin < node.end; ++octant) {
+            const uint32_t* split = std::partition_point(keys + begin, keys + node.end,
+                [&](uint32_t key) { return ((key >> shift) & 7u) <= octant; });
+            const uint32_t end = static_cast<uint32_t>(split - keys);
+            if (end == begin) continue;
+
+            LinearOctreeNode child{};
+            child.begin = begin;
+            child.end = end;
+            child.level = node.level + 1;
+            m_LinearNodes.push_back(child);
+            begin = end;
+        }
+
+        m_LinearNodes[ni].firstChild = firstChild;
+        m_LinearNodes[ni].childCount = static_cast<uint32_t>(m_LinearNodes.size()) - firstChild;
+    }
+
+    // Tight bounds: leaves in parallel from their boids, then parents from their children (which
+    // sit after them in breadth-first order)
+    m_Jobs.ParallelFor(static_cast<uint32_t>(m_LinearNodes.size()), kBuildGrain / 16, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t ni = begin; ni < end; ++ni) {
+            LinearOctreeNode& node = m_LinearNodes[ni];
+            if (node.childCount != 0) continue;
+
+            node.bounds.min = GetPosition(node.begin);
+            node.bounds.max = node.bounds.min;
+            for (uint32_t i = node.begin + 1; i < node.end; ++i) {
+                const glm::vec3 p = GetPosition(i);
+                node.bounds.min = glm::min(node.bounds.min, p);
+                node.bounds.max = glm::max(node.bounds.max, p);
+            }
+        }
+    });
+
+    for (size_t ni = m_LinearNodes.size(); ni-- > 0;) {
+        LinearOctreeNode& node = m_LinearNodes[ni];
+        if (node.childCount != 0) {
+            node.bounds = m_LinearNodes[node.firstChild].bounds;
+            for (uint32_t c = 1; c < node.childCount; ++c) {
+                const Aabb& child = m_LinearNodes[node.firstChild + c].bounds;
+                node.bounds.min = glm::min(node.bounds.min, child.min);
+                node.bounds.max = glm::max(node.bounds.max, child.max);
+            }
+        }
+    }
+
+    m_LastOctreeNodeCount = static_cast<uint32_t>(m_LinearNodes.size());
+}
+
+void FlockingScenario::AccumulateLinearOctreeNeighbours(const SimFlocking::BoidStreams& streams, const SimFlocking::NeighbourQuery& query, SimFlocking::NeighbourSums& sums) const
+{
+    if (m_LinearNodes.empty()) return;
+
+    std::array<uint32_t, kOctreeStackSize> stack;
+    size_t top = 0;
+    stack[top++] = 0;
+
+    // Leaves come out in Morton order, so nearby ones merge into one range for the kernel
+    uint32_t runBegin = 0;
+    uint32_t runEnd = 0;
+
+    while (top > 0) {
+        const LinearOctreeNode& node = m_LinearNodes[stack[--top]];
+        if (!AabbIntersectsSphere(node.bounds, query.position, m_Settings.neighborRadius)) continue;
+
+        if (node.childCount == 0) {
+            if (node.begin > runEnd + kMaxMergeGap) {
+                SimFlocking::AccumulateNeighbourRange(streams, query, runBegin, runEnd, sums, m_SteeringSimdLevel);
+                runBegin = node.begin;
+            }
+            runEnd = node.end;
+            continue;
+        }
+
+        // Reversed, so the first child is visited first
+        for (uint32_t c = node.childCount; c-- > 0;) {
+            stack[top++] = node.firstChild + c;
+        }
+    }
+
+    SimFlocking::AccumulateNeighbourRange(streams, query, runBegin, runEnd, sums, m_SteeringSimdLevel);
+}
+
 uint32_t FlockingScenario::EstimateModeMemoryBytes(NeighborSearchMode mode) const
 {
     switch (mode) {
@@ -759,15 +1306,43 @@ uint32_t FlockingScenario::EstimateModeMemoryBytes(NeighborSearchMode mode) cons
     {
         // rough estimate
         uint64_t bytes = 0;
-        bytes += static_cast<uint64_t>(m_UniformGrid.size()) * (sizeof(GridKey) + sizeof(std::vector<size_t>));
-        bytes += static_cast<uint64_t>(m_Boids.size()) * sizeof(size_t);
+        bytes += static_cast<uint64_t>(m_UniformGrid.size()) * (sizeof(GridKey) + sizeof(std::vector<uint32_t>));
+        bytes += static_cast<uint64_t>(m_Boids.size()) * sizeof(uint32_t);
         return static_cast<uint32_t>(bytes);
     }
     case NeighborSearchMode::Octree:
     {
         uint64_t bytes = 0;
         bytes += static_cast<uint64_t>(m_LastOctreeNodeCount) * sizeof(OctreeNode);
-        bytes += static_cast<uint64_t>(m_Boids.size()) * sizeof(size_t);
+        bytes += static_cast<uint64_t>(m_Boids.size()) * sizeof(uint32_t);
+        return static_cast<uint32_t>(bytes);
+    }
+    case NeighborSearchMode::SortedGrid:
+    {
+        // cell table, cell/order per boid, and the permutation scratch
+        uint64_t bytes = 0;
+        bytes += static_cast<uint64_t>(m_CellStart.capacity()) * sizeof(uint32_t);
+        bytes += static_cast<uint64_t>(m_BoidCell.capacity() + m_SortOrder.capacity()) * sizeof(uint32_t);
+        bytes += static_cast<uint64_t>(m_BoidScratch.capacity()) * sizeof(Boid);
+        return static_cast<uint32_t>(bytes);
+    }
+    case NeighborSearchMode::NeighborList:
+    {
+        // CSR lists and anchors, plus the cell table they are built from
+        uint64_t bytes = 0;
+        bytes += static_cast<uint64_t>(m_ListStart.capacity() + m_ListItems.capacity()) * sizeof(uint32_t);
+        bytes += static_cast<uint64_t>(m_ListAnchorX.capacity() + m_ListAnchorY.capacity() + m_ListAnchorZ.capacity()) * sizeof(float);
+        bytes += static_cast<uint64_t>(m_CellStart.capacity() + m_BoidCell.capacity() + m_SortOrder.capacity()) * sizeof(uint32_t);
+        return static_cast<uint32_t>(bytes);
+    }
+    case NeighborSearchMode::LinearOctree:
+    {
+        // nodes, keys and sort order (plus their radix scratch), and the permutation scratch
+        uint64_t bytes = 0;
+        bytes += static_cast<uint64_t>(m_LinearNodes.capacity()) * sizeof(LinearOctreeNode);
+        bytes += static_cast<uint64_t>(m_MortonKeys.capacity() + m_MortonScratch.capacity()) * sizeof(uint32_t);
+        bytes += static_cast<uint64_t>(m_SortOrder.capacity() + m_SortOrderScratch.capacity()) * sizeof(uint32_t);
+        bytes += static_cast<uint64_t>(m_BoidScratch.capacity()) * sizeof(Boid);
         return static_cast<uint32_t>(bytes);
     }
     default:
@@ -5,6 +5,8 @@
 #include "../Renderer/MeshGenerator.h"
 #include "../Scene/SceneRuntime.h"
 #include "../Networking/NetworkPeer.h"
+#include "../SimulationLibrary/FlockSteering.h"
+#include "../SimulationLibrary/JobSystem.h"
 
 #include <glm/glm.hpp>
 #include <vector>
@@ -21,15 +23,13 @@
 
 class FlockingScenario : public Scenario {
 private:
+    // Cold per-boid data. Position and velocity live in the SoA streams below (same index), so
+    // the steering loop only touches the floats it reads.
     struct Boid {
         uint32_t id = 0;
         SimRuntime::OwnerType owner = SimRuntime::OwnerType::One;
         bool isLocallyOwned = true;
 
-        glm::vec3 position{ 0.0f };
-        glm::vec3 velocity{ 0.0f };
-        glm::mat4 model{ 1.0f };
-
         glm::vec3 initialPosition{ 0.0f };
         glm::vec3 initialVelocity{ 0.0f };
 
@@ -41,7 +41,10 @@ private:
     enum class NeighborSearchMode {
         BruteForce = 0,
         UniformGrid = 1,
-        Octree = 2
+        Octree = 2,
+        SortedGrid = 3,
+        LinearOctree = 4,
+        NeighborList = 5
     };
 
     struct GridKey {
@@ -70,18 +73,50 @@ private:
 
     struct OctreeNode {
         Aabb bounds{};
-        std::vector<size_t> indices;
+        std::vector<uint32_t> indices;
         std::array<std::unique_ptr<OctreeNode>, 8> children{};
     };
 
+    // Linear octree node. Boids are permuted into Morton order, so every node covers the boid
+    // range [begin, end). Nodes are stored breadth first and a node's children are
+    // m_LinearNodes[firstChild, firstChild + childCount); leaves have no children.
+    struct LinearOctreeNode {
+        Aabb bounds{};
+        uint32_t begin = 0;
+        uint32_t end = 0;
+        uint32_t firstChild = 0;
+        uint32_t childCount = 0;
+        uint32_t level = 0;
+    };
+
     struct ModeSample {
         bool valid = false;
         float updateMs = 0.0f;
         float buildMs = 0.0f;
         uint32_t memoryBytes = 0;
+        int octreeMaxDepth = 0;
+        int octreeLeafCapacity = 0;
+        float listRebuildInterval = 0.0f; // ticks per rebuild
+        float listHitRate = 0.0f;         // list entries within neighborRadius
+    };
+
+    // Per-thread state for ComputeSteering.
+    struct SteeringScratch {
+        std::vector<uint32_t> candidates;
+        uint64_t listEntries = 0;    // neighbour-list entries tested
+        uint64_t listNeighbours = 0; // ... of which were within neighborRadius
     };
 
     std::vector<Boid> m_Boids;
+    std::vector<float> m_PosX, m_PosY, m_PosZ;
+    std::vector<float> m_VelX, m_VelY, m_VelZ;
+    // Next-tick streams: the update reads the streams above and writes these, then swaps them.
+    // Also the target of PermuteBoids().
+    std::vector<float> m_NextPosX, m_NextPosY, m_NextPosZ;
+    std::vector<float> m_NextVelX, m_NextVelY, m_NextVelZ;
+
+    JobSystem m_Jobs;
+    int m_UpdateThreads = 1;
     Mesh m_BoidMesh;
     SandboxApplication::MeshBuffers m_BoidBuffers{};
 
@@ -119,19 +154,55 @@ private:
     std::atomic<int> m_LastNetworkCpu{ -1 };
 
     NeighborSearchMode m_SearchMode = NeighborSearchMode::BruteForce;
-    std::unordered_map<GridKey, std::vector<size_t>, GridKeyHasher> m_UniformGrid;
+    std::unordered_map<GridKey, std::vector<uint32_t>, GridKeyHasher> m_UniformGrid;
+    SimSimd::SimdLevel m_SteeringSimdLevel = SimSimd::GetBestSimdLevel();
     float m_LastGridBuildMs = 0.0f;
     float m_LastUpdateMs = 0.0f;
+    PhaseTimer m_PhaseTimer;
     uint32_t m_LastGridCellCount = 0;
     uint32_t m_LastGridEntryCount = 0;
 
+    // Cell table: boid indices counting-sorted by cell into m_SortOrder, cell c holding
+    // m_SortOrder[m_CellStart[c] .. m_CellStart[c + 1]). The sorted grid then permutes the boid
+    // arrays into that order, so a cell's boids are [m_CellStart[c], m_CellStart[c + 1]) and
+    // three cells along x are one contiguous range. All buffers keep their capacity between ticks.
+    std::vector<uint32_t> m_CellStart;
+    std::vector<uint32_t> m_BoidCell;
+    std::vector<uint32_t> m_SortOrder;
+    std::vector<Boid> m_BoidScratch;
+    glm::vec3 m_SortedGridOrigin{ 0.0f };
+    glm::ivec3 m_SortedGridDims{ 0 };
+    float m_SortedGridCellSize = 1.0f;
+
     std::unique_ptr<OctreeNode> m_OctreeRoot;
     float m_LastOctreeBuildMs = 0.0f;
     uint32_t m_LastOctreeNodeCount = 0;
     int m_OctreeMaxDepth = 6;
     int m_OctreeLeafCapacity = 12;
 
-    std::array<ModeSample, 3> m_ModeSamples{};
+    std::vector<LinearOctreeNode> m_LinearNodes;
+    std::vector<uint32_t> m_MortonKeys;
+    std::vector<uint32_t> m_MortonScratch;
+    std::vector<uint32_t> m_SortOrderScratch;
+
+    // Neighbour lists (Verlet): boid i's candidates within neighborRadius + skin at the last build
+    // are m_ListItems[m_ListStart[i] .. m_ListStart[i + 1]). They are rebuilt once any boid has
+    // moved more than skin / 2 from its anchor (its position at that build), before which no pair
+    // can have come within neighborRadius unlisted.
+    float m_NeighborSkin = 1.0f;
+    std::vector<uint32_t> m_ListStart;
+    std::vector<uint32_t> m_ListItems;
+    std::vector<float> m_ListAnchorX, m_ListAnchorY, m_ListAnchorZ;
+    float m_ListRadius = 0.0f;
+    float m_ListSkin = 0.0f;
+    bool m_ListValid = false;
+    uint32_t m_ListRebuilds = 0;  // since the mode was last selected
+    uint32_t m_ListTicks = 0;
+    float m_ListBuildMsTotal = 0.0f;
+    float m_LastListBuildMs = 0.0f;
+    float m_LastListHitRate = 0.0f;
+
+    std::array<ModeSample, 6> m_ModeSamples{};
 
     std::atomic<bool> m_EnableNetEmulation{ false };
     std::atomic<float> m_EmuBaseLatencyMs{ 100.0f };
@@ -147,17 +218,37 @@ private:
 
     void BuildFromSceneOrFallback();
     void BuildBoids(uint32_t count, const glm::vec3& center, const glm::vec3& extents);
+    void ClearBoids();
+
+    glm::vec3 GetPosition(size_t i) const { return { m_PosX[i], m_PosY[i], m_PosZ[i] }; }
+    glm::vec3 GetVelocity(size_t i) const { return { m_VelX[i], m_VelY[i], m_VelZ[i] }; }
+    void SetPosition(size_t i, const glm::vec3& p) { m_PosX[i] = p.x; m_PosY[i] = p.y; m_PosZ[i] = p.z; }
+    void SetVelocity(size_t i, const glm::vec3& v) { m_VelX[i] = v.x; m_VelY[i] = v.y; m_VelZ[i] = v.z; }
+    SimFlocking::BoidStreams GetBoidStreams() const;
+    void SwapBoidBuffers();
+
     void ResetBoids();
     void ResetBoids_NoLock();
     void RefreshOwnershipFlags();
-    Boid* FindBoidById(uint32_t id);
+    // Index into m_Boids and the SoA streams, or -1.
+    ptrdiff_t FindBoidById(uint32_t id) const;
 
     GridKey ToGridKey(const glm::vec3& p) const;
     void BuildUniformGrid();
-    void CollectUniformGridCandidates(size_t boidIndex, std::vector<size_t>& outCandidates) const;
+    void CollectUniformGridCandidates(size_t boidIndex, std::vector<uint32_t>& outCandidates) const;
+
+    glm::ivec3 SortedGridCellOf(const glm::vec3& p) const;
+    void BuildCellTable(float minCellSize);
+    void BuildSortedGrid();
+    void PermuteBoids(const std::vector<uint32_t>& order);
+    void AccumulateSortedGridNeighbours(const SimFlocking::BoidStreams& streams, const SimFlocking::NeighbourQuery& query, SimFlocking::NeighbourSums& sums) const;
+
+    bool NeighborListsNeedRebuild();
+    void BuildNeighborLists();
 
-    glm::vec3 ComputeSteering(size_t boidIndex) const;
-    glm::vec4 BoidTint(const Boid& b) const;
+    // Reads only the current streams, so boids can be steered in parallel.
+    glm::vec3 ComputeSteering(size_t boidIndex, SteeringScratch& scratch) const;
+    glm::vec4 BoidTint(size_t boidIndex) const;
 
     void SendOwnedBoidStates();
     void ReceiveRemoteBoidStates(float dt);
@@ -169,9 +260,11 @@ private:
     Aabb ComputeFlockBounds(float padding) const;
     static bool AabbContainsPoint(const Aabb& box, const glm::vec3& p);
     static bool AabbIntersectsSphere(const Aabb& box, const glm::vec3& c, float r);
-    std::unique_ptr<OctreeNode> BuildOctreeNode(const Aabb& box, const std::vector<size_t>& indices, int depth);
+    std::unique_ptr<OctreeNode> BuildOctreeNode(const Aabb& box, const std::vector<uint32_t>& indices, int depth);
     void BuildOctree();
-    void CollectOctreeCandidates(const OctreeNode* node, const glm::vec3& p, float radius, std::vector<size_t>& out) const;
+    void CollectOctreeCandidates(const OctreeNode* node, const glm::vec3& p, float radius, std::vector<uint32_t>& out) const;
+    void BuildLinearOctree();
+    void AccumulateLinearOctreeNeighbours(const SimFlocking::BoidStreams& streams, const SimFlocking::NeighbourQuery& query, SimFlocking::NeighbourSums& sums) const;
 
     uint32_t EstimateModeMemoryBytes(NeighborSearchMode mode) const;
 
@@ -180,6 +273,7 @@ public:
 
     void OnLoad() override;
     void OnUpdate(float deltaTime) override;
+    const PhaseTimer* GetPhaseTimer() const override { return &m_PhaseTimer; }
     void OnRender(VkCommandBuffer commandBuffer) override;
     void OnUnload() override;
     void OnImGui() override;
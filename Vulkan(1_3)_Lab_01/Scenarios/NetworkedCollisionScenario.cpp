@@ -1,11 +1,14 @@
 #include "NetworkedCollisionScenario.h"
 
+#include "../SimulationLibrary/CollisionDispatch.h"
 #include "../SimulationLibrary/CollisionUtil.h"
+#include "../SimulationLibrary/ContinuousCollision.h"
 
 #include <imgui.h>
 #include <algorithm>
 #include <chrono>
 #include <cmath>
+#include <iostream>
 
 #ifdef _WIN32
 #ifndef WIN32_LEAN_AND_MEAN
@@ -35,6 +38,20 @@ namespace
 }
 #endif
 
+// World bounds of a box body or a capsule/cylinder obstacle.
+static bool BoxInstanceBounds(const PhysicsObject& body, SimCollision::AABB& out)
+{
+    if (auto* col = body.GetColliderAs<BoxCollider>()) {
+        out = SimCollision::OBBBounds({ col->GetCenter(), col->GetOrientation(), col->GetHalfExtents() });
+        return true;
+    }
+
+    SimCollision::ConvexShape shape;
+    if (!SimCollision::ToConvex(body.GetCollider(), shape)) return false;
+    out = SimCollision::ConvexBounds(shape);
+    return true;
+}
+
 static Mesh BuildCuboidMesh(const glm::vec3& halfExtents, const glm::vec3& color)
 {
     const float hx = halfExtents.x;
@@ -81,8 +98,16 @@ void NetworkedCollisionScenario::ClearScene()
     m_Spheres.clear();
     m_Planes.clear();
     m_Boxes.clear();
+    ResetBroadphase_NoLock();
+    m_SATCache.Clear();
+    m_GJKCache.Clear();
+    m_Islands.Clear();
+    m_IslandMembers.clear();
     m_NextObjectId = 1;
     m_NetTick = 0;
+    m_SimTick = 0;
+    ++m_SceneGeneration;
+    m_Snapshots.Clear();
 }
 
 void NetworkedCollisionScenario::UpdatePlaneTransform(PlaneInstance& plane, const glm::vec3& position)
@@ -101,7 +126,7 @@ void NetworkedCollisionScenario::AddPlane(const glm::vec3& point, const glm::vec
     const glm::vec3 n = glm::normalize(normal);
     instance.orientation = glm::rotation(glm::vec3(0.0f, 1.0f, 0.0f), n);
 
-    instance.body.SetCollider(std::make_unique<PlaneCollider>(n));
+    instance.body.SetCollider(PlaneCollider(n));
     instance.body.SetMass(0.0f);
     UpdatePlaneTransform(instance, point);
 
@@ -118,7 +143,9 @@ void NetworkedCollisionScenario::AddSphere(const glm::vec3& position, const glm:
     s.isLocallyOwned = (m_LocalPeerOwner == owner);
     s.color = color;
 
-    s.body.SetCollider(std::make_unique<SphereCollider>(radius));
+    s.body.AttachToWorld(m_World);
+    m_World.SetSimulated(s.body.GetWorldHandle(), s.isLocallyOwned);
+    s.body.SetCollider(SphereCollider(radius));
     s.body.SetPosition(position);
     s.body.SetVelocity(velocity);
     s.body.SetRadius(radius);
@@ -140,7 +167,9 @@ void NetworkedCollisionScenario::AddBox(const glm::vec3& position, const glm::qu
     b.color = color;
     b.halfExtents = glm::max(halfExtents, glm::vec3(0.05f));
 
-    b.body.SetCollider(std::make_unique<BoxCollider>(b.halfExtents));
+    b.body.AttachToWorld(m_World);
+    m_World.SetSimulated(b.body.GetWorldHandle(), b.isLocallyOwned);
+    b.body.SetCollider(BoxCollider(b.halfExtents));
     b.body.SetPosition(position);
     b.body.SetOrientation(orientation);
     b.body.SetVelocity(velocity);
@@ -159,19 +188,23 @@ void NetworkedCollisionScenario::AddStaticCylinderObstacle(const glm::vec3& posi
     b.id = m_NextObjectId++;
     b.owner = SimRuntime::OwnerType::One;
     b.isLocallyOwned = false; // never replicate / simulate
+    b.isStaticObstacle = true;
     b.color = color;
 
+    // Local bounds, used for picking
     const glm::vec3 halfExtents{ radius, height * 0.5f, radius };
     b.halfExtents = glm::max(halfExtents, glm::vec3(0.05f));
 
-    b.body.SetCollider(std::make_unique<BoxCollider>(b.halfExtents));
+    b.body.AttachToWorld(m_World);
+    m_World.SetSimulated(b.body.GetWorldHandle(), false);
+    b.body.SetCollider(CylinderCollider(radius, height * 0.5f));
     b.body.SetPosition(position);
     b.body.SetOrientation(orientation);
     b.body.SetVelocity({ 0,0,0 });
     b.body.SetMass(0.0f);
     b.body.SetRestitution(m_BounceRestitution);
 
-    // Render as cylinder, collide as box-approx
+    // Collides as a cylinder through GJK/EPA
     b.mesh = MeshGenerator::GenerateCylinder(radius, height, 24, color);
     b.buffers = m_App->UploadMesh(b.mesh);
 
@@ -184,20 +217,23 @@ void NetworkedCollisionScenario::AddStaticCapsuleObstacle(const glm::vec3& posit
     b.id = m_NextObjectId++;
     b.owner = SimRuntime::OwnerType::One;
     b.isLocallyOwned = false; // never replicate / simulate
+    b.isStaticObstacle = true;
     b.color = color;
 
-    // Capsule AABB half extents approx
+    // Local bounds, used for picking
     const glm::vec3 halfExtents{ radius, height * 0.5f + radius, radius };
     b.halfExtents = glm::max(halfExtents, glm::vec3(0.05f));
 
-    b.body.SetCollider(std::make_unique<BoxCollider>(b.halfExtents));
+    b.body.AttachToWorld(m_World);
+    m_World.SetSimulated(b.body.GetWorldHandle(), false);
+    b.body.SetCollider(CapsuleCollider(radius, height * 0.5f - radius)); // 'height' includes the caps, as in the mesh
     b.body.SetPosition(position);
     b.body.SetOrientation(orientation);
     b.body.SetVelocity({ 0,0,0 });
     b.body.SetMass(0.0f);
     b.body.SetRestitution(m_BounceRestitution);
 
-    // Render as capsule, collide as box-approx
+    // Collides as a capsule through GJK/EPA
     b.mesh = MeshGenerator::GenerateCapsule(radius, height, 24, 12, color);
     b.buffers = m_App->UploadMesh(b.mesh);
 
@@ -269,7 +305,7 @@ void NetworkedCollisionScenario::SetupPreset(DemoPreset preset)
         AddPlane({ 0, 0, -halfZ }, { 0, 0,  1 }, { 14, 7 },  { 0.25f, 0.35f, 0.25f }); // back
         AddPlane({ 0, 0,  halfZ }, { 0, 0, -1 }, { 14, 7 },  { 0.25f, 0.35f, 0.25f }); // front
 
-        // Static obstacles: capsule + cylinder (rendered as such; collide as box approximation)
+        // Static obstacles: capsule + cylinder (rendered as such; collide as those shapes through GJK/EPA)
         AddStaticCapsuleObstacle({ -1.5f, -0.5f,  0.0f }, 0.35f, 1.6f, glm::quat(glm::vec3(0.0f, glm::radians(25.0f), 0.0f)), { 0.7f, 0.7f, 0.2f });
         AddStaticCylinderObstacle({  1.8f,  0.0f, -1.5f }, 0.40f, 2.0f, glm::quat(glm::vec3(0.0f, glm::radians(-15.0f), 0.0f)), { 0.2f, 0.7f, 0.7f });
         AddStaticCapsuleObstacle({  2.5f,  0.5f,  2.0f }, 0.25f, 1.2f, glm::quat(glm::vec3(0.0f, glm::radians(60.0f), 0.0f)), { 0.8f, 0.4f, 0.2f });
@@ -325,11 +361,16 @@ void NetworkedCollisionScenario::SetupPreset(DemoPreset preset)
     }
 
     // Refresh ownership flags after rebuild
-    for (auto& s : m_Spheres) s.isLocallyOwned = (m_LocalPeerOwner == s.owner);
-    for (auto& b : m_Boxes)  b.isLocallyOwned = (m_LocalPeerOwner == b.owner);
+    RefreshOwnership_NoLock();
 
     m_TxPackets.store(0);
     m_RxPackets.store(0);
+
+    // Local and remote resets alike end up here; the settings are the ones the scene was built with
+    if (m_Recording) {
+        m_SessionSettings = CaptureSessionSettings_NoLock();
+        m_Session.Append(m_SessionTick, SessionRecording::EventType::Preset, SessionPreset{ static_cast<int32_t>(preset), m_SessionSettings });
+    }
 }
 
 void NetworkedCollisionScenario::ResolveSpherePlane(SphereInstance& sphere, const PlaneCollider& plane)
@@ -341,32 +382,82 @@ void NetworkedCollisionScenario::ResolveSpherePlane(SphereInstance& sphere, cons
     const float radius = sCol->GetRadius();
 
     if (distance < radius) {
-        const float penetration = radius - distance;
-        const glm::vec3 n = plane.GetNormal();
+        ApplySpherePlaneContact(sphere, plane.GetNormal(), radius - distance);
+    }
+}
 
-        sphere.body.SetPosition(sphere.body.GetPosition() + n * penetration);
+void NetworkedCollisionScenario::ApplySpherePlaneContact(SphereInstance& sphere, const glm::vec3& n, float penetration)
+{
+    sphere.body.SetPosition(sphere.body.GetPosition() + n * penetration);
 
-        glm::vec3 v = sphere.body.GetVelocity();
-        const float vN = glm::dot(v, n);
+    glm::vec3 v = sphere.body.GetVelocity();
+    const float vN = glm::dot(v, n);
 
-        if (vN < 0.0f) {
-            const float e = m_UseBounce ? sphere.body.GetRestitution() : 0.0f;
-            v = v - (1.0f + e) * vN * n;
-            sphere.body.SetVelocity(v);
+    if (vN < 0.0f) {
+        const float e = ContactRestitution(sphere.body.GetRestitution(), -vN);
+        v = v - (1.0f + e) * vN * n;
+        sphere.body.SetVelocity(v);
+    }
+}
+
+void NetworkedCollisionScenario::ResolveSpherePlanesBatched_NoLock()
+{
+    auto& sp = m_SpherePlaneScratch;
+    sp.sphere.clear();
+    for (uint32_t i = 0; i < static_cast<uint32_t>(m_Spheres.size()); ++i) {
+        const auto& s = m_Spheres[i];
+        if (s.isLocallyOwned && !s.sleep.asleep && s.body.GetColliderAs<SphereCollider>()) sp.sphere.push_back(i);
+    }
+
+    const size_t count = sp.sphere.size();
+    if (count == 0) return;
+
+    for (auto* v : { &sp.cx, &sp.cy, &sp.cz, &sp.r, &sp.nx, &sp.ny, &sp.nz, &sp.px, &sp.py, &sp.pz }) v->resize(count);
+
+    // One plane at a time across every sphere; each sphere still meets the planes in the same
+    // order as the old per-sphere loop.
+    for (const auto& p : m_Planes) {
+        auto* pc = p.body.GetColliderAs<PlaneCollider>();
+        if (!pc) continue;
+
+        const glm::vec3 n = pc->GetNormal();
+        const glm::vec3 point = pc->GetPoint();
+        for (size_t k = 0; k < count; ++k) {
+            const auto* col = m_Spheres[sp.sphere[k]].body.GetColliderAs<SphereCollider>();
+            const glm::vec3 c = col->GetCenter();
+            sp.cx[k] = c.x; sp.cy[k] = c.y; sp.cz[k] = c.z;
+            sp.r[k] = col->GetRadius();
+            sp.nx[k] = n.x; sp.ny[k] = n.y; sp.nz[k] = n.z;
+            sp.px[k] = point.x; sp.py[k] = point.y; sp.pz[k] = point.z;
+        }
+
+        SimCollision::SpherePlaneBatch batch;
+        batch.center = { sp.cx.data(), sp.cy.data(), sp.cz.data() };
+        batch.radius = sp.r.data();
+        batch.planeNormal = { sp.nx.data(), sp.ny.data(), sp.nz.data() };
+        batch.planePoint = { sp.px.data(), sp.py.data(), sp.pz.data() };
+        batch.count = count;
+
+        SimCollision::SphereVsPlaneBatch(batch, sp.hits);
+        m_StaticTests += count;
+
+        for (size_t h = 0; h < sp.hits.Size(); ++h) {
+            const glm::vec3 hitNormal{ sp.hits.normalX[h], sp.hits.normalY[h], sp.hits.normalZ[h] };
+            ApplySpherePlaneContact(m_Spheres[sp.sphere[sp.hits.pairIndex[h]]], hitNormal, sp.hits.penetration[h]);
         }
     }
 }
 
-void NetworkedCollisionScenario::ResolveSphereSphere(SphereInstance& a, SphereInstance& b)
+bool NetworkedCollisionScenario::ResolveSphereSphere(SphereInstance& a, SphereInstance& b)
 {
     auto* aCol = a.body.GetColliderAs<SphereCollider>();
     auto* bCol = b.body.GetColliderAs<SphereCollider>();
-    if (!aCol || !bCol) return;
+    if (!aCol || !bCol) return false;
 
     const glm::vec3 d = bCol->GetCenter() - aCol->GetCenter();
     const float dist = glm::length(d);
     const float rSum = aCol->GetRadius() + bCol->GetRadius();
-    if (dist <= 0.0f || dist >= rSum) return;
+    if (dist <= 0.0f || dist >= rSum) return false;
 
     const glm::vec3 n = d / dist;
     const float penetration = rSum - dist;
@@ -374,62 +465,80 @@ void NetworkedCollisionScenario::ResolveSphereSphere(SphereInstance& a, SphereIn
     const float invA = a.body.GetInverseMass();
     const float invB = b.body.GetInverseMass();
     const float invSum = invA + invB;
-    if (invSum <= 0.0f) return;
+    if (invSum <= 0.0f) return true;
 
+    // Static sides (inverse mass 0) are never written: the island stage shares them between threads.
     const glm::vec3 corr = n * (penetration / invSum);
-    a.body.SetPosition(a.body.GetPosition() - corr * invA);
-    b.body.SetPosition(b.body.GetPosition() + corr * invB);
+    if (invA > 0.0f) a.body.SetPosition(a.body.GetPosition() - corr * invA);
+    if (invB > 0.0f) b.body.SetPosition(b.body.GetPosition() + corr * invB);
 
     glm::vec3 va = a.body.GetVelocity();
     glm::vec3 vb = b.body.GetVelocity();
     const glm::vec3 rel = vb - va;
     const float velN = glm::dot(rel, n);
-    if (velN > 0.0f) return;
+    if (velN > 0.0f) return true;
 
-    const float e = m_UseBounce ? m_BounceRestitution : 0.0f;
+    const float e = ContactRestitution(m_BounceRestitution, -velN);
     const float j = -(1.0f + e) * velN / invSum;
     const glm::vec3 impulse = j * n;
 
-    a.body.SetVelocity(va - impulse * invA);
-    b.body.SetVelocity(vb + impulse * invB);
+    if (invA > 0.0f) a.body.SetVelocity(va - impulse * invA);
+    if (invB > 0.0f) b.body.SetVelocity(vb + impulse * invB);
+
+    return true;
 }
 
-void NetworkedCollisionScenario::ResolveSphereBox(SphereInstance& sphere, BoxInstance& box)
+bool NetworkedCollisionScenario::ResolveSphereBox(SphereInstance& sphere, BoxInstance& box)
 {
     auto* sCol = sphere.body.GetColliderAs<SphereCollider>();
-    auto* bCol = box.body.GetColliderAs<BoxCollider>();
-    if (!sCol || !bCol) return;
-
-    SimCollision::OBB obb{};
-    obb.center = bCol->GetCenter();
-    obb.orientation = bCol->GetOrientation();
-    obb.halfExtents = bCol->GetHalfExtents();
+    if (!sCol) return false;
 
+    // Normal points from the box (or obstacle) to the sphere
     SimCollision::Contact c{};
-    if (!SimCollision::SphereVsOBB(sCol->GetCenter(), sCol->GetRadius(), obb, c)) return;
+    if (auto* bCol = box.body.GetColliderAs<BoxCollider>()) {
+        SimCollision::OBB obb{};
+        obb.center = bCol->GetCenter();
+        obb.orientation = bCol->GetOrientation();
+        obb.halfExtents = bCol->GetHalfExtents();
+
+        if (!SimCollision::SphereVsOBB(sCol->GetCenter(), sCol->GetRadius(), obb, c)) return false;
+    }
+    else {
+        SimCollision::ConvexShape shape;
+        if (!SimCollision::ToConvex(box.body.GetCollider(), shape)) return false;
+
+        const SimCollision::ConvexShape ball = SimCollision::ToConvex(*sCol);
+        const bool hit = m_UseGJKCache
+            ? m_GJKCache.Test(sphere.body.GetWorldHandle(), box.body.GetWorldHandle(), ball, shape, c)
+            : SimCollision::ConvexVsConvex(ball, shape, c);
+        if (!hit) return false;
+        c.normal = -c.normal;
+    }
 
     const glm::vec3 n = c.normal;
     const float invS = sphere.body.GetInverseMass();
     const float invB = box.body.GetInverseMass();
     const float invSum = invS + invB;
-    if (invSum <= 0.0f) return;
+    if (invSum <= 0.0f) return true;
 
     const glm::vec3 corr = n * (c.penetration / invSum);
-    box.body.SetPosition(box.body.GetPosition() - corr * invB);
-    sphere.body.SetPosition(sphere.body.GetPosition() + corr * invS);
+    if (invB > 0.0f) box.body.SetPosition(box.body.GetPosition() - corr * invB);
+    if (invS > 0.0f) sphere.body.SetPosition(sphere.body.GetPosition() + corr * invS);
 
     glm::vec3 vs = sphere.body.GetVelocity();
     glm::vec3 vb = box.body.GetVelocity();
     const glm::vec3 rel = vs - vb;
     const float velN = glm::dot(rel, n);
-    if (velN > 0.0f) return;
+    if (velN > 0.0f) return true;
 
-    const float e = m_UseBounce ? m_BounceRestitution : 0.0f;
+    const float e = ContactRestitution(m_BounceRestitution, -velN);
     const float j = -(1.0f + e) * velN / invSum;
     const glm::vec3 impulse = j * n;
 
-    sphere.body.SetVelocity(vs + impulse * invS);
-    box.body.SetVelocity(vb - impulse * invB);
+    if (invS > 0.0f) sphere.body.SetVelocity(vs + impulse * invS);
+    if (invB > 0.0f) box.body.SetVelocity(vb - impulse * invB);
+
+    return true;
 }
 
 void NetworkedCollisionScenario::ResolveBoxPlane(BoxInstance& box, const PlaneCollider& plane)
@@ -454,46 +563,570 @@ void NetworkedCollisionScenario::ResolveBoxPlane(BoxInstance& box, const PlaneCo
     glm::vec3 v = box.body.GetVelocity();
     const float vN = glm::dot(v, n);
     if (vN < 0.0f) {
-        const float e = m_UseBounce ? box.body.GetRestitution() : 0.0f;
+        const float e = ContactRestitution(box.body.GetRestitution(), -vN);
         v = v - (1.0f + e) * vN * n;
         box.body.SetVelocity(v);
     }
 }
 
-void NetworkedCollisionScenario::ResolveBoxBox(BoxInstance& a, BoxInstance& b)
+bool NetworkedCollisionScenario::ResolveBoxBox(BoxInstance& a, BoxInstance& b)
 {
     auto* aCol = a.body.GetColliderAs<BoxCollider>();
     auto* bCol = b.body.GetColliderAs<BoxCollider>();
-    if (!aCol || !bCol) return;
+    if (!aCol || !bCol) return false;
 
     SimCollision::OBB A{ aCol->GetCenter(), aCol->GetOrientation(), aCol->GetHalfExtents() };
     SimCollision::OBB B{ bCol->GetCenter(), bCol->GetOrientation(), bCol->GetHalfExtents() };
 
     SimCollision::Contact c{};
-    if (!SimCollision::OBBVsOBB(A, B, c)) return;
+    const bool hit = m_UseSATCache
+        ? m_SATCache.Test(a.body.GetWorldHandle(), b.body.GetWorldHandle(), A, B, c)
+        : SimCollision::OBBVsOBB(A, B, c);
+    if (!hit) return false;
 
     const glm::vec3 n = c.normal;
     const float invA = a.body.GetInverseMass();
     const float invB = b.body.GetInverseMass();
     const float invSum = invA + invB;
-    if (invSum <= 0.0f) return;
+    if (invSum <= 0.0f) return true;
 
     const glm::vec3 corr = n * (c.penetration / invSum);
-    a.body.SetPosition(a.body.GetPosition() - corr * invA);
-    b.body.SetPosition(b.body.GetPosition() + corr * invB);
+    if (invA > 0.0f) a.body.SetPosition(a.body.GetPosition() - corr * invA);
+    if (invB > 0.0f) b.body.SetPosition(b.body.GetPosition() + corr * invB);
 
     glm::vec3 va = a.body.GetVelocity();
     glm::vec3 vb = b.body.GetVelocity();
     const glm::vec3 rel = vb - va;
     const float velN = glm::dot(rel, n);
-    if (velN > 0.0f) return;
+    if (velN > 0.0f) return true;
 
-    const float e = m_UseBounce ? m_BounceRestitution : 0.0f;
+    const float e = ContactRestitution(m_BounceRestitution, -velN);
     const float j = -(1.0f + e) * velN / invSum;
     const glm::vec3 impulse = j * n;
 
-    a.body.SetVelocity(va - impulse * invA);
-    b.body.SetVelocity(vb + impulse * invB);
+    if (invA > 0.0f) a.body.SetVelocity(va - impulse * invA);
+    if (invB > 0.0f) b.body.SetVelocity(vb + impulse * invB);
+
+    return true;
+}
+
+void NetworkedCollisionScenario::ResetBroadphase_NoLock()
+{
+    m_Broadphase.Clear();
+    m_DynamicTree.Clear();
+    m_StaticTree.Clear();
+    m_StaticTreeDirty = true;
+    m_StaticWorld.Clear();
+    m_StaticWorldDirty = true;
+    m_BroadphasePairs.clear();
+
+    for (auto& s : m_Spheres) s.broadphaseProxy = SweepAndPrune::kInvalidProxy;
+    for (auto& b : m_Boxes) b.broadphaseProxy = SweepAndPrune::kInvalidProxy;
+}
+
+void NetworkedCollisionScenario::BuildStaticTree_NoLock()
+{
+    // Planes are unbounded; a slab a couple of metres deep behind each one is enough to catch
+    // anything that is touching or has just crossed it.
+    constexpr float kPlaneSlabDepth = 2.0f;
+    constexpr float kWorldExtent = 1.0e4f;
+
+    m_StaticTree.Clear();
+
+    for (size_t i = 0; i < m_Planes.size(); ++i) {
+        auto* pc = m_Planes[i].body.GetColliderAs<PlaneCollider>();
+        if (!pc) continue;
+        const SimCollision::AABB bounds = SimCollision::PlaneSlabBounds(pc->GetPoint(), pc->GetNormal(), kPlaneSlabDepth, kWorldExtent);
+        m_StaticTree.CreateProxy(bounds, static_cast<uint32_t>(i) | kBroadphasePlaneTag);
+    }
+
+    for (size_t i = 0; i < m_Boxes.size(); ++i) {
+        auto& b = m_Boxes[i];
+        if (!b.isStaticObstacle) continue;
+        SimCollision::AABB bounds{};
+        if (!BoxInstanceBounds(b.body, bounds)) continue;
+
+        b.broadphaseProxy = m_StaticTree.CreateProxy(bounds, static_cast<uint32_t>(i) | kBroadphaseBoxTag);
+    }
+
+    m_StaticTreeDirty = false;
+}
+
+void NetworkedCollisionScenario::BuildStaticWorld_NoLock()
+{
+    m_StaticWorld.Clear();
+
+    for (size_t i = 0; i < m_Planes.size(); ++i) {
+        auto* pc = m_Planes[i].body.GetColliderAs<PlaneCollider>();
+        if (!pc) continue;
+        m_StaticWorld.AddPlane(pc->GetNormal(), pc->GetPoint(), static_cast<uint32_t>(i) | kBroadphasePlaneTag);
+    }
+
+    for (size_t i = 0; i < m_Boxes.size(); ++i) {
+        if (!m_Boxes[i].isStaticObstacle) continue;
+        SimCollision::AABB bounds{};
+        if (!BoxInstanceBounds(m_Boxes[i].body, bounds)) continue;
+        m_StaticWorld.AddShape(bounds, static_cast<uint32_t>(i) | kBroadphaseBoxTag);
+    }
+
+    m_StaticWorld.Build();
+    m_StaticWorldDirty = false;
+}
+
+template <typename Callback>
+void NetworkedCollisionScenario::QueryStatic_NoLock(const SimCollision::AABB& bounds, Callback&& callback) const
+{
+    if (m_UseStaticGrid) m_StaticWorld.Query(bounds, callback);
+    else m_StaticTree.Query(bounds, callback);
+}
+
+void NetworkedCollisionScenario::UpdateBroadphase_NoLock(float dt)
+{
+    const bool useTree = (m_BroadphaseMode == BroadphaseMode::AABBTree);
+    if (useTree && m_StaticTreeDirty) BuildStaticTree_NoLock();
+
+    auto updateProxy = [&](uint32_t& proxy, const SimCollision::AABB& bounds, uint32_t userData, const glm::vec3& velocity)
+        {
+            if (proxy == SweepAndPrune::kInvalidProxy) {
+                proxy = useTree ? m_DynamicTree.CreateProxy(bounds, userData) : m_Broadphase.CreateProxy(bounds, userData);
+            }
+            else if (useTree) {
+                m_DynamicTree.MoveProxy(proxy, bounds, velocity * dt);
+            }
+            else {
+                m_Broadphase.UpdateProxy(proxy, bounds);
+            }
+        };
+
+    // Sleeping bodies keep their proxies where they are; they did not move.
+    for (size_t i = 0; i < m_Spheres.size(); ++i) {
+        auto& s = m_Spheres[i];
+        if (s.sleep.asleep && s.broadphaseProxy != SweepAndPrune::kInvalidProxy) continue;
+        auto* col = s.body.GetColliderAs<SphereCollider>();
+        if (!col) continue;
+
+        updateProxy(s.broadphaseProxy, SimCollision::SphereBounds(col->GetCenter(), col->GetRadius()),
+            static_cast<uint32_t>(i), s.body.GetVelocity());
+    }
+
+    for (size_t i = 0; i < m_Boxes.size(); ++i) {
+        auto& b = m_Boxes[i];
+        if (useTree && b.isStaticObstacle) continue; // lives in the static tree
+        if (b.sleep.asleep && b.broadphaseProxy != SweepAndPrune::kInvalidProxy) continue;
+        SimCollision::AABB bounds{};
+        if (!BoxInstanceBounds(b.body, bounds)) continue;
+
+        updateProxy(b.broadphaseProxy, bounds,
+            static_cast<uint32_t>(i) | kBroadphaseBoxTag, b.body.GetVelocity());
+    }
+}
+
+void NetworkedCollisionScenario::ResolveStaticContacts_NoLock()
+{
+    auto resolveAgainstStatic = [&](const SimCollision::AABB& bounds, auto&& onPlane, auto&& onBox)
+        {
+            QueryStatic_NoLock(bounds, [&](uint32_t userData)
+                {
+                    ++m_StaticTests;
+                    if (userData & kBroadphasePlaneTag) onPlane(m_Planes[userData & ~kBroadphasePlaneTag]);
+                    else onBox(m_Boxes[userData & ~kBroadphaseBoxTag]);
+                });
+        };
+
+    for (auto& s : m_Spheres) {
+        if (!s.isLocallyOwned || s.sleep.asleep) continue;
+        auto* col = s.body.GetColliderAs<SphereCollider>();
+        if (!col) continue;
+
+        resolveAgainstStatic(SimCollision::SphereBounds(col->GetCenter(), col->GetRadius()),
+            [&](PlaneInstance& p) { if (auto* pc = p.body.GetColliderAs<PlaneCollider>()) ResolveSpherePlane(s, *pc); },
+            [&](BoxInstance& box) { ResolveSphereBox(s, box); });
+    }
+
+    for (auto& b : m_Boxes) {
+        if (!b.isLocallyOwned || b.isStaticObstacle || b.sleep.asleep) continue;
+        auto* col = b.body.GetColliderAs<BoxCollider>();
+        if (!col) continue;
+
+        const SimCollision::OBB obb{ col->GetCenter(), col->GetOrientation(), col->GetHalfExtents() };
+        resolveAgainstStatic(SimCollision::OBBBounds(obb),
+            [&](PlaneInstance& p) { if (auto* pc = p.body.GetColliderAs<PlaneCollider>()) ResolveBoxPlane(b, *pc); },
+            [&](BoxInstance& other) { if (other.isLocallyOwned) ResolveBoxBox(b, other); });
+    }
+}
+
+void NetworkedCollisionScenario::FindBroadphasePairs_NoLock()
+{
+    // Only depends on the proxies, so it can run before any contact is resolved.
+    if (m_BroadphaseMode == BroadphaseMode::AABBTree) {
+        m_BroadphasePairs = m_DynamicTree.UpdatePairs();
+    }
+    else {
+        m_Broadphase.FindPairs(m_BroadphasePairs);
+    }
+}
+
+void NetworkedCollisionScenario::ResolveBroadphasePairs_NoLock()
+{
+    m_PairsTested = 0;
+    m_PairsColliding = 0;
+
+    // Nothing to do when neither side can move: sleeping or static against sleeping or static.
+    auto isResting = [](const auto& instance) { return instance.sleep.asleep || instance.body.GetInverseMass() <= 0.0f; };
+
+    for (const auto& pair : m_BroadphasePairs) {
+        // Box tag is the high bit, so a sphere (if any) is always pair.a
+        const bool aIsBox = (pair.a & kBroadphaseBoxTag) != 0;
+        const bool bIsBox = (pair.b & kBroadphaseBoxTag) != 0;
+        const uint32_t ia = pair.a & ~kBroadphaseBoxTag;
+        const uint32_t ib = pair.b & ~kBroadphaseBoxTag;
+
+        bool hit = false;
+        if (!aIsBox && !bIsBox) {
+            auto& a = m_Spheres[ia];
+            auto& b = m_Spheres[ib];
+            if (!a.isLocallyOwned || !b.isLocallyOwned) continue;
+            if (isResting(a) && isResting(b)) continue;
+            ++m_PairsTested;
+            hit = ResolveSphereSphere(a, b);
+            if (hit) LinkIslands_NoLock(a.islandIndex, b.islandIndex);
+        }
+        else if (!aIsBox) {
+            auto& s = m_Spheres[ia];
+            auto& box = m_Boxes[ib];
+            if (!s.isLocallyOwned) continue;
+            if (isResting(s) && isResting(box)) continue;
+            ++m_PairsTested;
+            hit = ResolveSphereBox(s, box);
+            if (hit) LinkIslands_NoLock(s.islandIndex, box.islandIndex);
+        }
+        else {
+            auto& a = m_Boxes[ia];
+            auto& b = m_Boxes[ib];
+            if (!a.isLocallyOwned || !b.isLocallyOwned) continue;
+            if (isResting(a) && isResting(b)) continue;
+            ++m_PairsTested;
+            hit = ResolveBoxBox(a, b);
+            if (hit) LinkIslands_NoLock(a.islandIndex, b.islandIndex);
+        }
+
+        if (hit) ++m_PairsColliding;
+    }
+}
+
+void NetworkedCollisionScenario::BeginContinuous_NoLock()
+{
+    m_ContinuousMovers.clear();
+    if (!m_UseCCD) return;
+
+    // Same population as the contact stage: locally simulated, awake, dynamic.
+    const float threshold2 = m_CcdSpeedThreshold * m_CcdSpeedThreshold;
+    auto consider = [&](const PhysicsObject& body, uint32_t id)
+    {
+        if (body.GetInverseMass() <= 0.0f || glm::length2(body.GetVelocity()) < threshold2) return;
+        m_ContinuousMovers.push_back({ id, body.GetPosition(), body.GetOrientation() });
+    };
+
+    for (uint32_t i = 0; i < static_cast<uint32_t>(m_Spheres.size()); ++i) {
+        const auto& s = m_Spheres[i];
+        if (s.isLocallyOwned && !s.sleep.asleep) consider(s.body, i);
+    }
+    for (uint32_t i = 0; i < static_cast<uint32_t>(m_Boxes.size()); ++i) {
+        const auto& b = m_Boxes[i];
+        if (b.isLocallyOwned && !b.isStaticObstacle && !b.sleep.asleep) consider(b.body, i | kBroadphaseBoxTag);
+    }
+}
+
+void NetworkedCollisionScenario::ApplyContinuous_NoLock()
+{
+    m_CcdHits = 0;
+    if (m_ContinuousMovers.empty()) return;
+
+    const bool useTree = (m_BroadphaseMode == BroadphaseMode::AABBTree);
+    if (useTree && m_StaticTreeDirty) BuildStaticTree_NoLock();
+
+    for (const auto& mover : m_ContinuousMovers) {
+        const bool isBox = (mover.body & kBroadphaseBoxTag) != 0;
+        const uint32_t index = mover.body & ~kBroadphaseBoxTag;
+        PhysicsObject& body = isBox ? m_Boxes[index].body : m_Spheres[index].body;
+
+        const glm::vec3 endPosition = body.GetPosition();
+        const glm::vec3 translation = endPosition - mover.startPosition;
+        const glm::quat endOrientation = body.GetOrientation();
+
+        // Moving shape. Spheres only translate; boxes also rotate by the step's relative rotation.
+        float radius = 0.0f;
+        float minExtent = 0.0f;
+        SimCollision::OBBSweep sweep{};
+        if (isBox) {
+            auto* col = body.GetColliderAs<BoxCollider>();
+            if (!col) continue;
+            glm::quat dq = endOrientation * glm::inverse(mover.startOrientation);
+            if (dq.w < 0.0f) dq = -dq;
+            sweep.start = { mover.startPosition, glm::mat3_cast(mover.startOrientation), col->GetHalfExtents() };
+            sweep.translation = translation;
+            sweep.rotation = glm::axis(dq) * glm::angle(dq);
+            radius = glm::length(col->GetHalfExtents());
+            minExtent = std::min({ col->GetHalfExtents().x, col->GetHalfExtents().y, col->GetHalfExtents().z });
+        }
+        else {
+            auto* col = body.GetColliderAs<SphereCollider>();
+            if (!col) continue;
+            radius = col->GetRadius();
+            minExtent = radius;
+        }
+
+        // Earliest impact that the discrete stage could not recover from: anything that would
+        // end the step less than half the body deep is left to it (with friction and stacking).
+        SimCollision::TimeOfImpact first{};
+        float firstRestitution = 0.0f;
+        bool hit = false;
+        auto keep = [&](const SimCollision::TimeOfImpact& toi, float restitution)
+        {
+            const float depth = -glm::dot(translation, toi.normal) * (1.0f - toi.t);
+            if (toi.t >= first.t || depth < 0.5f * minExtent) return;
+            first = toi;
+            firstRestitution = restitution;
+            hit = true;
+        };
+
+        auto sweepPlane = [&](const PlaneInstance& plane)
+        {
+            auto* pc = plane.body.GetColliderAs<PlaneCollider>();
+            if (!pc) return;
+            SimCollision::TimeOfImpact toi{};
+            const bool found = isBox
+                ? SimCollision::SweptOBBVsPlane(sweep, pc->GetNormal(), pc->GetPoint(), toi)
+                : SimCollision::SweptSphereVsPlane(mover.startPosition, endPosition, radius, pc->GetNormal(), pc->GetPoint(), toi);
+            if (found) keep(toi, body.GetRestitution());
+        };
+
+        // Mirrors the discrete stage: boxes only collide with obstacles this peer simulates.
+        auto sweepObstacle = [&](const BoxInstance& obstacle)
+        {
+            if (isBox && !obstacle.isLocallyOwned) return;
+            SimCollision::TimeOfImpact toi{};
+            auto* oc = obstacle.body.GetColliderAs<BoxCollider>();
+            if (!oc) {
+                // Capsule/cylinder obstacles; boxes never reach them (they are not locally owned)
+                SimCollision::ConvexShape shape;
+                if (isBox || !SimCollision::ToConvex(obstacle.body.GetCollider(), shape)) return;
+                if (SimCollision::SweptSphereVsConvex(mover.startPosition, endPosition, radius, shape, toi)) keep(toi, m_BounceRestitution);
+                return;
+            }
+            const SimCollision::OBB obb{ oc->GetCenter(), oc->GetOrientation(), oc->GetHalfExtents() };
+            const bool found = isBox
+                ? SimCollision::SweptOBBVsOBB(sweep, obb, toi)
+                : SimCollision::SweptSphereVsOBB(mover.startPosition, endPosition, radius, obb, toi);
+            if (found) keep(toi, m_BounceRestitution);
+        };
+
+        if (useTree || m_UseStaticGrid) {
+            // Bounding sphere at both ends covers any rotation in between.
+            const SimCollision::AABB a = SimCollision::SphereBounds(mover.startPosition, radius);
+            const SimCollision::AABB b = SimCollision::SphereBounds(endPosition, radius);
+            QueryStatic_NoLock({ glm::min(a.min, b.min), glm::max(a.max, b.max) }, [&](uint32_t userData)
+                {
+                    ++m_StaticTests;
+                    if (userData & kBroadphasePlaneTag) sweepPlane(m_Planes[userData & ~kBroadphasePlaneTag]);
+                    else sweepObstacle(m_Boxes[userData & ~kBroadphaseBoxTag]);
+                });
+        }
+        else {
+            for (const auto& p : m_Planes) sweepPlane(p);
+            for (const auto& b : m_Boxes) if (b.isStaticObstacle) sweepObstacle(b);
+            m_StaticTests += m_Planes.size() + m_Boxes.size();
+        }
+
+        if (!hit) continue;
+
+        // Stop at the impact pose and bounce; the rest of the step is dropped.
+        body.SetPosition(mover.startPosition + translation * first.t);
+        if (isBox) body.SetOrientation(glm::slerp(mover.startOrientation, endOrientation, first.t));
+
+        glm::vec3 v = body.GetVelocity();
+        const float vN = glm::dot(v, first.normal);
+        if (vN < 0.0f) {
+            const float e = ContactRestitution(firstRestitution, -vN);
+            body.SetVelocity(v - (1.0f + e) * vN * first.normal);
+        }
+        ++m_CcdHits;
+    }
+}
+
+void NetworkedCollisionScenario::GatherContactConstraints_NoLock()
+{
+    // Same candidates, same order and same counters as ResolveStaticContacts_NoLock() followed
+    // by ResolveBroadphasePairs_NoLock(); only the solving is deferred.
+    const uint32_t sphereCount = static_cast<uint32_t>(m_Spheres.size());
+
+    // Inverse-mass-0 bodies are never written here (the Resolve* functions skip such sides and
+    // they get no static contacts below), so they neither link islands nor constrain colours.
+    auto solverBody = [&](uint32_t id) -> uint32_t {
+        const bool isBox = (id & kBroadphaseBoxTag) != 0;
+        const uint32_t index = id & ~kBroadphaseBoxTag;
+        const PhysicsObject& body = isBox ? m_Boxes[index].body : m_Spheres[index].body;
+        if (body.GetInverseMass() <= 0.0f) return IslandSolver::kStaticBody;
+        return isBox ? sphereCount + index : index;
+    };
+
+    auto add = [&](uint32_t body, uint32_t other, bool isStatic) {
+        m_ContactConstraints.push_back({ body, other, isStatic });
+        m_IslandSolver.AddConstraint(solverBody(body), isStatic ? IslandSolver::kStaticBody : solverBody(other));
+    };
+
+    // Box-box SAT entries are created here so the threads only look them up.
+    auto prepareSAT = [&](const BoxInstance& a, const BoxInstance& b) {
+        if (m_UseSATCache) m_SATCache.Prepare(a.body.GetWorldHandle(), b.body.GetWorldHandle());
+    };
+    // Likewise for the GJK entries of spheres against capsule/cylinder obstacles.
+    auto prepareGJK = [&](const SphereInstance& s, const BoxInstance& b) {
+        if (m_UseGJKCache && !b.body.GetColliderAs<BoxCollider>()) m_GJKCache.Prepare(s.body.GetWorldHandle(), b.body.GetWorldHandle());
+    };
+
+    m_ContactConstraints.clear();
+    m_IslandSolver.Begin(sphereCount + static_cast<uint32_t>(m_Boxes.size()));
+
+    if (m_BroadphaseMode == BroadphaseMode::AABBTree) {
+        for (uint32_t i = 0; i < sphereCount; ++i) {
+            const auto& s = m_Spheres[i];
+            if (!s.isLocallyOwned || s.sleep.asleep || s.body.GetInverseMass() <= 0.0f) continue;
+            auto* col = s.body.GetColliderAs<SphereCollider>();
+            if (!col) continue;
+
+            QueryStatic_NoLock(SimCollision::SphereBounds(col->GetCenter(), col->GetRadius()), [&](uint32_t userData)
+                {
+                    ++m_StaticTests;
+                    add(i, userData, true);
+                    if (!(userData & kBroadphasePlaneTag)) prepareGJK(s, m_Boxes[userData & ~kBroadphaseBoxTag]);
+                });
+        }
+
+        for (uint32_t i = 0; i < static_cast<uint32_t>(m_Boxes.size()); ++i) {
+            const auto& b = m_Boxes[i];
+            if (!b.isLocallyOwned || b.isStaticObstacle || b.sleep.asleep || b.body.GetInverseMass() <= 0.0f) continue;
+            auto* col = b.body.GetColliderAs<BoxCollider>();
+            if (!col) continue;
+
+            const SimCollision::OBB obb{ col->GetCenter(), col->GetOrientation(), col->GetHalfExtents() };
+            QueryStatic_NoLock(SimCollision::OBBBounds(obb), [&](uint32_t userData)
+                {
+                    ++m_StaticTests;
+                    add(i | kBroadphaseBoxTag, userData, true);
+                    if (!(userData & kBroadphasePlaneTag) && m_Boxes[userData & ~kBroadphaseBoxTag].isLocallyOwned) {
+                        prepareSAT(b, m_Boxes[userData & ~kBroadphaseBoxTag]);
+                    }
+                });
+        }
+    }
+
+    m_PairsTested = 0;
+    m_PairsColliding = 0;
+
+    auto isResting = [](const auto& instance) { return instance.sleep.asleep || instance.body.GetInverseMass() <= 0.0f; };
+
+    for (const auto& pair : m_BroadphasePairs) {
+        const bool aIsBox = (pair.a & kBroadphaseBoxTag) != 0;
+        const bool bIsBox = (pair.b & kBroadphaseBoxTag) != 0;
+        const uint32_t ia = pair.a & ~kBroadphaseBoxTag;
+        const uint32_t ib = pair.b & ~kBroadphaseBoxTag;
+
+        if (!aIsBox && !bIsBox) {
+            const auto& a = m_Spheres[ia];
+            const auto& b = m_Spheres[ib];
+            if (!a.isLocallyOwned || !b.isLocallyOwned) continue;
+            if (isResting(a) && isResting(b)) continue;
+        }
+        else if (!aIsBox) {
+            const auto& s = m_Spheres[ia];
+            if (!s.isLocallyOwned) continue;
+            if (isResting(s) && isResting(m_Boxes[ib])) continue;
+            prepareGJK(s, m_Boxes[ib]);
+        }
+        else {
+            const auto& a = m_Boxes[ia];
+            const auto& b = m_Boxes[ib];
+            if (!a.isLocallyOwned || !b.isLocallyOwned) continue;
+            if (isResting(a) && isResting(b)) continue;
+            prepareSAT(a, b);
+        }
+
+        ++m_PairsTested;
+        add(pair.a, pair.b, false);
+    }
+}
+
+bool NetworkedCollisionScenario::SolveContactConstraint(const ContactConstraint& c)
+{
+    const bool bodyIsBox = (c.body & kBroadphaseBoxTag) != 0;
+    const uint32_t index = c.body & ~kBroadphaseBoxTag;
+
+    if (c.isStatic) {
+        if (c.other & kBroadphasePlaneTag) {
+            auto* pc = m_Planes[c.other & ~kBroadphasePlaneTag].body.GetColliderAs<PlaneCollider>();
+            if (!pc) return false;
+            if (bodyIsBox) ResolveBoxPlane(m_Boxes[index], *pc);
+            else ResolveSpherePlane(m_Spheres[index], *pc);
+            return false;
+        }
+
+        auto& obstacle = m_Boxes[c.other & ~kBroadphaseBoxTag];
+        if (!bodyIsBox) ResolveSphereBox(m_Spheres[index], obstacle);
+        else if (obstacle.isLocallyOwned) ResolveBoxBox(m_Boxes[index], obstacle);
+        return false;
+    }
+
+    // Box tag is the high bit, so a sphere (if any) is always the first body
+    const uint32_t other = c.other & ~kBroadphaseBoxTag;
+    if (!bodyIsBox && !(c.other & kBroadphaseBoxTag)) return ResolveSphereSphere(m_Spheres[index], m_Spheres[other]);
+    if (!bodyIsBox) return ResolveSphereBox(m_Spheres[index], m_Boxes[other]);
+    return ResolveBoxBox(m_Boxes[index], m_Boxes[other]);
+}
+
+void NetworkedCollisionScenario::SolveContactConstraints_NoLock()
+{
+    m_IslandSolver.Build();
+    m_ContactHits.assign(m_ContactConstraints.size(), 0);
+
+    // Transforms are rebuilt lazily on read; do it up front so workers only read shared bodies.
+    // (The planes are standalone objects and were already synced by the broadphase pass.)
+    m_World.SyncTransforms();
+
+    // Each constraint writes only its own hit flag; everything shared is folded in below.
+    m_IslandSolver.Solve(m_Jobs, [&](uint32_t c) {
+        m_ContactHits[c] = SolveContactConstraint(m_ContactConstraints[c]) ? 1 : 0;
+    });
+
+    auto islandIndex = [&](uint32_t id) {
+        return (id & kBroadphaseBoxTag) ? m_Boxes[id & ~kBroadphaseBoxTag].islandIndex : m_Spheres[id].islandIndex;
+    };
+
+    for (size_t c = 0; c < m_ContactConstraints.size(); ++c) {
+        const auto& constraint = m_ContactConstraints[c];
+        if (constraint.isStatic || !m_ContactHits[c]) continue;
+        ++m_PairsColliding;
+        LinkIslands_NoLock(islandIndex(constraint.body), islandIndex(constraint.other));
+    }
+}
+
+void NetworkedCollisionScenario::AdvanceScalingProfile_NoLock(float stageMs)
+{
+    if (m_ScalingStep < 0) return;
+
+    m_ScalingAccumMs += stageMs;
+    if (++m_ScalingFrame < kScalingFrames) return;
+
+    m_ScalingResultMs[m_ScalingStep] = m_ScalingAccumMs / static_cast<float>(kScalingFrames);
+    m_ScalingAccumMs = 0.0f;
+    m_ScalingFrame = 0;
+
+    if (++m_ScalingStep < kScalingSteps) {
+        m_Jobs.SetThreadCount(static_cast<uint32_t>(kScalingThreadCounts[m_ScalingStep]));
+        return;
+    }
+
+    m_ScalingStep = -1;
+    m_Jobs.SetThreadCount(static_cast<uint32_t>(m_ScalingRestoreThreads));
 }
 
 void NetworkedCollisionScenario::ApplyRemoteSmoothing(float dt)
@@ -537,8 +1170,24 @@ void NetworkedCollisionScenario::SendOwnedStates_NoLock()
 {
     if (!m_NetworkingActive) return;
 
-    for (const auto& s : m_Spheres) {
+    // A body that fell asleep is sent once more (at rest), then only as a staggered keep-alive
+    // so a lost packet cannot leave the remote copy drifting.
+    auto sendSleeping = [this](auto& instance)
+        {
+            if (!instance.sleep.asleep) {
+                instance.sleepStateSent = false;
+                return true;
+            }
+            if (!instance.sleepStateSent || (m_NetTick + instance.id) % kSleepingResendTicks == 0) {
+                instance.sleepStateSent = true;
+                return true;
+            }
+            return false;
+        };
+
+    for (auto& s : m_Spheres) {
         if (!s.isLocallyOwned) continue;
+        if (!sendSleeping(s)) continue;
 
         SimStatePacket p{};
         p.objectId = s.id;
@@ -552,8 +1201,9 @@ void NetworkedCollisionScenario::SendOwnedStates_NoLock()
         m_TxPackets.fetch_add(1);
     }
 
-    for (const auto& b : m_Boxes) {
+    for (auto& b : m_Boxes) {
         if (!b.isLocallyOwned) continue;
+        if (!sendSleeping(b)) continue;
 
         SimStatePacket p{};
         p.objectId = b.id;
@@ -572,7 +1222,8 @@ void NetworkedCollisionScenario::SendOwnedStates_NoLock()
 
 void NetworkedCollisionScenario::ReceiveRemoteCommands_NoLock()
 {
-    if (!m_NetworkingActive) return;
+    // A replay brings its own inputs
+    if (!m_NetworkingActive || m_Replaying) return;
 
     const auto cmds = m_Network.ReceiveCommands();
     for (const auto& c : cmds) {
@@ -585,38 +1236,40 @@ void NetworkedCollisionScenario::ReceiveRemoteCommands_NoLock()
     }
 }
 
-void NetworkedCollisionScenario::ReceiveRemoteStates_NoLock(float dt)
+void NetworkedCollisionScenario::ApplyRemoteState_NoLock(const SimStatePacket& p)
 {
-    if (!m_NetworkingActive) return;
+    if (m_Recording) m_Session.Append(m_SessionTick, SessionRecording::EventType::RemoteState, p);
 
-    // Helper lambda to actually apply the packet to the objects
-    auto applyPacket = [this](const SimStatePacket& p) {
-        const uint32_t id = p.objectId;
-        const glm::vec3 pos{ p.pos[0], p.pos[1], p.pos[2] };
-        const glm::vec3 vel{ p.vel[0], p.vel[1], p.vel[2] };
-        bool applied = false;
-
-        for (auto& s : m_Spheres) {
-            if (s.id != id) continue;
-            if (s.isLocallyOwned) { applied = true; break; }
-            s.replicatedTargetPos = pos;
-            s.replicatedTargetVel = vel;
-            s.hasReplicatedState = true;
-            applied = true;
+    const uint32_t id = p.objectId;
+    const glm::vec3 pos{ p.pos[0], p.pos[1], p.pos[2] };
+    const glm::vec3 vel{ p.vel[0], p.vel[1], p.vel[2] };
+    bool applied = false;
+
+    for (auto& s : m_Spheres) {
+        if (s.id != id) continue;
+        if (s.isLocallyOwned) { applied = true; break; }
+        s.replicatedTargetPos = pos;
+        s.replicatedTargetVel = vel;
+        s.hasReplicatedState = true;
+        applied = true;
+        break;
+    }
+    if (!applied) {
+        for (auto& b : m_Boxes) {
+            if (b.id != id) continue;
+            if (b.isLocallyOwned) { applied = true; break; }
+            b.replicatedTargetPos = pos;
+            b.replicatedTargetVel = vel;
+            b.hasReplicatedState = true;
             break;
         }
-        if (!applied) {
-            for (auto& b : m_Boxes) {
-                if (b.id != id) continue;
-                if (b.isLocallyOwned) { applied = true; break; }
-                b.replicatedTargetPos = pos;
-                b.replicatedTargetVel = vel;
-                b.hasReplicatedState = true;
-                break;
-            }
-        }
-        m_RxPackets.fetch_add(1);
-        };
+    }
+    m_RxPackets.fetch_add(1);
+}
+
+void NetworkedCollisionScenario::ReceiveRemoteStates_NoLock(float dt)
+{
+    if (!m_NetworkingActive || m_Replaying) return;
 
     const bool emulate = m_EnableNetEmulation.load();
     const float baseMs = m_EmuBaseLatencyMs.load();
@@ -636,7 +1289,7 @@ void NetworkedCollisionScenario::ReceiveRemoteStates_NoLock(float dt)
             m_DelayedIncomingStates.push_back({ p, delayedMs * 0.001f });
         }
         else {
-            applyPacket(p);
+            ApplyRemoteState_NoLock(p);
         }
     }
 
@@ -645,7 +1298,7 @@ void NetworkedCollisionScenario::ReceiveRemoteStates_NoLock(float dt)
         for (auto it = m_DelayedIncomingStates.begin(); it != m_DelayedIncomingStates.end(); ) {
             it->remainingDelaySec -= dt;
             if (it->remainingDelaySec <= 0.0f) {
-                applyPacket(it->packet);
+                ApplyRemoteState_NoLock(it->packet);
                 it = m_DelayedIncomingStates.erase(it);
             }
             else {
@@ -663,70 +1316,97 @@ void NetworkedCollisionScenario::SendSpawn_NoLock(const SimSpawnPacket& p)
 
 void NetworkedCollisionScenario::ReceiveRemoteSpawns_NoLock()
 {
-    if (!m_NetworkingActive) return;
+    if (!m_NetworkingActive || m_Replaying) return;
 
     const auto spawns = m_Network.ReceiveSpawns();
     for (const auto& p : spawns) {
-        const uint32_t id = p.objectId;
-
-        // already exists?
-        bool exists = false;
-        for (const auto& s : m_Spheres) if (s.id == id) { exists = true; break; }
-        if (!exists) for (const auto& b : m_Boxes) if (b.id == id) { exists = true; break; }
-        if (exists) continue;
-
-        const auto owner = static_cast<SimRuntime::OwnerType>(p.owner);
-        const auto shape = static_cast<SimRuntime::SpawnerShapeType>(p.shape);
-
-        if (shape == SimRuntime::SpawnerShapeType::Sphere) {
-            SphereInstance s{};
-            s.id = id;
-            s.owner = owner;
-            s.isLocallyOwned = (m_LocalPeerOwner == owner);
-            s.color = { 1.0f, 0.55f, 0.25f };
-
-            const float r = std::max(0.05f, p.radius);
-            const float mass = std::max(0.0f, p.mass);
-
-            s.body.SetCollider(std::make_unique<SphereCollider>(r));
-            s.body.SetPosition({ p.pos[0], p.pos[1], p.pos[2] });
-            s.body.SetVelocity({ p.vel[0], p.vel[1], p.vel[2] });
-            s.body.SetRadius(r);
-            s.body.SetMass(mass);
-            s.body.SetRestitution(m_BounceRestitution);
-
-            s.mesh = MeshGenerator::GenerateSphere(r, 32, 16, s.color);
-            s.buffers = m_App->UploadMesh(s.mesh);
-            m_Spheres.push_back(std::move(s));
-        }
-        else {
-            BoxInstance b{};
-            b.id = id;
-            b.owner = owner;
-            b.isLocallyOwned = (m_LocalPeerOwner == owner);
-            b.color = { 0.25f, 0.85f, 0.55f };
-
-            const glm::vec3 he = glm::max(glm::vec3(0.05f), glm::vec3(p.size[0], p.size[1], p.size[2]) * 0.5f);
-            const float mass = std::max(0.0f, p.mass);
-
-            b.halfExtents = he;
-            b.body.SetCollider(std::make_unique<BoxCollider>(b.halfExtents));
-            b.body.SetPosition({ p.pos[0], p.pos[1], p.pos[2] });
-            b.body.SetOrientation(glm::quat(glm::vec3(0, 0, 0)));
-            b.body.SetVelocity({ p.vel[0], p.vel[1], p.vel[2] });
-            b.body.SetMass(mass);
-            b.body.SetRestitution(m_BounceRestitution);
-
-            b.mesh = BuildCuboidMesh(b.halfExtents, b.color);
-            b.buffers = m_App->UploadMesh(b.mesh);
-            m_Boxes.push_back(std::move(b));
-        }
+        ApplyRemoteSpawn_NoLock(p);
+    }
+}
+
+void NetworkedCollisionScenario::ApplyRemoteSpawn_NoLock(const SimSpawnPacket& p)
+{
+    if (m_Recording) m_Session.Append(m_SessionTick, SessionRecording::EventType::RemoteSpawn, p);
+
+    const uint32_t id = p.objectId;
+
+    // already exists?
+    bool exists = false;
+    for (const auto& s : m_Spheres) if (s.id == id) { exists = true; break; }
+    if (!exists) for (const auto& b : m_Boxes) if (b.id == id) { exists = true; break; }
+    if (exists) return;
+
+    const auto owner = static_cast<SimRuntime::OwnerType>(p.owner);
+    const auto shape = static_cast<SimRuntime::SpawnerShapeType>(p.shape);
+
+    if (shape == SimRuntime::SpawnerShapeType::Sphere) {
+        SphereInstance s{};
+        s.id = id;
+        s.owner = owner;
+        s.isLocallyOwned = (m_LocalPeerOwner == owner);
+        s.color = { 1.0f, 0.55f, 0.25f };
+
+        const float r = std::max(0.05f, p.radius);
+        const float mass = std::max(0.0f, p.mass);
+
+        s.body.AttachToWorld(m_World);
+        m_World.SetSimulated(s.body.GetWorldHandle(), s.isLocallyOwned);
+        s.body.SetCollider(SphereCollider(r));
+        s.body.SetPosition({ p.pos[0], p.pos[1], p.pos[2] });
+        s.body.SetVelocity({ p.vel[0], p.vel[1], p.vel[2] });
+        s.body.SetRadius(r);
+        s.body.SetMass(mass);
+        s.body.SetRestitution(m_BounceRestitution);
+
+        s.mesh = MeshGenerator::GenerateSphere(r, 32, 16, s.color);
+        s.buffers = m_App->UploadMesh(s.mesh);
+        m_Spheres.push_back(std::move(s));
+    }
+    else {
+        BoxInstance b{};
+        b.id = id;
+        b.owner = owner;
+        b.isLocallyOwned = (m_LocalPeerOwner == owner);
+        b.color = { 0.25f, 0.85f, 0.55f };
+
+        const glm::vec3 he = glm::max(glm::vec3(0.05f), glm::vec3(p.size[0], p.size[1], p.size[2]) * 0.5f);
+        const float mass = std::max(0.0f, p.mass);
+
+        b.halfExtents = he;
+        b.body.AttachToWorld(m_World);
+        m_World.SetSimulated(b.body.GetWorldHandle(), b.isLocallyOwned);
+        b.body.SetCollider(BoxCollider(b.halfExtents));
+        b.body.SetPosition({ p.pos[0], p.pos[1], p.pos[2] });
+        b.body.SetOrientation(glm::quat(glm::vec3(0, 0, 0)));
+        b.body.SetVelocity({ p.vel[0], p.vel[1], p.vel[2] });
+        b.body.SetMass(mass);
+        b.body.SetRestitution(m_BounceRestitution);
+
+        b.mesh = BuildCuboidMesh(b.halfExtents, b.color);
+        b.buffers = m_App->UploadMesh(b.mesh);
+        m_Boxes.push_back(std::move(b));
+    }
+}
+
+void NetworkedCollisionScenario::RefreshOwnership_NoLock()
+{
+    // Ownership changes start everyone awake again
+    for (auto& s : m_Spheres) {
+        s.isLocallyOwned = (m_LocalPeerOwner == s.owner);
+        s.sleep = {};
+        m_World.SetSimulated(s.body.GetWorldHandle(), s.isLocallyOwned);
+    }
+    for (auto& b : m_Boxes) {
+        b.isLocallyOwned = (m_LocalPeerOwner == b.owner);
+        b.sleep = {};
+        m_World.SetSimulated(b.body.GetWorldHandle(), b.isLocallyOwned);
     }
 }
 
 void NetworkedCollisionScenario::EnforceMinimumSpeed_NoLock()
 {
-    if (m_MinDynamicSpeed <= 0.0f) return;
+    // The clamp exists to stop bodies settling, which is exactly what sleeping needs.
+    if (m_MinDynamicSpeed <= 0.0f || m_Islands.GetSettings().enabled) return;
 
     auto enforce = [&](PhysicsObject& body)
     {
@@ -748,6 +1428,63 @@ void NetworkedCollisionScenario::EnforceMinimumSpeed_NoLock()
     for (auto& b : m_Boxes)   if (b.isLocallyOwned) enforce(b.body);
 }
 
+float NetworkedCollisionScenario::ContactRestitution(float restitution, float approachSpeed) const
+{
+    return (m_UseBounce && approachSpeed > m_BounceThreshold) ? restitution : 0.0f;
+}
+
+void NetworkedCollisionScenario::BeginIslands_NoLock()
+{
+    // Only bodies this peer simulates take part; remote replicas and static obstacles never sleep.
+    m_IslandMembers.clear();
+    for (uint32_t i = 0; i < static_cast<uint32_t>(m_Spheres.size()); ++i) {
+        auto& s = m_Spheres[i];
+        const bool member = s.isLocallyOwned && s.body.GetInverseMass() > 0.0f;
+        s.islandIndex = member ? static_cast<uint32_t>(m_IslandMembers.size()) : kNotInIsland;
+        if (member) m_IslandMembers.push_back(i);
+    }
+    for (uint32_t i = 0; i < static_cast<uint32_t>(m_Boxes.size()); ++i) {
+        auto& b = m_Boxes[i];
+        const bool member = b.isLocallyOwned && !b.isStaticObstacle && b.body.GetInverseMass() > 0.0f;
+        b.islandIndex = member ? static_cast<uint32_t>(m_IslandMembers.size()) : kNotInIsland;
+        if (member) m_IslandMembers.push_back(i | kBroadphaseBoxTag);
+    }
+
+    m_Islands.Begin(m_IslandMembers.size());
+}
+
+void NetworkedCollisionScenario::LinkIslands_NoLock(uint32_t a, uint32_t b)
+{
+    if (a != kNotInIsland && b != kNotInIsland) m_Islands.AddContact(a, b);
+}
+
+void NetworkedCollisionScenario::UpdateSleeping_NoLock(float dt)
+{
+    auto bodyAt = [&](uint32_t member) -> PhysicsObject& {
+        return (member & kBroadphaseBoxTag) ? m_Boxes[member & ~kBroadphaseBoxTag].body : m_Spheres[member].body;
+    };
+    auto stateAt = [&](uint32_t member) -> SleepState& {
+        return (member & kBroadphaseBoxTag) ? m_Boxes[member & ~kBroadphaseBoxTag].sleep : m_Spheres[member].sleep;
+    };
+
+    for (uint32_t i = 0; i < static_cast<uint32_t>(m_IslandMembers.size()); ++i) {
+        const PhysicsObject& body = bodyAt(m_IslandMembers[i]);
+        m_Islands.SetBody(i, &stateAt(m_IslandMembers[i]), body.GetVelocity(), body.GetAngularVelocity());
+    }
+
+    m_Islands.Update(dt);
+
+    for (const uint32_t i : m_Islands.GetFellAsleep()) {
+        PhysicsObject& body = bodyAt(m_IslandMembers[i]);
+        body.SetVelocity(glm::vec3(0.0f));
+        body.SetAngularVelocity(glm::vec3(0.0f));
+        m_World.SetSimulated(body.GetWorldHandle(), false);
+    }
+    for (const uint32_t i : m_Islands.GetWokenUp()) {
+        m_World.SetSimulated(bodyAt(m_IslandMembers[i]).GetWorldHandle(), true);
+    }
+}
+
 void NetworkedCollisionScenario::SpawnSphereFromUI_NoLock()
 {
     if (m_Preset != DemoPreset::Arena_ManyObjects_Spawners) return;
@@ -782,6 +1519,7 @@ void NetworkedCollisionScenario::SpawnSphereFromUI_NoLock()
     p.mass = mass;
     p.tick = m_NetTick;
 
+    if (m_Recording) m_Session.Append(m_SessionTick, SessionRecording::EventType::LocalSpawn, p);
     SendSpawn_NoLock(p);
 }
 
@@ -817,9 +1555,26 @@ void NetworkedCollisionScenario::SpawnBoxFromUI_NoLock()
     p.mass = mass;
     p.tick = m_NetTick;
 
+    if (m_Recording) m_Session.Append(m_SessionTick, SessionRecording::EventType::LocalSpawn, p);
     SendSpawn_NoLock(p);
 }
 
+// Replays a UI spawn from its packet; the random spread was already applied when it was recorded.
+void NetworkedCollisionScenario::ApplyLocalSpawn_NoLock(const SimSpawnPacket& p)
+{
+    const glm::vec3 pos{ p.pos[0], p.pos[1], p.pos[2] };
+    const glm::vec3 vel{ p.vel[0], p.vel[1], p.vel[2] };
+    const auto owner = static_cast<SimRuntime::OwnerType>(p.owner);
+
+    if (static_cast<SimRuntime::SpawnerShapeType>(p.shape) == SimRuntime::SpawnerShapeType::Sphere) {
+        AddSphere(pos, vel, p.radius, p.mass, { 1.0f, 0.65f, 0.25f }, owner);
+    }
+    else {
+        const glm::vec3 he = glm::vec3(p.size[0], p.size[1], p.size[2]) * 0.5f;
+        AddBox(pos, glm::quat(glm::vec3(0, 0, 0)), he, vel, p.mass, { 0.25f, 0.85f, 0.55f }, owner);
+    }
+}
+
 void NetworkedCollisionScenario::StartNetworkWorker()
 {
     if (m_RunNetworkThread.exchange(true)) return;
@@ -894,9 +1649,429 @@ void NetworkedCollisionScenario::SendReset()
     m_Network.SendCommand(c);
 }
 
+NetworkedCollisionScenario::SessionSettings NetworkedCollisionScenario::CaptureSessionSettings_NoLock() const
+{
+    SessionSettings s;
+    s.gravity = m_Gravity;
+    s.bounceRestitution = m_BounceRestitution;
+    s.bounceThreshold = m_BounceThreshold;
+    s.minDynamicSpeed = m_MinDynamicSpeed;
+    s.ccdSpeedThreshold = m_CcdSpeedThreshold;
+    s.remoteInterpRate = m_RemoteInterpRate;
+    s.remoteSnapDistance = m_RemoteSnapDistance;
+    s.sleepLinearThreshold = m_Islands.GetSettings().linearThreshold;
+    s.sleepAngularThreshold = m_Islands.GetSettings().angularThreshold;
+    s.timeToSleep = m_Islands.GetSettings().timeToSleep;
+    s.colourMinConstraints = m_IslandSolver.GetSettings().colourMinConstraints;
+    s.integrationMethod = static_cast<uint8_t>(m_App->GetIntegrationMethod());
+    s.simdLevel = static_cast<uint8_t>(m_World.GetSimdLevel());
+    s.broadphaseMode = static_cast<uint8_t>(m_BroadphaseMode);
+    s.localPeer = static_cast<uint8_t>(m_LocalPeerOwner);
+    s.simOwner = static_cast<uint8_t>(m_SimOwner);
+    s.useBounce = m_UseBounce;
+    s.useCCD = m_UseCCD;
+    s.sleeping = m_Islands.GetSettings().enabled;
+    s.colouring = m_IslandSolver.GetSettings().colouring;
+    s.useIslandSolve = m_UseIslandSolve;
+    s.useStaticGrid = m_UseStaticGrid;
+    s.useSATCache = m_UseSATCache;
+    s.useGJKCache = m_UseGJKCache;
+    return s;
+}
+
+void NetworkedCollisionScenario::ApplySessionSettings_NoLock(const SessionSettings& s)
+{
+    m_Gravity = s.gravity;
+    m_BounceRestitution = s.bounceRestitution;
+    m_BounceThreshold = s.bounceThreshold;
+    m_MinDynamicSpeed = s.minDynamicSpeed;
+    m_CcdSpeedThreshold = s.ccdSpeedThreshold;
+    m_RemoteInterpRate = s.remoteInterpRate;
+    m_RemoteSnapDistance = s.remoteSnapDistance;
+    m_Islands.GetSettings().linearThreshold = s.sleepLinearThreshold;
+    m_Islands.GetSettings().angularThreshold = s.sleepAngularThreshold;
+    m_Islands.GetSettings().timeToSleep = s.timeToSleep;
+    m_Islands.GetSettings().enabled = s.sleeping;
+    m_IslandSolver.GetSettings().colourMinConstraints = s.colourMinConstraints;
+    m_IslandSolver.GetSettings().colouring = s.colouring;
+    m_App->SetIntegrationMethod(static_cast<IntegrationMethod>(s.integrationMethod));
+    m_UseBounce = s.useBounce;
+    m_UseCCD = s.useCCD;
+    m_UseIslandSolve = s.useIslandSolve;
+    m_UseStaticGrid = s.useStaticGrid;
+    m_UseSATCache = s.useSATCache;
+    m_UseGJKCache = s.useGJKCache;
+    m_SimOwner = static_cast<SimRuntime::OwnerType>(s.simOwner);
+
+    // A CPU without the recorded batch width runs the best it has; results may then differ
+    const int simdLevel = std::min<int>(s.simdLevel, static_cast<int>(SimSimd::GetBestSimdLevel()));
+    m_World.SetSimdLevel(static_cast<SimSimd::SimdLevel>(simdLevel));
+
+    // Same side effects as the UI controls
+    for (auto& sphere : m_Spheres) sphere.body.SetRestitution(m_BounceRestitution);
+    for (auto& box : m_Boxes) box.body.SetRestitution(m_BounceRestitution);
+    if (static_cast<uint8_t>(m_BroadphaseMode) != s.broadphaseMode) {
+        m_BroadphaseMode = static_cast<BroadphaseMode>(s.broadphaseMode);
+        ResetBroadphase_NoLock();
+    }
+    if (static_cast<uint8_t>(m_LocalPeerOwner) != s.localPeer) {
+        m_LocalPeerOwner = static_cast<SimRuntime::OwnerType>(s.localPeer);
+        RefreshOwnership_NoLock();
+    }
+}
+
+// FNV-1a over the bit patterns of every body's state: any difference in any bit shows up.
+uint64_t NetworkedCollisionScenario::SessionChecksum_NoLock() const
+{
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const void* data, size_t size)
+        {
+            const auto* bytes = static_cast<const uint8_t*>(data);
+            for (size_t i = 0; i < size; ++i) {
+                hash ^= bytes[i];
+                hash *= 1099511628211ull;
+            }
+        };
+    auto mixBody = [&mix](uint32_t id, const PhysicsObject& body)
+        {
+            const glm::vec3 position = body.GetPosition();
+            const glm::vec3 velocity = body.GetVelocity();
+            const glm::quat orientation = body.GetOrientation();
+            const glm::vec3 angularVelocity = body.GetAngularVelocity();
+            mix(&id, sizeof(id));
+            mix(&position, sizeof(position));
+            mix(&velocity, sizeof(velocity));
+            mix(&orientation, sizeof(orientation));
+            mix(&angularVelocity, sizeof(angularVelocity));
+        };
+
+    for (const auto& s : m_Spheres) mixBody(s.id, s.body);
+    for (const auto& b : m_Boxes) mixBody(b.id, b.body);
+    return hash;
+}
+
+void NetworkedCollisionScenario::StartRecording_NoLock()
+{
+    if (m_Replaying) return;
+
+    m_Session.Clear();
+    m_Recording = true;
+    m_SessionTick = 0;
+    m_SessionTimeStep = 0.0f;
+    m_SessionStatus.clear();
+
+    // The session starts from a freshly built preset, logged as its first event
+    SetupPreset(m_Preset);
+}
+
+void NetworkedCollisionScenario::StopRecording_NoLock()
+{
+    if (!m_Recording) return;
+    m_Recording = false;
+
+    if (m_SessionTick % kSessionChecksumTicks != 0) {
+        m_Session.Append(m_SessionTick, SessionRecording::EventType::Checksum, SessionChecksum_NoLock());
+    }
+
+    if (m_Session.Save(m_SessionPath, m_SessionTick)) {
+        m_SessionStatus = "Saved " + std::to_string(m_SessionTick) + " ticks, " + std::to_string(m_Session.GetEventCount())
+            + " events (" + std::to_string(m_Session.GetByteSize()) + " bytes) to " + m_SessionPath;
+    }
+    else {
+        m_SessionStatus = std::string("Could not write ") + m_SessionPath;
+    }
+    m_Session.Clear();
+}
+
+void NetworkedCollisionScenario::RecordSettings_NoLock()
+{
+    const SessionSettings settings = CaptureSessionSettings_NoLock();
+    if (settings == m_SessionSettings) return;
+
+    m_SessionSettings = settings;
+    m_Session.Append(m_SessionTick, SessionRecording::EventType::Settings, settings);
+}
+
+void NetworkedCollisionScenario::RecordUpdate_NoLock(float dt)
+{
+    RecordSettings_NoLock();
+    if (dt != m_SessionTimeStep) {
+        m_SessionTimeStep = dt;
+        m_Session.Append(m_SessionTick, SessionRecording::EventType::TimeStep, dt);
+    }
+}
+
+bool NetworkedCollisionScenario::StartReplay_NoLock(const std::string& path, std::string& error)
+{
+    if (m_Recording) {
+        error = "stop recording before replaying";
+        return false;
+    }
+    if (!m_Session.Load(path, error)) return false;
+
+    SessionRecording::Event first;
+    if (!m_Session.Peek(first) || first.tick != 0 || first.type != SessionRecording::EventType::Preset) {
+        m_Session.Clear();
+        error = "'" + path + "' does not start with a preset";
+        return false;
+    }
+
+    m_Replaying = true;
+    m_SessionTick = 0;
+    m_SessionTimeStep = 0.0f;
+    m_ReplayChecksums = 0;
+    m_ReplayDivergedTick = -1;
+    m_SessionStatus = "Replaying " + path;
+    return true;
+}
+
+bool NetworkedCollisionScenario::StartReplay(const std::string& path, std::string& error)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return StartReplay_NoLock(path, error);
+}
+
+bool NetworkedCollisionScenario::IsReplaying() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Replaying;
+}
+
+float NetworkedCollisionScenario::ReplayUpdate_NoLock(float dt)
+{
+    using EventType = SessionRecording::EventType;
+
+    SessionRecording::Event event;
+    while (m_Session.Peek(event) && event.tick <= m_SessionTick) {
+        switch (event.type) {
+        case EventType::Preset:
+        {
+            SessionPreset preset;
+            if (SessionRecording::ReadPayload(event, preset)) {
+                m_SessionSettings = preset.settings;
+                ApplySessionSettings_NoLock(preset.settings);
+                SetupPreset(static_cast<DemoPreset>(std::clamp(preset.preset, 0, 5)));
+            }
+            break;
+        }
+        case EventType::Settings:
+        {
+            SessionSettings settings;
+            if (SessionRecording::ReadPayload(event, settings)) {
+                m_SessionSettings = settings;
+                ApplySessionSettings_NoLock(settings);
+            }
+            break;
+        }
+        case EventType::TimeStep:
+            SessionRecording::ReadPayload(event, m_SessionTimeStep);
+            break;
+        case EventType::RemoteState:
+        {
+            SimStatePacket packet;
+            if (SessionRecording::ReadPayload(event, packet)) ApplyRemoteState_NoLock(packet);
+            break;
+        }
+        case EventType::RemoteSpawn:
+        case EventType::LocalSpawn:
+        {
+            SimSpawnPacket packet;
+            if (!SessionRecording::ReadPayload(event, packet)) break;
+            if (event.type == EventType::RemoteSpawn) ApplyRemoteSpawn_NoLock(packet);
+            else ApplyLocalSpawn_NoLock(packet);
+            break;
+        }
+        default:
+            break;
+        }
+        m_Session.Pop();
+    }
+
+    // Controls outside this scenario's window (the main menu's integrator) stay live during a
+    // replay; put back anything changed since the last recorded settings
+    if (CaptureSessionSettings_NoLock() != m_SessionSettings) ApplySessionSettings_NoLock(m_SessionSettings);
+
+    return m_SessionTimeStep > 0.0f ? m_SessionTimeStep : dt;
+}
+
+void NetworkedCollisionScenario::EndSessionUpdate_NoLock()
+{
+    ++m_SessionTick;
+
+    if (m_Recording) {
+        if (m_SessionTick % kSessionChecksumTicks == 0) {
+            m_Session.Append(m_SessionTick, SessionRecording::EventType::Checksum, SessionChecksum_NoLock());
+        }
+        return;
+    }
+
+    // Checksums taken after this update are compared now, before the next update's inputs
+    SessionRecording::Event event;
+    while (m_Session.Peek(event) && event.tick <= m_SessionTick && event.type == SessionRecording::EventType::Checksum) {
+        uint64_t expected = 0;
+        if (SessionRecording::ReadPayload(event, expected)) {
+            ++m_ReplayChecksums;
+            if (expected != SessionChecksum_NoLock() && m_ReplayDivergedTick < 0) {
+                m_ReplayDivergedTick = m_SessionTick;
+                std::cerr << "[Replay] State diverged from the recording by tick " << m_SessionTick << std::endl;
+            }
+        }
+        m_Session.Pop();
+    }
+
+    if (m_SessionTick >= m_Session.GetTickCount()) {
+        m_Replaying = false;
+        m_SessionStatus = "Replayed " + std::to_string(m_SessionTick) + " ticks, " + std::to_string(m_ReplayChecksums) + " checksums: "
+            + (m_ReplayDivergedTick < 0 ? "bit-exact" : "diverged by tick " + std::to_string(m_ReplayDivergedTick));
+        m_Session.Clear();
+    }
+}
+
+void NetworkedCollisionScenario::SaveSnapshot_NoLock(WorldSnapshot& out) const
+{
+    out.Write(kSnapshotTag);
+    out.Write(m_SceneGeneration);
+    out.Write(m_SimTick);
+    out.Write(m_NextObjectId);
+    out.Write(m_Rng);
+    out.Write(static_cast<uint32_t>(m_Spheres.size()));
+    out.Write(static_cast<uint32_t>(m_Boxes.size()));
+
+    auto writeBody = [&out](const auto& instance)
+        {
+            SnapshotBody body;
+            body.id = instance.id;
+            body.owner = instance.owner;
+            body.isLocallyOwned = instance.isLocallyOwned;
+            body.sleepStateSent = instance.sleepStateSent;
+            body.hasReplicatedState = instance.hasReplicatedState;
+            body.sleep = instance.sleep;
+            body.replicatedTargetPos = instance.replicatedTargetPos;
+            body.replicatedTargetVel = instance.replicatedTargetVel;
+            out.Write(body);
+        };
+    for (const auto& s : m_Spheres) writeBody(s);
+    for (const auto& b : m_Boxes) writeBody(b);
+
+    m_World.SaveState(out);
+}
+
+bool NetworkedCollisionScenario::RestoreSnapshot_NoLock(const WorldSnapshot& snapshot, std::string& error)
+{
+    if (m_Recording || m_Replaying) {
+        error = "not while a session is being recorded or replayed";
+        return false;
+    }
+
+    WorldSnapshot::Reader in(snapshot);
+    uint32_t tag = 0, generation = 0, simTick = 0, nextObjectId = 0, sphereCount = 0, boxCount = 0;
+    std::mt19937 rng;
+    if (!in.Read(tag) || tag != kSnapshotTag) {
+        error = "not a snapshot of this scenario";
+        return false;
+    }
+    if (!in.Read(generation) || !in.Read(simTick) || !in.Read(nextObjectId) || !in.Read(rng)
+        || !in.Read(sphereCount) || !in.Read(boxCount)) {
+        error = "snapshot is truncated";
+        return false;
+    }
+    if (generation != m_SceneGeneration) {
+        error = "the scene was rebuilt after this snapshot";
+        return false;
+    }
+
+    // Bodies are only ever appended within one scene, so the snapshot's must be a prefix of ours
+    if (sphereCount > m_Spheres.size() || boxCount > m_Boxes.size()) {
+        error = "snapshot has bodies this scene does not";
+        return false;
+    }
+    m_SnapshotBodies.resize(sphereCount + boxCount);
+    if (!in.ReadArray(m_SnapshotBodies.data(), m_SnapshotBodies.size())) {
+        error = "snapshot is truncated";
+        return false;
+    }
+    for (uint32_t i = 0; i < sphereCount + boxCount; ++i) {
+        const uint32_t id = i < sphereCount ? m_Spheres[i].id : m_Boxes[i - sphereCount].id;
+        if (id != m_SnapshotBodies[i].id) {
+            error = "snapshot bodies do not match the scene";
+            return false;
+        }
+    }
+
+    // Drop what was spawned after the snapshot; the broadphase is rebuilt from what is left
+    if (m_Spheres.size() > sphereCount || m_Boxes.size() > boxCount) {
+        for (size_t i = sphereCount; i < m_Spheres.size(); ++i) m_App->DestroyMeshBuffers(m_Spheres[i].buffers);
+        for (size_t i = boxCount; i < m_Boxes.size(); ++i) m_App->DestroyMeshBuffers(m_Boxes[i].buffers);
+        m_Spheres.erase(m_Spheres.begin() + sphereCount, m_Spheres.end());
+        m_Boxes.erase(m_Boxes.begin() + boxCount, m_Boxes.end());
+        ResetBroadphase_NoLock();
+    }
+
+    if (!m_World.RestoreState(in)) {
+        error = "snapshot body state does not match the world";
+        return false;
+    }
+
+    auto readBody = [](auto& instance, const SnapshotBody& body)
+        {
+            instance.owner = body.owner;
+            instance.isLocallyOwned = body.isLocallyOwned;
+            instance.sleepStateSent = body.sleepStateSent;
+            instance.hasReplicatedState = body.hasReplicatedState;
+            instance.sleep = body.sleep;
+            instance.replicatedTargetPos = body.replicatedTargetPos;
+            instance.replicatedTargetVel = body.replicatedTargetVel;
+        };
+    for (uint32_t i = 0; i < sphereCount; ++i) readBody(m_Spheres[i], m_SnapshotBodies[i]);
+    for (uint32_t i = 0; i < boxCount; ++i) readBody(m_Boxes[i], m_SnapshotBodies[sphereCount + i]);
+
+    m_SimTick = simTick;
+    m_NextObjectId = nextObjectId;
+    m_Rng = rng;
+
+    // Warm-start caches hold contacts from the abandoned future
+    m_SATCache.Clear();
+    m_GJKCache.Clear();
+    return true;
+}
+
+bool NetworkedCollisionScenario::Rollback_NoLock(uint32_t ticks, std::string& error)
+{
+    const uint32_t target = m_SimTick > ticks ? m_SimTick - ticks : 0;
+    const WorldSnapshot* snapshot = m_Snapshots.FindAtOrBefore(target);
+    if (!snapshot) {
+        error = "no snapshot " + std::to_string(ticks) + " ticks back";
+        return false;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    if (!RestoreSnapshot_NoLock(*snapshot, error)) return false;
+    m_LastSnapshotRestoreUs = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    m_Snapshots.DiscardAfter(m_SimTick);
+    return true;
+}
+
+bool NetworkedCollisionScenario::SaveSnapshot(WorldSnapshot& out)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    out.Clear();
+    out.SetTick(m_SimTick);
+    SaveSnapshot_NoLock(out);
+    return true;
+}
+
+bool NetworkedCollisionScenario::RestoreSnapshot(const WorldSnapshot& snapshot, std::string& error)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return RestoreSnapshot_NoLock(snapshot, error);
+}
+
 void NetworkedCollisionScenario::OnLoad()
 {
     std::lock_guard<std::mutex> lock(m_Mutex);
+    m_SolverThreads = static_cast<int>(std::clamp(std::thread::hardware_concurrency(), 1u, 16u));
+    m_Jobs.SetThreadCount(static_cast<uint32_t>(m_SolverThreads));
     SetupPreset(m_Preset);
     StartNetworkWorker();
 }
@@ -911,7 +2086,12 @@ void NetworkedCollisionScenario::OnUnload()
     }
 
     std::lock_guard<std::mutex> lock(m_Mutex);
+    StopRecording_NoLock();
+    m_Replaying = false;
+    m_Session.Clear();
     ClearScene();
+    m_ScalingStep = -1;
+    m_Jobs.SetThreadCount(1);
 }
 
 void NetworkedCollisionScenario::GetSelectionItems(std::vector<SceneSelectionItem>& out)
@@ -935,10 +2115,15 @@ void NetworkedCollisionScenario::GetSelectionItems(std::vector<SceneSelectionIte
             return proxy;
             };
 
+        // Inspector edits are not session events, so like snapshot restores they are refused
+        // while a session is recorded (the replay would diverge) or replayed (it would corrupt it)
         item.SetTransform = [this, idx](const TransformProxy& proxy) {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if (m_Recording || m_Replaying) return;
             if (idx < m_Spheres.size()) {
                 m_Spheres[idx].body.SetPosition(proxy.position);
                 m_Spheres[idx].body.SetVelocity(glm::vec3(0.0f));
+                m_Islands.WakeBody(m_Spheres[idx].sleep);
             }
             };
 
@@ -963,10 +2148,18 @@ void NetworkedCollisionScenario::GetSelectionItems(std::vector<SceneSelectionIte
             };
 
         item.SetTransform = [this, idx](const TransformProxy& proxy) {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if (m_Recording || m_Replaying) return;
             if (idx < m_Boxes.size()) {
                 m_Boxes[idx].body.SetPosition(proxy.position);
                 m_Boxes[idx].body.SetVelocity(glm::vec3(0.0f));
                 m_Boxes[idx].body.SetOrientation(glm::quat(glm::radians(proxy.rotationDeg)));
+                m_Islands.WakeBody(m_Boxes[idx].sleep);
+                // Obstacle tree and grid are only rebuilt when dirty; refit them to the new pose
+                if (m_Boxes[idx].isStaticObstacle) {
+                    m_StaticTreeDirty = true;
+                    m_StaticWorldDirty = true;
+                }
             }
             };
 
@@ -977,63 +2170,146 @@ void NetworkedCollisionScenario::GetSelectionItems(std::vector<SceneSelectionIte
 void NetworkedCollisionScenario::OnUpdate(float deltaTime)
 {
     std::lock_guard<std::mutex> lock(m_Mutex);
+    m_PhaseTimer.Begin();
 
-    const auto method = m_App->GetIntegrationMethod();
+    // Inputs for this update: logged when recording, fed from the file when replaying
+    if (m_Replaying) deltaTime = ReplayUpdate_NoLock(deltaTime);
+    else if (m_Recording) RecordUpdate_NoLock(deltaTime);
+    if (m_Replaying || m_Recording) m_PhaseTimer.Mark("session inputs");
 
-    // Integrate only locally-owned dynamic bodies
-    for (auto& s : m_Spheres) {
-        if (!s.isLocallyOwned) continue;
-        s.body.Update(deltaTime, m_Gravity, method);
-    }
-    for (auto& b : m_Boxes) {
-        if (!b.isLocallyOwned) continue;
-        b.body.Update(deltaTime, m_Gravity, method);
-    }
+    const auto method = m_App->GetIntegrationMethod();
 
-    // Collisions only among locally-owned dynamic bodies (keeps authority single-source)
-    for (auto& s : m_Spheres) {
-        if (!s.isLocallyOwned) continue;
+    BeginIslands_NoLock();
+    BeginContinuous_NoLock();
 
-        for (const auto& p : m_Planes) {
-            if (auto* pc = p.body.GetColliderAs<PlaneCollider>()) ResolveSpherePlane(s, *pc);
-        }
+    // Integrate only locally-owned, awake dynamic bodies (the world skips non-simulated slots)
+    m_World.Integrate(deltaTime, m_Gravity, method);
+    m_PhaseTimer.Mark("integrate");
 
-        for (auto& box : m_Boxes) {
-            ResolveSphereBox(s, box);
+    // Collisions only among locally-owned dynamic bodies (keeps authority single-source)
+    m_StaticTests = 0;
+    if (m_StaticWorldDirty) BuildStaticWorld_NoLock();
+    ApplyContinuous_NoLock();
+    m_PhaseTimer.Mark("continuous");
+    m_SATCache.NextFrame();
+    m_GJKCache.NextFrame();
+    if (m_BroadphaseMode == BroadphaseMode::SweepAndPrune) {
+        ResolveSpherePlanesBatched_NoLock();
+
+        // box-plane if locally owned
+        for (auto& b : m_Boxes) {
+            if (!b.isLocallyOwned || b.sleep.asleep) continue;
+            auto* col = b.body.GetColliderAs<BoxCollider>();
+            if (m_UseStaticGrid && col) {
+                // Obstacles come through the SAP pairs; only the planes are taken from here
+                const SimCollision::OBB obb{ col->GetCenter(), col->GetOrientation(), col->GetHalfExtents() };
+                m_StaticWorld.Query(SimCollision::OBBBounds(obb), [&](uint32_t userData)
+                    {
+                        if (!(userData & kBroadphasePlaneTag)) return;
+                        if (auto* pc = m_Planes[userData & ~kBroadphasePlaneTag].body.GetColliderAs<PlaneCollider>()) ResolveBoxPlane(b, *pc);
+                        ++m_StaticTests;
+                    });
+                continue;
+            }
+            for (const auto& p : m_Planes) {
+                if (auto* pc = p.body.GetColliderAs<PlaneCollider>()) ResolveBoxPlane(b, *pc);
+                ++m_StaticTests;
+            }
         }
     }
 
-    // sphere-sphere if both locally owned
-    for (size_t i = 0; i < m_Spheres.size(); ++i) {
-        for (size_t j = i + 1; j < m_Spheres.size(); ++j) {
-            if (!m_Spheres[i].isLocallyOwned) continue;
-            if (!m_Spheres[j].isLocallyOwned) continue;
-            ResolveSphereSphere(m_Spheres[i], m_Spheres[j]);
-        }
-    }
+    m_PhaseTimer.Mark("static");
 
-    // box-plane if locally owned
-    for (auto& b : m_Boxes) {
-        if (!b.isLocallyOwned) continue;
-        for (const auto& p : m_Planes) {
-            if (auto* pc = p.body.GetColliderAs<PlaneCollider>()) ResolveBoxPlane(b, *pc);
-        }
-    }
+    UpdateBroadphase_NoLock(deltaTime);
+    FindBroadphasePairs_NoLock();
+    m_PhaseTimer.Mark("broadphase");
 
-    // box-box if both locally owned
-    for (size_t i = 0; i < m_Boxes.size(); ++i) {
-        for (size_t j = i + 1; j < m_Boxes.size(); ++j) {
-            if (!m_Boxes[i].isLocallyOwned) continue;
-            if (!m_Boxes[j].isLocallyOwned) continue;
-            ResolveBoxBox(m_Boxes[i], m_Boxes[j]);
+    const auto stageStart = std::chrono::steady_clock::now();
+    if (m_UseIslandSolve) {
+        // static-tree contacts and broadphase pairs, islands solved in parallel
+        GatherContactConstraints_NoLock();
+        SolveContactConstraints_NoLock();
+    }
+    else {
+        // planes + static obstacles via the static tree
+        if (m_BroadphaseMode == BroadphaseMode::AABBTree) {
+            ResolveStaticContacts_NoLock();
         }
+
+        // sphere-sphere / sphere-box / box-box via broadphase candidate pairs
+        ResolveBroadphasePairs_NoLock();
     }
+    m_LastContactStageMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - stageStart).count();
+    AdvanceScalingProfile_NoLock(m_LastContactStageMs);
+    m_PhaseTimer.Mark("contacts");
 
-    // Keep bodies moving
+    // Keep bodies moving (only while sleeping is off)
     EnforceMinimumSpeed_NoLock();
 
+    UpdateSleeping_NoLock(deltaTime);
+    m_PhaseTimer.Mark("sleep");
+
     // Smooth remote replicas
     ApplyRemoteSmoothing(deltaTime);
+    m_PhaseTimer.Mark("smoothing");
+
+    if (m_Replaying || m_Recording) EndSessionUpdate_NoLock();
+
+    ++m_SimTick;
+    if (m_CaptureSnapshots) {
+        const auto start = std::chrono::steady_clock::now();
+        SaveSnapshot_NoLock(m_Snapshots.Push(m_SimTick));
+        m_LastSnapshotSaveUs = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - start).count();
+        m_PhaseTimer.Mark("snapshot");
+    }
+}
+
+StepActivity NetworkedCollisionScenario::GetStepActivity() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    // Bodies this peer simulates: speed drives substeps, depth behind the arena planes catches
+    // bodies being driven into the floor or walls.
+    StepActivity activity;
+    activity.valid = true;
+    float maxSpeed2 = 0.0f;
+
+    // Only planes the body's bounds reach can have a positive depth. The static world is empty
+    // between a preset change and the next update, which has nothing embedded yet anyway.
+    auto planeDepth = [&](const SimCollision::AABB& bounds, auto&& supportAlong)
+    {
+        m_StaticWorld.Query(bounds, [&](uint32_t userData)
+            {
+                if (!(userData & kBroadphasePlaneTag)) return;
+                auto* pc = m_Planes[userData & ~kBroadphasePlaneTag].body.GetColliderAs<PlaneCollider>();
+                if (pc) activity.maxPenetration = std::max(activity.maxPenetration, supportAlong(*pc));
+            });
+    };
+
+    for (const auto& s : m_Spheres) {
+        if (!s.isLocallyOwned || s.sleep.asleep) continue;
+        auto* col = s.body.GetColliderAs<SphereCollider>();
+        if (!col) continue;
+
+        maxSpeed2 = std::max(maxSpeed2, glm::length2(s.body.GetVelocity()));
+        planeDepth(SimCollision::SphereBounds(col->GetCenter(), col->GetRadius()),
+            [&](const PlaneCollider& pc) { return col->GetRadius() - pc.DistanceToPoint(col->GetCenter()); });
+    }
+
+    for (const auto& b : m_Boxes) {
+        if (!b.isLocallyOwned || b.isStaticObstacle || b.sleep.asleep) continue;
+        auto* col = b.body.GetColliderAs<BoxCollider>();
+        if (!col) continue;
+
+        maxSpeed2 = std::max(maxSpeed2, glm::length2(b.body.GetVelocity()));
+        const SimCollision::OBB obb{ col->GetCenter(), col->GetOrientation(), col->GetHalfExtents() };
+        planeDepth(SimCollision::OBBBounds(obb), [&](const PlaneCollider& pc) {
+            return SimCollision::SupportDistanceAlongNormal(obb, pc.GetNormal()) - pc.DistanceToPoint(obb.center);
+        });
+    }
+
+    activity.maxSpeed = std::sqrt(maxSpeed2);
+    return activity;
 }
 
 void NetworkedCollisionScenario::OnRender(VkCommandBuffer commandBuffer)
@@ -1104,12 +2380,16 @@ void NetworkedCollisionScenario::OnImGui()
     {
         std::lock_guard<std::mutex> lock(m_Mutex);
 
+        // A replay feeds the simulation its recorded inputs; anything changed here would make it
+        // diverge (and Reset / Sim Owner / Preset would also message the peer). Recordings log
+        // these controls through RecordSettings_NoLock() and the preset/spawn events.
+        if (m_Replaying) ImGui::BeginDisabled();
+
         const char* peerNames[] = { "ONE", "TWO", "THREE", "FOUR" };
         int localPeer = static_cast<int>(m_LocalPeerOwner);
         if (ImGui::Combo("Local Peer", &localPeer, peerNames, IM_ARRAYSIZE(peerNames))) {
             m_LocalPeerOwner = static_cast<SimRuntime::OwnerType>(localPeer);
-            for (auto& s : m_Spheres) s.isLocallyOwned = (m_LocalPeerOwner == s.owner);
-            for (auto& b : m_Boxes)  b.isLocallyOwned = (m_LocalPeerOwner == b.owner);
+            RefreshOwnership_NoLock();
         }
 
         int simOwner = static_cast<int>(m_SimOwner);
@@ -1138,8 +2418,140 @@ void NetworkedCollisionScenario::OnImGui()
         ImGui::Checkbox("Owner Tint", &m_ShowOwnerTint);
         ImGui::Checkbox("Use Impulse (bounce)", &m_UseBounce);
         ImGui::SliderFloat("Restitution (e)", &m_BounceRestitution, 0.0f, 1.0f);
+        ImGui::SliderFloat("Bounce Threshold (m/s)", &m_BounceThreshold, 0.0f, 3.0f, "%.2f");
         ImGui::SliderFloat("Gravity", &m_Gravity, -30.0f, 30.0f);
+
+        {
+            auto& sleep = m_Islands.GetSettings();
+            ImGui::Checkbox("Sleeping (islands)", &sleep.enabled);
+            if (sleep.enabled) {
+                ImGui::SliderFloat("Sleep Linear Threshold", &sleep.linearThreshold, 0.0f, 1.0f, "%.3f");
+                ImGui::SliderFloat("Sleep Angular Threshold", &sleep.angularThreshold, 0.0f, 1.0f, "%.3f");
+                ImGui::SliderFloat("Time To Sleep (s)", &sleep.timeToSleep, 0.05f, 5.0f, "%.2f");
+            }
+            ImGui::Text("Simulated bodies: %zu, sleeping: %u, awake islands: %u",
+                m_Islands.GetBodyCount(), m_Islands.GetSleepingCount(), m_Islands.GetIslandCount());
+        }
+
+        if (m_Islands.GetSettings().enabled) ImGui::BeginDisabled();
         ImGui::SliderFloat("Min Dynamic Speed", &m_MinDynamicSpeed, 0.0f, 10.0f, "%.2f");
+        if (m_Islands.GetSettings().enabled) ImGui::EndDisabled();
+
+        ImGui::Checkbox("Continuous Collision (fast bodies)", &m_UseCCD);
+        if (m_UseCCD) {
+            ImGui::SliderFloat("CCD Speed Threshold (m/s)", &m_CcdSpeedThreshold, 0.0f, 30.0f, "%.1f");
+            ImGui::Text("CCD: %zu fast bodies swept, %u stopped at impact", m_ContinuousMovers.size(), m_CcdHits);
+        }
+
+        {
+            const char* simdLevels[] = { "Scalar", "SSE2 (4-wide)", "AVX2 (8-wide)" };
+            const int maxLevel = static_cast<int>(SimSimd::GetBestSimdLevel());
+            int simdLevel = static_cast<int>(m_World.GetSimdLevel());
+            if (ImGui::Combo("Batch Integrator", &simdLevel, simdLevels, maxLevel + 1)) {
+                m_World.SetSimdLevel(static_cast<SimSimd::SimdLevel>(std::clamp(simdLevel, 0, maxLevel)));
+            }
+            ImGui::Text("CPU best: %s", SimSimd::GetSimdLevelName(SimSimd::GetBestSimdLevel()));
+        }
+
+        {
+            const char* broadphaseModes[] = { "Sweep and Prune", "AABB Tree" };
+            int mode = static_cast<int>(m_BroadphaseMode);
+            if (ImGui::Combo("Broadphase", &mode, broadphaseModes, IM_ARRAYSIZE(broadphaseModes))) {
+                m_BroadphaseMode = static_cast<BroadphaseMode>(std::clamp(mode, 0, IM_ARRAYSIZE(broadphaseModes) - 1));
+                ResetBroadphase_NoLock();
+            }
+
+            const size_t n = m_Spheres.size() + m_Boxes.size();
+            const uint64_t allPairs = n > 1 ? static_cast<uint64_t>(n) * (n - 1) / 2 : 0;
+            if (m_BroadphaseMode == BroadphaseMode::SweepAndPrune) {
+                ImGui::Text("SAP axis %c: %zu proxies, insertion sort swaps: %llu", "XYZ"[m_Broadphase.GetSweepAxis()],
+                    m_Broadphase.GetProxyCount(), static_cast<unsigned long long>(m_Broadphase.GetLastSwapCount()));
+            }
+            else {
+                ImGui::Text("Dynamic tree: %zu proxies, height %d, reinserts: %u", m_DynamicTree.GetProxyCount(),
+                    m_DynamicTree.GetHeight(), m_DynamicTree.GetLastReinsertCount());
+                ImGui::Text("Static tree: %zu proxies", m_StaticTree.GetProxyCount());
+            }
+            ImGui::Checkbox("Static World Grid (plane arrays + obstacle grid)", &m_UseStaticGrid);
+            const glm::ivec3 dims = m_StaticWorld.GetGridDimensions();
+            ImGui::Text("Static world: %zu planes, %zu obstacles in %dx%dx%d cells of %.2f m",
+                m_StaticWorld.GetPlaneCount(), m_StaticWorld.GetShapeCount(), dims.x, dims.y, dims.z, m_StaticWorld.GetCellSize());
+            ImGui::Text("Pairs tested: %llu / %llu (colliding: %llu)",
+                static_cast<unsigned long long>(m_PairsTested),
+                static_cast<unsigned long long>(allPairs),
+                static_cast<unsigned long long>(m_PairsColliding));
+            ImGui::Text("Static (plane/obstacle) tests: %llu", static_cast<unsigned long long>(m_StaticTests));
+
+            ImGui::Checkbox("SAT Axis Cache (box-box)", &m_UseSATCache);
+            const uint64_t lookups = m_SATCache.GetLastLookups();
+            const float pct = lookups > 0 ? 100.0f / static_cast<float>(lookups) : 0.0f;
+            ImGui::Text("SAT cache: %llu tests, %.1f%% cached axis, %.1f%% early-out (%zu pairs)",
+                static_cast<unsigned long long>(lookups),
+                static_cast<float>(m_SATCache.GetLastCacheHits()) * pct,
+                static_cast<float>(m_SATCache.GetLastEarlyOuts()) * pct,
+                m_SATCache.GetEntryCount());
+
+            ImGui::Checkbox("GJK Simplex Cache (sphere-capsule/cylinder)", &m_UseGJKCache);
+            const uint64_t gjkLookups = m_GJKCache.GetLastLookups();
+            const float gjkScale = gjkLookups > 0 ? 1.0f / static_cast<float>(gjkLookups) : 0.0f;
+            ImGui::Text("GJK cache: %llu tests, %.1f%% warm-started, %.2f iterations avg (%zu pairs)",
+                static_cast<unsigned long long>(gjkLookups),
+                static_cast<float>(m_GJKCache.GetLastWarmStarts()) * gjkScale * 100.0f,
+                static_cast<float>(m_GJKCache.GetLastIterations()) * gjkScale,
+                m_GJKCache.GetEntryCount());
+        }
+
+        {
+            ImGui::Checkbox("Island-Parallel Contact Solve", &m_UseIslandSolve);
+
+            const bool profiling = m_ScalingStep >= 0;
+            if (profiling) ImGui::BeginDisabled();
+            if (ImGui::SliderInt("Solver Threads", &m_SolverThreads, 1, 16)) {
+                m_Jobs.SetThreadCount(static_cast<uint32_t>(m_SolverThreads));
+            }
+            if (profiling) ImGui::EndDisabled();
+
+            if (m_UseIslandSolve) {
+                auto& solver = m_IslandSolver.GetSettings();
+                ImGui::Checkbox("Colour Large Islands", &solver.colouring);
+                if (solver.colouring) {
+                    int minConstraints = static_cast<int>(solver.colourMinConstraints);
+                    if (ImGui::SliderInt("Colour Min Constraints", &minConstraints, 16, 4096)) {
+                        solver.colourMinConstraints = static_cast<uint32_t>(minConstraints);
+                    }
+                }
+
+                ImGui::Text("Contact islands: %u (largest: %u of %u constraints), steals: %llu",
+                    m_IslandSolver.GetIslandCount(), m_IslandSolver.GetLargestIsland(), m_IslandSolver.GetConstraintCount(),
+                    static_cast<unsigned long long>(m_Jobs.GetStealCount()));
+                ImGui::Text("Coloured: %u constraints in %u colours, overflow: %u",
+                    m_IslandSolver.GetColouredConstraintCount(), m_IslandSolver.GetColourCount(), m_IslandSolver.GetOverflowCount());
+            }
+            ImGui::Text("Contact stage: %.3f ms (%u threads)", m_LastContactStageMs, m_Jobs.GetThreadCount());
+
+            if (!profiling) {
+                if (ImGui::Button("Profile Thread Scaling")) {
+                    m_UseIslandSolve = true;
+                    m_ScalingRestoreThreads = m_SolverThreads;
+                    m_ScalingStep = 0;
+                    m_ScalingFrame = 0;
+                    m_ScalingAccumMs = 0.0f;
+                    for (float& ms : m_ScalingResultMs) ms = 0.0f;
+                    m_Jobs.SetThreadCount(static_cast<uint32_t>(kScalingThreadCounts[0]));
+                }
+            }
+            else {
+                ImGui::Text("Profiling %d threads... (%d/%d frames)", kScalingThreadCounts[m_ScalingStep], m_ScalingFrame, kScalingFrames);
+            }
+
+            if (m_ScalingResultMs[0] > 0.0f) {
+                for (int i = 0; i < kScalingSteps; ++i) {
+                    if (m_ScalingResultMs[i] <= 0.0f) continue;
+                    ImGui::Text("  %2d threads: %.3f ms/frame, speedup x%.2f", kScalingThreadCounts[i],
+                        m_ScalingResultMs[i], m_ScalingResultMs[0] / m_ScalingResultMs[i]);
+                }
+            }
+        }
 
         for (auto& s : m_Spheres) s.body.SetRestitution(m_BounceRestitution);
         for (auto& b : m_Boxes)  b.body.SetRestitution(m_BounceRestitution);
@@ -1183,6 +2595,7 @@ void NetworkedCollisionScenario::OnImGui()
         ImGui::Text("Remote smoothing");
         ImGui::SliderFloat("Interp Rate", &m_RemoteInterpRate, 1.0f, 30.0f, "%.1f");
         ImGui::SliderFloat("Snap Distance", &m_RemoteSnapDistance, 0.1f, 10.0f, "%.2f");
+        if (m_Replaying) ImGui::EndDisabled();
 
         ImGui::Separator();
         ImGui::Text("Networking");
@@ -1204,10 +2617,59 @@ void NetworkedCollisionScenario::OnImGui()
             }
         }
 
+        ImGui::Separator();
+        ImGui::Text("Session Record / Replay");
+        if (m_Recording || m_Replaying) ImGui::BeginDisabled();
+        ImGui::InputText("Session File", m_SessionPath, IM_ARRAYSIZE(m_SessionPath));
+        if (m_Recording || m_Replaying) ImGui::EndDisabled();
+
+        if (m_Recording) {
+            if (ImGui::Button("Stop Recording")) StopRecording_NoLock();
+            ImGui::SameLine();
+            ImGui::Text("Recording: %u ticks, %u events", m_SessionTick, m_Session.GetEventCount());
+        }
+        else if (m_Replaying) {
+            if (ImGui::Button("Stop Replay")) {
+                m_Replaying = false;
+                m_Session.Clear();
+                m_SessionStatus = "Replay stopped at tick " + std::to_string(m_SessionTick);
+            }
+            ImGui::SameLine();
+            ImGui::Text("Replaying: tick %u / %u", m_SessionTick, m_Session.GetTickCount());
+        }
+        else {
+            if (ImGui::Button("Start Recording")) StartRecording_NoLock();
+            ImGui::SameLine();
+            if (ImGui::Button("Replay")) {
+                std::string error;
+                if (!StartReplay_NoLock(m_SessionPath, error)) m_SessionStatus = "Replay failed: " + error;
+            }
+        }
+        if (!m_SessionStatus.empty()) ImGui::TextWrapped("%s", m_SessionStatus.c_str());
+
+        ImGui::Separator();
+        ImGui::Text("Snapshots / Rollback");
+        ImGui::Checkbox("Capture Every Update", &m_CaptureSnapshots);
+        if (ImGui::SliderInt("Ring Size", &m_SnapshotCapacity, 1, 600)) {
+            m_Snapshots.SetCapacity(static_cast<size_t>(m_SnapshotCapacity));
+        }
+        ImGui::SliderInt("Rollback Ticks", &m_RollbackTicks, 0, m_SnapshotCapacity);
+        if (ImGui::Button("Rollback")) {
+            std::string error;
+            m_SnapshotStatus = Rollback_NoLock(static_cast<uint32_t>(m_RollbackTicks), error)
+                ? "Rolled back to tick " + std::to_string(m_SimTick) : "Rollback failed: " + error;
+        }
+        ImGui::Text("Tick %u, %zu / %zu snapshots, %.1f KB", m_SimTick, m_Snapshots.GetCount(), m_Snapshots.GetCapacity(),
+            m_Snapshots.GetByteSize() / 1024.0f);
+        ImGui::Text("Last save: %.1f us, last restore: %.1f us", m_LastSnapshotSaveUs, m_LastSnapshotRestoreUs);
+        if (!m_SnapshotStatus.empty()) ImGui::TextWrapped("%s", m_SnapshotStatus.c_str());
+
         ImGui::Separator();
         ImGui::Text("Robustness - Remote Smoothing");
+        if (m_Replaying) ImGui::BeginDisabled();
         ImGui::SliderFloat("Remote Interp Rate", &m_RemoteInterpRate, 1.0f, 40.0f, "%.1f");
         ImGui::SliderFloat("Remote Snap Distance", &m_RemoteSnapDistance, 0.05f, 5.0f, "%.2f");
+        if (m_Replaying) ImGui::EndDisabled();
         bool emulate = m_EnableNetEmulation.load();
         if (ImGui::Checkbox("Enable Delay/Loss Emulation", &emulate)) {
             m_EnableNetEmulation.store(emulate);
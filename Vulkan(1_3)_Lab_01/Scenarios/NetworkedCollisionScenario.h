@@ -3,10 +3,20 @@
 #include "Scenario.h"
 #include "../Application/SandboxApplication.h"
 #include "../Networking/NetworkPeer.h"
+#include "../Networking/SessionRecording.h"
 #include "../Renderer/MeshGenerator.h"
 #include "../Scene/SceneRuntime.h"
 #include "../SimulationLibrary/Collider.h"
+#include "../SimulationLibrary/GJKCache.h"
+#include "../SimulationLibrary/IslandSolver.h"
+#include "../SimulationLibrary/JobSystem.h"
 #include "../SimulationLibrary/PhysicsObject.h"
+#include "../SimulationLibrary/RigidBodyWorld.h"
+#include "../SimulationLibrary/SATCache.h"
+#include "../SimulationLibrary/SleepIslands.h"
+#include "../SimulationLibrary/StaticWorld.h"
+#include "../SimulationLibrary/DynamicAABBTree.h"
+#include "../SimulationLibrary/SweepAndPrune.h"
 
 #include <glm/glm.hpp>
 #include <glm/gtx/quaternion.hpp>
@@ -32,10 +42,22 @@ private:
         Arena_ManyObjects_Spawners = 5
     };
 
+    enum class BroadphaseMode : int {
+        SweepAndPrune = 0,
+        AABBTree = 1
+    };
+
+    static constexpr uint32_t kNotInIsland = 0xFFFFFFFFu;
+
     struct SphereInstance {
         uint32_t id = 0;
         SimRuntime::OwnerType owner = SimRuntime::OwnerType::One;
         bool isLocallyOwned = true;
+        uint32_t broadphaseProxy = SweepAndPrune::kInvalidProxy;
+
+        SleepState sleep;
+        uint32_t islandIndex = kNotInIsland;
+        bool sleepStateSent = false;
 
         PhysicsObject body;
         Mesh mesh;
@@ -60,6 +82,12 @@ private:
         uint32_t id = 0;
         SimRuntime::OwnerType owner = SimRuntime::OwnerType::One;
         bool isLocallyOwned = true;
+        bool isStaticObstacle = false;
+        uint32_t broadphaseProxy = SweepAndPrune::kInvalidProxy;
+
+        SleepState sleep;
+        uint32_t islandIndex = kNotInIsland;
+        bool sleepStateSent = false;
 
         PhysicsObject body;
         Mesh mesh;
@@ -73,11 +101,87 @@ private:
     };
 
 private:
+    // SoA body storage; sphere/box bodies are views into it. Must outlive the instance vectors.
+    RigidBodyWorld m_World;
+
     // Scene content
     std::vector<SphereInstance> m_Spheres;
     std::vector<PlaneInstance> m_Planes;
     std::vector<BoxInstance> m_Boxes;
 
+    // Broadphase. Proxy user data is the instance index, tagged for boxes/planes.
+    // SAP: spheres + all boxes, planes tested directly.
+    // AABB tree: spheres + moving boxes in the dynamic tree; planes + static obstacles in a
+    // static tree that is rebuilt only when the preset changes.
+    static constexpr uint32_t kBroadphaseBoxTag = 0x80000000u;
+    static constexpr uint32_t kBroadphasePlaneTag = 0x40000000u;
+    BroadphaseMode m_BroadphaseMode = BroadphaseMode::AABBTree;
+    SweepAndPrune m_Broadphase;
+    DynamicAABBTree m_DynamicTree{ 0.1f };
+    DynamicAABBTree m_StaticTree{ 0.0f };
+    bool m_StaticTreeDirty = true;
+    // The same planes and obstacles as half-space arrays + a uniform grid. When enabled it answers
+    // every static query in either mode (tree mode: instead of the static tree; SAP mode: instead
+    // of looping over all planes for boxes and continuous sweeps).
+    bool m_UseStaticGrid = true;
+    StaticWorld m_StaticWorld;
+    bool m_StaticWorldDirty = true;
+    std::vector<SweepAndPrune::Pair> m_BroadphasePairs;
+    uint64_t m_PairsTested = 0;
+    uint64_t m_PairsColliding = 0;
+    uint64_t m_StaticTests = 0;
+
+    // SoA staging for the batched sphere-plane narrowphase
+    struct SpherePlaneScratch {
+        std::vector<uint32_t> sphere;
+        std::vector<float> cx, cy, cz, r;
+        std::vector<float> nx, ny, nz;
+        std::vector<float> px, py, pz;
+        SimCollision::BatchContacts hits;
+    };
+    SpherePlaneScratch m_SpherePlaneScratch;
+
+    // Box-box SAT axis cache (per body handle pair)
+    bool m_UseSATCache = true;
+    SATCache m_SATCache;
+
+    // GJK simplex cache for spheres against capsule/cylinder obstacles (per body handle pair)
+    bool m_UseGJKCache = true;
+    GJKCache m_GJKCache;
+
+    // Islands/sleeping for locally simulated bodies. Island index = sphere index, or box index
+    // tagged with kBroadphaseBoxTag in m_IslandMembers.
+    SleepIslands m_Islands;
+    std::vector<uint32_t> m_IslandMembers;
+    static constexpr uint32_t kSleepingResendTicks = 30; // keep-alive for sleeping bodies (network ticks)
+
+    // Contact stage: static-tree and broadphase-pair contacts are gathered as constraints, split
+    // into islands and solved one island per job; large islands are graph coloured. Results do
+    // not depend on the thread count. The serial loops stay available for comparison.
+    struct ContactConstraint {
+        uint32_t body = 0;     // sphere index, or box index | kBroadphaseBoxTag
+        uint32_t other = 0;    // same encoding; static tree user data when isStatic
+        bool isStatic = false;
+    };
+    bool m_UseIslandSolve = true;
+    int m_SolverThreads = 1;
+    JobSystem m_Jobs;
+    IslandSolver m_IslandSolver;
+    std::vector<ContactConstraint> m_ContactConstraints;
+    std::vector<uint8_t> m_ContactHits;
+    float m_LastContactStageMs = 0.0f;
+    PhaseTimer m_PhaseTimer;
+
+    // Thread scaling profile: each count runs for kScalingFrames and the contact stage time is averaged.
+    static constexpr int kScalingThreadCounts[] = { 1, 2, 4, 8, 16 };
+    static constexpr int kScalingSteps = static_cast<int>(sizeof(kScalingThreadCounts) / sizeof(kScalingThreadCounts[0]));
+    static constexpr int kScalingFrames = 120;
+    int m_ScalingStep = -1; // active step, -1 when not profiling
+    int m_ScalingFrame = 0;
+    float m_ScalingAccumMs = 0.0f;
+    float m_ScalingResultMs[kScalingSteps] = {};
+    int m_ScalingRestoreThreads = 1;
+
     uint32_t m_NextObjectId = 1;
     DemoPreset m_Preset = DemoPreset::BounceCorner_SpherePlaneWall;
 
@@ -85,10 +189,23 @@ private:
     float m_Gravity = -9.81f;
     bool m_UseBounce = true;
     float m_BounceRestitution = 0.85f;
+    float m_BounceThreshold = 0.5f; // approach speed below which contacts do not bounce, so bodies can settle
 
     // NEW: keep objects moving
     float m_MinDynamicSpeed = 1.25f;
 
+    // Continuous collision: bodies faster than the threshold at the start of a step are swept
+    // against planes and static obstacles after integration and stopped at their first impact.
+    struct ContinuousMover {
+        uint32_t body = 0; // sphere index, or box index | kBroadphaseBoxTag
+        glm::vec3 startPosition{ 0.0f };
+        glm::quat startOrientation{ 1.0f, 0.0f, 0.0f, 0.0f };
+    };
+    bool m_UseCCD = true;
+    float m_CcdSpeedThreshold = 6.0f;
+    std::vector<ContinuousMover> m_ContinuousMovers;
+    uint32_t m_CcdHits = 0;
+
     // Ownership
     SimRuntime::OwnerType m_LocalPeerOwner = SimRuntime::OwnerType::One;
     SimRuntime::OwnerType m_SimOwner = SimRuntime::OwnerType::One; // who simulates the dynamic bodies in the preset
@@ -118,7 +235,7 @@ private:
     std::atomic<int> m_PendingPreset{ -1 };
     std::atomic<bool> m_PendingReset{ false };
 
-    std::mutex m_Mutex;
+    mutable std::mutex m_Mutex;
 
     // NEW: UI spawner controls
     float m_SpawnSphereRadius = 0.35f;
@@ -142,6 +259,79 @@ private:
     // Deterministic random (shared across peers for preset build)
     std::mt19937 m_Rng{ 1337u };
 
+    // Session record/replay. Recording starts from a fresh preset and logs every input that
+    // reaches the simulation between updates (remote packets as they are applied, UI spawns,
+    // preset resets, setting and time step changes), stamped with m_SessionTick. Replay feeds
+    // them back before the same updates, with no network, and checks the state checksums.
+    struct SessionSettings {
+        float gravity = 0.0f;
+        float bounceRestitution = 0.0f;
+        float bounceThreshold = 0.0f;
+        float minDynamicSpeed = 0.0f;
+        float ccdSpeedThreshold = 0.0f;
+        float remoteInterpRate = 0.0f;
+        float remoteSnapDistance = 0.0f;
+        float sleepLinearThreshold = 0.0f;
+        float sleepAngularThreshold = 0.0f;
+        float timeToSleep = 0.0f;
+        uint32_t colourMinConstraints = 0;
+        uint8_t integrationMethod = 0;
+        uint8_t simdLevel = 0;
+        uint8_t broadphaseMode = 0;
+        uint8_t localPeer = 0;
+        uint8_t simOwner = 0;
+        bool useBounce = false;
+        bool useCCD = false;
+        bool sleeping = false;
+        bool colouring = false;
+        bool useIslandSolve = false;
+        bool useStaticGrid = false;
+        bool useSATCache = false;
+        bool useGJKCache = false;
+
+        bool operator==(const SessionSettings&) const = default;
+    };
+    struct SessionPreset {
+        int32_t preset = 0;
+        SessionSettings settings;
+    };
+    static constexpr uint32_t kSessionChecksumTicks = 60;
+    SessionRecording m_Session;
+    bool m_Recording = false;
+    bool m_Replaying = false;
+    uint32_t m_SessionTick = 0;          // updates since the recording / replay started
+    float m_SessionTimeStep = 0.0f;      // last recorded or replayed delta time
+    SessionSettings m_SessionSettings;   // last recorded or replayed settings
+    uint32_t m_ReplayChecksums = 0;      // checksums verified so far
+    int64_t m_ReplayDivergedTick = -1;   // first tick whose checksum did not match
+    char m_SessionPath[260] = "session.simrec";
+    std::string m_SessionStatus;
+
+    // Snapshots: the world's hot arrays plus the per-instance runtime below, the preset RNG and
+    // the id counter. With capture on, one is pushed to the ring after every update, so rolling
+    // back is a restore instead of a preset rebuild and a re-simulation.
+    struct SnapshotBody {
+        uint32_t id = 0;
+        SimRuntime::OwnerType owner = SimRuntime::OwnerType::One;
+        bool isLocallyOwned = true;
+        bool sleepStateSent = false;
+        bool hasReplicatedState = false;
+        SleepState sleep;
+        glm::vec3 replicatedTargetPos{ 0.0f };
+        glm::vec3 replicatedTargetVel{ 0.0f };
+    };
+    static constexpr uint32_t kSnapshotTag = 0x4C4F434Eu; // "NCOL"
+    uint32_t m_SimTick = 0;             // updates since the scene was built
+    uint32_t m_SceneGeneration = 0;     // bumped by ClearScene(); snapshots never restore across it
+    SnapshotRing m_Snapshots{ 120 };
+    bool m_CaptureSnapshots = false;
+    int m_SnapshotCapacity = 120;
+    int m_RollbackTicks = 30;
+    float m_LastSnapshotSaveUs = 0.0f;
+    float m_LastSnapshotRestoreUs = 0.0f;
+    std::string m_SnapshotStatus;
+    std::vector<SnapshotBody> m_SnapshotBodies; // restore scratch
+
 private:
     void ClearScene();
     void SetupPreset(DemoPreset preset);
@@ -152,15 +342,38 @@ private:
     void AddSphere(const glm::vec3& position, const glm::vec3& velocity, float radius, float mass, const glm::vec3& color, SimRuntime::OwnerType owner);
     void AddBox(const glm::vec3& position, const glm::quat& orientation, const glm::vec3& halfExtents, const glm::vec3& velocity, float mass, const glm::vec3& color, SimRuntime::OwnerType owner);
 
-    // NEW: static “capsule/cylinder” obstacles (rendered as such, collision approximated by BoxCollider)
+    // NEW: static “capsule/cylinder” obstacles (rendered as such, colliding as real capsule/cylinder colliders through GJK)
     void AddStaticCylinderObstacle(const glm::vec3& position, float radius, float height, const glm::quat& orientation, const glm::vec3& color);
     void AddStaticCapsuleObstacle(const glm::vec3& position, float radius, float height, const glm::quat& orientation, const glm::vec3& color);
 
     void ResolveSpherePlane(SphereInstance& sphere, const PlaneCollider& plane);
-    void ResolveSphereSphere(SphereInstance& a, SphereInstance& b);
-    void ResolveSphereBox(SphereInstance& sphere, BoxInstance& box);
+    void ApplySpherePlaneContact(SphereInstance& sphere, const glm::vec3& n, float penetration);
+    void ResolveSpherePlanesBatched_NoLock();
+    bool ResolveSphereSphere(SphereInstance& a, SphereInstance& b);
+    bool ResolveSphereBox(SphereInstance& sphere, BoxInstance& box);
     void ResolveBoxPlane(BoxInstance& box, const PlaneCollider& plane);
-    void ResolveBoxBox(BoxInstance& a, BoxInstance& b);
+    bool ResolveBoxBox(BoxInstance& a, BoxInstance& b);
+
+    // Pushes current sphere/box bounds into the broadphase (creating proxies for new bodies)
+    void ResetBroadphase_NoLock();
+    void BuildStaticTree_NoLock();
+    void BuildStaticWorld_NoLock();
+    template <typename Callback>
+    void QueryStatic_NoLock(const SimCollision::AABB& bounds, Callback&& callback) const;
+    void UpdateBroadphase_NoLock(float dt);
+    void FindBroadphasePairs_NoLock();
+    void ResolveStaticContacts_NoLock();
+    void ResolveBroadphasePairs_NoLock();
+
+    // Records fast movers before integration; sweeps them against static geometry afterwards
+    void BeginContinuous_NoLock();
+    void ApplyContinuous_NoLock();
+
+    // Island-parallel contact stage (replaces the two serial loops above)
+    void GatherContactConstraints_NoLock();
+    void SolveContactConstraints_NoLock();
+    bool SolveContactConstraint(const ContactConstraint& c);
+    void AdvanceScalingProfile_NoLock(float stageMs);
 
     void ApplyRemoteSmoothing(float dt);
 
@@ -170,6 +383,9 @@ private:
 
     // NEW: spawn replication
     void ReceiveRemoteSpawns_NoLock();
+    void ApplyRemoteState_NoLock(const SimStatePacket& p);
+    void ApplyRemoteSpawn_NoLock(const SimSpawnPacket& p);
+    void ApplyLocalSpawn_NoLock(const SimSpawnPacket& p);
     void SendSpawn_NoLock(const SimSpawnPacket& p);
 
     void StartNetworkWorker();
@@ -179,9 +395,36 @@ private:
     void SendSetPreset(DemoPreset preset);
     void SendReset();
 
+    // Session record/replay
+    SessionSettings CaptureSessionSettings_NoLock() const;
+    void ApplySessionSettings_NoLock(const SessionSettings& settings);
+    uint64_t SessionChecksum_NoLock() const;
+    void StartRecording_NoLock();
+    void StopRecording_NoLock();
+    void RecordSettings_NoLock();
+    void RecordUpdate_NoLock(float dt);          // before an update: settings / time step changes
+    float ReplayUpdate_NoLock(float dt);         // before an update: applies its events, returns its dt
+    void EndSessionUpdate_NoLock();              // after an update: checksums, end of replay
+    bool StartReplay_NoLock(const std::string& path, std::string& error);
+
+    // Snapshots
+    void SaveSnapshot_NoLock(WorldSnapshot& out) const;
+    bool RestoreSnapshot_NoLock(const WorldSnapshot& snapshot, std::string& error);
+    bool Rollback_NoLock(uint32_t ticks, std::string& error); // to the newest ring entry that old
+
+    // Keeps the world's per-body simulate flag in step with isLocallyOwned
+    void RefreshOwnership_NoLock();
+
     // NEW: min-speed clamp
     void EnforceMinimumSpeed_NoLock();
 
+    float ContactRestitution(float restitution, float approachSpeed) const;
+
+    // Registers this tick's island members; links touching pairs; sleeps/wakes islands
+    void BeginIslands_NoLock();
+    void LinkIslands_NoLock(uint32_t a, uint32_t b);
+    void UpdateSleeping_NoLock(float dt);
+
     // NEW: UI spawners
     void SpawnSphereFromUI_NoLock();
     void SpawnBoxFromUI_NoLock();
@@ -191,6 +434,12 @@ public:
 
     void OnLoad() override;
     void OnUpdate(float deltaTime) override;
+    StepActivity GetStepActivity() const override;
+    const PhaseTimer* GetPhaseTimer() const override { return &m_PhaseTimer; }
+    bool StartReplay(const std::string& path, std::string& error) override;
+    bool IsReplaying() const override;
+    bool SaveSnapshot(WorldSnapshot& out) override;
+    bool RestoreSnapshot(const WorldSnapshot& snapshot, std::string& error) override;
     void OnRender(VkCommandBuffer commandBuffer) override;
     void OnImGui() override;
     void OnUnload() override;
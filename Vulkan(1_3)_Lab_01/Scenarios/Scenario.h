@@ -6,6 +6,9 @@
 #include <glm/glm.hpp>
 #include <functional>
 #include <vector>
+#include "../SimulationLibrary/StepController.h"
+#include "../SimulationLibrary/PhaseTimer.h"
+#include "../SimulationLibrary/WorldSnapshot.h"
 
 // Forward declaration
 class SandboxApplication;
@@ -27,6 +30,24 @@ public:
     virtual glm::vec4 GetClearColor() const { return { 0.1f, 0.1f, 0.1f, 1.0f }; }
     virtual std::string GetName() const = 0;
 
+    // Motion hints for the step controller, read before every update. The default gives none,
+    // which keeps plain fixed steps.
+    virtual StepActivity GetStepActivity() const { return {}; }
+
+    // Per-phase wall time of the last OnUpdate(), for the headless benchmark. nullptr: the
+    // scenario has no breakdown and only the whole update is timed.
+    virtual const PhaseTimer* GetPhaseTimer() const { return nullptr; }
+
+    // Replays a recorded session: the recorded inputs and time steps drive the following
+    // OnUpdate() calls (their deltaTime is ignored) until IsReplaying() turns false.
+    virtual bool StartReplay(const std::string& /*path*/, std::string& error) { error = GetName() + " does not record sessions"; return false; }
+    virtual bool IsReplaying() const { return false; }
+
+    // Copies all dynamic state into a flat snapshot / puts it back. A snapshot only restores into
+    // the scene it was taken from: bodies spawned after it are removed, but a rebuilt scene fails.
+    virtual bool SaveSnapshot(WorldSnapshot& /*out*/) { return false; }
+    virtual bool RestoreSnapshot(const WorldSnapshot& /*snapshot*/, std::string& error) { error = GetName() + " does not take snapshots"; return false; }
+
     // --- Selection / Editor API ---
     struct TransformProxy {
         glm::vec3 position{ 0.0f };
@@ -6,6 +6,7 @@
 #include <fstream>
 #include <sstream>
 #include <algorithm>
+#include <chrono>
 
 namespace {
     std::string Trim(std::string value) {
@@ -40,6 +41,7 @@ void SphereDropScenario::ClearScene() {
     m_Spheres.clear();
     m_Planes.clear();
     m_GroundPlaneIndex = -1;
+    m_StaticWorld.Clear();
 }
 
 void SphereDropScenario::RebuildSphereMesh(SphereInstance& sphere) {
@@ -152,7 +154,7 @@ void SphereDropScenario::AddSphere(const glm::vec3& position,
     SphereInstance instance{};
     instance.color = color;
 
-    instance.body.SetCollider(std::make_unique<SphereCollider>(radius));
+    instance.body.SetCollider(SphereCollider(radius));
     instance.body.SetPosition(position);
     instance.body.SetVelocity(velocity);
     instance.body.SetRadius(radius);
@@ -176,7 +178,7 @@ void SphereDropScenario::AddPlane(const glm::vec3& point,
     glm::vec3 n = glm::normalize(normal);
     instance.orientation = glm::rotation(glm::vec3(0.0f, 1.0f, 0.0f), n);
 
-    instance.body.SetCollider(std::make_unique<PlaneCollider>(n));
+    instance.body.SetCollider(PlaneCollider(n));
     instance.body.SetMass(0.0f);
     UpdatePlaneTransform(instance, point);
 
@@ -187,6 +189,9 @@ void SphereDropScenario::AddPlane(const glm::vec3& point,
         m_GroundPlaneIndex = static_cast<int>(m_Planes.size());
     }
 
+    const auto* planeCollider = instance.body.GetColliderAs<PlaneCollider>();
+    m_StaticWorld.AddPlane(planeCollider->GetNormal(), planeCollider->GetPoint(), static_cast<uint32_t>(m_Planes.size()));
+
     m_Planes.push_back(std::move(instance));
 }
 
@@ -313,8 +318,14 @@ void SphereDropScenario::OnLoad() {
 }
 
 void SphereDropScenario::OnUpdate(float deltaTime) {
+    m_PhaseTimer.Begin();
+
     if (m_GroundPlaneIndex >= 0 && m_GroundPlaneIndex < static_cast<int>(m_Planes.size())) {
-        UpdatePlaneTransform(m_Planes[m_GroundPlaneIndex], {0.0f, m_GroundY, 0.0f});
+        auto& ground = m_Planes[m_GroundPlaneIndex];
+        UpdatePlaneTransform(ground, {0.0f, m_GroundY, 0.0f});
+        if (auto* planeCollider = ground.body.GetColliderAs<PlaneCollider>()) {
+            m_StaticWorld.SetPlane(static_cast<uint32_t>(m_GroundPlaneIndex), planeCollider->GetNormal(), planeCollider->GetPoint());
+        }
     }
 
     const auto method = m_App->GetIntegrationMethod();
@@ -322,19 +333,48 @@ void SphereDropScenario::OnUpdate(float deltaTime) {
     for (auto& sphere : m_Spheres) {
         sphere.body.Update(deltaTime, m_Gravity, method);
 
-        for (const auto& plane : m_Planes) {
-            auto* planeCollider = plane.body.GetColliderAs<PlaneCollider>();
-            if (planeCollider) {
+        auto* sphereCollider = sphere.body.GetColliderAs<SphereCollider>();
+        if (!sphereCollider) {
+            continue;
+        }
+
+        // Only the planes the sphere touches, found in one pass over the half-space arrays
+        m_StaticWorld.QuerySphere(sphereCollider->GetCenter(), sphereCollider->GetRadius(), [&](uint32_t planeIndex) {
+            if (auto* planeCollider = m_Planes[planeIndex].body.GetColliderAs<PlaneCollider>()) {
                 ResolveSpherePlane(sphere, *planeCollider);
             }
-        }
+        });
     }
+    m_PhaseTimer.Mark("integrate + planes");
 
     for (size_t i = 0; i < m_Spheres.size(); ++i) {
         for (size_t j = i + 1; j < m_Spheres.size(); ++j) {
             ResolveSphereSphere(m_Spheres[i], m_Spheres[j]);
         }
     }
+    m_PhaseTimer.Mark("sphere pairs");
+}
+
+StepActivity SphereDropScenario::GetStepActivity() const {
+    StepActivity activity;
+    activity.valid = true;
+
+    for (const auto& sphere : m_Spheres) {
+        auto* sphereCollider = sphere.body.GetColliderAs<SphereCollider>();
+        if (!sphereCollider) {
+            continue;
+        }
+
+        activity.maxSpeed = std::max(activity.maxSpeed, glm::length(sphere.body.GetVelocity()));
+        m_StaticWorld.QuerySphere(sphereCollider->GetCenter(), sphereCollider->GetRadius(), [&](uint32_t planeIndex) {
+            if (auto* planeCollider = m_Planes[planeIndex].body.GetColliderAs<PlaneCollider>()) {
+                const float penetration = sphereCollider->GetRadius() - planeCollider->DistanceToPoint(sphereCollider->GetCenter());
+                activity.maxPenetration = std::max(activity.maxPenetration, penetration);
+            }
+        });
+    }
+
+    return activity;
 }
 
 void SphereDropScenario::OnRender(VkCommandBuffer commandBuffer) {
@@ -433,6 +473,63 @@ void SphereDropScenario::OnImGui() {
         OnLoad();
     }
 
+    ImGui::Separator();
+    ImGui::Text("Integrator Benchmark");
+    int benchmarkBodies = static_cast<int>(m_IntegratorBenchmarkSettings.bodies);
+    if (ImGui::SliderInt("Benchmark Bodies", &benchmarkBodies, 16, 4096)) {
+        m_IntegratorBenchmarkSettings.bodies = static_cast<uint32_t>(benchmarkBodies);
+    }
+    int benchmarkSteps = static_cast<int>(m_IntegratorBenchmarkSettings.steps);
+    if (ImGui::SliderInt("Benchmark Steps", &benchmarkSteps, 1000, 100000)) {
+        m_IntegratorBenchmarkSettings.steps = static_cast<uint32_t>(benchmarkSteps);
+    }
+    ImGui::SliderFloat("Stable Energy Drift", &m_IntegratorBenchmarkSettings.stableDrift, 0.001f, 0.1f, "%.3f");
+    if (m_IntegratorBenchmarkJob.valid()
+        && m_IntegratorBenchmarkJob.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        m_IntegratorBenchmark = m_IntegratorBenchmarkJob.get();
+    }
+    if (m_IntegratorBenchmarkJob.valid()) {
+        ImGui::Text("Integrator benchmark running...");
+    }
+    else if (ImGui::Button("Run Integrator Benchmark")) {
+        // The job gets its own copy of the settings, so the sliders stay live
+        m_IntegratorBenchmarkJob = std::async(std::launch::async, SimIntegration::RunIntegratorBenchmark, m_IntegratorBenchmarkSettings);
+    }
+
+    if (!m_IntegratorBenchmark.empty() && ImGui::BeginTable("IntegratorBenchmark", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn("Scene");
+        ImGui::TableSetupColumn("Method");
+        ImGui::TableSetupColumn("dt");
+        ImGui::TableSetupColumn("Energy drift");
+        ImGui::TableSetupColumn("Max drift");
+        ImGui::TableSetupColumn("ns/body/step");
+        ImGui::TableHeadersRow();
+
+        for (const auto& r : m_IntegratorBenchmark) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::TextUnformatted(SimIntegration::GetBenchmarkSceneName(r.scene));
+            ImGui::TableNextColumn(); ImGui::TextUnformatted(GetIntegrationMethodName(r.method));
+            ImGui::TableNextColumn(); ImGui::Text("1/%.0f", 1.0f / r.timeStep);
+            ImGui::TableNextColumn(); ImGui::Text("%+.2e", r.finalDrift);
+            ImGui::TableNextColumn();
+            if (r.stable) ImGui::Text("%.2e", r.maxDrift);
+            else ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "%.2e", r.maxDrift);
+            ImGui::TableNextColumn(); ImGui::Text("%.2f", r.nsPerBodyStep);
+        }
+        ImGui::EndTable();
+
+        for (int s = 0; s < SimIntegration::kBenchmarkSceneCount; ++s) {
+            const auto scene = static_cast<SimIntegration::BenchmarkScene>(s);
+            ImGui::Text("%s, largest stable dt:", SimIntegration::GetBenchmarkSceneName(scene));
+            for (int m = 0; m < kIntegrationMethodCount; ++m) {
+                const auto method = static_cast<IntegrationMethod>(m);
+                const float dt = SimIntegration::LargestStableTimeStep(m_IntegratorBenchmark, scene, method);
+                if (dt > 0.0f) ImGui::BulletText("%s: 1/%.0f s", GetIntegrationMethodName(method), 1.0f / dt);
+                else ImGui::BulletText("%s: none", GetIntegrationMethodName(method));
+            }
+        }
+    }
+
     ImGui::End();
 }
 
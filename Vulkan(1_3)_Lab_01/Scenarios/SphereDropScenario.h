@@ -4,9 +4,12 @@
 #include "../Application/SandboxApplication.h"
 #include "../SimulationLibrary/PhysicsObject.h"
 #include "../SimulationLibrary/Collider.h"
+#include "../SimulationLibrary/IntegratorBenchmark.h"
+#include "../SimulationLibrary/StaticWorld.h"
 #include <glm/glm.hpp>
 #include <vector>
 #include <string>
+#include <future>
 
 class SphereDropScenario : public Scenario {
 private:
@@ -30,6 +33,10 @@ private:
     std::vector<PlaneInstance> m_Planes;
     int m_GroundPlaneIndex = -1;
 
+    // Plane half-spaces (user data = plane index), filled as planes are added
+    StaticWorld m_StaticWorld;
+    PhaseTimer m_PhaseTimer;
+
     float m_Gravity = -9.81f;
     float m_GroundY = 0.0f;
     bool m_UseBounce = true;
@@ -39,6 +46,11 @@ private:
 
     std::string m_ConfigPath = "Configs/SphereDropScenario.cfg";
 
+    SimIntegration::IntegratorBenchmarkSettings m_IntegratorBenchmarkSettings;
+    std::vector<SimIntegration::IntegratorBenchmarkResult> m_IntegratorBenchmark;
+    // Runs off the render thread; a large run takes minutes.
+    std::future<std::vector<SimIntegration::IntegratorBenchmarkResult>> m_IntegratorBenchmarkJob;
+
     void ClearScene();
     void RebuildSphereMesh(SphereInstance& sphere);
 
@@ -68,6 +80,8 @@ public:
 
     void OnLoad() override;
     void OnUpdate(float deltaTime) override;
+    StepActivity GetStepActivity() const override;
+    const PhaseTimer* GetPhaseTimer() const override { return &m_PhaseTimer; }
     void OnRender(VkCommandBuffer commandBuffer) override;
     void OnImGui() override;
     void ImGuiMainMenu() override;
@@ -0,0 +1,232 @@
+#include "BatchIntegrator.h"
+#include <cstring>
+
+#if SIM_HAS_X86
+#include <immintrin.h>
+#endif
+
+namespace SimIntegration
+{
+    namespace
+    {
+        void IntegrateScalar(const LinearStreams& s, size_t begin, float dt, float gravity, IntegrationMethod method)
+        {
+            for (size_t i = begin; i < s.count; ++i) {
+                if (!s.simulated[i]) continue;
+
+                const float invMass = s.inverseMass[i];
+                if (invMass != 0.0f) {
+                    const float ax = s.forceX[i] * invMass;
+                    const float ay = s.forceY[i] * invMass + gravity;
+                    const float az = s.forceZ[i] * invMass;
+
+                    if (method == IntegrationMethod::ExplicitEuler) {
+                        s.posX[i] += s.velX[i] * dt;
+                        s.posY[i] += s.velY[i] * dt;
+                        s.posZ[i] += s.velZ[i] * dt;
+                        s.velX[i] += ax * dt;
+                        s.velY[i] += ay * dt;
+                        s.velZ[i] += az * dt;
+                    }
+                    else if (method != IntegrationMethod::SemiImplicitEuler) {
+                        // Higher-order methods: exact for constant acceleration (see StepConstantAcceleration)
+                        const float halfDtSq = 0.5f * dt * dt;
+                        s.posX[i] += s.velX[i] * dt + ax * halfDtSq;
+                        s.posY[i] += s.velY[i] * dt + ay * halfDtSq;
+                        s.posZ[i] += s.velZ[i] * dt + az * halfDtSq;
+                        s.velX[i] += ax * dt;
+                        s.velY[i] += ay * dt;
+                        s.velZ[i] += az * dt;
+                    }
+                    else {
+                        s.velX[i] += ax * dt;
+                        s.velY[i] += ay * dt;
+                        s.velZ[i] += az * dt;
+                        s.posX[i] += s.velX[i] * dt;
+                        s.posY[i] += s.velY[i] * dt;
+                        s.posZ[i] += s.velZ[i] * dt;
+                    }
+                }
+
+                s.forceX[i] = 0.0f;
+                s.forceY[i] = 0.0f;
+                s.forceZ[i] = 0.0f;
+            }
+        }
+
+#if SIM_HAS_X86
+        // ---- SSE2: 4 bodies per iteration ----
+        inline __m128 Select4(__m128 mask, __m128 a, __m128 b)
+        {
+            return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+        }
+
+        size_t IntegrateSSE2(const LinearStreams& s, float dt, float gravity, IntegrationMethod method)
+        {
+            const __m128 vDt = _mm_set1_ps(dt);
+            const __m128 vHalfDtSq = _mm_set1_ps(0.5f * dt * dt);
+            const __m128 vG = _mm_set1_ps(gravity);
+            const __m128 zero = _mm_setzero_ps();
+            const bool explicitEuler = (method == IntegrationMethod::ExplicitEuler);
+            const bool exactParabola = !explicitEuler && method != IntegrationMethod::SemiImplicitEuler;
+
+            size_t i = 0;
+            for (; i + 4 <= s.count; i += 4) {
+                int32_t flagBytes;
+                std::memcpy(&flagBytes, s.simulated + i, sizeof(flagBytes));
+                if (flagBytes == 0) continue;
+
+                __m128i flags = _mm_cvtsi32_si128(flagBytes);
+                flags = _mm_unpacklo_epi8(flags, _mm_setzero_si128());
+                flags = _mm_unpacklo_epi16(flags, _mm_setzero_si128());
+                const __m128 simMask = _mm_castsi128_ps(_mm_cmpgt_epi32(flags, _mm_setzero_si128()));
+
+                const __m128 invMass = _mm_loadu_ps(s.inverseMass + i);
+                const __m128 moveMask = _mm_and_ps(simMask, _mm_cmpneq_ps(invMass, zero));
+
+                const __m128 fx = _mm_loadu_ps(s.forceX + i);
+                const __m128 fy = _mm_loadu_ps(s.forceY + i);
+                const __m128 fz = _mm_loadu_ps(s.forceZ + i);
+                const __m128 ax = _mm_mul_ps(fx, invMass);
+                const __m128 ay = _mm_add_ps(_mm_mul_ps(fy, invMass), vG);
+                const __m128 az = _mm_mul_ps(fz, invMass);
+
+                __m128 px = _mm_loadu_ps(s.posX + i), py = _mm_loadu_ps(s.posY + i), pz = _mm_loadu_ps(s.posZ + i);
+                __m128 vx = _mm_loadu_ps(s.velX + i), vy = _mm_loadu_ps(s.velY + i), vz = _mm_loadu_ps(s.velZ + i);
+                __m128 npx, npy, npz, nvx, nvy, nvz;
+
+                if (explicitEuler) {
+                    npx = _mm_add_ps(px, _mm_mul_ps(vx, vDt));
+                    npy = _mm_add_ps(py, _mm_mul_ps(vy, vDt));
+                    npz = _mm_add_ps(pz, _mm_mul_ps(vz, vDt));
+                    nvx = _mm_add_ps(vx, _mm_mul_ps(ax, vDt));
+                    nvy = _mm_add_ps(vy, _mm_mul_ps(ay, vDt));
+                    nvz = _mm_add_ps(vz, _mm_mul_ps(az, vDt));
+                }
+                else if (exactParabola) {
+                    npx = _mm_add_ps(px, _mm_add_ps(_mm_mul_ps(vx, vDt), _mm_mul_ps(ax, vHalfDtSq)));
+                    npy = _mm_add_ps(py, _mm_add_ps(_mm_mul_ps(vy, vDt), _mm_mul_ps(ay, vHalfDtSq)));
+                    npz = _mm_add_ps(pz, _mm_add_ps(_mm_mul_ps(vz, vDt), _mm_mul_ps(az, vHalfDtSq)));
+                    nvx = _mm_add_ps(vx, _mm_mul_ps(ax, vDt));
+                    nvy = _mm_add_ps(vy, _mm_mul_ps(ay, vDt));
+                    nvz = _mm_add_ps(vz, _mm_mul_ps(az, vDt));
+                }
+                else {
+                    nvx = _mm_add_ps(vx, _mm_mul_ps(ax, vDt));
+                    nvy = _mm_add_ps(vy, _mm_mul_ps(ay, vDt));
+                    nvz = _mm_add_ps(vz, _mm_mul_ps(az, vDt));
+                    npx = _mm_add_ps(px, _mm_mul_ps(nvx, vDt));
+                    npy = _mm_add_ps(py, _mm_mul_ps(nvy, vDt));
+                    npz = _mm_add_ps(pz, _mm_mul_ps(nvz, vDt));
+                }
+
+                _mm_storeu_ps(s.posX + i, Select4(moveMask, npx, px));
+                _mm_storeu_ps(s.posY + i, Select4(moveMask, npy, py));
+                _mm_storeu_ps(s.posZ + i, Select4(moveMask, npz, pz));
+                _mm_storeu_ps(s.velX + i, Select4(moveMask, nvx, vx));
+                _mm_storeu_ps(s.velY + i, Select4(moveMask, nvy, vy));
+                _mm_storeu_ps(s.velZ + i, Select4(moveMask, nvz, vz));
+
+                _mm_storeu_ps(s.forceX + i, Select4(simMask, zero, fx));
+                _mm_storeu_ps(s.forceY + i, Select4(simMask, zero, fy));
+                _mm_storeu_ps(s.forceZ + i, Select4(simMask, zero, fz));
+            }
+            return i;
+        }
+
+        // ---- AVX2: 8 bodies per iteration ----
+        SIM_TARGET_AVX2 size_t IntegrateAVX2(const LinearStreams& s, float dt, float gravity, IntegrationMethod method)
+        {
+            const __m256 vDt = _mm256_set1_ps(dt);
+            const __m256 vHalfDtSq = _mm256_set1_ps(0.5f * dt * dt);
+            const __m256 vG = _mm256_set1_ps(gravity);
+            const __m256 zero = _mm256_setzero_ps();
+            const bool explicitEuler = (method == IntegrationMethod::ExplicitEuler);
+            const bool exactParabola = !explicitEuler && method != IntegrationMethod::SemiImplicitEuler;
+
+            size_t i = 0;
+            for (; i + 8 <= s.count; i += 8) {
+                const __m128i flagBytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(s.simulated + i));
+                // Low 8 bytes all zero: nothing simulated in this block (movemask rather than a
+                // 64-bit extract, which 32-bit x86 lacks)
+                if ((_mm_movemask_epi8(_mm_cmpeq_epi8(flagBytes, _mm_setzero_si128())) & 0xFF) == 0xFF) continue;
+
+                const __m256i flags = _mm256_cvtepu8_epi32(flagBytes);
+                const __m256 simMask = _mm256_castsi256_ps(_mm256_cmpgt_epi32(flags, _mm256_setzero_si256()));
+
+                const __m256 invMass = _mm256_loadu_ps(s.inverseMass + i);
+                const __m256 moveMask = _mm256_and_ps(simMask, _mm256_cmp_ps(invMass, zero, _CMP_NEQ_UQ));
+
+                const __m256 fx = _mm256_loadu_ps(s.forceX + i);
+                const __m256 fy = _mm256_loadu_ps(s.forceY + i);
+                const __m256 fz = _mm256_loadu_ps(s.forceZ + i);
+                const __m256 ax = _mm256_mul_ps(fx, invMass);
+                const __m256 ay = _mm256_add_ps(_mm256_mul_ps(fy, invMass), vG);
+                const __m256 az = _mm256_mul_ps(fz, invMass);
+
+                __m256 px = _mm256_loadu_ps(s.posX + i), py = _mm256_loadu_ps(s.posY + i), pz = _mm256_loadu_ps(s.posZ + i);
+                __m256 vx = _mm256_loadu_ps(s.velX + i), vy = _mm256_loadu_ps(s.velY + i), vz = _mm256_loadu_ps(s.velZ + i);
+                __m256 npx, npy, npz, nvx, nvy, nvz;
+
+                if (explicitEuler) {
+                    npx = _mm256_add_ps(px, _mm256_mul_ps(vx, vDt));
+                    npy = _mm256_add_ps(py, _mm256_mul_ps(vy, vDt));
+                    npz = _mm256_add_ps(pz, _mm256_mul_ps(vz, vDt));
+                    nvx = _mm256_add_ps(vx, _mm256_mul_ps(ax, vDt));
+                    nvy = _mm256_add_ps(vy, _mm256_mul_ps(ay, vDt));
+                    nvz = _mm256_add_ps(vz, _mm256_mul_ps(az, vDt));
+                }
+                else if (exactParabola) {
+                    npx = _mm256_add_ps(px, _mm256_add_ps(_mm256_mul_ps(vx, vDt), _mm256_mul_ps(ax, vHalfDtSq)));
+                    npy = _mm256_add_ps(py, _mm256_add_ps(_mm256_mul_ps(vy, vDt), _mm256_mul_ps(ay, vHalfDtSq)));
+                    npz = _mm256_add_ps(pz, _mm256_add_ps(_mm256_mul_ps(vz, vDt), _mm256_mul_ps(az, vHalfDtSq)));
+                    nvx = _mm256_add_ps(vx, _mm256_mul_ps(ax, vDt));
+                    nvy = _mm256_add_ps(vy, _mm256_mul_ps(ay, vDt));
+                    nvz = _mm256_add_ps(vz, _mm256_mul_ps(az, vDt));
+                }
+                else {
+                    nvx = _mm256_add_ps(vx, _mm256_mul_ps(ax, vDt));
+                    nvy = _mm256_add_ps(vy, _mm256_mul_ps(ay, vDt));
+                    nvz = _mm256_add_ps(vz, _mm256_mul_ps(az, vDt));
+                    npx = _mm256_add_ps(px, _mm256_mul_ps(nvx, vDt));
+                    npy = _mm256_add_ps(py, _mm256_mul_ps(nvy, vDt));
+                    npz = _mm256_add_ps(pz, _mm256_mul_ps(nvz, vDt));
+                }
+
+                _mm256_storeu_ps(s.posX + i, _mm256_blendv_ps(px, npx, moveMask));
+                _mm256_storeu_ps(s.posY + i, _mm256_blendv_ps(py, npy, moveMask));
+                _mm256_storeu_ps(s.posZ + i, _mm256_blendv_ps(pz, npz, moveMask));
+                _mm256_storeu_ps(s.velX + i, _mm256_blendv_ps(vx, nvx, moveMask));
+                _mm256_storeu_ps(s.velY + i, _mm256_blendv_ps(vy, nvy, moveMask));
+                _mm256_storeu_ps(s.velZ + i, _mm256_blendv_ps(vz, nvz, moveMask));
+
+                _mm256_storeu_ps(s.forceX + i, _mm256_blendv_ps(fx, zero, simMask));
+                _mm256_storeu_ps(s.forceY + i, _mm256_blendv_ps(fy, zero, simMask));
+                _mm256_storeu_ps(s.forceZ + i, _mm256_blendv_ps(fz, zero, simMask));
+            }
+            return i;
+        }
+#endif
+    }
+
+    void IntegrateLinear(const LinearStreams& streams, float deltaTime, float gravity, IntegrationMethod method, SimdLevel level)
+    {
+        size_t done = 0;
+
+#if SIM_HAS_X86
+        if (level > SimSimd::GetBestSimdLevel()) level = SimSimd::GetBestSimdLevel();
+
+        if (level == SimdLevel::AVX2) {
+            done = IntegrateAVX2(streams, deltaTime, gravity, method);
+        }
+        else if (level == SimdLevel::SSE2) {
+            done = IntegrateSSE2(streams, deltaTime, gravity, method);
+        }
+#else
+        (void)level;
+#endif
+
+        // Tail (and full fallback)
+        IntegrateScalar(streams, done, deltaTime, gravity, method);
+    }
+}
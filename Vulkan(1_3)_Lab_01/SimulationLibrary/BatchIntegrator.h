@@ -0,0 +1,33 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "IntegrationMethod.h"
+#include "SimdSupport.h"
+
+namespace SimIntegration
+{
+    using SimSimd::SimdLevel;
+
+    // Per-component linear state for 'count' bodies. Forces are cleared for every
+    // simulated body; bodies with simulated == 0 are left untouched, and bodies with
+    // inverseMass == 0 keep their position and velocity.
+    struct LinearStreams
+    {
+        float* posX = nullptr;
+        float* posY = nullptr;
+        float* posZ = nullptr;
+        float* velX = nullptr;
+        float* velY = nullptr;
+        float* velZ = nullptr;
+        float* forceX = nullptr;
+        float* forceY = nullptr;
+        float* forceZ = nullptr;
+        const float* inverseMass = nullptr;
+        const uint8_t* simulated = nullptr;
+        size_t count = 0;
+    };
+
+    // Advances position/velocity for every body in 'streams'. The vector paths use the same
+    // operation order as the scalar path (no FMA), so all levels produce identical results.
+    void IntegrateLinear(const LinearStreams& streams, float deltaTime, float gravity, IntegrationMethod method, SimdLevel level);
+}
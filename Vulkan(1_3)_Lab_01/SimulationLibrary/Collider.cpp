@@ -1,5 +1,6 @@
 #include "Collider.h"
 #include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
 #include <cmath>
 
 SphereCollider::SphereCollider(float radius)
@@ -27,11 +28,9 @@ float PlaneCollider::DistanceToPoint(const glm::vec3& point) const {
 BoxCollider::BoxCollider(const glm::vec3& halfExtents)
     : m_HalfExtents(glm::max(halfExtents, glm::vec3(0.01f))) {}
 
-void BoxCollider::SyncFromTransform(const glm::mat4& transform)
+// Rotation part of a transform (ignore scaling as best-effort by normalizing columns)
+static glm::mat3 RotationFromTransform(const glm::mat4& transform)
 {
-    m_Center = glm::vec3(transform[3]);
-
-    // Extract rotation (ignore scaling as best-effort by normalizing columns)
     glm::vec3 x = glm::vec3(transform[0]);
     glm::vec3 y = glm::vec3(transform[1]);
     glm::vec3 z = glm::vec3(transform[2]);
@@ -49,7 +48,44 @@ void BoxCollider::SyncFromTransform(const glm::mat4& transform)
     z = glm::cross(x, y);
     z = safeNorm(z, { 0,0,1 });
 
-    m_Orientation[0] = x;
-    m_Orientation[1] = y;
-    m_Orientation[2] = z;
-}
\ No newline at end of file
+    glm::mat3 orientation(1.0f);
+    orientation[0] = x;
+    orientation[1] = y;
+    orientation[2] = z;
+    return orientation;
+}
+
+void BoxCollider::SyncFromTransform(const glm::mat4& transform)
+{
+    m_Center = glm::vec3(transform[3]);
+    m_Orientation = RotationFromTransform(transform);
+}
+
+CapsuleCollider::CapsuleCollider(float radius, float halfHeight)
+    : m_Radius(std::max(radius, 0.01f)), m_HalfHeight(std::max(halfHeight, 0.0f)) {}
+
+void CapsuleCollider::SyncFromTransform(const glm::mat4& transform)
+{
+    m_Center = glm::vec3(transform[3]);
+    m_Orientation = RotationFromTransform(transform);
+}
+
+CylinderCollider::CylinderCollider(float radius, float halfHeight)
+    : m_Radius(std::max(radius, 0.01f)), m_HalfHeight(std::max(halfHeight, 0.01f)) {}
+
+void CylinderCollider::SyncFromTransform(const glm::mat4& transform)
+{
+    m_Center = glm::vec3(transform[3]);
+    m_Orientation = RotationFromTransform(transform);
+}
+
+void Collider::SyncFromTransform(const glm::mat4& transform) {
+    switch (GetType()) {
+    case Type::Sphere: As<SphereCollider>()->SyncFromTransform(transform); break;
+    case Type::Plane: As<PlaneCollider>()->SyncFromTransform(transform); break;
+    case Type::Box: As<BoxCollider>()->SyncFromTransform(transform); break;
+    case Type::Capsule: As<CapsuleCollider>()->SyncFromTransform(transform); break;
+    case Type::Cylinder: As<CylinderCollider>()->SyncFromTransform(transform); break;
+    case Type::None: break;
+    }
+}
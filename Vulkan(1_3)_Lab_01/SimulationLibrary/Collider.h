@@ -1,25 +1,17 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
+#include <variant>
 #include <glm/glm.hpp>
 
-class Collider {
-public:
-    enum class Type {
-        Sphere,
-        Plane,
-        Box
-    };
-
-    virtual ~Collider() = default;
-    virtual Type GetType() const = 0;
-    virtual void SyncFromTransform(const glm::mat4& transform) = 0;
-};
+// Collider shapes are plain values. A body stores one of them inside a Collider (a tagged
+// union), so there is no base class, no virtual call and no allocation per body.
 
-class SphereCollider : public Collider {
+class SphereCollider {
 public:
     explicit SphereCollider(float radius = 0.5f);
 
-    Type GetType() const override { return Type::Sphere; }
-    void SyncFromTransform(const glm::mat4& transform) override;
+    void SyncFromTransform(const glm::mat4& transform);
 
     float GetRadius() const { return m_Radius; }
     void SetRadius(float radius) { m_Radius = radius; }
@@ -30,12 +22,11 @@ private:
     float m_Radius = 0.5f;
 };
 
-class PlaneCollider : public Collider {
+class PlaneCollider {
 public:
     explicit PlaneCollider(const glm::vec3& normal = {0.0f, 1.0f, 0.0f});
 
-    Type GetType() const override { return Type::Plane; }
-    void SyncFromTransform(const glm::mat4& transform) override;
+    void SyncFromTransform(const glm::mat4& transform);
 
     const glm::vec3& GetNormal() const { return m_Normal; }
     const glm::vec3& GetPoint() const { return m_Point; }
@@ -46,12 +37,11 @@ private:
     glm::vec3 m_Point{0.0f};
 };
 
-class BoxCollider : public Collider {
+class BoxCollider {
 public:
     explicit BoxCollider(const glm::vec3& halfExtents = {0.5f, 0.5f, 0.5f});
 
-    Type GetType() const override { return Type::Box; }
-    void SyncFromTransform(const glm::mat4& transform) override;
+    void SyncFromTransform(const glm::mat4& transform);
 
     const glm::vec3& GetCenter() const { return m_Center; }
     const glm::mat3& GetOrientation() const { return m_Orientation; } // columns = axes
@@ -61,4 +51,83 @@ private:
     glm::vec3 m_Center{0.0f};
     glm::mat3 m_Orientation{1.0f};
     glm::vec3 m_HalfExtents{0.5f, 0.5f, 0.5f};
-};
\ No newline at end of file
+};
+
+// Segment along the local Y axis (from -halfHeight to +halfHeight) swept by a sphere.
+class CapsuleCollider {
+public:
+    explicit CapsuleCollider(float radius = 0.5f, float halfHeight = 0.5f);
+
+    void SyncFromTransform(const glm::mat4& transform);
+
+    const glm::vec3& GetCenter() const { return m_Center; }
+    const glm::mat3& GetOrientation() const { return m_Orientation; }
+    float GetRadius() const { return m_Radius; }
+    float GetHalfHeight() const { return m_HalfHeight; }
+
+private:
+    glm::vec3 m_Center{0.0f};
+    glm::mat3 m_Orientation{1.0f};
+    float m_Radius = 0.5f;
+    float m_HalfHeight = 0.5f;
+};
+
+// Flat-capped cylinder along the local Y axis.
+class CylinderCollider {
+public:
+    explicit CylinderCollider(float radius = 0.5f, float halfHeight = 0.5f);
+
+    void SyncFromTransform(const glm::mat4& transform);
+
+    const glm::vec3& GetCenter() const { return m_Center; }
+    const glm::mat3& GetOrientation() const { return m_Orientation; }
+    float GetRadius() const { return m_Radius; }
+    float GetHalfHeight() const { return m_HalfHeight; }
+
+private:
+    glm::vec3 m_Center{0.0f};
+    glm::mat3 m_Orientation{1.0f};
+    float m_Radius = 0.5f;
+    float m_HalfHeight = 0.5f;
+};
+
+// One of the shapes above, or none. As<T>() is a tag compare rather than a dynamic_cast;
+// pairs of colliders are routed by SimCollision::Collide() (CollisionDispatch.h).
+class Collider {
+public:
+    // Same order as the Shape alternatives, so a type is its variant index.
+    enum class Type : uint8_t {
+        None,
+        Sphere,
+        Plane,
+        Box,
+        Capsule,
+        Cylinder
+    };
+
+    using Shape = std::variant<std::monostate, SphereCollider, PlaneCollider, BoxCollider, CapsuleCollider, CylinderCollider>;
+    static constexpr size_t kTypeCount = std::variant_size_v<Shape>;
+
+    Collider() = default;
+    Collider(const SphereCollider& sphere) : m_Shape(sphere) {}
+    Collider(const PlaneCollider& plane) : m_Shape(plane) {}
+    Collider(const BoxCollider& box) : m_Shape(box) {}
+    Collider(const CapsuleCollider& capsule) : m_Shape(capsule) {}
+    Collider(const CylinderCollider& cylinder) : m_Shape(cylinder) {}
+
+    Type GetType() const { return static_cast<Type>(m_Shape.index()); }
+    bool IsEmpty() const { return GetType() == Type::None; }
+
+    void SyncFromTransform(const glm::mat4& transform);
+
+    // nullptr when the collider holds a different shape
+    template <typename T>
+    T* As() { return std::get_if<T>(&m_Shape); }
+    template <typename T>
+    const T* As() const { return std::get_if<T>(&m_Shape); }
+
+    const Shape& GetShape() const { return m_Shape; }
+
+private:
+    Shape m_Shape;
+};
@@ -0,0 +1,186 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include "Collider.h"
+#include "CollisionUtil.h"
+#include "ConvexCollision.h"
+
+// Narrowphase dispatch over Collider shapes.
+// Collide() indexes a (typeA, typeB) table of function pointers that is built at compile time
+// from the PairTest specialisations below. Each mixed pair is written once; the swapped order
+// reuses it and flips the normal, so the contact normal always points from A to B.
+// Any other pair of convex shapes goes through GJK/EPA (ConvexCollision.h), and a convex shape
+// against a plane through its support point, so a new shape only needs a ToConvex() overload.
+// Pairs without a test (plane vs plane, empty colliders) never report a contact.
+namespace SimCollision
+{
+    inline OBB ToOBB(const BoxCollider& box)
+    {
+        return { box.GetCenter(), box.GetOrientation(), box.GetHalfExtents() };
+    }
+
+    inline ConvexShape ToConvex(const SphereCollider& sphere)
+    {
+        return ConvexShape::Sphere(sphere.GetCenter(), sphere.GetRadius());
+    }
+
+    inline ConvexShape ToConvex(const BoxCollider& box)
+    {
+        return ConvexShape::Box(ToOBB(box));
+    }
+
+    inline ConvexShape ToConvex(const CapsuleCollider& capsule)
+    {
+        return ConvexShape::Capsule(capsule.GetCenter(), capsule.GetOrientation(), capsule.GetRadius(), capsule.GetHalfHeight());
+    }
+
+    inline ConvexShape ToConvex(const CylinderCollider& cylinder)
+    {
+        return ConvexShape::Cylinder(cylinder.GetCenter(), cylinder.GetOrientation(), cylinder.GetRadius(), cylinder.GetHalfHeight());
+    }
+
+    // Shapes with a ToConvex() overload above.
+    template <typename T>
+    inline constexpr bool kIsConvex = requires(const T& shape) { ToConvex(shape); };
+
+    // False for planes and empty colliders.
+    inline bool ToConvex(const Collider& collider, ConvexShape& out)
+    {
+        return std::visit([&](const auto& shape)
+            {
+                if constexpr (kIsConvex<std::decay_t<decltype(shape)>>) { out = ToConvex(shape); return true; }
+                else return false;
+            }, collider.GetShape());
+    }
+
+    template <typename A, typename B>
+    struct PairTest
+    {
+        static constexpr bool kDefined = false;
+    };
+
+    template <>
+    struct PairTest<SphereCollider, SphereCollider>
+    {
+        static constexpr bool kDefined = true;
+        static bool Run(const SphereCollider& a, const SphereCollider& b, Contact& out)
+        {
+            return SphereVsSphere(a.GetCenter(), a.GetRadius(), b.GetCenter(), b.GetRadius(), out);
+        }
+    };
+
+    template <>
+    struct PairTest<SphereCollider, PlaneCollider>
+    {
+        static constexpr bool kDefined = true;
+        static bool Run(const SphereCollider& a, const PlaneCollider& b, Contact& out)
+        {
+            if (!SphereVsPlane(a.GetCenter(), a.GetRadius(), b.GetNormal(), b.GetPoint(), out)) return false;
+            out.normal = -out.normal; // plane normal points plane -> sphere
+            return true;
+        }
+    };
+
+    template <>
+    struct PairTest<SphereCollider, BoxCollider>
+    {
+        static constexpr bool kDefined = true;
+        static bool Run(const SphereCollider& a, const BoxCollider& b, Contact& out)
+        {
+            if (!SphereVsOBB(a.GetCenter(), a.GetRadius(), ToOBB(b), out)) return false;
+            out.normal = -out.normal; // SphereVsOBB reports box -> sphere
+            return true;
+        }
+    };
+
+    template <>
+    struct PairTest<BoxCollider, PlaneCollider>
+    {
+        static constexpr bool kDefined = true;
+        static bool Run(const BoxCollider& a, const PlaneCollider& b, Contact& out)
+        {
+            if (!OBBVsPlane(ToOBB(a), b.GetNormal(), b.GetPoint(), out)) return false;
+            out.normal = -out.normal;
+            return true;
+        }
+    };
+
+    template <>
+    struct PairTest<BoxCollider, BoxCollider>
+    {
+        static constexpr bool kDefined = true;
+        static bool Run(const BoxCollider& a, const BoxCollider& b, Contact& out)
+        {
+            return OBBVsOBB(ToOBB(a), ToOBB(b), out);
+        }
+    };
+
+    using PairFunction = bool (*)(const Collider& a, const Collider& b, Contact& out);
+
+    namespace Detail
+    {
+        template <size_t I>
+        using ShapeAt = std::variant_alternative_t<I, Collider::Shape>;
+
+        // Only ever called with colliders whose tags are (IA, IB), so the As<>() calls cannot fail.
+        template <size_t IA, size_t IB>
+        bool CollidePair(const Collider& a, const Collider& b, Contact& out)
+        {
+            using A = ShapeAt<IA>;
+            using B = ShapeAt<IB>;
+
+            if constexpr (PairTest<A, B>::kDefined)
+            {
+                return PairTest<A, B>::Run(*a.As<A>(), *b.As<B>(), out);
+            }
+            else if constexpr (PairTest<B, A>::kDefined)
+            {
+                if (!PairTest<B, A>::Run(*b.As<B>(), *a.As<A>(), out)) return false;
+                out.normal = -out.normal;
+                return true;
+            }
+            else if constexpr (kIsConvex<A> && kIsConvex<B>)
+            {
+                return ConvexVsConvex(ToConvex(*a.As<A>()), ToConvex(*b.As<B>()), out);
+            }
+            else if constexpr (kIsConvex<A> && std::is_same_v<B, PlaneCollider>)
+            {
+                const PlaneCollider& plane = *b.As<B>();
+                if (!ConvexVsPlane(ToConvex(*a.As<A>()), plane.GetNormal(), plane.GetPoint(), out)) return false;
+                out.normal = -out.normal;
+                return true;
+            }
+            else if constexpr (std::is_same_v<A, PlaneCollider> && kIsConvex<B>)
+            {
+                const PlaneCollider& plane = *a.As<A>();
+                return ConvexVsPlane(ToConvex(*b.As<B>()), plane.GetNormal(), plane.GetPoint(), out);
+            }
+            else
+            {
+                out = {};
+                return false;
+            }
+        }
+
+        template <size_t... I>
+        constexpr std::array<PairFunction, sizeof...(I)> MakePairTable(std::index_sequence<I...>)
+        {
+            constexpr size_t n = Collider::kTypeCount;
+            return { &CollidePair<I / n, I % n>... };
+        }
+    }
+
+    // Row = type of A, column = type of B.
+    inline constexpr std::array<PairFunction, Collider::kTypeCount * Collider::kTypeCount> kPairTable =
+        Detail::MakePairTable(std::make_index_sequence<Collider::kTypeCount * Collider::kTypeCount>{});
+
+    inline bool Collide(const Collider& a, const Collider& b, Contact& out)
+    {
+        const size_t row = static_cast<size_t>(a.GetType());
+        const size_t column = static_cast<size_t>(b.GetType());
+        return kPairTable[row * Collider::kTypeCount + column](a, b, out);
+    }
+}
@@ -0,0 +1,394 @@
+#include "CollisionUtil.h"
+
+#if SIM_HAS_X86
+#include <immintrin.h>
+#endif
+
+// The kernels are written once against a small lane wrapper and instantiated per width.
+// GCC/Clang cannot apply a target attribute to a template instantiation, so there the AVX2
+// width is only built when the whole TU is compiled with AVX2 enabled.
+#if SIM_HAS_X86 && (defined(_MSC_VER) || defined(__AVX2__))
+#define SIM_COLLISION_AVX2 1
+#else
+#define SIM_COLLISION_AVX2 0
+#endif
+
+namespace SimCollision
+{
+    namespace
+    {
+        glm::vec3 Load3(const Vec3Stream& s, size_t i)
+        {
+            return { s.x[i], s.y[i], s.z[i] };
+        }
+
+        glm::mat3 LoadAxes(const Vec3Stream* axes, size_t i)
+        {
+            glm::mat3 m(1.0f);
+            m[0] = Load3(axes[0], i);
+            m[1] = Load3(axes[1], i);
+            m[2] = Load3(axes[2], i);
+            return m;
+        }
+
+        void Emit(BatchContacts& out, size_t index, const Contact& c)
+        {
+            out.pairIndex.push_back(static_cast<uint32_t>(index));
+            out.normalX.push_back(c.normal.x);
+            out.normalY.push_back(c.normal.y);
+            out.normalZ.push_back(c.normal.z);
+            out.penetration.push_back(c.penetration);
+        }
+
+        // ---- Scalar reference (used for tails and the Scalar level) ----
+
+        void SphereVsPlaneScalar(const SpherePlaneBatch& b, size_t begin, BatchContacts& out)
+        {
+            for (size_t i = begin; i < b.count; ++i) {
+                Contact c{};
+                if (SphereVsPlane(Load3(b.center, i), b.radius[i], Load3(b.planeNormal, i), Load3(b.planePoint, i), c)) Emit(out, i, c);
+            }
+        }
+
+        void OBBVsPlaneScalar(const OBBPlaneBatch& b, size_t begin, BatchContacts& out)
+        {
+            for (size_t i = begin; i < b.count; ++i) {
+                const OBB obb{ Load3(b.center, i), LoadAxes(b.axis, i), Load3(b.halfExtents, i) };
+                Contact c{};
+                if (OBBVsPlane(obb, Load3(b.planeNormal, i), Load3(b.planePoint, i), c)) Emit(out, i, c);
+            }
+        }
+
+        void SphereVsOBBScalar(const SphereOBBBatch& b, size_t begin, BatchContacts& out)
+        {
+            for (size_t i = begin; i < b.count; ++i) {
+                const OBB obb{ Load3(b.obbCenter, i), LoadAxes(b.obbAxis, i), Load3(b.obbHalfExtents, i) };
+                Contact c{};
+                if (SphereVsOBB(Load3(b.sphereCenter, i), b.sphereRadius[i], obb, c)) Emit(out, i, c);
+            }
+        }
+
+        void SphereVsCapsuleScalar(const SphereCapsuleBatch& b, size_t begin, BatchContacts& out)
+        {
+            for (size_t i = begin; i < b.count; ++i) {
+                Contact c{};
+                if (SphereVsCapsule(Load3(b.sphereCenter, i), b.sphereRadius[i], Load3(b.capsuleA, i), Load3(b.capsuleB, i), b.capsuleRadius[i], c)) Emit(out, i, c);
+            }
+        }
+
+#if SIM_HAS_X86
+        // ---- Lane wrappers ----
+
+        struct LanesSSE
+        {
+            using V = __m128;
+            static constexpr size_t kWidth = 4;
+
+            static V Load(const float* p) { return _mm_loadu_ps(p); }
+            static void Store(float* p, V v) { _mm_storeu_ps(p, v); }
+            static V Set(float f) { return _mm_set1_ps(f); }
+            static V Add(V a, V b) { return _mm_add_ps(a, b); }
+            static V Sub(V a, V b) { return _mm_sub_ps(a, b); }
+            static V Mul(V a, V b) { return _mm_mul_ps(a, b); }
+            static V Div(V a, V b) { return _mm_div_ps(a, b); }
+            static V Min(V a, V b) { return _mm_min_ps(a, b); }
+            static V Max(V a, V b) { return _mm_max_ps(a, b); }
+            static V Sqrt(V a) { return _mm_sqrt_ps(a); }
+            static V Abs(V a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+            static V CmpLE(V a, V b) { return _mm_cmple_ps(a, b); }
+            static V CmpGT(V a, V b) { return _mm_cmpgt_ps(a, b); }
+            static V CmpGE(V a, V b) { return _mm_cmpge_ps(a, b); }
+            static V Select(V mask, V a, V b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+            static int Mask(V m) { return _mm_movemask_ps(m); }
+        };
+
+#if SIM_COLLISION_AVX2
+        struct LanesAVX
+        {
+            using V = __m256;
+            static constexpr size_t kWidth = 8;
+
+            static V Load(const float* p) { return _mm256_loadu_ps(p); }
+            static void Store(float* p, V v) { _mm256_storeu_ps(p, v); }
+            static V Set(float f) { return _mm256_set1_ps(f); }
+            static V Add(V a, V b) { return _mm256_add_ps(a, b); }
+            static V Sub(V a, V b) { return _mm256_sub_ps(a, b); }
+            static V Mul(V a, V b) { return _mm256_mul_ps(a, b); }
+            static V Div(V a, V b) { return _mm256_div_ps(a, b); }
+            static V Min(V a, V b) { return _mm256_min_ps(a, b); }
+            static V Max(V a, V b) { return _mm256_max_ps(a, b); }
+            static V Sqrt(V a) { return _mm256_sqrt_ps(a); }
+            static V Abs(V a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+            static V CmpLE(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+            static V CmpGT(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+            static V CmpGE(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+            static V Select(V mask, V a, V b) { return _mm256_blendv_ps(b, a, mask); }
+            static int Mask(V m) { return _mm256_movemask_ps(m); }
+        };
+#endif
+
+        template <typename L>
+        struct Vec3L
+        {
+            typename L::V x, y, z;
+        };
+
+        template <typename L>
+        Vec3L<L> Load3L(const Vec3Stream& s, size_t i)
+        {
+            return { L::Load(s.x + i), L::Load(s.y + i), L::Load(s.z + i) };
+        }
+
+        template <typename L>
+        Vec3L<L> Sub3(const Vec3L<L>& a, const Vec3L<L>& b)
+        {
+            return { L::Sub(a.x, b.x), L::Sub(a.y, b.y), L::Sub(a.z, b.z) };
+        }
+
+        template <typename L>
+        typename L::V Dot3(const Vec3L<L>& a, const Vec3L<L>& b)
+        {
+            return L::Add(L::Add(L::Mul(a.x, b.x), L::Mul(a.y, b.y)), L::Mul(a.z, b.z));
+        }
+
+        // Appends the lanes set in 'mask' to the compacted output.
+        template <typename L>
+        void EmitLanes(BatchContacts& out, size_t base, int mask, const Vec3L<L>& n, typename L::V pen)
+        {
+            alignas(32) float nx[L::kWidth], ny[L::kWidth], nz[L::kWidth], p[L::kWidth];
+            L::Store(nx, n.x);
+            L::Store(ny, n.y);
+            L::Store(nz, n.z);
+            L::Store(p, pen);
+
+            for (size_t lane = 0; lane < L::kWidth; ++lane) {
+                if (!(mask & (1 << lane))) continue;
+                out.pairIndex.push_back(static_cast<uint32_t>(base + lane));
+                out.normalX.push_back(nx[lane]);
+                out.normalY.push_back(ny[lane]);
+                out.normalZ.push_back(nz[lane]);
+                out.penetration.push_back(p[lane]);
+            }
+        }
+
+        // ---- Kernels (return the number of pairs processed; caller finishes the tail) ----
+
+        template <typename L>
+        size_t SphereVsPlaneLanes(const SpherePlaneBatch& b, BatchContacts& out)
+        {
+            size_t i = 0;
+            for (; i + L::kWidth <= b.count; i += L::kWidth) {
+                const Vec3L<L> c = Load3L<L>(b.center, i);
+                const Vec3L<L> n = Load3L<L>(b.planeNormal, i);
+                const Vec3L<L> p = Load3L<L>(b.planePoint, i);
+                const typename L::V r = L::Load(b.radius + i);
+
+                const typename L::V dist = Dot3<L>(Sub3<L>(c, p), n);
+                const int mask = L::Mask(L::CmpLE(dist, r));
+                if (!mask) continue;
+
+                EmitLanes<L>(out, i, mask, n, L::Sub(r, dist));
+            }
+            return i;
+        }
+
+        template <typename L>
+        size_t OBBVsPlaneLanes(const OBBPlaneBatch& b, BatchContacts& out)
+        {
+            size_t i = 0;
+            for (; i + L::kWidth <= b.count; i += L::kWidth) {
+                const Vec3L<L> center = Load3L<L>(b.center, i);
+                const Vec3L<L> he = Load3L<L>(b.halfExtents, i);
+                const Vec3L<L> n = Load3L<L>(b.planeNormal, i);
+                const Vec3L<L> p = Load3L<L>(b.planePoint, i);
+
+                // Same as SupportDistanceAlongNormal: |R^T n| . halfExtents
+                const typename L::V n0 = L::Abs(Dot3<L>(Load3L<L>(b.axis[0], i), n));
+                const typename L::V n1 = L::Abs(Dot3<L>(Load3L<L>(b.axis[1], i), n));
+                const typename L::V n2 = L::Abs(Dot3<L>(Load3L<L>(b.axis[2], i), n));
+                const typename L::V projected = L::Add(L::Add(L::Mul(n0, he.x), L::Mul(n1, he.y)), L::Mul(n2, he.z));
+
+                const typename L::V dist = Dot3<L>(Sub3<L>(center, p), n);
+                const int mask = L::Mask(L::CmpLE(dist, projected));
+                if (!mask) continue;
+
+                EmitLanes<L>(out, i, mask, n, L::Sub(projected, dist));
+            }
+            return i;
+        }
+
+        template <typename L>
+        size_t SphereVsOBBLanes(const SphereOBBBatch& b, BatchContacts& out)
+        {
+            using V = typename L::V;
+            const V eps = L::Set(kEps);
+            const V zero = L::Set(0.0f);
+            const V one = L::Set(1.0f);
+            const V minusOne = L::Set(-1.0f);
+
+            size_t i = 0;
+            for (; i + L::kWidth <= b.count; i += L::kWidth) {
+                const Vec3L<L> sc = Load3L<L>(b.sphereCenter, i);
+                const V r = L::Load(b.sphereRadius + i);
+                const Vec3L<L> oc = Load3L<L>(b.obbCenter, i);
+                const Vec3L<L> he = Load3L<L>(b.obbHalfExtents, i);
+                const Vec3L<L> a0 = Load3L<L>(b.obbAxis[0], i);
+                const Vec3L<L> a1 = Load3L<L>(b.obbAxis[1], i);
+                const Vec3L<L> a2 = Load3L<L>(b.obbAxis[2], i);
+
+                // Sphere centre in box space, clamped to the extents -> closest point
+                const Vec3L<L> d = Sub3<L>(sc, oc);
+                const V lx = Dot3<L>(a0, d);
+                const V ly = Dot3<L>(a1, d);
+                const V lz = Dot3<L>(a2, d);
+                const V cx = L::Min(L::Max(lx, L::Sub(zero, he.x)), he.x);
+                const V cy = L::Min(L::Max(ly, L::Sub(zero, he.y)), he.y);
+                const V cz = L::Min(L::Max(lz, L::Sub(zero, he.z)), he.z);
+
+                const Vec3L<L> closest{
+                    L::Add(oc.x, L::Add(L::Add(L::Mul(a0.x, cx), L::Mul(a1.x, cy)), L::Mul(a2.x, cz))),
+                    L::Add(oc.y, L::Add(L::Add(L::Mul(a0.y, cx), L::Mul(a1.y, cy)), L::Mul(a2.y, cz))),
+                    L::Add(oc.z, L::Add(L::Add(L::Mul(a0.z, cx), L::Mul(a1.z, cy)), L::Mul(a2.z, cz)))
+                };
+
+                const Vec3L<L> delta = Sub3<L>(sc, closest);
+                const V dist2 = Dot3<L>(delta, delta);
+                const int mask = L::Mask(L::CmpLE(dist2, L::Mul(r, r)));
+                if (!mask) continue;
+
+                const V dist = L::Sqrt(L::Max(dist2, eps));
+                Vec3L<L> n{ L::Div(delta.x, dist), L::Div(delta.y, dist), L::Div(delta.z, dist) };
+
+                // Centre inside the box: push out along the local axis of largest offset
+                const V inside = L::CmpLE(dist, L::Set(1e-5f));
+                if (L::Mask(inside)) {
+                    const V ax = L::Abs(lx), ay = L::Abs(ly), az = L::Abs(lz);
+                    const V pickY = L::CmpGT(ay, ax);
+                    const V best = L::Select(pickY, ay, ax);
+                    const V pickZ = L::CmpGT(az, best);
+
+                    const V local = L::Select(pickZ, lz, L::Select(pickY, ly, lx));
+                    const V sign = L::Select(L::CmpGE(local, zero), one, minusOne);
+                    Vec3L<L> axis{
+                        L::Select(pickZ, a2.x, L::Select(pickY, a1.x, a0.x)),
+                        L::Select(pickZ, a2.y, L::Select(pickY, a1.y, a0.y)),
+                        L::Select(pickZ, a2.z, L::Select(pickY, a1.z, a0.z))
+                    };
+                    axis = { L::Mul(axis.x, sign), L::Mul(axis.y, sign), L::Mul(axis.z, sign) };
+
+                    const V len2 = Dot3<L>(axis, axis);
+                    const V valid = L::CmpGT(len2, eps);
+                    const V invLen = L::Div(one, L::Sqrt(L::Max(len2, eps)));
+                    const Vec3L<L> fallbackN{
+                        L::Select(valid, L::Mul(axis.x, invLen), one),
+                        L::Select(valid, L::Mul(axis.y, invLen), zero),
+                        L::Select(valid, L::Mul(axis.z, invLen), zero)
+                    };
+
+                    n = { L::Select(inside, fallbackN.x, n.x), L::Select(inside, fallbackN.y, n.y), L::Select(inside, fallbackN.z, n.z) };
+                }
+
+                EmitLanes<L>(out, i, mask, n, L::Sub(r, dist));
+            }
+            return i;
+        }
+
+        template <typename L>
+        size_t SphereVsCapsuleLanes(const SphereCapsuleBatch& b, BatchContacts& out)
+        {
+            using V = typename L::V;
+            const V eps = L::Set(kEps);
+            const V zero = L::Set(0.0f);
+            const V one = L::Set(1.0f);
+
+            size_t i = 0;
+            for (; i + L::kWidth <= b.count; i += L::kWidth) {
+                const Vec3L<L> sc = Load3L<L>(b.sphereCenter, i);
+                const V sr = L::Load(b.sphereRadius + i);
+                const Vec3L<L> ca = Load3L<L>(b.capsuleA, i);
+                const Vec3L<L> cb = Load3L<L>(b.capsuleB, i);
+                const V cr = L::Load(b.capsuleRadius + i);
+
+                const Vec3L<L> ab = Sub3<L>(cb, ca);
+                V t = L::Div(Dot3<L>(Sub3<L>(sc, ca), ab), Dot3<L>(ab, ab));
+                t = L::Min(L::Max(t, zero), one);
+
+                const Vec3L<L> closest{ L::Add(ca.x, L::Mul(t, ab.x)), L::Add(ca.y, L::Mul(t, ab.y)), L::Add(ca.z, L::Mul(t, ab.z)) };
+                const Vec3L<L> delta = Sub3<L>(sc, closest);
+                const V dist2 = Dot3<L>(delta, delta);
+                const V radiusSum = L::Add(sr, cr);
+
+                const int mask = L::Mask(L::CmpLE(dist2, L::Mul(radiusSum, radiusSum)));
+                if (!mask) continue;
+
+                const V dist = L::Sqrt(L::Max(dist2, eps));
+                const Vec3L<L> n{ L::Div(delta.x, dist), L::Div(delta.y, dist), L::Div(delta.z, dist) };
+                EmitLanes<L>(out, i, mask, n, L::Sub(radiusSum, dist));
+            }
+            return i;
+        }
+#endif
+
+        // Runs the widest available kernel, then the scalar reference for the remainder.
+        template <typename Batch, typename SseKernel, typename AvxKernel, typename ScalarKernel>
+        void Dispatch(const Batch& batch, BatchContacts& out, SimSimd::SimdLevel level, SseKernel sse, AvxKernel avx, ScalarKernel scalar)
+        {
+            out.Clear();
+            size_t done = 0;
+
+            if (level > SimSimd::GetBestSimdLevel()) level = SimSimd::GetBestSimdLevel();
+#if SIM_HAS_X86
+            if (level == SimSimd::SimdLevel::AVX2) {
+#if SIM_COLLISION_AVX2
+                done = avx(batch, out);
+#else
+                (void)avx;
+                done = sse(batch, out);
+#endif
+            }
+            else if (level == SimSimd::SimdLevel::SSE2) {
+                done = sse(batch, out);
+            }
+#else
+            (void)sse;
+            (void)avx;
+#endif
+            scalar(batch, done, out);
+        }
+    }
+
+#if SIM_HAS_X86
+#if SIM_COLLISION_AVX2
+#define SIM_AVX_KERNEL(name) name<LanesAVX>
+#else
+#define SIM_AVX_KERNEL(name) name<LanesSSE>
+#endif
+#define SIM_SSE_KERNEL(name) name<LanesSSE>
+#else
+#define SIM_AVX_KERNEL(name) nullptr
+#define SIM_SSE_KERNEL(name) nullptr
+#endif
+
+    void SphereVsPlaneBatch(const SpherePlaneBatch& batch, BatchContacts& out, SimSimd::SimdLevel level)
+    {
+        Dispatch(batch, out, level, SIM_SSE_KERNEL(SphereVsPlaneLanes), SIM_AVX_KERNEL(SphereVsPlaneLanes), SphereVsPlaneScalar);
+    }
+
+    void OBBVsPlaneBatch(const OBBPlaneBatch& batch, BatchContacts& out, SimSimd::SimdLevel level)
+    {
+        Dispatch(batch, out, level, SIM_SSE_KERNEL(OBBVsPlaneLanes), SIM_AVX_KERNEL(OBBVsPlaneLanes), OBBVsPlaneScalar);
+    }
+
+    void SphereVsOBBBatch(const SphereOBBBatch& batch, BatchContacts& out, SimSimd::SimdLevel level)
+    {
+        Dispatch(batch, out, level, SIM_SSE_KERNEL(SphereVsOBBLanes), SIM_AVX_KERNEL(SphereVsOBBLanes), SphereVsOBBScalar);
+    }
+
+    void SphereVsCapsuleBatch(const SphereCapsuleBatch& batch, BatchContacts& out, SimSimd::SimdLevel level)
+    {
+        Dispatch(batch, out, level, SIM_SSE_KERNEL(SphereVsCapsuleLanes), SIM_AVX_KERNEL(SphereVsCapsuleLanes), SphereVsCapsuleScalar);
+    }
+
+#undef SIM_AVX_KERNEL
+#undef SIM_SSE_KERNEL
+}
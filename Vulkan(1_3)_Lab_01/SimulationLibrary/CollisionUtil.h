@@ -2,7 +2,10 @@
 #include <glm/glm.hpp>
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <limits>
+#include <vector>
+#include "SimdSupport.h"
 
 namespace SimCollision
 {
@@ -22,6 +25,61 @@ namespace SimCollision
         float penetration = 0.0f;
     };
 
+    struct AABB
+    {
+        glm::vec3 min{ 0.0f };
+        glm::vec3 max{ 0.0f };
+    };
+
+    // Candidate pair from a broadphase, by proxy user data (a < b).
+    struct BroadphasePair
+    {
+        uint32_t a = 0;
+        uint32_t b = 0;
+    };
+
+    inline bool AABBOverlap(const AABB& a, const AABB& b)
+    {
+        return a.min.x <= b.max.x && a.max.x >= b.min.x &&
+               a.min.y <= b.max.y && a.max.y >= b.min.y &&
+               a.min.z <= b.max.z && a.max.z >= b.min.z;
+    }
+
+    inline AABB SphereBounds(const glm::vec3& center, float radius)
+    {
+        return { center - glm::vec3(radius), center + glm::vec3(radius) };
+    }
+
+    inline AABB OBBBounds(const OBB& obb)
+    {
+        const glm::mat3& R = obb.orientation;
+        const glm::vec3 e{
+            std::abs(R[0].x) * obb.halfExtents.x + std::abs(R[1].x) * obb.halfExtents.y + std::abs(R[2].x) * obb.halfExtents.z,
+            std::abs(R[0].y) * obb.halfExtents.x + std::abs(R[1].y) * obb.halfExtents.y + std::abs(R[2].y) * obb.halfExtents.z,
+            std::abs(R[0].z) * obb.halfExtents.x + std::abs(R[1].z) * obb.halfExtents.y + std::abs(R[2].z) * obb.halfExtents.z
+        };
+        return { obb.center - e, obb.center + e };
+    }
+
+    // Bounds of the slab just behind a plane (from the surface to 'depth' below it), clipped to
+    // +-extent. Only axis-aligned normals produce a tight slab; tilted planes cover the whole extent.
+    inline AABB PlaneSlabBounds(const glm::vec3& point, const glm::vec3& normal, float depth, float extent)
+    {
+        AABB out{ glm::vec3(-extent), glm::vec3(extent) };
+        for (int axis = 0; axis < 3; ++axis) {
+            if (std::abs(normal[axis]) < 0.999f) continue;
+            if (normal[axis] > 0.0f) {
+                out.min[axis] = point[axis] - depth;
+                out.max[axis] = point[axis];
+            }
+            else {
+                out.min[axis] = point[axis];
+                out.max[axis] = point[axis] + depth;
+            }
+        }
+        return out;
+    }
+
     inline glm::vec3 SafeNormalize(const glm::vec3& v, const glm::vec3& fallback = { 1,0,0 })
     {
         const float len2 = glm::dot(v, v);
@@ -61,6 +119,23 @@ namespace SimCollision
         return obb.center + obb.orientation * local;
     }
 
+    inline bool SphereVsSphere(const glm::vec3& centerA, float radiusA, const glm::vec3& centerB, float radiusB, Contact& out)
+    {
+        out = {};
+        const glm::vec3 delta = centerB - centerA;
+        const float dist2 = glm::dot(delta, delta);
+        const float radiusSum = radiusA + radiusB;
+
+        if (dist2 >= radiusSum * radiusSum) return false;
+
+        const float dist = std::sqrt(dist2);
+        out.hit = true;
+        out.normal = (dist > kEps) ? delta / dist : glm::vec3(0.0f, 1.0f, 0.0f); // A -> B
+        out.penetration = radiusSum - dist;
+
+        return true;
+    }
+
     inline bool SphereVsOBB(const glm::vec3& sphereCenter, float radius, const OBB& obb, Contact& out)
     {
         out = {};
@@ -99,9 +174,15 @@ namespace SimCollision
         return true;
     }
 
-    inline bool OBBVsOBB(const OBB& A, const OBB& B, Contact& out)
+    // SAT axis ids used by OBBVsOBB: 0-2 = A's axes, 3-5 = B's axes, 6-14 = A[i] x B[j] (6 + 3*i + j).
+    constexpr int kNoSATAxis = -1;
+
+    // 'decidingAxis' receives the separating axis when this returns false, otherwise the
+    // minimum-overlap axis.
+    inline bool OBBVsOBB(const OBB& A, const OBB& B, Contact& out, int& decidingAxis)
     {
         out = {};
+        decidingAxis = kNoSATAxis;
 
         const glm::mat3 Au = OrthonormalizeColumns(A.orientation);
         const glm::mat3 Bu = OrthonormalizeColumns(B.orientation);
@@ -126,13 +207,15 @@ namespace SimCollision
 
         float minOverlap = std::numeric_limits<float>::infinity();
         glm::vec3 bestAxisWorld = Au[0];
+        int bestAxis = 0;
 
-        auto considerAxis = [&](const glm::vec3& axisWorld, float overlap)
+        auto considerAxis = [&](const glm::vec3& axisWorld, float overlap, int axisId)
         {
             if (overlap < minOverlap)
             {
                 minOverlap = overlap;
                 bestAxisWorld = axisWorld;
+                bestAxis = axisId;
             }
         };
 
@@ -144,9 +227,9 @@ namespace SimCollision
             ra = aE[i];
             rb = bE[0] * AbsR[i][0] + bE[1] * AbsR[i][1] + bE[2] * AbsR[i][2];
             dist = std::abs(t[i]);
-            if (dist > ra + rb) return false;
+            if (dist > ra + rb) { decidingAxis = i; return false; }
             overlap = (ra + rb) - dist;
-            considerAxis(Au[i], overlap);
+            considerAxis(Au[i], overlap, i);
         }
 
         // Test B’s axes
@@ -155,9 +238,9 @@ namespace SimCollision
             ra = aE[0] * AbsR[0][j] + aE[1] * AbsR[1][j] + aE[2] * AbsR[2][j];
             rb = bE[j];
             dist = std::abs(t[0] * R[0][j] + t[1] * R[1][j] + t[2] * R[2][j]);
-            if (dist > ra + rb) return false;
+            if (dist > ra + rb) { decidingAxis = 3 + j; return false; }
             overlap = (ra + rb) - dist;
-            considerAxis(Bu[j], overlap);
+            considerAxis(Bu[j], overlap, 3 + j);
         }
 
         // Test cross products A[i] x B[j]
@@ -168,7 +251,7 @@ namespace SimCollision
                 // Axis = A_i x B_j
                 const glm::vec3 axisWorld = glm::cross(Au[i], Bu[j]);
                 const float axisLen2 = glm::dot(axisWorld, axisWorld);
-                if (axisLen2 <= 1e-10f) continue; // parallel -> skip
+                if (axisLen2 <= 1e-6f) continue; // (near) parallel -> face axes already cover it
 
                 const int i1 = (i + 1) % 3;
                 const int i2 = (i + 2) % 3;
@@ -179,15 +262,17 @@ namespace SimCollision
                 rb = bE[j1] * AbsR[i][j2] + bE[j2] * AbsR[i][j1];
 
                 dist = std::abs(t[i2] * R[i1][j] - t[i1] * R[i2][j]);
-                if (dist > ra + rb) return false;
+                if (dist > ra + rb) { decidingAxis = 6 + 3 * i + j; return false; }
 
-                overlap = (ra + rb) - dist;
-                considerAxis(SafeNormalize(axisWorld), overlap);
+                // ra/rb/dist are scaled by |axis|; normalise so overlaps compare with the face axes
+                overlap = ((ra + rb) - dist) / std::sqrt(axisLen2);
+                considerAxis(axisWorld / std::sqrt(axisLen2), overlap, 6 + 3 * i + j);
             }
         }
 
         out.hit = true;
         out.penetration = std::max(0.0f, minOverlap);
+        decidingAxis = bestAxis;
 
         glm::vec3 n = SafeNormalize(bestAxisWorld, { 1,0,0 });
         if (glm::dot(n, B.center - A.center) < 0.0f) n = -n;
@@ -195,6 +280,37 @@ namespace SimCollision
         return true;
     }
 
+    inline bool OBBVsOBB(const OBB& A, const OBB& B, Contact& out)
+    {
+        int decidingAxis = kNoSATAxis;
+        return OBBVsOBB(A, B, out, decidingAxis);
+    }
+
+    // Single-axis SAT check with an OBBVsOBB axis id. Works on the stored orientations directly
+    // (no re-orthonormalisation), with a small tolerance so it never reports a separation the
+    // full test would reject.
+    inline bool OBBSeparatedOnAxis(const OBB& A, const OBB& B, int axisId)
+    {
+        glm::vec3 L;
+        if (axisId < 0 || axisId > 14) return false;
+        if (axisId < 3) L = A.orientation[axisId];
+        else if (axisId < 6) L = B.orientation[axisId - 3];
+        else L = glm::cross(A.orientation[(axisId - 6) / 3], B.orientation[(axisId - 6) % 3]);
+
+        const float len2 = glm::dot(L, L);
+        if (len2 <= 1e-10f) return false;
+
+        const float ra = A.halfExtents.x * std::abs(glm::dot(A.orientation[0], L)) +
+                         A.halfExtents.y * std::abs(glm::dot(A.orientation[1], L)) +
+                         A.halfExtents.z * std::abs(glm::dot(A.orientation[2], L));
+        const float rb = B.halfExtents.x * std::abs(glm::dot(B.orientation[0], L)) +
+                         B.halfExtents.y * std::abs(glm::dot(B.orientation[1], L)) +
+                         B.halfExtents.z * std::abs(glm::dot(B.orientation[2], L));
+        const float dist = std::abs(glm::dot(B.center - A.center, L));
+
+        return dist > (ra + rb) * 1.0001f + 1e-4f * std::sqrt(len2);
+    }
+
     inline float SupportDistanceAlongNormal(const OBB& obb, const glm::vec3& nWorld)
     {
         const glm::vec3 nLocal = glm::transpose(obb.orientation) * nWorld;
@@ -264,4 +380,79 @@ namespace SimCollision
 
         return true;
     }
-}
\ No newline at end of file
+
+    // ---------------------------------------------------------
+    // Batched narrowphase: SoA pair arrays in, compacted hit lists out.
+    // Implemented in CollisionUtil.cpp with SSE2/AVX2 paths; the scalar functions above
+    // are the reference and also handle the tail of each batch.
+    // ---------------------------------------------------------
+
+    struct BatchContacts
+    {
+        std::vector<uint32_t> pairIndex; // index into the input batch
+        std::vector<float> normalX, normalY, normalZ;
+        std::vector<float> penetration;
+
+        void Clear()
+        {
+            pairIndex.clear();
+            normalX.clear(); normalY.clear(); normalZ.clear();
+            penetration.clear();
+        }
+
+        size_t Size() const { return pairIndex.size(); }
+    };
+
+    struct Vec3Stream
+    {
+        const float* x = nullptr;
+        const float* y = nullptr;
+        const float* z = nullptr;
+    };
+
+    struct SpherePlaneBatch
+    {
+        Vec3Stream center;
+        const float* radius = nullptr;
+        Vec3Stream planeNormal;
+        Vec3Stream planePoint;
+        size_t count = 0;
+    };
+
+    struct OBBPlaneBatch
+    {
+        Vec3Stream center;
+        Vec3Stream axis[3]; // OBB orientation columns
+        Vec3Stream halfExtents;
+        Vec3Stream planeNormal;
+        Vec3Stream planePoint;
+        size_t count = 0;
+    };
+
+    struct SphereOBBBatch
+    {
+        Vec3Stream sphereCenter;
+        const float* sphereRadius = nullptr;
+        Vec3Stream obbCenter;
+        Vec3Stream obbAxis[3];
+        Vec3Stream obbHalfExtents;
+        size_t count = 0;
+    };
+
+    struct SphereCapsuleBatch
+    {
+        Vec3Stream sphereCenter;
+        const float* sphereRadius = nullptr;
+        Vec3Stream capsuleA;
+        Vec3Stream capsuleB;
+        const float* capsuleRadius = nullptr;
+        size_t count = 0;
+    };
+
+    // Each call clears 'out'. Normals follow the scalar versions (plane normal / box -> sphere /
+    // capsule -> sphere). 'level' is clamped to what the CPU supports.
+    void SphereVsPlaneBatch(const SpherePlaneBatch& batch, BatchContacts& out, SimSimd::SimdLevel level = SimSimd::GetBestSimdLevel());
+    void OBBVsPlaneBatch(const OBBPlaneBatch& batch, BatchContacts& out, SimSimd::SimdLevel level = SimSimd::GetBestSimdLevel());
+    void SphereVsOBBBatch(const SphereOBBBatch& batch, BatchContacts& out, SimSimd::SimdLevel level = SimSimd::GetBestSimdLevel());
+    void SphereVsCapsuleBatch(const SphereCapsuleBatch& batch, BatchContacts& out, SimSimd::SimdLevel level = SimSimd::GetBestSimdLevel());
+}
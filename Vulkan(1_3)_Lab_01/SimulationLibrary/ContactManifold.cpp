@@ -0,0 +1,345 @@
+#include "ContactManifold.h"
+
+namespace SimCollision
+{
+    namespace
+    {
+        // Feature id layout (face contacts):
+        //   bits 24-31  reference face (axis * 2 + negative side, +8 when the reference box is B)
+        //   bits 16-23  incident face  (axis * 2 + negative side)
+        //   bits  0-7   the two lines the point lies on: 0-3 incident face edges, 4-7 reference face sides
+        // Edge-edge contacts set the top byte to 0xFF and store the edge pair instead.
+        constexpr uint32_t kEdgeContactFeature = 0xFF000000u;
+
+        struct ClipVertex
+        {
+            glm::vec3 p{ 0.0f };
+            uint8_t inLine = 0;  // line shared with the previous vertex
+            uint8_t outLine = 0; // line shared with the next vertex
+        };
+
+        constexpr int kMaxClipVertices = 8;
+        constexpr float kClipTolerance = 0.005f;
+
+        // Sutherland-Hodgman: keeps the part of the polygon with dot(n, p) <= offset.
+        int ClipPolygon(const ClipVertex* in, int count, const glm::vec3& n, float offset, uint8_t clipLine, ClipVertex* out)
+        {
+            if (count == 0) return 0;
+
+            int outCount = 0;
+            ClipVertex a = in[count - 1];
+            float da = glm::dot(n, a.p) - offset;
+
+            for (int i = 0; i < count; ++i) {
+                const ClipVertex& b = in[i];
+                const float db = glm::dot(n, b.p) - offset;
+
+                if ((da <= 0.0f) != (db <= 0.0f) && outCount < kMaxClipVertices) {
+                    ClipVertex c;
+                    c.p = a.p + (b.p - a.p) * (da / (da - db));
+                    if (da > 0.0f) { c.inLine = clipLine; c.outLine = a.outLine; } // entering
+                    else { c.inLine = a.outLine; c.outLine = clipLine; }             // leaving
+                    out[outCount++] = c;
+                }
+                if (db <= 0.0f && outCount < kMaxClipVertices) out[outCount++] = b;
+
+                a = b;
+                da = db;
+            }
+            return outCount;
+        }
+
+        // Picks at most four points that keep the deepest contact and span the largest area.
+        void ReduceManifold(Manifold& m, const ManifoldPoint* points, int count)
+        {
+            if (count <= kMaxManifoldPoints) {
+                for (int i = 0; i < count; ++i) m.points[i] = points[i];
+                m.pointCount = count;
+                return;
+            }
+
+            int a = 0;
+            for (int i = 1; i < count; ++i) {
+                if (points[i].penetration > points[a].penetration) a = i;
+            }
+
+            int b = -1;
+            float bestDist = -1.0f;
+            for (int i = 0; i < count; ++i) {
+                const glm::vec3 d = points[i].position - points[a].position;
+                const float dist2 = glm::dot(d, d);
+                if (i != a && dist2 > bestDist) { bestDist = dist2; b = i; }
+            }
+
+            auto signedArea = [&](int i) {
+                return glm::dot(glm::cross(points[b].position - points[a].position, points[i].position - points[a].position), m.normal);
+            };
+
+            int c = -1;
+            int d = -1;
+            float maxArea = 0.0f;
+            float minArea = 0.0f;
+            for (int i = 0; i < count; ++i) {
+                if (i == a || i == b) continue;
+                const float area = signedArea(i);
+                if (c < 0 || area > maxArea) { maxArea = area; c = i; }
+                if (d < 0 || area < minArea) { minArea = area; d = i; }
+            }
+
+            m.pointCount = 0;
+            m.points[m.pointCount++] = points[a];
+            m.points[m.pointCount++] = points[b];
+            if (c >= 0) m.points[m.pointCount++] = points[c];
+            if (d >= 0 && d != c) m.points[m.pointCount++] = points[d];
+        }
+
+        float FaceAxisOverlap(const OBB& ref, const glm::mat3& refAxes, int axis, const OBB& other, const glm::mat3& otherAxes)
+        {
+            const glm::vec3 L = refAxes[axis];
+            const float rb = other.halfExtents.x * std::abs(glm::dot(otherAxes[0], L)) +
+                             other.halfExtents.y * std::abs(glm::dot(otherAxes[1], L)) +
+                             other.halfExtents.z * std::abs(glm::dot(otherAxes[2], L));
+            return ref.halfExtents[axis] + rb - std::abs(glm::dot(other.center - ref.center, L));
+        }
+
+        void FaceContact(const OBB& ref, const glm::mat3& refAxes, int refAxis, const OBB& inc, const glm::mat3& incAxes,
+            bool refIsB, float fallbackPenetration, Manifold& out)
+        {
+            // Reference face normal points from the reference box towards the incident box
+            const float side = glm::dot(refAxes[refAxis], inc.center - ref.center) >= 0.0f ? 1.0f : -1.0f;
+            const glm::vec3 refNormal = refAxes[refAxis] * side;
+            const uint32_t refFace = static_cast<uint32_t>(refAxis * 2 + (side < 0.0f ? 1 : 0) + (refIsB ? 8 : 0));
+
+            // Incident face: the one most anti-parallel to the reference normal
+            int incAxis = 0;
+            float bestDot = 0.0f;
+            for (int j = 0; j < 3; ++j) {
+                const float d = std::abs(glm::dot(incAxes[j], refNormal));
+                if (d > bestDot) { bestDot = d; incAxis = j; }
+            }
+            const float incSide = glm::dot(incAxes[incAxis], refNormal) > 0.0f ? -1.0f : 1.0f;
+            const uint32_t incFace = static_cast<uint32_t>(incAxis * 2 + (incSide < 0.0f ? 1 : 0));
+
+            const int i1 = (incAxis + 1) % 3;
+            const int i2 = (incAxis + 2) % 3;
+            const glm::vec3 faceCenter = inc.center + incAxes[incAxis] * (inc.halfExtents[incAxis] * incSide);
+            const glm::vec3 e1 = incAxes[i1] * inc.halfExtents[i1];
+            const glm::vec3 e2 = incAxes[i2] * inc.halfExtents[i2];
+
+            ClipVertex polyA[kMaxClipVertices];
+            ClipVertex polyB[kMaxClipVertices];
+            polyA[0].p = faceCenter + e1 + e2;
+            polyA[1].p = faceCenter - e1 + e2;
+            polyA[2].p = faceCenter - e1 - e2;
+            polyA[3].p = faceCenter + e1 - e2;
+            for (int v = 0; v < 4; ++v) {
+                polyA[v].inLine = static_cast<uint8_t>((v + 3) % 4);
+                polyA[v].outLine = static_cast<uint8_t>(v);
+            }
+
+            // Clip against the four side planes of the reference face
+            const int r1 = (refAxis + 1) % 3;
+            const int r2 = (refAxis + 2) % 3;
+            int count = 4;
+            ClipVertex* src = polyA;
+            ClipVertex* dst = polyB;
+            const int sideAxes[2] = { r1, r2 };
+            for (int s = 0; s < 2; ++s) {
+                const glm::vec3 u = refAxes[sideAxes[s]];
+                const float c = glm::dot(u, ref.center);
+                // Slightly widened so equal-sized faces resting on each other keep their own corners
+                // instead of flickering between corners and clip points.
+                const float e = ref.halfExtents[sideAxes[s]] + kClipTolerance;
+
+                count = ClipPolygon(src, count, u, c + e, static_cast<uint8_t>(4 + s * 2), dst);
+                std::swap(src, dst);
+                count = ClipPolygon(src, count, -u, -c + e, static_cast<uint8_t>(5 + s * 2), dst);
+                std::swap(src, dst);
+            }
+
+            const float refOffset = glm::dot(refNormal, ref.center) + ref.halfExtents[refAxis];
+            const glm::vec3 normal = refIsB ? -refNormal : refNormal;
+
+            ManifoldPoint candidates[kMaxClipVertices];
+            int candidateCount = 0;
+            for (int i = 0; i < count; ++i) {
+                const float separation = glm::dot(refNormal, src[i].p) - refOffset;
+                if (separation > 0.0f) continue;
+
+                ManifoldPoint& mp = candidates[candidateCount++];
+                mp.penetration = -separation;
+                mp.position = src[i].p - refNormal * (separation * 0.5f);
+                mp.featureId = (refFace << 24) | (incFace << 16) | (static_cast<uint32_t>(src[i].inLine) << 4) | src[i].outLine;
+            }
+
+            out.normal = normal;
+            if (candidateCount == 0) {
+                // Clipping lost everything (grazing contact); keep the deepest incident vertex.
+                int deepest = 0;
+                for (int v = 1; v < 4; ++v) {
+                    if (glm::dot(refNormal, polyA[v].p) < glm::dot(refNormal, polyA[deepest].p)) deepest = v;
+                }
+                out.points[0].position = polyA[deepest].p + refNormal * (fallbackPenetration * 0.5f);
+                out.points[0].penetration = fallbackPenetration;
+                out.points[0].featureId = (refFace << 24) | (incFace << 16) | static_cast<uint32_t>(deepest);
+                out.pointCount = 1;
+                return;
+            }
+
+            ReduceManifold(out, candidates, candidateCount);
+        }
+
+        void EdgeContact(const OBB& A, const glm::mat3& Au, const OBB& B, const glm::mat3& Bu, int axisId, const Contact& c, Manifold& out)
+        {
+            const int i = (axisId - 6) / 3;
+            const int j = (axisId - 6) % 3;
+            const glm::vec3 n = c.normal;
+
+            // Support edges: A's edge furthest along +n, B's edge furthest along -n
+            uint32_t signBits = 0;
+            glm::vec3 pA = A.center;
+            for (int k = 0; k < 3; ++k) {
+                if (k == i) continue;
+                const float s = glm::dot(Au[k], n) >= 0.0f ? 1.0f : -1.0f;
+                if (s < 0.0f) signBits |= 1u << k;
+                pA += Au[k] * (A.halfExtents[k] * s);
+            }
+            glm::vec3 pB = B.center;
+            for (int k = 0; k < 3; ++k) {
+                if (k == j) continue;
+                const float s = glm::dot(Bu[k], n) >= 0.0f ? -1.0f : 1.0f;
+                if (s < 0.0f) signBits |= 1u << (k + 3);
+                pB += Bu[k] * (B.halfExtents[k] * s);
+            }
+
+            // Closest points between the two edge lines, clamped to the edges
+            const glm::vec3 dA = Au[i];
+            const glm::vec3 dB = Bu[j];
+            const glm::vec3 r = pA - pB;
+            const float b = glm::dot(dA, dB);
+            const float cc = glm::dot(dA, r);
+            const float f = glm::dot(dB, r);
+            const float denom = 1.0f - b * b;
+
+            float s = 0.0f;
+            if (denom > 1e-6f) s = std::clamp((b * f - cc) / denom, -A.halfExtents[i], A.halfExtents[i]);
+            const float t = std::clamp(b * s + f, -B.halfExtents[j], B.halfExtents[j]);
+
+            const glm::vec3 onA = pA + dA * s;
+            const glm::vec3 onB = pB + dB * t;
+
+            out.normal = n;
+            out.points[0].position = (onA + onB) * 0.5f;
+            out.points[0].penetration = c.penetration;
+            out.points[0].featureId = kEdgeContactFeature | (static_cast<uint32_t>(axisId) << 8) | signBits;
+            out.pointCount = 1;
+        }
+    }
+
+    bool SphereVsSphereManifold(const glm::vec3& centerA, float radiusA, const glm::vec3& centerB, float radiusB, Manifold& out)
+    {
+        out = {};
+        const glm::vec3 d = centerB - centerA;
+        const float dist2 = glm::dot(d, d);
+        const float rSum = radiusA + radiusB;
+        if (dist2 >= rSum * rSum) return false;
+
+        const float dist = std::sqrt(dist2);
+        out.normal = dist > kEps ? d / dist : glm::vec3(0.0f, 1.0f, 0.0f);
+        out.points[0].penetration = rSum - dist;
+        out.points[0].position = centerA + out.normal * (radiusA - out.points[0].penetration * 0.5f);
+        out.pointCount = 1;
+        return true;
+    }
+
+    bool SphereVsPlaneManifold(const glm::vec3& center, float radius, const glm::vec3& planeNormal, const glm::vec3& planePoint, Manifold& out)
+    {
+        out = {};
+        Contact c{};
+        if (!SphereVsPlane(center, radius, planeNormal, planePoint, c)) return false;
+
+        // SphereVsPlane reports the plane normal; sphere (A) -> plane (B) is the opposite way.
+        out.normal = -c.normal;
+        out.points[0].penetration = c.penetration;
+        out.points[0].position = center + out.normal * (radius - c.penetration * 0.5f);
+        out.pointCount = 1;
+        return true;
+    }
+
+    bool SphereVsOBBManifold(const glm::vec3& center, float radius, const OBB& obb, Manifold& out)
+    {
+        out = {};
+        Contact c{};
+        if (!SphereVsOBB(center, radius, obb, c)) return false;
+
+        out.normal = -c.normal; // SphereVsOBB points box -> sphere
+        out.points[0].penetration = c.penetration;
+        out.points[0].position = center + out.normal * (radius - c.penetration * 0.5f);
+        out.pointCount = 1;
+        return true;
+    }
+
+    bool OBBVsPlaneManifold(const OBB& obb, const glm::vec3& planeNormal, const glm::vec3& planePoint, Manifold& out)
+    {
+        out = {};
+        const float offset = glm::dot(planeNormal, planePoint);
+
+        ManifoldPoint candidates[8];
+        int count = 0;
+        for (uint32_t v = 0; v < 8; ++v) {
+            const glm::vec3 local{
+                (v & 1u) ? obb.halfExtents.x : -obb.halfExtents.x,
+                (v & 2u) ? obb.halfExtents.y : -obb.halfExtents.y,
+                (v & 4u) ? obb.halfExtents.z : -obb.halfExtents.z
+            };
+            const glm::vec3 p = obb.center + obb.orientation * local;
+            const float separation = glm::dot(planeNormal, p) - offset;
+            if (separation > 0.0f) continue;
+
+            ManifoldPoint& mp = candidates[count++];
+            mp.penetration = -separation;
+            mp.position = p - planeNormal * (separation * 0.5f);
+            mp.featureId = v;
+        }
+        if (count == 0) return false;
+
+        out.normal = -planeNormal;
+        ReduceManifold(out, candidates, count);
+        return true;
+    }
+
+    bool OBBVsOBBManifold(const OBB& A, const OBB& B, Manifold& out)
+    {
+        out = {};
+        Contact c{};
+        int axisId = kNoSATAxis;
+        if (!OBBVsOBB(A, B, c, axisId)) return false;
+
+        const glm::mat3 Au = OrthonormalizeColumns(A.orientation);
+        const glm::mat3 Bu = OrthonormalizeColumns(B.orientation);
+
+        int bestA = 0;
+        int bestB = 0;
+        float overlapA = std::numeric_limits<float>::infinity();
+        float overlapB = std::numeric_limits<float>::infinity();
+        for (int k = 0; k < 3; ++k) {
+            const float oa = FaceAxisOverlap(A, Au, k, B, Bu);
+            const float ob = FaceAxisOverlap(B, Bu, k, A, Au);
+            if (oa < overlapA) { overlapA = oa; bestA = k; }
+            if (ob < overlapB) { overlapB = ob; bestB = k; }
+        }
+
+        // Prefer face contacts (and A as the reference) unless the alternative is clearly
+        // shallower; otherwise tiny rounding differences flip the manifold between frames.
+        const bool useB = overlapB < 0.98f * overlapA - 0.001f;
+        const float faceOverlap = useB ? overlapB : overlapA;
+        if (axisId >= 6 && c.penetration < 0.95f * faceOverlap - 0.01f) {
+            EdgeContact(A, Au, B, Bu, axisId, c, out);
+            return true;
+        }
+
+        if (useB) FaceContact(B, Bu, bestB, A, Au, true, c.penetration, out);
+        else FaceContact(A, Au, bestA, B, Bu, false, c.penetration, out);
+        return out.pointCount > 0;
+    }
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "CollisionUtil.h"
+
+// Multi-point contact generation for the contact solver.
+// Every point carries a feature id built from the box faces/edges/vertices that produced it,
+// so the same physical contact gets the same id on consecutive frames while the pair rests.
+namespace SimCollision
+{
+    constexpr int kMaxManifoldPoints = 4;
+
+    struct ManifoldPoint
+    {
+        glm::vec3 position{ 0.0f }; // world space, midway between the two surfaces
+        float penetration = 0.0f;
+        uint32_t featureId = 0;
+    };
+
+    struct Manifold
+    {
+        glm::vec3 normal{ 0.0f, 1.0f, 0.0f }; // points from A -> B
+        ManifoldPoint points[kMaxManifoldPoints];
+        int pointCount = 0;
+    };
+
+    // A is always the first shape named in the function.
+    bool SphereVsSphereManifold(const glm::vec3& centerA, float radiusA, const glm::vec3& centerB, float radiusB, Manifold& out);
+    bool SphereVsPlaneManifold(const glm::vec3& center, float radius, const glm::vec3& planeNormal, const glm::vec3& planePoint, Manifold& out);
+    bool SphereVsOBBManifold(const glm::vec3& center, float radius, const OBB& obb, Manifold& out);
+    bool OBBVsPlaneManifold(const OBB& obb, const glm::vec3& planeNormal, const glm::vec3& planePoint, Manifold& out);
+    bool OBBVsOBBManifold(const OBB& A, const OBB& B, Manifold& out);
+}
@@ -0,0 +1,276 @@
+#include "ContactSolver.h"
+#include "PhysicsObject.h"
+
+void ContactSolver::AddManifold(uint64_t key, PhysicsObject* a, PhysicsObject* b, const SimCollision::Manifold& manifold) {
+    if (!a || !b || manifold.pointCount <= 0) return;
+    if (a->GetInverseMass() == 0.0f && b->GetInverseMass() == 0.0f) return;
+
+    ManifoldState* state = nullptr;
+    auto it = m_Lookup.find(key);
+    if (it == m_Lookup.end()) {
+        m_Lookup.emplace(key, static_cast<uint32_t>(m_Manifolds.size()));
+        state = &m_Manifolds.emplace_back();
+        state->key = key;
+    }
+    else {
+        state = &m_Manifolds[it->second];
+        // Same key, different bodies (instance indices got reused): start over.
+        if (state->objA != a || state->objB != b) state->pointCount = 0;
+    }
+
+    Point previous[SimCollision::kMaxManifoldPoints];
+    const int previousCount = state->pointCount;
+    for (int i = 0; i < previousCount; ++i) previous[i] = state->points[i];
+
+    // A large normal change means the old impulses point the wrong way; don't carry them over.
+    const bool canMatch = m_Settings.warmStart && previousCount > 0 && glm::dot(state->normal, manifold.normal) > 0.95f;
+
+    state->objA = a;
+    state->objB = b;
+    state->normal = manifold.normal;
+    state->restitution = std::min(a->GetRestitution(), b->GetRestitution());
+    state->pointCount = std::min(manifold.pointCount, SimCollision::kMaxManifoldPoints);
+    state->touched = true;
+
+    for (int i = 0; i < state->pointCount; ++i) {
+        const SimCollision::ManifoldPoint& src = manifold.points[i];
+        Point& p = state->points[i];
+        p = {};
+        p.position = src.position;
+        p.penetration = src.penetration;
+        p.featureId = src.featureId;
+
+        if (!canMatch) continue;
+        for (int j = 0; j < previousCount; ++j) {
+            if (previous[j].featureId != src.featureId) continue;
+            p.normalImpulse = previous[j].normalImpulse;
+            p.tangentImpulse = previous[j].tangentImpulse;
+            ++m_PendingWarmStarted;
+            break;
+        }
+    }
+}
+
+void ContactSolver::Solve(float deltaTime) {
+    // Drop pairs that stopped touching (keeps submission order for the survivors).
+    size_t write = 0;
+    for (size_t read = 0; read < m_Manifolds.size(); ++read) {
+        if (!m_Manifolds[read].touched) continue;
+        if (write != read) m_Manifolds[write] = m_Manifolds[read];
+        ++write;
+    }
+    if (write != m_Manifolds.size()) {
+        m_Manifolds.resize(write);
+        m_Lookup.clear();
+        for (size_t i = 0; i < m_Manifolds.size(); ++i) m_Lookup.emplace(m_Manifolds[i].key, static_cast<uint32_t>(i));
+    }
+
+    m_LastContacts = 0;
+    m_LastWarmStarted = m_PendingWarmStarted;
+    m_PendingWarmStarted = 0;
+
+    if (!m_Manifolds.empty() && deltaTime > 0.0f) {
+        m_Bodies.clear();
+        m_BodyLookup.clear();
+        for (auto& m : m_Manifolds) {
+            m.bodyA = GetBodyIndex(m.objA);
+            m.bodyB = GetBodyIndex(m.objB);
+        }
+
+        const float invDt = 1.0f / deltaTime;
+        for (auto& m : m_Manifolds) {
+            PreStep(m, invDt);
+            m_LastContacts += static_cast<uint32_t>(m.pointCount);
+        }
+
+        if (m_Settings.warmStart) {
+            for (auto& m : m_Manifolds) WarmStart(m);
+        }
+
+        for (int iteration = 0; iteration < m_Settings.iterations; ++iteration) {
+            for (auto& m : m_Manifolds) SolveVelocities(m);
+        }
+
+        if (m_Settings.splitImpulse) {
+            for (int iteration = 0; iteration < m_Settings.iterations; ++iteration) {
+                for (auto& m : m_Manifolds) SolvePositions(m);
+            }
+        }
+
+        for (auto& m : m_Manifolds) {
+            for (int i = 0; i < m.pointCount; ++i) {
+                Point& p = m.points[i];
+                p.tangentImpulse = m.tangent[0] * p.tangentLambda[0] + m.tangent[1] * p.tangentLambda[1];
+            }
+        }
+
+        for (const auto& body : m_Bodies) {
+            if (body.invMass == 0.0f) continue;
+            body.object->SetVelocity(body.v);
+            body.object->SetAngularVelocity(body.w);
+
+            // Pseudo-velocities only move the body for this step.
+            if (glm::dot(body.pseudoV, body.pseudoV) > 0.0f) {
+                body.object->SetPosition(body.object->GetPosition() + body.pseudoV * deltaTime);
+            }
+            if (glm::dot(body.pseudoW, body.pseudoW) > 0.0f) {
+                // World-space rotation, so it goes on the left.
+                body.object->SetOrientation(glm::quat(body.pseudoW * deltaTime) * body.object->GetOrientation());
+            }
+        }
+    }
+
+    for (auto& m : m_Manifolds) m.touched = false;
+}
+
+void ContactSolver::Clear() {
+    m_Manifolds.clear();
+    m_Lookup.clear();
+    m_Bodies.clear();
+    m_BodyLookup.clear();
+    m_PendingWarmStarted = 0;
+    m_LastContacts = 0;
+    m_LastWarmStarted = 0;
+}
+
+uint32_t ContactSolver::GetBodyIndex(PhysicsObject* object) {
+    auto it = m_BodyLookup.find(object);
+    if (it != m_BodyLookup.end()) return it->second;
+
+    Body body;
+    body.object = object;
+    body.invMass = object->GetInverseMass();
+    if (body.invMass > 0.0f) {
+        body.v = object->GetVelocity();
+        body.w = object->GetAngularVelocity();
+        body.invInertia = object->GetWorldInverseInertiaTensor();
+    }
+
+    const uint32_t index = static_cast<uint32_t>(m_Bodies.size());
+    m_Bodies.push_back(body);
+    m_BodyLookup.emplace(object, index);
+    return index;
+}
+
+void ContactSolver::PreStep(ManifoldState& m, float invDt) {
+    const Body& A = m_Bodies[m.bodyA];
+    const Body& B = m_Bodies[m.bodyB];
+    const glm::vec3 n = m.normal;
+
+    m.tangent[0] = glm::normalize(std::abs(n.x) < 0.57735f ? glm::cross(n, glm::vec3(1.0f, 0.0f, 0.0f)) : glm::cross(n, glm::vec3(0.0f, 1.0f, 0.0f)));
+    m.tangent[1] = glm::cross(n, m.tangent[0]);
+
+    const glm::vec3 posA = m.objA->GetPosition();
+    const glm::vec3 posB = m.objB->GetPosition();
+
+    auto effectiveMass = [&](const Point& p, const glm::vec3& axis) {
+        const glm::vec3 raXn = glm::cross(p.rA, axis);
+        const glm::vec3 rbXn = glm::cross(p.rB, axis);
+        const float k = A.invMass + B.invMass + glm::dot(raXn, A.invInertia * raXn) + glm::dot(rbXn, B.invInertia * rbXn);
+        return k > 0.0f ? 1.0f / k : 0.0f;
+    };
+
+    for (int i = 0; i < m.pointCount; ++i) {
+        Point& p = m.points[i];
+        p.rA = p.position - posA;
+        p.rB = p.position - posB;
+
+        p.normalMass = effectiveMass(p, n);
+        p.tangentMass[0] = effectiveMass(p, m.tangent[0]);
+        p.tangentMass[1] = effectiveMass(p, m.tangent[1]);
+
+        if (!m_Settings.warmStart) {
+            p.normalImpulse = 0.0f;
+            p.tangentImpulse = glm::vec3(0.0f);
+        }
+        p.tangentLambda[0] = glm::dot(p.tangentImpulse, m.tangent[0]);
+        p.tangentLambda[1] = glm::dot(p.tangentImpulse, m.tangent[1]);
+
+        const glm::vec3 dv = B.v + glm::cross(B.w, p.rB) - A.v - glm::cross(A.w, p.rA);
+        const float vn = glm::dot(dv, n);
+
+        const float positionBias = m_Settings.baumgarte * invDt * std::max(0.0f, p.penetration - m_Settings.linearSlop);
+        const float bounce = vn < -m_Settings.restitutionThreshold ? -m.restitution * vn : 0.0f;
+        p.pseudoImpulse = 0.0f;
+        if (m_Settings.splitImpulse) {
+            p.positionBias = positionBias;
+            p.velocityBias = bounce;
+        }
+        else {
+            p.positionBias = 0.0f;
+            p.velocityBias = std::max(positionBias, bounce);
+        }
+    }
+}
+
+void ContactSolver::WarmStart(ManifoldState& m) {
+    Body& A = m_Bodies[m.bodyA];
+    Body& B = m_Bodies[m.bodyB];
+
+    for (int i = 0; i < m.pointCount; ++i) {
+        const Point& p = m.points[i];
+        const glm::vec3 P = m.normal * p.normalImpulse + m.tangent[0] * p.tangentLambda[0] + m.tangent[1] * p.tangentLambda[1];
+
+        A.v -= P * A.invMass;
+        A.w -= A.invInertia * glm::cross(p.rA, P);
+        B.v += P * B.invMass;
+        B.w += B.invInertia * glm::cross(p.rB, P);
+    }
+}
+
+void ContactSolver::SolveVelocities(ManifoldState& m) {
+    Body& A = m_Bodies[m.bodyA];
+    Body& B = m_Bodies[m.bodyB];
+
+    auto apply = [&](const Point& p, const glm::vec3& P) {
+        A.v -= P * A.invMass;
+        A.w -= A.invInertia * glm::cross(p.rA, P);
+        B.v += P * B.invMass;
+        B.w += B.invInertia * glm::cross(p.rB, P);
+    };
+
+    auto relativeVelocity = [&](const Point& p) {
+        return B.v + glm::cross(B.w, p.rB) - A.v - glm::cross(A.w, p.rA);
+    };
+
+    // Friction first so the non-penetration constraint gets the last word.
+    for (int i = 0; i < m.pointCount; ++i) {
+        Point& p = m.points[i];
+        const float maxFriction = m_Settings.friction * p.normalImpulse;
+
+        for (int k = 0; k < 2; ++k) {
+            const float vt = glm::dot(relativeVelocity(p), m.tangent[k]);
+            const float old = p.tangentLambda[k];
+            p.tangentLambda[k] = std::clamp(old - vt * p.tangentMass[k], -maxFriction, maxFriction);
+            apply(p, m.tangent[k] * (p.tangentLambda[k] - old));
+        }
+    }
+
+    for (int i = 0; i < m.pointCount; ++i) {
+        Point& p = m.points[i];
+        const float vn = glm::dot(relativeVelocity(p), m.normal);
+        const float old = p.normalImpulse;
+        p.normalImpulse = std::max(old + p.normalMass * (p.velocityBias - vn), 0.0f);
+        apply(p, m.normal * (p.normalImpulse - old));
+    }
+}
+
+void ContactSolver::SolvePositions(ManifoldState& m) {
+    Body& A = m_Bodies[m.bodyA];
+    Body& B = m_Bodies[m.bodyB];
+
+    for (int i = 0; i < m.pointCount; ++i) {
+        Point& p = m.points[i];
+        const glm::vec3 dv = B.pseudoV + glm::cross(B.pseudoW, p.rB) - A.pseudoV - glm::cross(A.pseudoW, p.rA);
+        const float vn = glm::dot(dv, m.normal);
+
+        const float old = p.pseudoImpulse;
+        p.pseudoImpulse = std::max(old + p.normalMass * (p.positionBias - vn), 0.0f);
+        const glm::vec3 P = m.normal * (p.pseudoImpulse - old);
+
+        A.pseudoV -= P * A.invMass;
+        A.pseudoW -= A.invInertia * glm::cross(p.rA, P);
+        B.pseudoV += P * B.invMass;
+        B.pseudoW += B.invInertia * glm::cross(p.rB, P);
+    }
+}
@@ -0,0 +1,102 @@
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "ContactManifold.h"
+
+class PhysicsObject;
+
+// Sequential-impulse contact solver with persistent manifolds.
+// Each tick the caller submits one manifold per touching pair under a stable pair key.
+// Points are matched to last tick's manifold by feature id and inherit its accumulated
+// impulses, which are applied up front (warm starting) before the iterations run.
+// Penetration is removed with a Baumgarte bias, either on the real velocities or (split impulse)
+// on separate pseudo-velocities that move the bodies apart without adding kinetic energy.
+class ContactSolver {
+public:
+    struct Settings {
+        int iterations = 10;
+        bool warmStart = true;
+        float friction = 0.5f;
+        bool splitImpulse = true;          // push out of penetration with pseudo-velocities that are not kept
+        float baumgarte = 0.2f;
+        float linearSlop = 0.005f;
+        float restitutionThreshold = 1.0f; // approach speed (m/s) below which contacts do not bounce
+    };
+
+    Settings& GetSettings() { return m_Settings; }
+    const Settings& GetSettings() const { return m_Settings; }
+
+    // Bodies with zero inverse mass are treated as static. Both bodies must stay valid until Solve().
+    void AddManifold(uint64_t key, PhysicsObject* a, PhysicsObject* b, const SimCollision::Manifold& manifold);
+
+    // Drops pairs that were not submitted since the last call, then solves and writes velocities back.
+    void Solve(float deltaTime);
+    void Clear();
+
+    size_t GetManifoldCount() const { return m_Manifolds.size(); }
+    uint32_t GetLastContactCount() const { return m_LastContacts; }
+    uint32_t GetLastWarmStartedCount() const { return m_LastWarmStarted; }
+
+private:
+    struct Point {
+        glm::vec3 position{ 0.0f };
+        float penetration = 0.0f;
+        uint32_t featureId = 0;
+
+        float normalImpulse = 0.0f;
+        glm::vec3 tangentImpulse{ 0.0f }; // world space, re-projected if the tangent basis changes
+
+        // Per-solve
+        glm::vec3 rA{ 0.0f };
+        glm::vec3 rB{ 0.0f };
+        float normalMass = 0.0f;
+        float tangentMass[2] = { 0.0f, 0.0f };
+        float tangentLambda[2] = { 0.0f, 0.0f };
+        float velocityBias = 0.0f;
+        float positionBias = 0.0f;
+        float pseudoImpulse = 0.0f;
+    };
+
+    struct ManifoldState {
+        uint64_t key = 0;
+        PhysicsObject* objA = nullptr;
+        PhysicsObject* objB = nullptr;
+        uint32_t bodyA = 0;
+        uint32_t bodyB = 0;
+        glm::vec3 normal{ 0.0f, 1.0f, 0.0f };
+        glm::vec3 tangent[2]{};
+        float restitution = 0.0f;
+        Point points[SimCollision::kMaxManifoldPoints];
+        int pointCount = 0;
+        bool touched = false;
+    };
+
+    struct Body {
+        PhysicsObject* object = nullptr;
+        glm::vec3 v{ 0.0f };
+        glm::vec3 w{ 0.0f };
+        float invMass = 0.0f;
+        glm::mat3 invInertia{ 0.0f };
+        glm::vec3 pseudoV{ 0.0f };
+        glm::vec3 pseudoW{ 0.0f };
+    };
+
+    uint32_t GetBodyIndex(PhysicsObject* object);
+    void PreStep(ManifoldState& m, float invDt);
+    void WarmStart(ManifoldState& m);
+    void SolveVelocities(ManifoldState& m);
+    void SolvePositions(ManifoldState& m);
+
+    Settings m_Settings;
+
+    std::vector<ManifoldState> m_Manifolds;
+    std::unordered_map<uint64_t, uint32_t> m_Lookup;
+
+    std::vector<Body> m_Bodies;
+    std::unordered_map<PhysicsObject*, uint32_t> m_BodyLookup;
+
+    uint32_t m_PendingWarmStarted = 0;
+    uint32_t m_LastContacts = 0;
+    uint32_t m_LastWarmStarted = 0;
+};
@@ -0,0 +1,157 @@
+#include "ContinuousCollision.h"
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/quaternion.hpp>
+
+namespace SimCollision
+{
+    namespace
+    {
+        // Conservative advancement over t in [0, 1]. 'distanceAt(t, normal)' returns a lower bound
+        // on the separation at t (<= 0 when touching) and the normal towards the moving shape;
+        // 'maxApproach' bounds how far any point of the moving shape travels over the whole step.
+        template <typename DistanceFn>
+        bool Advance(DistanceFn&& distanceAt, float maxApproach, TimeOfImpact& out)
+        {
+            glm::vec3 normal{ 0.0f, 1.0f, 0.0f };
+            float distance = distanceAt(0.0f, normal);
+            if (distance <= 0.0f || maxApproach <= kEps) return false;
+
+            float t = 0.0f;
+            for (int iteration = 0; iteration < kMaxTOIIterations; ++iteration)
+            {
+                if (distance <= kTOITolerance)
+                {
+                    out.t = t;
+                    out.normal = normal;
+                    return true;
+                }
+
+                t += distance / maxApproach;
+                if (t >= 1.0f) return false;
+                distance = distanceAt(t, normal);
+            }
+
+            // Out of iterations while still creeping closer (usually a grazing path): only report
+            // an impact if the end pose actually touches.
+            glm::vec3 endNormal;
+            if (distanceAt(1.0f, endNormal) > 0.0f) return false;
+            out.t = t;
+            out.normal = normal;
+            return true;
+        }
+
+        // Largest separation over the 15 SAT axes: a lower bound on the true distance between
+        // the boxes, and the axis it came from oriented from 'fixed' towards 'moving'.
+        float OBBSeparation(const OBB& fixed, const OBB& moving, glm::vec3& normal)
+        {
+            const glm::vec3 d = moving.center - fixed.center;
+            float best = -std::numeric_limits<float>::infinity();
+
+            auto consider = [&](const glm::vec3& axis)
+            {
+                const float len2 = glm::dot(axis, axis);
+                if (len2 <= 1e-6f) return; // (near) parallel edges: the face axes cover it
+
+                const glm::vec3 L = axis * (1.0f / std::sqrt(len2));
+                const float along = glm::dot(d, L);
+                const float gap = std::abs(along) - SupportDistanceAlongNormal(fixed, L) - SupportDistanceAlongNormal(moving, L);
+                if (gap > best)
+                {
+                    best = gap;
+                    normal = along < 0.0f ? -L : L;
+                }
+            };
+
+            for (int i = 0; i < 3; ++i) consider(fixed.orientation[i]);
+            for (int j = 0; j < 3; ++j) consider(moving.orientation[j]);
+            for (int i = 0; i < 3; ++i)
+                for (int j = 0; j < 3; ++j)
+                    consider(glm::cross(fixed.orientation[i], moving.orientation[j]));
+
+            return best;
+        }
+    }
+
+    OBB OBBSweep::PoseAt(float t) const
+    {
+        OBB pose = start;
+        pose.center += translation * t;
+
+        const float angle = glm::length(rotation);
+        if (angle > kEps)
+            pose.orientation = glm::mat3_cast(glm::angleAxis(angle * t, rotation / angle)) * start.orientation;
+
+        return pose;
+    }
+
+    bool SweptSphereVsPlane(const glm::vec3& start, const glm::vec3& end, float radius, const glm::vec3& planeNormal, const glm::vec3& planePoint, TimeOfImpact& out)
+    {
+        const float d0 = glm::dot(start - planePoint, planeNormal) - radius;
+        const float d1 = glm::dot(end - planePoint, planeNormal) - radius;
+        if (d0 <= 0.0f || d1 >= 0.0f) return false;
+
+        out.t = d0 / (d0 - d1);
+        out.normal = planeNormal;
+        return true;
+    }
+
+    bool SweptSphereVsOBB(const glm::vec3& start, const glm::vec3& end, float radius, const OBB& obb, TimeOfImpact& out)
+    {
+        const glm::vec3 motion = end - start;
+
+        auto distanceAt = [&](float t, glm::vec3& normal)
+        {
+            const glm::vec3 center = start + motion * t;
+            const glm::vec3 offset = center - ClosestPointOnOBB(center, obb);
+            const float len = glm::length(offset);
+            normal = len > kEps ? offset / len : glm::vec3(0.0f, 1.0f, 0.0f);
+            return len - radius;
+        };
+
+        return Advance(distanceAt, glm::length(motion), out);
+    }
+
+    bool SweptOBBVsPlane(const OBBSweep& sweep, const glm::vec3& planeNormal, const glm::vec3& planePoint, TimeOfImpact& out)
+    {
+        auto distanceAt = [&](float t, glm::vec3& normal)
+        {
+            const OBB pose = sweep.PoseAt(t);
+            normal = planeNormal;
+            return glm::dot(pose.center - planePoint, planeNormal) - SupportDistanceAlongNormal(pose, planeNormal);
+        };
+
+        const float maxApproach = std::abs(glm::dot(sweep.translation, planeNormal)) +
+                                  glm::length(sweep.rotation) * glm::length(sweep.start.halfExtents);
+        return Advance(distanceAt, maxApproach, out);
+    }
+
+    bool SweptOBBVsOBB(const OBBSweep& sweep, const OBB& obb, TimeOfImpact& out)
+    {
+        auto distanceAt = [&](float t, glm::vec3& normal)
+        {
+            return OBBSeparation(obb, sweep.PoseAt(t), normal);
+        };
+
+        const float maxApproach = glm::length(sweep.translation) +
+                                  glm::length(sweep.rotation) * glm::length(sweep.start.halfExtents);
+        return Advance(distanceAt, maxApproach, out);
+    }
+
+    bool SweptSphereVsConvex(const glm::vec3& start, const glm::vec3& end, float radius, const ConvexShape& shape, TimeOfImpact& out)
+    {
+        const glm::vec3 motion = end - start;
+
+        // One simplex carried through the advancement steps: each pose is close to the last.
+        GJKSimplex simplex;
+        auto distanceAt = [&](float t, glm::vec3& normal)
+        {
+            const glm::vec3 center = start + motion * t;
+            const GJKResult r = GJKDistance(shape, ConvexShape::Sphere(center, radius), &simplex);
+            if (r.overlap) return 0.0f;
+            normal = SafeNormalize(center - r.pointA, { 0.0f, 1.0f, 0.0f }); // at least 'radius' long
+            return r.distance;
+        };
+
+        return Advance(distanceAt, glm::length(motion), out);
+    }
+}
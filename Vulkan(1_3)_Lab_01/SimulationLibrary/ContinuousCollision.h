@@ -0,0 +1,40 @@
+#pragma once
+#include <glm/glm.hpp>
+#include "CollisionUtil.h"
+#include "ConvexCollision.h"
+
+// Continuous collision for bodies that move further in one step than the discrete tests can
+// handle. Each test sweeps a moving shape over the step (t = 0 at the start pose, t = 1 at the
+// end pose) against a fixed one and reports the first time of impact.
+// A sphere against a plane is solved in closed form. Everything else uses conservative
+// advancement: step forward by a lower bound on the current distance divided by an upper bound
+// on how fast any point of the moving shape can approach, which never steps past first contact.
+// Shapes that already touch at t = 0 report nothing; that contact belongs to the discrete stage.
+namespace SimCollision
+{
+    constexpr float kTOITolerance = 1e-3f; // advancement stops this close to contact
+    constexpr int kMaxTOIIterations = 32;
+
+    struct TimeOfImpact
+    {
+        float t = 1.0f;                       // fraction of the step
+        glm::vec3 normal{ 0.0f, 1.0f, 0.0f }; // from the fixed shape towards the moving one
+    };
+
+    // Motion of a box over one step. Rotation is about the box center.
+    struct OBBSweep
+    {
+        OBB start;
+        glm::vec3 translation{ 0.0f }; // center displacement over the step
+        glm::vec3 rotation{ 0.0f };    // world-space rotation vector (angular velocity * dt)
+
+        OBB PoseAt(float t) const;
+    };
+
+    bool SweptSphereVsPlane(const glm::vec3& start, const glm::vec3& end, float radius, const glm::vec3& planeNormal, const glm::vec3& planePoint, TimeOfImpact& out);
+    bool SweptSphereVsOBB(const glm::vec3& start, const glm::vec3& end, float radius, const OBB& obb, TimeOfImpact& out);
+    bool SweptOBBVsPlane(const OBBSweep& sweep, const glm::vec3& planeNormal, const glm::vec3& planePoint, TimeOfImpact& out);
+    bool SweptOBBVsOBB(const OBBSweep& sweep, const OBB& obb, TimeOfImpact& out);
+    // Distances come from GJK, so 'shape' can be any support-mapped convex shape.
+    bool SweptSphereVsConvex(const glm::vec3& start, const glm::vec3& end, float radius, const ConvexShape& shape, TimeOfImpact& out);
+}
@@ -0,0 +1,636 @@
+#include "ConvexCollision.h"
+#include <array>
+
+namespace SimCollision
+{
+    namespace
+    {
+        constexpr float kDuplicateDistance2 = 1e-12f; // support points closer than this are the same
+        constexpr float kTouchingDistance2 = 1e-10f;  // cores this close count as overlapping
+        constexpr int kMaxEPAVertices = 4 + kMaxEPAIterations;
+        constexpr int kMaxEPAFaces = 2 * kMaxEPAVertices;
+        constexpr int kMaxEPAEdges = kMaxEPAVertices;
+
+        glm::vec3 Normalized(const glm::vec3& d)
+        {
+            const float len2 = glm::dot(d, d);
+            return len2 > 0.0f ? d * (1.0f / std::sqrt(len2)) : glm::vec3(1.0f, 0.0f, 0.0f);
+        }
+
+        // Point of the Minkowski difference A - B of the two cores, with the direction that
+        // produced it (so the simplex can be rebuilt at the next query) and its two witnesses.
+        struct SupportPoint
+        {
+            glm::vec3 w{ 0.0f };
+            glm::vec3 a{ 0.0f };
+            glm::vec3 b{ 0.0f };
+            glm::vec3 direction{ 1.0f, 0.0f, 0.0f };
+        };
+
+        SupportPoint CoreSupportPoint(const ConvexShape& a, const ConvexShape& b, const glm::vec3& direction)
+        {
+            SupportPoint p;
+            p.direction = Normalized(direction);
+            p.a = a.CoreSupport(p.direction);
+            p.b = b.CoreSupport(-p.direction);
+            p.w = p.a - p.b;
+            return p;
+        }
+
+        struct Simplex
+        {
+            std::array<SupportPoint, 4> points{};
+            std::array<float, 4> weights{}; // barycentric coordinates of the closest point
+            int count = 0;
+        };
+
+        // Sub-simplex nearest the origin: which vertices span it and the point's weights on them.
+        struct Feature
+        {
+            std::array<int, 3> index{};
+            std::array<float, 3> weight{};
+            int count = 0;
+            glm::vec3 point{ 0.0f };
+        };
+
+        Feature VertexFeature(const Simplex& s, int i)
+        {
+            return { { i, 0, 0 }, { 1.0f, 0.0f, 0.0f }, 1, s.points[i].w };
+        }
+
+        Feature EdgeFeature(const Simplex& s, int i, int j, float t)
+        {
+            return { { i, j, 0 }, { 1.0f - t, t, 0.0f }, 2, s.points[i].w + (s.points[j].w - s.points[i].w) * t };
+        }
+
+        Feature ClosestOnSegment(const Simplex& s, int i, int j)
+        {
+            const glm::vec3& a = s.points[i].w;
+            const glm::vec3 ab = s.points[j].w - a;
+            const float denom = glm::dot(ab, ab);
+            const float t = denom > 0.0f ? -glm::dot(a, ab) / denom : 0.0f;
+
+            if (t <= 0.0f) return VertexFeature(s, i);
+            if (t >= 1.0f) return VertexFeature(s, j);
+            return EdgeFeature(s, i, j, t);
+        }
+
+        // Voronoi-region walk over the triangle (Ericson, Real-Time Collision Detection 5.1.5)
+        // with the query point at the origin.
+        Feature ClosestOnTriangle(const Simplex& s, int i, int j, int k)
+        {
+            const glm::vec3& a = s.points[i].w;
+            const glm::vec3& b = s.points[j].w;
+            const glm::vec3& c = s.points[k].w;
+            const glm::vec3 ab = b - a;
+            const glm::vec3 ac = c - a;
+
+            const float d1 = -glm::dot(ab, a);
+            const float d2 = -glm::dot(ac, a);
+            if (d1 <= 0.0f && d2 <= 0.0f) return VertexFeature(s, i);
+
+            const float d3 = -glm::dot(ab, b);
+            const float d4 = -glm::dot(ac, b);
+            if (d3 >= 0.0f && d4 <= d3) return VertexFeature(s, j);
+
+            const float vc = d1 * d4 - d3 * d2;
+            if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+                return EdgeFeature(s, i, j, d1 - d3 > 0.0f ? d1 / (d1 - d3) : 0.0f);
+
+            const float d5 = -glm::dot(ab, c);
+            const float d6 = -glm::dot(ac, c);
+            if (d6 >= 0.0f && d5 <= d6) return VertexFeature(s, k);
+
+            const float vb = d5 * d2 - d1 * d6;
+            if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+                return EdgeFeature(s, i, k, d2 - d6 > 0.0f ? d2 / (d2 - d6) : 0.0f);
+
+            const float va = d3 * d6 - d5 * d4;
+            const float e1 = d4 - d3;
+            const float e2 = d5 - d6;
+            if (va <= 0.0f && e1 >= 0.0f && e2 >= 0.0f)
+                return EdgeFeature(s, j, k, e1 + e2 > 0.0f ? e1 / (e1 + e2) : 0.0f);
+
+            const float sum = va + vb + vc;
+            if (sum <= 0.0f)
+            {
+                // Collinear vertices: the nearest of the three edges.
+                Feature best = ClosestOnSegment(s, i, j);
+                for (const Feature& f : { ClosestOnSegment(s, i, k), ClosestOnSegment(s, j, k) })
+                    if (glm::dot(f.point, f.point) < glm::dot(best.point, best.point)) best = f;
+                return best;
+            }
+
+            const float v = vb / sum;
+            const float w = vc / sum;
+            return { { i, j, k }, { 1.0f - v - w, v, w }, 3, a + ab * v + ac * w };
+        }
+
+        // False when the origin lies inside the tetrahedron.
+        bool ClosestOnTetrahedron(const Simplex& s, Feature& out)
+        {
+            static constexpr int kFaces[4][4] = { { 0, 1, 2, 3 }, { 0, 3, 1, 2 }, { 0, 2, 3, 1 }, { 1, 3, 2, 0 } };
+
+            bool outside = false;
+            float bestDistance2 = std::numeric_limits<float>::infinity();
+            for (const auto& face : kFaces)
+            {
+                const glm::vec3& a = s.points[face[0]].w;
+                const glm::vec3 n = glm::cross(s.points[face[1]].w - a, s.points[face[2]].w - a);
+                const float sideOrigin = -glm::dot(a, n);
+                const float sideOpposite = glm::dot(s.points[face[3]].w - a, n);
+
+                // A flat tetrahedron has no inside; every face is a candidate then.
+                if (sideOrigin * sideOpposite > 0.0f && std::abs(sideOpposite) > kDuplicateDistance2) continue;
+
+                const Feature f = ClosestOnTriangle(s, face[0], face[1], face[2]);
+                const float distance2 = glm::dot(f.point, f.point);
+                if (distance2 < bestDistance2)
+                {
+                    bestDistance2 = distance2;
+                    out = f;
+                }
+                outside = true;
+            }
+            return outside;
+        }
+
+        // Reduces the simplex to the feature nearest the origin and returns that point.
+        // False when the simplex is a tetrahedron around the origin.
+        bool Solve(Simplex& s, glm::vec3& closest)
+        {
+            Feature f;
+            switch (s.count)
+            {
+            case 1: f = VertexFeature(s, 0); break;
+            case 2: f = ClosestOnSegment(s, 0, 1); break;
+            case 3: f = ClosestOnTriangle(s, 0, 1, 2); break;
+            default:
+                if (!ClosestOnTetrahedron(s, f)) return false;
+                break;
+            }
+
+            std::array<SupportPoint, 4> kept{};
+            for (int i = 0; i < f.count; ++i) kept[i] = s.points[f.index[i]];
+            for (int i = 0; i < f.count; ++i)
+            {
+                s.points[i] = kept[i];
+                s.weights[i] = f.weight[i];
+            }
+            s.count = f.count;
+            closest = f.point;
+            return true;
+        }
+
+        struct CoreQuery
+        {
+            Simplex simplex;
+            glm::vec3 closest{ 0.0f }; // nearest point of the core difference to the origin
+            bool overlap = false;
+            int iterations = 0;
+        };
+
+        CoreQuery RunGJK(const ConvexShape& a, const ConvexShape& b, GJKSimplex* cache)
+        {
+            CoreQuery q;
+            Simplex& s = q.simplex;
+
+            auto isNew = [&](const glm::vec3& w)
+            {
+                for (int i = 0; i < s.count; ++i)
+                    if (glm::dot(s.points[i].w - w, s.points[i].w - w) <= kDuplicateDistance2) return false;
+                return true;
+            };
+
+            // Rebuild last query's simplex at the current poses; the directions still give valid
+            // support points, and they are usually already next to the answer.
+            if (cache)
+            {
+                for (int i = 0; i < cache->count && i < 4; ++i)
+                {
+                    const SupportPoint p = CoreSupportPoint(a, b, cache->directions[i]);
+                    if (isNew(p.w)) s.points[s.count++] = p;
+                }
+            }
+            if (s.count == 0)
+            {
+                s.points[0] = CoreSupportPoint(a, b, b.center - a.center);
+                s.count = 1;
+            }
+
+            glm::vec3 v{ 0.0f };
+            for (;;)
+            {
+                if (!Solve(s, v) || glm::dot(v, v) <= kTouchingDistance2)
+                {
+                    q.overlap = true;
+                    break;
+                }
+                if (q.iterations >= kMaxGJKIterations) break;
+
+                const float vv = glm::dot(v, v);
+                const SupportPoint p = CoreSupportPoint(a, b, -v);
+                ++q.iterations;
+
+                // No support point gets meaningfully closer than v: converged.
+                if (vv - glm::dot(v, p.w) <= kGJKTolerance * vv || !isNew(p.w)) break;
+                s.points[s.count++] = p;
+            }
+
+            if (cache)
+            {
+                cache->count = s.count;
+                for (int i = 0; i < s.count; ++i) cache->directions[i] = s.points[i].direction;
+            }
+
+            q.closest = v;
+            return q;
+        }
+
+        // Expanding polytope over the full shapes (margins included), starting from the GJK
+        // simplex around the origin. False if the difference is too flat to give a depth.
+        bool RunEPA(const ConvexShape& a, const ConvexShape& b, const Simplex& simplex, Contact& out)
+        {
+            auto support = [&](const glm::vec3& d)
+            {
+                const glm::vec3 n = Normalized(d);
+                return a.Support(n) - b.Support(-n);
+            };
+
+            std::array<glm::vec3, kMaxEPAVertices> vertices{};
+            int vertexCount = 0;
+            for (int i = 0; i < simplex.count; ++i) vertices[vertexCount++] = simplex.points[i].w;
+
+            // GJK stops early when the origin sits on a vertex, edge or face of the simplex;
+            // grow it into a tetrahedron first.
+            if (vertexCount == 1)
+            {
+                static const glm::vec3 kAxes[6] = { { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 } };
+                for (const glm::vec3& axis : kAxes)
+                {
+                    const glm::vec3 w = support(axis);
+                    if (glm::dot(w - vertices[0], w - vertices[0]) > kDuplicateDistance2) { vertices[vertexCount++] = w; break; }
+                }
+            }
+            if (vertexCount == 2)
+            {
+                const glm::vec3 line = Normalized(vertices[1] - vertices[0]);
+                const glm::vec3 absLine = glm::abs(line);
+                glm::vec3 axis{ 0.0f };
+                axis[absLine.x < absLine.y ? (absLine.x < absLine.z ? 0 : 2) : (absLine.y < absLine.z ? 1 : 2)] = 1.0f;
+                const glm::vec3 e1 = Normalized(glm::cross(line, axis));
+                const glm::vec3 e2 = glm::cross(line, e1);
+                for (int k = 0; k < 6; ++k)
+                {
+                    const float angle = static_cast<float>(k) * (3.14159265f / 3.0f);
+                    const glm::vec3 w = support(e1 * std::cos(angle) + e2 * std::sin(angle));
+                    const glm::vec3 offset = w - vertices[0];
+                    const glm::vec3 offLine = offset - line * glm::dot(offset, line);
+                    if (glm::dot(offLine, offLine) > kDuplicateDistance2) { vertices[vertexCount++] = w; break; }
+                }
+            }
+            if (vertexCount == 3)
+            {
+                const glm::vec3 n = Normalized(glm::cross(vertices[1] - vertices[0], vertices[2] - vertices[0]));
+                for (const glm::vec3& d : { n, -n })
+                {
+                    const glm::vec3 w = support(d);
+                    if (std::abs(glm::dot(w - vertices[0], n)) > kEPATolerance) { vertices[vertexCount++] = w; break; }
+                }
+            }
+            if (vertexCount < 4) return false;
+
+            struct Face
+            {
+                int a, b, c;
+                glm::vec3 normal;
+                float distance;
+            };
+            std::array<Face, kMaxEPAFaces> faces{};
+            int faceCount = 0;
+
+            // Degenerate (zero-area) faces stay in the polytope so its edges still close, but
+            // are never picked as the nearest face.
+            auto addFace = [&](int i, int j, int k)
+            {
+                const glm::vec3 n = glm::cross(vertices[j] - vertices[i], vertices[k] - vertices[i]);
+                const float len2 = glm::dot(n, n);
+                Face& f = faces[faceCount++];
+                f = { i, j, k, glm::vec3(0.0f), std::numeric_limits<float>::infinity() };
+                if (len2 > 0.0f)
+                {
+                    f.normal = n * (1.0f / std::sqrt(len2));
+                    f.distance = glm::dot(f.normal, vertices[i]);
+                }
+            };
+
+            // Wind the tetrahedron faces outwards (away from the opposite vertex).
+            static constexpr int kFaces[4][4] = { { 0, 1, 2, 3 }, { 0, 3, 1, 2 }, { 0, 2, 3, 1 }, { 1, 3, 2, 0 } };
+            for (const auto& face : kFaces)
+            {
+                const glm::vec3 n = glm::cross(vertices[face[1]] - vertices[face[0]], vertices[face[2]] - vertices[face[0]]);
+                if (glm::dot(n, vertices[face[3]] - vertices[face[0]]) > 0.0f) addFace(face[0], face[2], face[1]);
+                else addFace(face[0], face[1], face[2]);
+            }
+
+            auto nearestFace = [&]()
+            {
+                int best = 0;
+                for (int i = 1; i < faceCount; ++i)
+                    if (faces[i].distance < faces[best].distance) best = i;
+                return best;
+            };
+
+            struct Edge { int a, b; };
+            std::array<Edge, kMaxEPAEdges> horizon{};
+
+            auto sharesEdge = [](const Face& f, const Face& g)
+            {
+                const int shared = (f.a == g.a || f.a == g.b || f.a == g.c) +
+                                   (f.b == g.a || f.b == g.b || f.b == g.c) +
+                                   (f.c == g.a || f.c == g.b || f.c == g.c);
+                return shared >= 2;
+            };
+
+            std::array<bool, kMaxEPAFaces> removed{};
+            for (int iteration = 0; iteration < kMaxEPAIterations; ++iteration)
+            {
+                const int nearestIndex = nearestFace();
+                const Face nearest = faces[nearestIndex];
+                if (!std::isfinite(nearest.distance)) return false;
+
+                const glm::vec3 w = support(nearest.normal);
+                if (glm::dot(w, nearest.normal) - nearest.distance < kEPATolerance) break;
+                if (vertexCount == kMaxEPAVertices) break;
+
+                // Drop the faces that can see the new point, grown outwards from the nearest face
+                // across shared edges: on curved shapes rounding can make a far face look visible
+                // too, and a second hole would tear the polytope.
+                removed.fill(false);
+                removed[nearestIndex] = true;
+                int removedCount = 1;
+                for (bool grew = true; grew;)
+                {
+                    grew = false;
+                    for (int i = 0; i < faceCount; ++i)
+                    {
+                        if (removed[i] || glm::dot(faces[i].normal, w - vertices[faces[i].a]) <= 0.0f) continue;
+                        for (int j = 0; j < faceCount; ++j)
+                        {
+                            if (!removed[j] || !sharesEdge(faces[i], faces[j])) continue;
+                            removed[i] = true;
+                            ++removedCount;
+                            grew = true;
+                            break;
+                        }
+                    }
+                }
+
+                // The edges bordering the hole (used by exactly one dropped face) form the horizon.
+                int edgeCount = 0;
+                bool overflow = false;
+                auto addEdge = [&](int i, int j)
+                {
+                    for (int e = 0; e < edgeCount; ++e)
+                    {
+                        if (horizon[e].a == j && horizon[e].b == i)
+                        {
+                            horizon[e] = horizon[--edgeCount];
+                            return;
+                        }
+                    }
+                    if (edgeCount == kMaxEPAEdges) { overflow = true; return; }
+                    horizon[edgeCount++] = { i, j };
+                };
+                for (int i = 0; i < faceCount; ++i)
+                {
+                    if (!removed[i]) continue;
+                    addEdge(faces[i].a, faces[i].b);
+                    addEdge(faces[i].b, faces[i].c);
+                    addEdge(faces[i].c, faces[i].a);
+                }
+                if (overflow || faceCount - removedCount + edgeCount > kMaxEPAFaces) break;
+
+                int kept = 0;
+                for (int i = 0; i < faceCount; ++i)
+                    if (!removed[i]) faces[kept++] = faces[i];
+                faceCount = kept;
+
+                const int newVertex = vertexCount++;
+                vertices[newVertex] = w;
+                for (int e = 0; e < edgeCount; ++e) addFace(horizon[e].a, horizon[e].b, newVertex);
+            }
+
+            const Face& result = faces[nearestFace()];
+            if (!std::isfinite(result.distance)) return false;
+
+            out.hit = true;
+            out.normal = result.normal;
+            out.penetration = std::max(0.0f, result.distance);
+            return true;
+        }
+    }
+
+    ConvexShape ConvexShape::Sphere(const glm::vec3& center, float radius)
+    {
+        ConvexShape s;
+        s.kind = Kind::Sphere;
+        s.center = center;
+        s.radius = radius;
+        return s;
+    }
+
+    ConvexShape ConvexShape::Capsule(const glm::vec3& center, const glm::mat3& orientation, float radius, float halfHeight)
+    {
+        ConvexShape s;
+        s.kind = Kind::Capsule;
+        s.center = center;
+        s.orientation = orientation;
+        s.radius = radius;
+        s.halfHeight = halfHeight;
+        return s;
+    }
+
+    ConvexShape ConvexShape::Cylinder(const glm::vec3& center, const glm::mat3& orientation, float radius, float halfHeight)
+    {
+        ConvexShape s = Capsule(center, orientation, radius, halfHeight);
+        s.kind = Kind::Cylinder;
+        return s;
+    }
+
+    ConvexShape ConvexShape::Box(const OBB& obb)
+    {
+        ConvexShape s;
+        s.kind = Kind::Box;
+        s.center = obb.center;
+        s.orientation = obb.orientation;
+        s.halfExtents = obb.halfExtents;
+        return s;
+    }
+
+    ConvexShape ConvexShape::Hull(const glm::vec3& center, const glm::mat3& orientation, const glm::vec3* points, uint32_t pointCount)
+    {
+        ConvexShape s;
+        s.kind = Kind::Hull;
+        s.center = center;
+        s.orientation = orientation;
+        s.points = points;
+        s.pointCount = pointCount;
+        return s;
+    }
+
+    float ConvexShape::Margin() const
+    {
+        return (kind == Kind::Sphere || kind == Kind::Capsule) ? radius : 0.0f;
+    }
+
+    glm::vec3 ConvexShape::CoreSupport(const glm::vec3& direction) const
+    {
+        switch (kind)
+        {
+        case Kind::Sphere:
+            return center;
+
+        case Kind::Capsule:
+            return center + orientation[1] * (glm::dot(orientation[1], direction) >= 0.0f ? halfHeight : -halfHeight);
+
+        case Kind::Cylinder:
+        {
+            // Radial part from the local x/z components: subtracting the axial part in world
+            // space cancels badly for directions close to the axis.
+            const float x = glm::dot(orientation[0], direction);
+            const float y = glm::dot(orientation[1], direction);
+            const float z = glm::dot(orientation[2], direction);
+            const float radial2 = x * x + z * z;
+
+            glm::vec3 p = center + orientation[1] * (y >= 0.0f ? halfHeight : -halfHeight);
+            if (radial2 > kDuplicateDistance2)
+            {
+                const float scale = radius / std::sqrt(radial2);
+                p += (orientation[0] * x + orientation[2] * z) * scale;
+            }
+            return p;
+        }
+
+        case Kind::Box:
+        {
+            glm::vec3 p = center;
+            for (int i = 0; i < 3; ++i)
+                p += orientation[i] * (glm::dot(orientation[i], direction) >= 0.0f ? halfExtents[i] : -halfExtents[i]);
+            return p;
+        }
+
+        case Kind::Hull:
+        {
+            if (!points || pointCount == 0) return center;
+            const glm::vec3 local = glm::transpose(orientation) * direction;
+            uint32_t best = 0;
+            float bestDot = glm::dot(points[0], local);
+            for (uint32_t i = 1; i < pointCount; ++i)
+            {
+                const float d = glm::dot(points[i], local);
+                if (d > bestDot) { bestDot = d; best = i; }
+            }
+            return center + orientation * points[best];
+        }
+        }
+        return center;
+    }
+
+    glm::vec3 ConvexShape::Support(const glm::vec3& direction) const
+    {
+        const float margin = Margin();
+        if (margin <= 0.0f) return CoreSupport(direction);
+        return CoreSupport(direction) + Normalized(direction) * margin;
+    }
+
+    AABB ConvexBounds(const ConvexShape& shape)
+    {
+        AABB out{};
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            glm::vec3 d{ 0.0f };
+            d[axis] = 1.0f;
+            out.max[axis] = shape.Support(d)[axis];
+            out.min[axis] = shape.Support(-d)[axis];
+        }
+        return out;
+    }
+
+    GJKResult GJKDistance(const ConvexShape& a, const ConvexShape& b, GJKSimplex* cache)
+    {
+        GJKResult result;
+        const CoreQuery q = RunGJK(a, b, cache);
+        result.iterations = q.iterations;
+        if (q.overlap)
+        {
+            result.overlap = true;
+            return result;
+        }
+
+        glm::vec3 coreA{ 0.0f };
+        glm::vec3 coreB{ 0.0f };
+        for (int i = 0; i < q.simplex.count; ++i)
+        {
+            coreA += q.simplex.points[i].a * q.simplex.weights[i];
+            coreB += q.simplex.points[i].b * q.simplex.weights[i];
+        }
+
+        const float coreDistance = glm::length(q.closest);
+        const glm::vec3 n = -q.closest / coreDistance; // A -> B
+        result.distance = coreDistance - a.Margin() - b.Margin();
+        if (result.distance <= 0.0f)
+        {
+            result.overlap = true;
+            result.distance = 0.0f;
+            return result;
+        }
+
+        result.pointA = coreA + n * a.Margin();
+        result.pointB = coreB - n * b.Margin();
+        return result;
+    }
+
+    bool ConvexVsConvex(const ConvexShape& a, const ConvexShape& b, Contact& out, GJKSimplex* cache, int* iterations)
+    {
+        out = {};
+        const CoreQuery q = RunGJK(a, b, cache);
+        if (iterations) *iterations = q.iterations;
+
+        if (!q.overlap)
+        {
+            // Separated cores: only the margins can make the shapes touch.
+            const float margin = a.Margin() + b.Margin();
+            const float distance2 = glm::dot(q.closest, q.closest);
+            if (distance2 >= margin * margin) return false;
+
+            const float distance = std::sqrt(distance2);
+            out.hit = true;
+            out.normal = -q.closest / distance;
+            out.penetration = margin - distance;
+            return true;
+        }
+
+        if (!RunEPA(a, b, q.simplex, out))
+        {
+            // Flat difference (the shapes only touch): report the contact without a depth.
+            out.hit = true;
+            out.normal = SafeNormalize(b.center - a.center, { 0.0f, 1.0f, 0.0f });
+            out.penetration = 0.0f;
+        }
+        return true;
+    }
+
+    bool ConvexVsPlane(const ConvexShape& shape, const glm::vec3& planeNormal, const glm::vec3& planePoint, Contact& out)
+    {
+        out = {};
+        const glm::vec3 deepest = shape.Support(-planeNormal);
+        const float dist = glm::dot(deepest - planePoint, planeNormal);
+        if (dist > 0.0f) return false;
+
+        out.hit = true;
+        out.normal = planeNormal;
+        out.penetration = -dist;
+        return true;
+    }
+}
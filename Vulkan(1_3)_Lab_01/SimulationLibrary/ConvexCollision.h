@@ -0,0 +1,71 @@
+#pragma once
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "CollisionUtil.h"
+
+// GJK distance and EPA penetration over support-mapped convex shapes.
+// A shape only has to report its furthest point along a direction, so the same two routines
+// cover every pairing of sphere, capsule, cylinder, box and convex hull.
+// Spheres and capsules are run as their core (a point or a segment) with the radius kept as a
+// margin: GJK on the cores gives their exact distance, and EPA only runs once the cores overlap.
+// Passing the same GJKSimplex to consecutive queries on a pair seeds GJK with the previous
+// simplex, so a persistent contact usually converges in one or two iterations.
+namespace SimCollision
+{
+    constexpr int kMaxGJKIterations = 32;
+    constexpr int kMaxEPAIterations = 64;
+    constexpr float kGJKTolerance = 1e-4f; // relative, on the squared distance
+    constexpr float kEPATolerance = 1e-4f; // absolute, on the penetration depth
+
+    struct ConvexShape
+    {
+        enum class Kind : uint8_t { Sphere, Capsule, Cylinder, Box, Hull };
+
+        Kind kind = Kind::Sphere;
+        glm::vec3 center{ 0.0f };
+        glm::mat3 orientation{ 1.0f };     // columns are local axes in world-space
+        float radius = 0.5f;               // sphere, capsule, cylinder
+        float halfHeight = 0.0f;           // capsule segment / cylinder, along local Y
+        glm::vec3 halfExtents{ 0.5f };     // box
+        const glm::vec3* points = nullptr; // hull vertices in local space (not owned)
+        uint32_t pointCount = 0;
+
+        static ConvexShape Sphere(const glm::vec3& center, float radius);
+        static ConvexShape Capsule(const glm::vec3& center, const glm::mat3& orientation, float radius, float halfHeight);
+        static ConvexShape Cylinder(const glm::vec3& center, const glm::mat3& orientation, float radius, float halfHeight);
+        static ConvexShape Box(const OBB& obb);
+        static ConvexShape Hull(const glm::vec3& center, const glm::mat3& orientation, const glm::vec3* points, uint32_t pointCount);
+
+        // Rounding radius of spheres and capsules, 0 for the others.
+        float Margin() const;
+        // Furthest point along 'direction' in world space, without / with the margin.
+        glm::vec3 CoreSupport(const glm::vec3& direction) const;
+        glm::vec3 Support(const glm::vec3& direction) const;
+    };
+
+    AABB ConvexBounds(const ConvexShape& shape);
+
+    // Search directions of the simplex a query ended with; count == 0 means no history.
+    struct GJKSimplex
+    {
+        glm::vec3 directions[4]{};
+        int count = 0;
+    };
+
+    struct GJKResult
+    {
+        bool overlap = false;          // the shapes (margins included) intersect
+        float distance = 0.0f;         // between the surfaces, 0 when overlapping
+        glm::vec3 pointA{ 0.0f };      // closest points, valid when not overlapping
+        glm::vec3 pointB{ 0.0f };
+        int iterations = 0;            // support evaluations after the seed simplex
+    };
+
+    GJKResult GJKDistance(const ConvexShape& a, const ConvexShape& b, GJKSimplex* cache = nullptr);
+
+    // Contact normal points from A to B. 'iterations' receives the GJK iteration count.
+    bool ConvexVsConvex(const ConvexShape& a, const ConvexShape& b, Contact& out, GJKSimplex* cache = nullptr, int* iterations = nullptr);
+
+    // Same convention as OBBVsPlane: the normal is the plane normal (plane -> shape).
+    bool ConvexVsPlane(const ConvexShape& shape, const glm::vec3& planeNormal, const glm::vec3& planePoint, Contact& out);
+}
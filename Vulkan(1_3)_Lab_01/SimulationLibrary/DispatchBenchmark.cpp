@@ -0,0 +1,285 @@
+#include "DispatchBenchmark.h"
+#include "CollisionDispatch.h"
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/quaternion.hpp>
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using namespace SimCollision;
+
+    // The layout Collider replaced, kept only as the baseline.
+    struct VirtualCollider
+    {
+        virtual ~VirtualCollider() = default;
+        virtual Collider::Type GetType() const = 0;
+        virtual void SyncFromTransform(const glm::mat4& transform) = 0;
+    };
+
+    template <typename T>
+    struct VirtualShape final : VirtualCollider
+    {
+        explicit VirtualShape(const T& s) : shape(s), type(Collider(s).GetType()) {}
+        Collider::Type GetType() const override { return type; }
+        void SyncFromTransform(const glm::mat4& transform) override { shape.SyncFromTransform(transform); }
+
+        T shape;
+        Collider::Type type;
+    };
+
+    // Same shape tests as the table, reached the old way: one dynamic_cast per side.
+    template <typename A, typename B>
+    bool VirtualPair(const VirtualCollider* a, const VirtualCollider* b, Contact& out)
+    {
+        const auto* sa = dynamic_cast<const VirtualShape<A>*>(a);
+        const auto* sb = dynamic_cast<const VirtualShape<B>*>(b);
+        if (!sa || !sb) return false;
+
+        if constexpr (PairTest<A, B>::kDefined)
+        {
+            return PairTest<A, B>::Run(sa->shape, sb->shape, out);
+        }
+        else
+        {
+            if (!PairTest<B, A>::Run(sb->shape, sa->shape, out)) return false;
+            out.normal = -out.normal;
+            return true;
+        }
+    }
+
+    bool VirtualCollide(const VirtualCollider* a, const VirtualCollider* b, Contact& out)
+    {
+        using Type = Collider::Type;
+        const Type ta = a->GetType();
+        const Type tb = b->GetType();
+
+        if (ta == Type::Sphere && tb == Type::Sphere) return VirtualPair<SphereCollider, SphereCollider>(a, b, out);
+        if (ta == Type::Sphere && tb == Type::Plane) return VirtualPair<SphereCollider, PlaneCollider>(a, b, out);
+        if (ta == Type::Sphere && tb == Type::Box) return VirtualPair<SphereCollider, BoxCollider>(a, b, out);
+        if (ta == Type::Plane && tb == Type::Sphere) return VirtualPair<PlaneCollider, SphereCollider>(a, b, out);
+        if (ta == Type::Plane && tb == Type::Box) return VirtualPair<PlaneCollider, BoxCollider>(a, b, out);
+        if (ta == Type::Box && tb == Type::Sphere) return VirtualPair<BoxCollider, SphereCollider>(a, b, out);
+        if (ta == Type::Box && tb == Type::Plane) return VirtualPair<BoxCollider, PlaneCollider>(a, b, out);
+        if (ta == Type::Box && tb == Type::Box) return VirtualPair<BoxCollider, BoxCollider>(a, b, out);
+
+        out = {};
+        return false;
+    }
+
+    double ElapsedMs(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Owns the float arrays behind a Vec3Stream.
+    struct Vec3Storage
+    {
+        std::vector<float> x, y, z;
+
+        void Push(const glm::vec3& v) { x.push_back(v.x); y.push_back(v.y); z.push_back(v.z); }
+        glm::vec3 Get(size_t i) const { return { x[i], y[i], z[i] }; }
+        Vec3Stream Stream() const { return { x.data(), y.data(), z.data() }; }
+    };
+
+    // Runs 'batch' through 'kernel' at each level and compares every pair with 'scalar(i, contact)'.
+    template <typename Batch, typename Kernel, typename Scalar>
+    void CheckBatchKernel(const Batch& batch, Kernel kernel, Scalar scalar, float tolerance, BatchKernelCheckResult& result)
+    {
+        const int best = static_cast<int>(SimSimd::GetBestSimdLevel());
+        BatchContacts hits;
+        std::vector<int> hitOf(batch.count);
+
+        for (int level = 0; level <= best; ++level)
+        {
+            kernel(batch, hits, static_cast<SimSimd::SimdLevel>(level));
+            std::fill(hitOf.begin(), hitOf.end(), -1);
+            for (size_t h = 0; h < hits.Size(); ++h) hitOf[hits.pairIndex[h]] = static_cast<int>(h);
+
+            for (size_t i = 0; i < batch.count; ++i)
+            {
+                Contact expected{};
+                const bool hit = scalar(i, expected);
+                ++result.comparisons;
+
+                const int h = hitOf[i];
+                if (hit != (h >= 0))
+                {
+                    ++result.mismatches;
+                    continue;
+                }
+                if (!hit) continue;
+
+                const float error = std::max({ std::abs(hits.normalX[h] - expected.normal.x),
+                    std::abs(hits.normalY[h] - expected.normal.y), std::abs(hits.normalZ[h] - expected.normal.z),
+                    std::abs(hits.penetration[h] - expected.penetration) });
+                result.maxError = std::max(result.maxError, error);
+                if (error > tolerance) ++result.mismatches;
+            }
+        }
+    }
+}
+
+namespace SimCollision
+{
+    DispatchBenchmarkResult RunDispatchBenchmark(uint32_t bodyCount, uint32_t passes, uint32_t seed)
+    {
+        DispatchBenchmarkResult result{};
+        result.bodyCount = bodyCount;
+
+        // Mostly spheres and boxes with the odd plane, packed so that a few percent of pairs touch.
+        std::mt19937 rng(seed);
+        const float extent = 1.2f * std::cbrt(static_cast<float>(std::max(bodyCount, 1u)));
+        std::uniform_real_distribution<float> position(-extent, extent);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        std::uniform_real_distribution<float> size(0.2f, 0.5f);
+
+        std::vector<glm::mat4> transforms(bodyCount);
+        std::vector<std::unique_ptr<VirtualCollider>> virtualColliders;
+        std::vector<Collider> colliders;
+        virtualColliders.reserve(bodyCount);
+        colliders.reserve(bodyCount);
+
+        for (uint32_t i = 0; i < bodyCount; ++i)
+        {
+            const glm::vec3 axis = SafeNormalize({ unit(rng), unit(rng), unit(rng) });
+            transforms[i] = glm::mat4_cast(glm::angleAxis(unit(rng) * 3.14159265f, axis));
+            transforms[i][3] = glm::vec4(position(rng), position(rng), position(rng), 1.0f);
+
+            if (i % 32 == 31)
+            {
+                const PlaneCollider plane(axis);
+                virtualColliders.push_back(std::make_unique<VirtualShape<PlaneCollider>>(plane));
+                colliders.push_back(plane);
+            }
+            else if (i % 2 == 0)
+            {
+                const SphereCollider sphere(size(rng));
+                virtualColliders.push_back(std::make_unique<VirtualShape<SphereCollider>>(sphere));
+                colliders.push_back(sphere);
+            }
+            else
+            {
+                const BoxCollider box({ size(rng), size(rng), size(rng) });
+                virtualColliders.push_back(std::make_unique<VirtualShape<BoxCollider>>(box));
+                colliders.push_back(box);
+            }
+        }
+
+        const uint64_t pairsPerPass = uint64_t(bodyCount) * (bodyCount > 0 ? bodyCount - 1 : 0) / 2;
+        result.pairTests = pairsPerPass * passes;
+        Contact contact{};
+
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t pass = 0; pass < passes; ++pass)
+        {
+            for (uint32_t i = 0; i < bodyCount; ++i) virtualColliders[i]->SyncFromTransform(transforms[i]);
+            for (uint32_t i = 0; i < bodyCount; ++i)
+                for (uint32_t j = i + 1; j < bodyCount; ++j)
+                    result.virtualHits += VirtualCollide(virtualColliders[i].get(), virtualColliders[j].get(), contact) ? 1 : 0;
+        }
+        result.virtualMs = ElapsedMs(start);
+
+        start = std::chrono::steady_clock::now();
+        for (uint32_t pass = 0; pass < passes; ++pass)
+        {
+            for (uint32_t i = 0; i < bodyCount; ++i) colliders[i].SyncFromTransform(transforms[i]);
+            for (uint32_t i = 0; i < bodyCount; ++i)
+                for (uint32_t j = i + 1; j < bodyCount; ++j)
+                    result.tableHits += Collide(colliders[i], colliders[j], contact) ? 1 : 0;
+        }
+        result.tableMs = ElapsedMs(start);
+
+        return result;
+    }
+
+    BatchKernelCheckResult RunBatchKernelCheck(uint32_t pairCount, uint32_t seed, float tolerance)
+    {
+        BatchKernelCheckResult result{};
+        result.pairCount = pairCount;
+        result.levelsChecked = static_cast<int>(SimSimd::GetBestSimdLevel()) + 1;
+
+        // Shapes a couple of units apart, so roughly half of the pairs touch
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> position(-2.0f, 2.0f);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        std::uniform_real_distribution<float> size(0.2f, 1.0f);
+        auto randomDirection = [&]() { return SafeNormalize({ unit(rng), unit(rng), unit(rng) }); };
+
+        Vec3Storage sphereCenter, planeNormal, planePoint, obbCenter, obbAxis[3], obbHalfExtents, capsuleA, capsuleB;
+        std::vector<float> sphereRadius, capsuleRadius;
+        std::vector<OBB> obbs;
+
+        for (uint32_t i = 0; i < pairCount; ++i)
+        {
+            sphereCenter.Push({ position(rng), position(rng), position(rng) });
+            sphereRadius.push_back(size(rng));
+            planeNormal.Push(randomDirection());
+            planePoint.Push({ unit(rng), unit(rng), unit(rng) });
+
+            OBB obb;
+            obb.center = { unit(rng), unit(rng), unit(rng) };
+            obb.orientation = glm::mat3_cast(glm::angleAxis(unit(rng) * 3.14159265f, randomDirection()));
+            obb.halfExtents = { size(rng), size(rng), size(rng) };
+            obbs.push_back(obb);
+            obbCenter.Push(obb.center);
+            for (int a = 0; a < 3; ++a) obbAxis[a].Push(obb.orientation[a]);
+            obbHalfExtents.Push(obb.halfExtents);
+
+            capsuleA.Push({ unit(rng), unit(rng), unit(rng) });
+            capsuleB.Push({ unit(rng), unit(rng), unit(rng) });
+            capsuleRadius.push_back(0.5f * size(rng));
+        }
+
+        SpherePlaneBatch spherePlane;
+        spherePlane.center = sphereCenter.Stream();
+        spherePlane.radius = sphereRadius.data();
+        spherePlane.planeNormal = planeNormal.Stream();
+        spherePlane.planePoint = planePoint.Stream();
+        spherePlane.count = pairCount;
+        CheckBatchKernel(spherePlane, SphereVsPlaneBatch, [&](size_t i, Contact& out) {
+            return SphereVsPlane(sphereCenter.Get(i), sphereRadius[i], planeNormal.Get(i), planePoint.Get(i), out);
+        }, tolerance, result);
+
+        OBBPlaneBatch obbPlane;
+        obbPlane.center = obbCenter.Stream();
+        for (int a = 0; a < 3; ++a) obbPlane.axis[a] = obbAxis[a].Stream();
+        obbPlane.halfExtents = obbHalfExtents.Stream();
+        obbPlane.planeNormal = planeNormal.Stream();
+        obbPlane.planePoint = planePoint.Stream();
+        obbPlane.count = pairCount;
+        CheckBatchKernel(obbPlane, OBBVsPlaneBatch, [&](size_t i, Contact& out) {
+            return OBBVsPlane(obbs[i], planeNormal.Get(i), planePoint.Get(i), out);
+        }, tolerance, result);
+
+        SphereOBBBatch sphereOBB;
+        sphereOBB.sphereCenter = sphereCenter.Stream();
+        sphereOBB.sphereRadius = sphereRadius.data();
+        sphereOBB.obbCenter = obbCenter.Stream();
+        for (int a = 0; a < 3; ++a) sphereOBB.obbAxis[a] = obbAxis[a].Stream();
+        sphereOBB.obbHalfExtents = obbHalfExtents.Stream();
+        sphereOBB.count = pairCount;
+        CheckBatchKernel(sphereOBB, SphereVsOBBBatch, [&](size_t i, Contact& out) {
+            return SphereVsOBB(sphereCenter.Get(i), sphereRadius[i], obbs[i], out);
+        }, tolerance, result);
+
+        SphereCapsuleBatch sphereCapsule;
+        sphereCapsule.sphereCenter = sphereCenter.Stream();
+        sphereCapsule.sphereRadius = sphereRadius.data();
+        sphereCapsule.capsuleA = capsuleA.Stream();
+        sphereCapsule.capsuleB = capsuleB.Stream();
+        sphereCapsule.capsuleRadius = capsuleRadius.data();
+        sphereCapsule.count = pairCount;
+        CheckBatchKernel(sphereCapsule, SphereVsCapsuleBatch, [&](size_t i, Contact& out) {
+            return SphereVsCapsule(sphereCenter.Get(i), sphereRadius[i], capsuleA.Get(i), capsuleB.Get(i), capsuleRadius[i], out);
+        }, tolerance, result);
+
+        assert(result.mismatches == 0 && "batched narrowphase disagrees with the scalar routines");
+        return result;
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <cstdint>
+
+// Microbenchmark for collider storage and pair dispatch.
+// Runs the same sync + all-pairs narrowphase twice over identical shapes: once in the old
+// layout (one heap-allocated collider per body behind a virtual base, shapes picked with
+// dynamic_cast) and once over Collider values in a dense array routed through
+// SimCollision::Collide(). Both sides call the same shape tests, so only storage and dispatch
+// differ; the hit counts must match.
+namespace SimCollision
+{
+    struct DispatchBenchmarkResult
+    {
+        uint32_t bodyCount = 0;
+        uint64_t pairTests = 0;     // per layout, over all passes
+        uint64_t virtualHits = 0;
+        uint64_t tableHits = 0;
+        double virtualMs = 0.0;
+        double tableMs = 0.0;
+    };
+
+    DispatchBenchmarkResult RunDispatchBenchmark(uint32_t bodyCount, uint32_t passes, uint32_t seed = 1);
+
+    // Self-check for the batched narrowphase kernels (SphereVsPlaneBatch and friends).
+    // The same random pairs go through each kernel at every SIMD level up to the CPU's best and
+    // through its scalar routine; a pair mismatches when the hit flags differ or a hit's normal
+    // or penetration is off by more than 'tolerance'. Asserts on mismatches in debug builds.
+    struct BatchKernelCheckResult
+    {
+        uint32_t pairCount = 0;     // per kernel and level
+        int levelsChecked = 0;
+        uint64_t comparisons = 0;
+        uint64_t mismatches = 0;
+        float maxError = 0.0f;      // largest normal/penetration difference between matching hits
+    };
+
+    BatchKernelCheckResult RunBatchKernelCheck(uint32_t pairCount, uint32_t seed = 1, float tolerance = 1e-4f);
+}
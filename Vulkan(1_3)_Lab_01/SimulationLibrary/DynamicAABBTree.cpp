@@ -0,0 +1,343 @@
+#include "DynamicAABBTree.h"
+#include <algorithm>
+
+namespace {
+    constexpr float kDisplacementMultiplier = 2.0f;
+
+    SimCollision::AABB Union(const SimCollision::AABB& a, const SimCollision::AABB& b) {
+        return { glm::min(a.min, b.min), glm::max(a.max, b.max) };
+    }
+
+    float Perimeter(const SimCollision::AABB& a) {
+        const glm::vec3 d = a.max - a.min;
+        return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+    }
+
+    bool Contains(const SimCollision::AABB& outer, const SimCollision::AABB& inner) {
+        return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z &&
+               inner.max.x <= outer.max.x && inner.max.y <= outer.max.y && inner.max.z <= outer.max.z;
+    }
+}
+
+uint32_t DynamicAABBTree::AllocateNode() {
+    if (m_FreeList == kNullNode) {
+        m_Nodes.emplace_back();
+        m_Nodes.back().height = 0;
+        return static_cast<uint32_t>(m_Nodes.size() - 1);
+    }
+
+    const uint32_t node = m_FreeList;
+    m_FreeList = m_Nodes[node].parent;
+    m_Nodes[node] = Node{};
+    m_Nodes[node].height = 0;
+    return node;
+}
+
+void DynamicAABBTree::FreeNode(uint32_t node) {
+    m_Nodes[node].parent = m_FreeList;
+    m_Nodes[node].height = -1;
+    m_FreeList = node;
+}
+
+uint32_t DynamicAABBTree::CreateProxy(const SimCollision::AABB& bounds, uint32_t userData) {
+    const uint32_t proxy = AllocateNode();
+    const glm::vec3 r(m_Margin);
+
+    Node& node = m_Nodes[proxy];
+    node.aabb = { bounds.min - r, bounds.max + r };
+    node.userData = userData;
+    node.moved = true;
+
+    InsertLeaf(proxy);
+    m_MoveBuffer.push_back(proxy);
+    ++m_ProxyCount;
+    return proxy;
+}
+
+void DynamicAABBTree::DestroyProxy(uint32_t proxy) {
+    if (proxy >= m_Nodes.size() || m_Nodes[proxy].height < 0 || !m_Nodes[proxy].IsLeaf()) return;
+
+    RemoveLeaf(proxy);
+    FreeNode(proxy);
+    --m_ProxyCount;
+
+    // The node may be reused before the next UpdatePairs(), so forget its pairs now.
+    m_ProxyPairs.erase(std::remove_if(m_ProxyPairs.begin(), m_ProxyPairs.end(),
+        [proxy](const ProxyPair& p) { return p.a == proxy || p.b == proxy; }), m_ProxyPairs.end());
+}
+
+bool DynamicAABBTree::MoveProxy(uint32_t proxy, const SimCollision::AABB& bounds, const glm::vec3& displacement) {
+    if (Contains(m_Nodes[proxy].aabb, bounds)) return false;
+
+    RemoveLeaf(proxy);
+
+    // Fatten by the margin, then stretch in the direction of travel.
+    const glm::vec3 r(m_Margin);
+    SimCollision::AABB fat{ bounds.min - r, bounds.max + r };
+    const glm::vec3 d = displacement * kDisplacementMultiplier;
+    fat.min += glm::min(d, glm::vec3(0.0f));
+    fat.max += glm::max(d, glm::vec3(0.0f));
+
+    m_Nodes[proxy].aabb = fat;
+    InsertLeaf(proxy);
+
+    if (!m_Nodes[proxy].moved) {
+        m_Nodes[proxy].moved = true;
+        m_MoveBuffer.push_back(proxy);
+    }
+    ++m_PendingReinserts;
+    return true;
+}
+
+void DynamicAABBTree::Clear() {
+    m_Nodes.clear();
+    m_Root = kNullNode;
+    m_FreeList = kNullNode;
+    m_ProxyCount = 0;
+    m_MoveBuffer.clear();
+    m_ProxyPairs.clear();
+    m_Pairs.clear();
+    m_LastReinserts = 0;
+    m_PendingReinserts = 0;
+}
+
+void DynamicAABBTree::InsertLeaf(uint32_t leaf) {
+    if (m_Root == kNullNode) {
+        m_Root = leaf;
+        m_Nodes[leaf].parent = kNullNode;
+        return;
+    }
+
+    // Descend using the surface-area cost of creating a new parent vs pushing down.
+    const SimCollision::AABB leafAABB = m_Nodes[leaf].aabb;
+    uint32_t index = m_Root;
+    while (!m_Nodes[index].IsLeaf()) {
+        const Node& node = m_Nodes[index];
+        const float area = Perimeter(node.aabb);
+        const float combinedArea = Perimeter(Union(node.aabb, leafAABB));
+
+        const float cost = 2.0f * combinedArea;
+        const float inheritanceCost = 2.0f * (combinedArea - area);
+
+        auto descendCost = [&](uint32_t child) {
+            const Node& c = m_Nodes[child];
+            const float unionArea = Perimeter(Union(leafAABB, c.aabb));
+            return c.IsLeaf() ? unionArea + inheritanceCost : (unionArea - Perimeter(c.aabb)) + inheritanceCost;
+        };
+
+        const float cost1 = descendCost(node.child1);
+        const float cost2 = descendCost(node.child2);
+
+        if (cost < cost1 && cost < cost2) break;
+        index = (cost1 < cost2) ? node.child1 : node.child2;
+    }
+
+    const uint32_t sibling = index;
+    const uint32_t oldParent = m_Nodes[sibling].parent;
+    const uint32_t newParent = AllocateNode();
+
+    Node& parent = m_Nodes[newParent];
+    parent.parent = oldParent;
+    parent.aabb = Union(leafAABB, m_Nodes[sibling].aabb);
+    parent.height = m_Nodes[sibling].height + 1;
+    parent.child1 = sibling;
+    parent.child2 = leaf;
+
+    if (oldParent != kNullNode) {
+        if (m_Nodes[oldParent].child1 == sibling) m_Nodes[oldParent].child1 = newParent;
+        else m_Nodes[oldParent].child2 = newParent;
+    }
+    else {
+        m_Root = newParent;
+    }
+    m_Nodes[sibling].parent = newParent;
+    m_Nodes[leaf].parent = newParent;
+
+    // Walk back up refitting bounds and rebalancing.
+    index = m_Nodes[leaf].parent;
+    while (index != kNullNode) {
+        index = Balance(index);
+
+        Node& n = m_Nodes[index];
+        const Node& c1 = m_Nodes[n.child1];
+        const Node& c2 = m_Nodes[n.child2];
+        n.height = 1 + std::max(c1.height, c2.height);
+        n.aabb = Union(c1.aabb, c2.aabb);
+
+        index = n.parent;
+    }
+}
+
+void DynamicAABBTree::RemoveLeaf(uint32_t leaf) {
+    if (leaf == m_Root) {
+        m_Root = kNullNode;
+        return;
+    }
+
+    const uint32_t parent = m_Nodes[leaf].parent;
+    const uint32_t grandParent = m_Nodes[parent].parent;
+    const uint32_t sibling = (m_Nodes[parent].child1 == leaf) ? m_Nodes[parent].child2 : m_Nodes[parent].child1;
+
+    if (grandParent == kNullNode) {
+        m_Root = sibling;
+        m_Nodes[sibling].parent = kNullNode;
+        FreeNode(parent);
+        return;
+    }
+
+    if (m_Nodes[grandParent].child1 == parent) m_Nodes[grandParent].child1 = sibling;
+    else m_Nodes[grandParent].child2 = sibling;
+    m_Nodes[sibling].parent = grandParent;
+    FreeNode(parent);
+
+    uint32_t index = grandParent;
+    while (index != kNullNode) {
+        index = Balance(index);
+
+        Node& n = m_Nodes[index];
+        const Node& c1 = m_Nodes[n.child1];
+        const Node& c2 = m_Nodes[n.child2];
+        n.aabb = Union(c1.aabb, c2.aabb);
+        n.height = 1 + std::max(c1.height, c2.height);
+
+        index = n.parent;
+    }
+}
+
+// Rotates the taller child of 'iA' up if the subtree is imbalanced. Returns the new subtree root.
+uint32_t DynamicAABBTree::Balance(uint32_t iA) {
+    Node& A = m_Nodes[iA];
+    if (A.IsLeaf() || A.height < 2) return iA;
+
+    const uint32_t iB = A.child1;
+    const uint32_t iC = A.child2;
+    Node& B = m_Nodes[iB];
+    Node& C = m_Nodes[iC];
+
+    const int32_t balance = C.height - B.height;
+
+    auto replaceInParent = [&](uint32_t oldChild, uint32_t newChild, uint32_t parentIndex) {
+        if (parentIndex == kNullNode) {
+            m_Root = newChild;
+            return;
+        }
+        Node& p = m_Nodes[parentIndex];
+        if (p.child1 == oldChild) p.child1 = newChild;
+        else p.child2 = newChild;
+    };
+
+    // Rotate C up
+    if (balance > 1) {
+        const uint32_t iF = C.child1;
+        const uint32_t iG = C.child2;
+        Node& F = m_Nodes[iF];
+        Node& G = m_Nodes[iG];
+
+        C.child1 = iA;
+        C.parent = A.parent;
+        A.parent = iC;
+        replaceInParent(iA, iC, C.parent);
+
+        if (F.height > G.height) {
+            C.child2 = iF;
+            A.child2 = iG;
+            G.parent = iA;
+            A.aabb = Union(B.aabb, G.aabb);
+            C.aabb = Union(A.aabb, F.aabb);
+            A.height = 1 + std::max(B.height, G.height);
+            C.height = 1 + std::max(A.height, F.height);
+        }
+        else {
+            C.child2 = iG;
+            A.child2 = iF;
+            F.parent = iA;
+            A.aabb = Union(B.aabb, F.aabb);
+            C.aabb = Union(A.aabb, G.aabb);
+            A.height = 1 + std::max(B.height, F.height);
+            C.height = 1 + std::max(A.height, G.height);
+        }
+        return iC;
+    }
+
+    // Rotate B up
+    if (balance < -1) {
+        const uint32_t iD = B.child1;
+        const uint32_t iE = B.child2;
+        Node& D = m_Nodes[iD];
+        Node& E = m_Nodes[iE];
+
+        B.child1 = iA;
+        B.parent = A.parent;
+        A.parent = iB;
+        replaceInParent(iA, iB, B.parent);
+
+        if (D.height > E.height) {
+            B.child2 = iD;
+            A.child1 = iE;
+            E.parent = iA;
+            A.aabb = Union(C.aabb, E.aabb);
+            B.aabb = Union(A.aabb, D.aabb);
+            A.height = 1 + std::max(C.height, E.height);
+            B.height = 1 + std::max(A.height, D.height);
+        }
+        else {
+            B.child2 = iE;
+            A.child1 = iD;
+            D.parent = iA;
+            A.aabb = Union(C.aabb, D.aabb);
+            B.aabb = Union(A.aabb, E.aabb);
+            A.height = 1 + std::max(C.height, D.height);
+            B.height = 1 + std::max(A.height, E.height);
+        }
+        return iB;
+    }
+
+    return iA;
+}
+
+const std::vector<DynamicAABBTree::Pair>& DynamicAABBTree::UpdatePairs() {
+    // Drop cached pairs whose proxies were destroyed or whose fat bounds separated.
+    m_ProxyPairs.erase(std::remove_if(m_ProxyPairs.begin(), m_ProxyPairs.end(), [this](const ProxyPair& p) {
+        const Node& a = m_Nodes[p.a];
+        const Node& b = m_Nodes[p.b];
+        if (a.height != 0 || b.height != 0) return true;
+        return !SimCollision::AABBOverlap(a.aabb, b.aabb);
+    }), m_ProxyPairs.end());
+
+    // Only proxies that were created or reinserted can have gained new partners.
+    for (const uint32_t proxy : m_MoveBuffer) {
+        if (m_Nodes[proxy].height != 0) continue;
+
+        QueryLeaves(m_Nodes[proxy].aabb, [&](uint32_t other) {
+            if (other == proxy) return;
+            // Both moved: let the lower id report it once.
+            if (m_Nodes[other].moved && other < proxy) return;
+            m_ProxyPairs.push_back({ std::min(proxy, other), std::max(proxy, other) });
+        });
+    }
+
+    for (const uint32_t proxy : m_MoveBuffer) {
+        if (proxy < m_Nodes.size()) m_Nodes[proxy].moved = false;
+    }
+    m_MoveBuffer.clear();
+
+    auto byIds = [](const ProxyPair& x, const ProxyPair& y) { return x.a != y.a ? x.a < y.a : x.b < y.b; };
+    std::sort(m_ProxyPairs.begin(), m_ProxyPairs.end(), byIds);
+    m_ProxyPairs.erase(std::unique(m_ProxyPairs.begin(), m_ProxyPairs.end(),
+        [](const ProxyPair& x, const ProxyPair& y) { return x.a == y.a && x.b == y.b; }), m_ProxyPairs.end());
+
+    m_Pairs.clear();
+    m_Pairs.reserve(m_ProxyPairs.size());
+    for (const ProxyPair& p : m_ProxyPairs) {
+        const uint32_t ua = m_Nodes[p.a].userData;
+        const uint32_t ub = m_Nodes[p.b].userData;
+        m_Pairs.push_back({ std::min(ua, ub), std::max(ua, ub) });
+    }
+    std::sort(m_Pairs.begin(), m_Pairs.end(), [](const Pair& x, const Pair& y) {
+        return x.a != y.a ? x.a < y.a : x.b < y.b;
+    });
+
+    m_LastReinserts = m_PendingReinserts;
+    m_PendingReinserts = 0;
+    return m_Pairs;
+}
@@ -0,0 +1,110 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "CollisionUtil.h"
+
+// Dynamic bounding volume hierarchy over AABBs.
+// Leaves store "fat" AABBs (tight bounds + margin, stretched along the last displacement),
+// so a body is only reinserted when it leaves its margin. Internal nodes are kept balanced
+// with AVL-style rotations. Overlapping leaf pairs are cached and only re-queried for
+// proxies that moved, keeping per-tick cost proportional to motion rather than body count.
+class DynamicAABBTree {
+public:
+    static constexpr uint32_t kNullNode = 0xFFFFFFFFu;
+
+    using Pair = SimCollision::BroadphasePair;
+
+    explicit DynamicAABBTree(float margin = 0.1f) : m_Margin(margin) {}
+
+    uint32_t CreateProxy(const SimCollision::AABB& bounds, uint32_t userData);
+    void DestroyProxy(uint32_t proxy);
+
+    // Returns true if the proxy had to be reinserted (bounds left the fat AABB).
+    bool MoveProxy(uint32_t proxy, const SimCollision::AABB& bounds, const glm::vec3& displacement);
+
+    void Clear();
+
+    const SimCollision::AABB& GetFatAABB(uint32_t proxy) const { return m_Nodes[proxy].aabb; }
+    uint32_t GetUserData(uint32_t proxy) const { return m_Nodes[proxy].userData; }
+
+    // Calls callback(userData) for every leaf whose fat AABB overlaps 'bounds'.
+    template <typename Callback>
+    void Query(const SimCollision::AABB& bounds, Callback&& callback) const;
+
+    // Refreshes the cached overlap pairs. Result is ordered by (a, b) user data.
+    const std::vector<Pair>& UpdatePairs();
+
+    size_t GetProxyCount() const { return m_ProxyCount; }
+    int GetHeight() const { return m_Root == kNullNode ? 0 : m_Nodes[m_Root].height; }
+    uint32_t GetLastReinsertCount() const { return m_LastReinserts; }
+
+private:
+    struct Node {
+        SimCollision::AABB aabb{};
+        uint32_t parent = kNullNode; // also "next" in the free list
+        uint32_t child1 = kNullNode;
+        uint32_t child2 = kNullNode;
+        int32_t height = -1; // leaf = 0, free = -1
+        uint32_t userData = 0;
+        bool moved = false;
+
+        bool IsLeaf() const { return child1 == kNullNode; }
+    };
+
+    struct ProxyPair {
+        uint32_t a = 0; // proxy ids, a < b
+        uint32_t b = 0;
+    };
+
+    uint32_t AllocateNode();
+    void FreeNode(uint32_t node);
+    void InsertLeaf(uint32_t leaf);
+    void RemoveLeaf(uint32_t leaf);
+    uint32_t Balance(uint32_t node);
+
+    template <typename Callback>
+    void QueryLeaves(const SimCollision::AABB& bounds, Callback&& callback) const;
+
+    std::vector<Node> m_Nodes;
+    uint32_t m_Root = kNullNode;
+    uint32_t m_FreeList = kNullNode;
+    size_t m_ProxyCount = 0;
+    float m_Margin = 0.1f;
+
+    std::vector<uint32_t> m_MoveBuffer;
+    std::vector<ProxyPair> m_ProxyPairs;
+    std::vector<Pair> m_Pairs;
+    uint32_t m_LastReinserts = 0;
+    uint32_t m_PendingReinserts = 0;
+
+    mutable std::vector<uint32_t> m_Stack;
+};
+
+template <typename Callback>
+void DynamicAABBTree::Query(const SimCollision::AABB& bounds, Callback&& callback) const {
+    QueryLeaves(bounds, [&](uint32_t leaf) { callback(m_Nodes[leaf].userData); });
+}
+
+template <typename Callback>
+void DynamicAABBTree::QueryLeaves(const SimCollision::AABB& bounds, Callback&& callback) const {
+    if (m_Root == kNullNode) return;
+
+    m_Stack.clear();
+    m_Stack.push_back(m_Root);
+
+    while (!m_Stack.empty()) {
+        const uint32_t index = m_Stack.back();
+        m_Stack.pop_back();
+
+        const Node& node = m_Nodes[index];
+        if (!SimCollision::AABBOverlap(node.aabb, bounds)) continue;
+
+        if (node.IsLeaf()) {
+            callback(index);
+        }
+        else {
+            m_Stack.push_back(node.child1);
+            m_Stack.push_back(node.child2);
+        }
+    }
+}
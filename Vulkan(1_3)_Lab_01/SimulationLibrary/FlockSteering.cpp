@@ -0,0 +1,259 @@
+#include "FlockSteering.h"
+#include <algorithm>
+#include <cmath>
+
+#if SIM_HAS_X86
+#include <immintrin.h>
+#endif
+
+namespace SimFlocking
+{
+    namespace
+    {
+        constexpr float kMinDistance = 0.0001f;
+        constexpr float kMinSeparationDistance = 0.1f;
+
+        // 'indices' == nullptr means the candidates are the boids [begin, end) themselves.
+        void AccumulateScalar(const BoidStreams& b, const NeighbourQuery& q, const uint32_t* indices, size_t begin, size_t end, NeighbourSums& sums)
+        {
+            for (size_t k = begin; k < end; ++k) {
+                const size_t j = indices ? indices[k] : k;
+                if (j == q.self) continue;
+
+                const float dx = b.posX[j] - q.position.x;
+                const float dy = b.posY[j] - q.position.y;
+                const float dz = b.posZ[j] - q.position.z;
+                const float dist = std::sqrt(dx * dx + dy * dy + dz * dz);
+                if (dist <= kMinDistance) continue;
+
+                if (dist < q.neighborRadius) {
+                    sums.cohesion += glm::vec3(b.posX[j], b.posY[j], b.posZ[j]);
+                    sums.alignment += glm::vec3(b.velX[j], b.velY[j], b.velZ[j]);
+                    ++sums.neighbourCount;
+                }
+
+                if (dist < q.separationRadius) {
+                    const float scale = 1.0f / (dist * std::max(kMinSeparationDistance, dist));
+                    sums.separation -= glm::vec3(dx, dy, dz) * scale;
+                    ++sums.separationCount;
+                }
+            }
+        }
+
+#if SIM_HAS_X86
+        // ---- SSE2: 4 candidates per iteration ----
+        float Sum4(__m128 v)
+        {
+            alignas(16) float lanes[4];
+            _mm_store_ps(lanes, v);
+            return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+        }
+
+        uint32_t SumCounts4(__m128i v)
+        {
+            alignas(16) uint32_t lanes[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(lanes), v);
+            return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+        }
+
+        size_t AccumulateSSE2(const BoidStreams& b, const NeighbourQuery& q, const uint32_t* indices, size_t begin, size_t end, NeighbourSums& sums)
+        {
+            const __m128 selfX = _mm_set1_ps(q.position.x);
+            const __m128 selfY = _mm_set1_ps(q.position.y);
+            const __m128 selfZ = _mm_set1_ps(q.position.z);
+            const __m128 neighborRadius = _mm_set1_ps(q.neighborRadius);
+            const __m128 separationRadius = _mm_set1_ps(q.separationRadius);
+            const __m128 minDist = _mm_set1_ps(kMinDistance);
+            const __m128 minSepDist = _mm_set1_ps(kMinSeparationDistance);
+            const __m128 one = _mm_set1_ps(1.0f);
+            const __m128i self = _mm_set1_epi32(static_cast<int>(q.self));
+            const __m128i laneOffsets = _mm_setr_epi32(0, 1, 2, 3);
+
+            __m128 cohX = _mm_setzero_ps(), cohY = _mm_setzero_ps(), cohZ = _mm_setzero_ps();
+            __m128 alignX = _mm_setzero_ps(), alignY = _mm_setzero_ps(), alignZ = _mm_setzero_ps();
+            __m128 sepX = _mm_setzero_ps(), sepY = _mm_setzero_ps(), sepZ = _mm_setzero_ps();
+            // Per-lane counts: subtracting a mask lane (-1) adds one
+            __m128i neighbourCount = _mm_setzero_si128();
+            __m128i separationCount = _mm_setzero_si128();
+
+            size_t k = begin;
+            for (; k + 4 <= end; k += 4) {
+                __m128i ids;
+                __m128 px, py, pz, vx, vy, vz;
+                if (indices) {
+                    // No gather before AVX2: assemble the lanes from scalar loads
+                    const uint32_t j0 = indices[k], j1 = indices[k + 1], j2 = indices[k + 2], j3 = indices[k + 3];
+                    ids = _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + k));
+                    px = _mm_setr_ps(b.posX[j0], b.posX[j1], b.posX[j2], b.posX[j3]);
+                    py = _mm_setr_ps(b.posY[j0], b.posY[j1], b.posY[j2], b.posY[j3]);
+                    pz = _mm_setr_ps(b.posZ[j0], b.posZ[j1], b.posZ[j2], b.posZ[j3]);
+                    vx = _mm_setr_ps(b.velX[j0], b.velX[j1], b.velX[j2], b.velX[j3]);
+                    vy = _mm_setr_ps(b.velY[j0], b.velY[j1], b.velY[j2], b.velY[j3]);
+                    vz = _mm_setr_ps(b.velZ[j0], b.velZ[j1], b.velZ[j2], b.velZ[j3]);
+                }
+                else {
+                    ids = _mm_add_epi32(_mm_set1_epi32(static_cast<int>(k)), laneOffsets);
+                    px = _mm_loadu_ps(b.posX + k);
+                    py = _mm_loadu_ps(b.posY + k);
+                    pz = _mm_loadu_ps(b.posZ + k);
+                    vx = _mm_loadu_ps(b.velX + k);
+                    vy = _mm_loadu_ps(b.velY + k);
+                    vz = _mm_loadu_ps(b.velZ + k);
+                }
+
+                const __m128 dx = _mm_sub_ps(px, selfX);
+                const __m128 dy = _mm_sub_ps(py, selfY);
+                const __m128 dz = _mm_sub_ps(pz, selfZ);
+                const __m128 dist = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+
+                const __m128 isSelf = _mm_castsi128_ps(_mm_cmpeq_epi32(ids, self));
+                const __m128 valid = _mm_andnot_ps(isSelf, _mm_cmpgt_ps(dist, minDist));
+                const __m128 neighbourMask = _mm_and_ps(valid, _mm_cmplt_ps(dist, neighborRadius));
+                const __m128 separationMask = _mm_and_ps(valid, _mm_cmplt_ps(dist, separationRadius));
+
+                cohX = _mm_add_ps(cohX, _mm_and_ps(neighbourMask, px));
+                cohY = _mm_add_ps(cohY, _mm_and_ps(neighbourMask, py));
+                cohZ = _mm_add_ps(cohZ, _mm_and_ps(neighbourMask, pz));
+                alignX = _mm_add_ps(alignX, _mm_and_ps(neighbourMask, vx));
+                alignY = _mm_add_ps(alignY, _mm_and_ps(neighbourMask, vy));
+                alignZ = _mm_add_ps(alignZ, _mm_and_ps(neighbourMask, vz));
+
+                // Masked-off lanes may hold inf/NaN here; the AND clears them
+                const __m128 scale = _mm_div_ps(one, _mm_mul_ps(dist, _mm_max_ps(minSepDist, dist)));
+                sepX = _mm_sub_ps(sepX, _mm_and_ps(separationMask, _mm_mul_ps(dx, scale)));
+                sepY = _mm_sub_ps(sepY, _mm_and_ps(separationMask, _mm_mul_ps(dy, scale)));
+                sepZ = _mm_sub_ps(sepZ, _mm_and_ps(separationMask, _mm_mul_ps(dz, scale)));
+
+                neighbourCount = _mm_sub_epi32(neighbourCount, _mm_castps_si128(neighbourMask));
+                separationCount = _mm_sub_epi32(separationCount, _mm_castps_si128(separationMask));
+            }
+
+            sums.cohesion += glm::vec3(Sum4(cohX), Sum4(cohY), Sum4(cohZ));
+            sums.alignment += glm::vec3(Sum4(alignX), Sum4(alignY), Sum4(alignZ));
+            sums.separation += glm::vec3(Sum4(sepX), Sum4(sepY), Sum4(sepZ));
+            sums.neighbourCount += SumCounts4(neighbourCount);
+            sums.separationCount += SumCounts4(separationCount);
+            return k;
+        }
+
+        // ---- AVX2: 8 candidates per iteration ----
+        SIM_TARGET_AVX2 float Sum8(__m256 v)
+        {
+            const __m128 halves = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+            return Sum4(halves);
+        }
+
+        SIM_TARGET_AVX2 uint32_t SumCounts8(__m256i v)
+        {
+            return SumCounts4(_mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1)));
+        }
+
+        SIM_TARGET_AVX2 size_t AccumulateAVX2(const BoidStreams& b, const NeighbourQuery& q, const uint32_t* indices, size_t begin, size_t end, NeighbourSums& sums)
+        {
+            const __m256 selfX = _mm256_set1_ps(q.position.x);
+            const __m256 selfY = _mm256_set1_ps(q.position.y);
+            const __m256 selfZ = _mm256_set1_ps(q.position.z);
+            const __m256 neighborRadius = _mm256_set1_ps(q.neighborRadius);
+            const __m256 separationRadius = _mm256_set1_ps(q.separationRadius);
+            const __m256 minDist = _mm256_set1_ps(kMinDistance);
+            const __m256 minSepDist = _mm256_set1_ps(kMinSeparationDistance);
+            const __m256 one = _mm256_set1_ps(1.0f);
+            const __m256i self = _mm256_set1_epi32(static_cast<int>(q.self));
+            const __m256i laneOffsets = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+            __m256 cohX = _mm256_setzero_ps(), cohY = _mm256_setzero_ps(), cohZ = _mm256_setzero_ps();
+            __m256 alignX = _mm256_setzero_ps(), alignY = _mm256_setzero_ps(), alignZ = _mm256_setzero_ps();
+            __m256 sepX = _mm256_setzero_ps(), sepY = _mm256_setzero_ps(), sepZ = _mm256_setzero_ps();
+            __m256i neighbourCount = _mm256_setzero_si256();
+            __m256i separationCount = _mm256_setzero_si256();
+
+            size_t k = begin;
+            for (; k + 8 <= end; k += 8) {
+                __m256i ids;
+                __m256 px, py, pz, vx, vy, vz;
+                if (indices) {
+                    ids = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + k));
+                    px = _mm256_i32gather_ps(b.posX, ids, 4);
+                    py = _mm256_i32gather_ps(b.posY, ids, 4);
+                    pz = _mm256_i32gather_ps(b.posZ, ids, 4);
+                    vx = _mm256_i32gather_ps(b.velX, ids, 4);
+                    vy = _mm256_i32gather_ps(b.velY, ids, 4);
+                    vz = _mm256_i32gather_ps(b.velZ, ids, 4);
+                }
+                else {
+                    ids = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(k)), laneOffsets);
+                    px = _mm256_loadu_ps(b.posX + k);
+                    py = _mm256_loadu_ps(b.posY + k);
+                    pz = _mm256_loadu_ps(b.posZ + k);
+                    vx = _mm256_loadu_ps(b.velX + k);
+                    vy = _mm256_loadu_ps(b.velY + k);
+                    vz = _mm256_loadu_ps(b.velZ + k);
+                }
+
+                const __m256 dx = _mm256_sub_ps(px, selfX);
+                const __m256 dy = _mm256_sub_ps(py, selfY);
+                const __m256 dz = _mm256_sub_ps(pz, selfZ);
+                const __m256 dist = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz)));
+
+                const __m256 isSelf = _mm256_castsi256_ps(_mm256_cmpeq_epi32(ids, self));
+                const __m256 valid = _mm256_andnot_ps(isSelf, _mm256_cmp_ps(dist, minDist, _CMP_GT_OQ));
+                const __m256 neighbourMask = _mm256_and_ps(valid, _mm256_cmp_ps(dist, neighborRadius, _CMP_LT_OQ));
+                const __m256 separationMask = _mm256_and_ps(valid, _mm256_cmp_ps(dist, separationRadius, _CMP_LT_OQ));
+
+                cohX = _mm256_add_ps(cohX, _mm256_and_ps(neighbourMask, px));
+                cohY = _mm256_add_ps(cohY, _mm256_and_ps(neighbourMask, py));
+                cohZ = _mm256_add_ps(cohZ, _mm256_and_ps(neighbourMask, pz));
+                alignX = _mm256_add_ps(alignX, _mm256_and_ps(neighbourMask, vx));
+                alignY = _mm256_add_ps(alignY, _mm256_and_ps(neighbourMask, vy));
+                alignZ = _mm256_add_ps(alignZ, _mm256_and_ps(neighbourMask, vz));
+
+                const __m256 scale = _mm256_div_ps(one, _mm256_mul_ps(dist, _mm256_max_ps(minSepDist, dist)));
+                sepX = _mm256_sub_ps(sepX, _mm256_and_ps(separationMask, _mm256_mul_ps(dx, scale)));
+                sepY = _mm256_sub_ps(sepY, _mm256_and_ps(separationMask, _mm256_mul_ps(dy, scale)));
+                sepZ = _mm256_sub_ps(sepZ, _mm256_and_ps(separationMask, _mm256_mul_ps(dz, scale)));
+
+                neighbourCount = _mm256_sub_epi32(neighbourCount, _mm256_castps_si256(neighbourMask));
+                separationCount = _mm256_sub_epi32(separationCount, _mm256_castps_si256(separationMask));
+            }
+
+            sums.cohesion += glm::vec3(Sum8(cohX), Sum8(cohY), Sum8(cohZ));
+            sums.alignment += glm::vec3(Sum8(alignX), Sum8(alignY), Sum8(alignZ));
+            sums.separation += glm::vec3(Sum8(sepX), Sum8(sepY), Sum8(sepZ));
+            sums.neighbourCount += SumCounts8(neighbourCount);
+            sums.separationCount += SumCounts8(separationCount);
+            return k;
+        }
+#endif
+
+        void Accumulate(const BoidStreams& b, const NeighbourQuery& q, const uint32_t* indices, size_t begin, size_t end, NeighbourSums& sums, SimdLevel level)
+        {
+            size_t done = begin;
+
+#if SIM_HAS_X86
+            if (level > SimSimd::GetBestSimdLevel()) level = SimSimd::GetBestSimdLevel();
+
+            if (level == SimdLevel::AVX2) {
+                done = AccumulateAVX2(b, q, indices, begin, end, sums);
+            }
+            else if (level == SimdLevel::SSE2) {
+                done = AccumulateSSE2(b, q, indices, begin, end, sums);
+            }
+#else
+            (void)level;
+#endif
+
+            // Tail (and full fallback)
+            AccumulateScalar(b, q, indices, done, end, sums);
+        }
+    }
+
+    void AccumulateNeighbours(const BoidStreams& boids, const NeighbourQuery& query, const uint32_t* indices, size_t count, NeighbourSums& sums, SimdLevel level)
+    {
+        Accumulate(boids, query, indices, 0, count, sums, level);
+    }
+
+    void AccumulateNeighbourRange(const BoidStreams& boids, const NeighbourQuery& query, size_t begin, size_t end, NeighbourSums& sums, SimdLevel level)
+    {
+        Accumulate(boids, query, nullptr, begin, std::min(end, boids.count), sums, level);
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "SimdSupport.h"
+
+namespace SimFlocking
+{
+    using SimSimd::SimdLevel;
+
+    // Per-component boid state for 'count' boids.
+    struct BoidStreams
+    {
+        const float* posX = nullptr;
+        const float* posY = nullptr;
+        const float* posZ = nullptr;
+        const float* velX = nullptr;
+        const float* velY = nullptr;
+        const float* velZ = nullptr;
+        size_t count = 0;
+    };
+
+    // The boid whose neighbours are being summed. Candidates equal to 'self', or closer than
+    // 1e-4, are ignored.
+    struct NeighbourQuery
+    {
+        uint32_t self = 0;
+        glm::vec3 position{ 0.0f };
+        float neighborRadius = 0.0f;
+        float separationRadius = 0.0f;
+    };
+
+    // Running sums over the accepted candidates; a query may be fed in several calls.
+    struct NeighbourSums
+    {
+        glm::vec3 cohesion{ 0.0f };   // neighbour positions, dist < neighborRadius
+        glm::vec3 alignment{ 0.0f };  // neighbour velocities, dist < neighborRadius
+        glm::vec3 separation{ 0.0f }; // -d / (dist * max(0.1, dist)), dist < separationRadius
+        uint32_t neighbourCount = 0;
+        uint32_t separationCount = 0;
+    };
+
+    // Accumulates the candidates indices[0 .. count). The AVX2 path gathers 8 candidates per
+    // iteration, SSE2 loads 4. Lanes are summed separately, so the vector paths differ from
+    // scalar only by float summation order.
+    void AccumulateNeighbours(const BoidStreams& boids, const NeighbourQuery& query, const uint32_t* indices, size_t count, NeighbourSums& sums, SimdLevel level);
+
+    // Same for the contiguous boids [begin, end), with plain vector loads instead of gathers.
+    void AccumulateNeighbourRange(const BoidStreams& boids, const NeighbourQuery& query, size_t begin, size_t end, NeighbourSums& sums, SimdLevel level);
+}
@@ -0,0 +1,32 @@
+#include "GJKCache.h"
+
+void GJKCache::Prepare(RigidBodyHandle a, RigidBodyHandle b) {
+    m_Pairs.Acquire(a, b);
+}
+
+bool GJKCache::Test(RigidBodyHandle a, RigidBodyHandle b, const SimCollision::ConvexShape& A, const SimCollision::ConvexShape& B, SimCollision::Contact& out) {
+    m_Lookups.fetch_add(1, std::memory_order_relaxed);
+
+    SimCollision::GJKSimplex& simplex = m_Pairs.Acquire(a, b);
+    if (simplex.count > 0) m_WarmStarts.fetch_add(1, std::memory_order_relaxed);
+
+    int iterations = 0;
+    const bool hit = SimCollision::ConvexVsConvex(A, B, out, &simplex, &iterations);
+    m_Iterations.fetch_add(static_cast<uint64_t>(iterations), std::memory_order_relaxed);
+    return hit;
+}
+
+void GJKCache::NextFrame() {
+    m_LastLookups = m_Lookups.exchange(0, std::memory_order_relaxed);
+    m_LastWarmStarts = m_WarmStarts.exchange(0, std::memory_order_relaxed);
+    m_LastIterations = m_Iterations.exchange(0, std::memory_order_relaxed);
+    m_Pairs.NextFrame();
+}
+
+void GJKCache::Clear() {
+    m_Pairs.Clear();
+    m_Lookups = 0;
+    m_WarmStarts = 0;
+    m_Iterations = 0;
+    m_LastLookups = m_LastWarmStarts = m_LastIterations = 0;
+}
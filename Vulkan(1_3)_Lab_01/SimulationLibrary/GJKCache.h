@@ -0,0 +1,35 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include "ConvexCollision.h"
+#include "PairCache.h"
+
+// Per-pair GJK simplex cache, keyed by body handle pair. Each entry keeps the search directions
+// of the simplex the pair's last query ended with; the next query starts from that simplex
+// rebuilt at the new poses, so a resting or sliding contact converges almost immediately.
+// Threading follows PairCache, with Prepare() as the single-threaded acquire.
+class GJKCache {
+public:
+    bool Test(RigidBodyHandle a, RigidBodyHandle b, const SimCollision::ConvexShape& A, const SimCollision::ConvexShape& B, SimCollision::Contact& out);
+    void Prepare(RigidBodyHandle a, RigidBodyHandle b);
+
+    // Call once per tick; drops pairs that have not been tested for a while.
+    void NextFrame();
+    void Clear();
+
+    size_t GetEntryCount() const { return m_Pairs.GetEntryCount(); }
+    uint64_t GetLastLookups() const { return m_LastLookups; }
+    uint64_t GetLastWarmStarts() const { return m_LastWarmStarts; }
+    uint64_t GetLastIterations() const { return m_LastIterations; }
+
+private:
+    // Ordered pairs: the cached directions are for A - B, so (b, a) is a separate entry.
+    PairCache<SimCollision::GJKSimplex> m_Pairs;
+
+    std::atomic<uint64_t> m_Lookups{ 0 };
+    std::atomic<uint64_t> m_WarmStarts{ 0 };
+    std::atomic<uint64_t> m_Iterations{ 0 };
+    uint64_t m_LastLookups = 0;
+    uint64_t m_LastWarmStarts = 0;
+    uint64_t m_LastIterations = 0;
+};
@@ -2,5 +2,21 @@
 
 enum class IntegrationMethod {
     ExplicitEuler = 0,
-    SemiImplicitEuler = 1
-};
\ No newline at end of file
+    SemiImplicitEuler = 1,
+    VelocityVerlet = 2, // 2nd order, symplectic
+    RK4 = 3,            // classic 4th-order Runge-Kutta, not symplectic
+    Yoshida4 = 4        // 4th-order symplectic (Forest-Ruth / Yoshida composition of Verlet)
+};
+
+constexpr int kIntegrationMethodCount = 5;
+
+inline const char* GetIntegrationMethodName(IntegrationMethod method) {
+    switch (method) {
+        case IntegrationMethod::ExplicitEuler: return "Explicit Euler";
+        case IntegrationMethod::SemiImplicitEuler: return "Semi-Implicit Euler";
+        case IntegrationMethod::VelocityVerlet: return "Velocity Verlet";
+        case IntegrationMethod::RK4: return "RK4";
+        case IntegrationMethod::Yoshida4: return "Yoshida (4th order)";
+    }
+    return "Unknown";
+}
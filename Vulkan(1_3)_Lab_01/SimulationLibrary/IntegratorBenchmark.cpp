@@ -0,0 +1,149 @@
+#include "IntegratorBenchmark.h"
+#include "Integrators.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    using namespace SimIntegration;
+
+    constexpr float kGravity = 9.81f;
+    constexpr float kRadius = 0.5f;
+    constexpr float kGroundStiffness = 2.0e3f; // per unit mass; contact period ~0.07 s
+    constexpr float kSpringStiffness = 40.0f;  // per unit mass; period ~1 s
+    constexpr uint32_t kEnergySampleInterval = 50;
+
+    // Energy is per unit mass; every body has the same mass, so the sum is proportional to the total.
+    struct SphereDropModel {
+        glm::vec3 Acceleration(const glm::vec3& p, const glm::vec3&) const
+        {
+            const float penetration = kRadius - p.y;
+            return { 0.0f, -kGravity + (penetration > 0.0f ? kGroundStiffness * penetration : 0.0f), 0.0f };
+        }
+
+        double Energy(const glm::vec3& p, const glm::vec3& v) const
+        {
+            const double penetration = std::max(0.0f, kRadius - p.y);
+            return 0.5 * double(glm::dot(v, v)) + double(kGravity) * p.y + 0.5 * kGroundStiffness * penetration * penetration;
+        }
+
+        void Initialise(uint32_t i, uint32_t count, glm::vec3& p, glm::vec3& v) const
+        {
+            const float u = count > 1 ? float(i) / float(count - 1) : 0.0f;
+            p = { 0.0f, 1.0f + 5.0f * u, 0.0f };
+            v = { 0.0f, 0.0f, 0.0f };
+        }
+    };
+
+    struct SpringModel {
+        glm::vec3 Acceleration(const glm::vec3& p, const glm::vec3&) const
+        {
+            return -kSpringStiffness * p;
+        }
+
+        double Energy(const glm::vec3& p, const glm::vec3& v) const
+        {
+            return 0.5 * double(glm::dot(v, v)) + 0.5 * kSpringStiffness * double(glm::dot(p, p));
+        }
+
+        void Initialise(uint32_t i, uint32_t count, glm::vec3& p, glm::vec3& v) const
+        {
+            // Ellipses of different shape and phase around the anchor.
+            const float phase = 6.2831853f * (count > 0 ? float(i) / float(count) : 0.0f);
+            const float omega = std::sqrt(kSpringStiffness);
+            p = { std::cos(phase), 0.5f * std::sin(phase), 0.0f };
+            v = { -0.5f * omega * std::sin(phase), 0.0f, omega * std::cos(phase) };
+        }
+    };
+
+    template <typename Model>
+    IntegratorBenchmarkResult RunScene(const Model& model, BenchmarkScene scene, IntegrationMethod method, float dt, const IntegratorBenchmarkSettings& settings)
+    {
+        IntegratorBenchmarkResult result{};
+        result.scene = scene;
+        result.method = method;
+        result.timeStep = dt;
+
+        const uint32_t count = std::max(settings.bodies, 1u);
+        std::vector<glm::vec3> positions(count), velocities(count);
+        for (uint32_t i = 0; i < count; ++i) model.Initialise(i, count, positions[i], velocities[i]);
+
+        auto totalEnergy = [&]()
+        {
+            double energy = 0.0;
+            for (uint32_t i = 0; i < count; ++i) energy += model.Energy(positions[i], velocities[i]);
+            return energy;
+        };
+
+        const double initialEnergy = totalEnergy();
+        const double scale = std::abs(initialEnergy) > 0.0 ? 1.0 / std::abs(initialEnergy) : 1.0;
+        auto acceleration = [&model](const glm::vec3& p, const glm::vec3& v) { return model.Acceleration(p, v); };
+
+        double integrateNs = 0.0;
+        double drift = 0.0;
+        uint32_t stepsRun = 0;
+        for (uint32_t step = 0; step < settings.steps; step += kEnergySampleInterval) {
+            const uint32_t chunk = std::min(kEnergySampleInterval, settings.steps - step);
+
+            const auto start = std::chrono::steady_clock::now();
+            for (uint32_t k = 0; k < chunk; ++k)
+                for (uint32_t i = 0; i < count; ++i)
+                    StepLinear(positions[i], velocities[i], dt, method, acceleration);
+            integrateNs += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+            stepsRun += chunk;
+
+            drift = (totalEnergy() - initialEnergy) * scale;
+            if (!std::isfinite(drift)) { // blew up; no point running further
+                result.maxDrift = drift = std::numeric_limits<double>::infinity();
+                break;
+            }
+            result.maxDrift = std::max(result.maxDrift, std::abs(drift));
+        }
+
+        result.finalDrift = drift;
+        result.nsPerBodyStep = integrateNs / (double(count) * double(std::max(stepsRun, 1u)));
+        result.stable = result.maxDrift <= settings.stableDrift;
+        return result;
+    }
+}
+
+namespace SimIntegration
+{
+    const char* GetBenchmarkSceneName(BenchmarkScene scene)
+    {
+        switch (scene) {
+            case BenchmarkScene::SphereDrop: return "Sphere drop";
+            case BenchmarkScene::Spring: return "Spring";
+        }
+        return "Unknown";
+    }
+
+    std::vector<IntegratorBenchmarkResult> RunIntegratorBenchmark(const IntegratorBenchmarkSettings& settings)
+    {
+        std::vector<IntegratorBenchmarkResult> results;
+        results.reserve(size_t(kBenchmarkSceneCount) * kIntegrationMethodCount * settings.timeSteps.size());
+
+        for (int s = 0; s < kBenchmarkSceneCount; ++s) {
+            const auto scene = static_cast<BenchmarkScene>(s);
+            for (int m = 0; m < kIntegrationMethodCount; ++m) {
+                const auto method = static_cast<IntegrationMethod>(m);
+                for (float dt : settings.timeSteps) {
+                    if (scene == BenchmarkScene::SphereDrop) results.push_back(RunScene(SphereDropModel{}, scene, method, dt, settings));
+                    else results.push_back(RunScene(SpringModel{}, scene, method, dt, settings));
+                }
+            }
+        }
+        return results;
+    }
+
+    float LargestStableTimeStep(const std::vector<IntegratorBenchmarkResult>& results, BenchmarkScene scene, IntegrationMethod method)
+    {
+        float best = 0.0f;
+        for (const auto& r : results) {
+            if (r.scene == scene && r.method == method && r.stable) best = std::max(best, r.timeStep);
+        }
+        return best;
+    }
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "IntegrationMethod.h"
+
+// Accuracy-vs-cost benchmark for the linear integrators (SimIntegration::StepLinear).
+// Each scene runs a batch of point masses for a fixed number of steps at a range of time steps
+// and reports how far total energy drifts and how long a body-step takes. Forces depend on the
+// state in both scenes; with constant forces every method above the Euler pair is exact.
+//   Sphere drop: spheres bouncing on a ground plane under gravity. The ground is a stiff,
+//                undamped penalty spring so that energy is conserved by the real system.
+//   Spring:      spheres on isotropic springs with different phases, the bounded orbit that
+//                shows secular energy growth or decay.
+namespace SimIntegration
+{
+    enum class BenchmarkScene : int {
+        SphereDrop = 0,
+        Spring = 1
+    };
+
+    constexpr int kBenchmarkSceneCount = 2;
+
+    const char* GetBenchmarkSceneName(BenchmarkScene scene);
+
+    struct IntegratorBenchmarkSettings {
+        uint32_t bodies = 256;
+        uint32_t steps = 10000;
+        std::vector<float> timeSteps{ 1.0f / 480.0f, 1.0f / 240.0f, 1.0f / 120.0f, 1.0f / 60.0f, 1.0f / 30.0f };
+        float stableDrift = 0.01f; // a run counts as stable while |drift| stays below this
+    };
+
+    struct IntegratorBenchmarkResult {
+        BenchmarkScene scene = BenchmarkScene::SphereDrop;
+        IntegrationMethod method = IntegrationMethod::SemiImplicitEuler;
+        float timeStep = 0.0f;
+        double finalDrift = 0.0;     // (E_end - E_0) / E_0 over all bodies
+        double maxDrift = 0.0;       // largest |E - E_0| / E_0 seen while running
+        double nsPerBodyStep = 0.0;  // integration only; energy sampling is not timed
+        bool stable = false;
+    };
+
+    std::vector<IntegratorBenchmarkResult> RunIntegratorBenchmark(const IntegratorBenchmarkSettings& settings);
+
+    // Largest time step in 'results' that stayed stable for the scene/method, or 0 if none did.
+    float LargestStableTimeStep(const std::vector<IntegratorBenchmarkResult>& results, BenchmarkScene scene, IntegrationMethod method);
+}
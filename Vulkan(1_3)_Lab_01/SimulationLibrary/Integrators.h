@@ -0,0 +1,95 @@
+#pragma once
+#include <glm/glm.hpp>
+#include "IntegrationMethod.h"
+
+namespace SimIntegration
+{
+    // Yoshida / Forest-Ruth coefficients: three Verlet substeps of w1, w0, w1 * dt.
+    constexpr float kYoshidaW1 = 1.3512071919596578f; // 1 / (2 - 2^(1/3))
+    constexpr float kYoshidaW0 = -1.7024143839193153f; // -2^(1/3) / (2 - 2^(1/3))
+
+    // Step for an acceleration that is constant over 'dt' (accumulated forces + gravity, which is
+    // all bodies see between contact solves). Every method above the Euler pair integrates that
+    // exactly, so they share the closed form; BatchIntegrator uses the same operation order.
+    inline void StepConstantAcceleration(glm::vec3& position, glm::vec3& velocity, const glm::vec3& acceleration, float dt, IntegrationMethod method)
+    {
+        switch (method) {
+            case IntegrationMethod::ExplicitEuler:
+                position += velocity * dt;
+                velocity += acceleration * dt;
+                break;
+
+            case IntegrationMethod::SemiImplicitEuler:
+                velocity += acceleration * dt;
+                position += velocity * dt;
+                break;
+
+            default:
+                position += velocity * dt + acceleration * (0.5f * dt * dt);
+                velocity += acceleration * dt;
+                break;
+        }
+    }
+
+    // Advances one point mass by 'dt'. 'acceleration(position, velocity)' is sampled as often as
+    // the method needs: once for the Euler variants, twice for Velocity Verlet, three times for
+    // Yoshida and four times for RK4. For forces that depend on position or velocity (springs,
+    // penalty contacts, drag), which is where the methods actually differ.
+    template <typename AccelerationFn>
+    void StepLinear(glm::vec3& position, glm::vec3& velocity, float dt, IntegrationMethod method, AccelerationFn&& acceleration)
+    {
+        switch (method) {
+            case IntegrationMethod::ExplicitEuler: {
+                const glm::vec3 a = acceleration(position, velocity);
+                position += velocity * dt;
+                velocity += a * dt;
+                break;
+            }
+
+            case IntegrationMethod::VelocityVerlet: {
+                const glm::vec3 a0 = acceleration(position, velocity);
+                position += velocity * dt + a0 * (0.5f * dt * dt);
+                // Velocity-dependent forces see the Euler-predicted end velocity.
+                const glm::vec3 a1 = acceleration(position, velocity + a0 * dt);
+                velocity += (a0 + a1) * (0.5f * dt);
+                break;
+            }
+
+            case IntegrationMethod::RK4: {
+                const float h = 0.5f * dt;
+                const glm::vec3 x1 = position, v1 = velocity;
+                const glm::vec3 a1 = acceleration(x1, v1);
+                const glm::vec3 x2 = position + v1 * h, v2 = velocity + a1 * h;
+                const glm::vec3 a2 = acceleration(x2, v2);
+                const glm::vec3 x3 = position + v2 * h, v3 = velocity + a2 * h;
+                const glm::vec3 a3 = acceleration(x3, v3);
+                const glm::vec3 v4 = velocity + a3 * dt;
+                const glm::vec3 a4 = acceleration(position + v3 * dt, v4);
+                position += (v1 + 2.0f * v2 + 2.0f * v3 + v4) * (dt / 6.0f);
+                velocity += (a1 + 2.0f * a2 + 2.0f * a3 + a4) * (dt / 6.0f);
+                break;
+            }
+
+            case IntegrationMethod::Yoshida4: {
+                // Drift-kick-drift form: c1 = c4 = w1 / 2, c2 = c3 = (w0 + w1) / 2, d1 = d3 = w1, d2 = w0.
+                constexpr float c1 = 0.5f * kYoshidaW1;
+                constexpr float c2 = 0.5f * (kYoshidaW0 + kYoshidaW1);
+                position += velocity * (c1 * dt);
+                velocity += acceleration(position, velocity) * (kYoshidaW1 * dt);
+                position += velocity * (c2 * dt);
+                velocity += acceleration(position, velocity) * (kYoshidaW0 * dt);
+                position += velocity * (c2 * dt);
+                velocity += acceleration(position, velocity) * (kYoshidaW1 * dt);
+                position += velocity * (c1 * dt);
+                break;
+            }
+
+            case IntegrationMethod::SemiImplicitEuler:
+            default: {
+                velocity += acceleration(position, velocity) * dt;
+                position += velocity * dt;
+                break;
+            }
+        }
+    }
+}
@@ -0,0 +1,138 @@
+#include "IslandSolver.h"
+#include <bit>
+
+void IslandSolver::Begin(uint32_t bodyCount) {
+    m_Parent.resize(bodyCount);
+    for (uint32_t i = 0; i < bodyCount; ++i) m_Parent[i] = i;
+    m_BodyA.clear();
+    m_BodyB.clear();
+    m_IslandStart.clear();
+    m_Order.clear();
+    m_LargestIsland = 0;
+    m_PlainIslands.clear();
+    m_ColouredIslands.clear();
+    m_ColourStart.clear();
+    m_ColourOrder.clear();
+    m_Overflow.clear();
+}
+
+uint32_t IslandSolver::Find(uint32_t body) {
+    // Path halving
+    while (m_Parent[body] != body) {
+        m_Parent[body] = m_Parent[m_Parent[body]];
+        body = m_Parent[body];
+    }
+    return body;
+}
+
+uint32_t IslandSolver::AddConstraint(uint32_t bodyA, uint32_t bodyB) {
+    if (bodyA != kStaticBody && bodyB != kStaticBody) {
+        const uint32_t ra = Find(bodyA);
+        const uint32_t rb = Find(bodyB);
+        // Lower index wins, so roots do not depend on anything but the constraint set.
+        if (ra != rb) m_Parent[std::max(ra, rb)] = std::min(ra, rb);
+    }
+
+    m_BodyA.push_back(bodyA);
+    m_BodyB.push_back(bodyB);
+    return static_cast<uint32_t>(m_BodyA.size() - 1);
+}
+
+void IslandSolver::Build() {
+    const uint32_t constraintCount = GetConstraintCount();
+
+    // Islands are numbered by their first constraint.
+    m_RootIsland.assign(m_Parent.size(), kNoIsland);
+    m_ConstraintIsland.resize(constraintCount);
+    uint32_t islandCount = 0;
+
+    for (uint32_t c = 0; c < constraintCount; ++c) {
+        const uint32_t body = (m_BodyA[c] != kStaticBody) ? m_BodyA[c] : m_BodyB[c];
+        if (body == kStaticBody) {
+            m_ConstraintIsland[c] = islandCount++; // nothing dynamic involved; stands alone
+            continue;
+        }
+
+        uint32_t& island = m_RootIsland[Find(body)];
+        if (island == kNoIsland) island = islandCount++;
+        m_ConstraintIsland[c] = island;
+    }
+
+    // Stable counting sort keeps submission order inside each island.
+    m_IslandStart.assign(islandCount + 1, 0);
+    for (uint32_t c = 0; c < constraintCount; ++c) ++m_IslandStart[m_ConstraintIsland[c] + 1];
+
+    m_LargestIsland = 0;
+    for (uint32_t i = 0; i < islandCount; ++i) {
+        m_LargestIsland = std::max(m_LargestIsland, m_IslandStart[i + 1]);
+        m_IslandStart[i + 1] += m_IslandStart[i];
+    }
+
+    m_Order.resize(constraintCount);
+    m_RootIsland.assign(islandCount, 0); // reused as the per-island write cursor
+    for (uint32_t c = 0; c < constraintCount; ++c) {
+        const uint32_t island = m_ConstraintIsland[c];
+        m_Order[m_IslandStart[island] + m_RootIsland[island]++] = c;
+    }
+
+    ColourIslands();
+}
+
+void IslandSolver::ColourIslands() {
+    const uint32_t islandCount = GetIslandCount();
+    std::vector<uint32_t>& colourOf = m_ConstraintIsland; // island ids are not needed any more
+    uint32_t colourCount = 0;
+
+    m_BodyColours.assign(m_Parent.size(), 0);
+
+    for (uint32_t island = 0; island < islandCount; ++island) {
+        const uint32_t begin = m_IslandStart[island];
+        const uint32_t end = m_IslandStart[island + 1];
+        if (!m_Settings.colouring || end - begin < m_Settings.colourMinConstraints) {
+            m_PlainIslands.push_back(island);
+            continue;
+        }
+        m_ColouredIslands.push_back(island);
+
+        for (uint32_t k = begin; k < end; ++k) {
+            const uint32_t c = m_Order[k];
+            const uint32_t a = m_BodyA[c];
+            const uint32_t b = m_BodyB[c];
+
+            // Static sides put no restriction on the colour.
+            const uint64_t used = (a != kStaticBody ? m_BodyColours[a] : 0) | (b != kStaticBody ? m_BodyColours[b] : 0);
+            if (used == ~0ull) {
+                colourOf[c] = kNoIsland;
+                m_Overflow.push_back(c);
+                continue;
+            }
+
+            const uint32_t colour = static_cast<uint32_t>(std::countr_zero(~used));
+            if (a != kStaticBody) m_BodyColours[a] |= 1ull << colour;
+            if (b != kStaticBody) m_BodyColours[b] |= 1ull << colour;
+            colourOf[c] = colour;
+            colourCount = std::max(colourCount, colour + 1);
+        }
+    }
+
+    if (colourCount == 0) return;
+
+    // Stable counting sort by colour: island order, then submission order, inside a colour.
+    m_ColourStart.assign(colourCount + 1, 0);
+    for (const uint32_t island : m_ColouredIslands) {
+        for (uint32_t k = m_IslandStart[island]; k < m_IslandStart[island + 1]; ++k) {
+            const uint32_t colour = colourOf[m_Order[k]];
+            if (colour != kNoIsland) ++m_ColourStart[colour + 1];
+        }
+    }
+    for (uint32_t i = 0; i < colourCount; ++i) m_ColourStart[i + 1] += m_ColourStart[i];
+
+    m_ColourOrder.resize(m_ColourStart[colourCount]);
+    m_RootIsland.assign(m_ColourStart.begin(), m_ColourStart.end() - 1); // reused as the per-colour write cursor
+    for (const uint32_t island : m_ColouredIslands) {
+        for (uint32_t k = m_IslandStart[island]; k < m_IslandStart[island + 1]; ++k) {
+            const uint32_t c = m_Order[k];
+            if (colourOf[c] != kNoIsland) m_ColourOrder[m_RootIsland[colourOf[c]]++] = c;
+        }
+    }
+}
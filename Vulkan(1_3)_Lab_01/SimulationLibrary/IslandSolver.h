@@ -0,0 +1,112 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "JobSystem.h"
+
+// Island-parallel constraint stage.
+// Constraints are submitted in the order a serial loop would solve them. Build() groups them
+// into islands (connected components over the dynamic bodies they touch) and Solve() runs the
+// islands concurrently, each on one thread in submission order. Islands share no dynamic body,
+// so the outcome is bitwise identical to the serial loop for any thread count.
+// Bodies passed as kStaticBody (inverse mass 0) never join islands; the solve callback must
+// not write to them.
+//
+// A single giant island (a full container) would keep one thread busy, so islands with at least
+// colourMinConstraints constraints are graph coloured instead. Each constraint, in submission
+// order, takes the lowest colour that neither of its dynamic bodies uses yet. Colours run one
+// after another, each as a parallel batch. Coloured islands no longer follow the serial order,
+// but they still give the same result for any thread count.
+class IslandSolver {
+public:
+    static constexpr uint32_t kStaticBody = 0xFFFFFFFFu;
+
+    struct Settings {
+        bool colouring = true;
+        uint32_t colourMinConstraints = 256;
+    };
+
+    Settings& GetSettings() { return m_Settings; }
+    const Settings& GetSettings() const { return m_Settings; }
+
+    // Starts a stage over bodies [0, bodyCount).
+    void Begin(uint32_t bodyCount);
+    // Either body may be kStaticBody. Returns the constraint index passed to the solve callback.
+    uint32_t AddConstraint(uint32_t bodyA, uint32_t bodyB);
+    void Build();
+
+    // Calls solve(constraintIndex) for every constraint. Call after Build().
+    template<typename Fn>
+    void Solve(JobSystem& jobs, Fn&& solve) const;
+
+    uint32_t GetConstraintCount() const { return static_cast<uint32_t>(m_BodyA.size()); }
+    uint32_t GetIslandCount() const { return m_IslandStart.empty() ? 0u : static_cast<uint32_t>(m_IslandStart.size() - 1); }
+    // Constraints in the biggest island; bounds how far the uncoloured stage can scale.
+    uint32_t GetLargestIsland() const { return m_LargestIsland; }
+
+    uint32_t GetColourCount() const { return m_ColourStart.empty() ? 0u : static_cast<uint32_t>(m_ColourStart.size() - 1); }
+    uint32_t GetColouredConstraintCount() const { return static_cast<uint32_t>(m_ColourOrder.size()); }
+    // Constraints whose bodies had used up every colour; solved serially after the colours.
+    uint32_t GetOverflowCount() const { return static_cast<uint32_t>(m_Overflow.size()); }
+
+    // Below this many constraints waking the workers costs more than the work; runs inline.
+    static constexpr uint32_t kMinParallelConstraints = 64;
+    // Smallest range handed to a worker inside one colour
+    static constexpr uint32_t kMinColourGrain = 16;
+
+private:
+    static constexpr uint32_t kNoIsland = 0xFFFFFFFFu;
+
+    uint32_t Find(uint32_t body);
+    void ColourIslands();
+
+    Settings m_Settings;
+
+    std::vector<uint32_t> m_Parent;
+    std::vector<uint32_t> m_BodyA;
+    std::vector<uint32_t> m_BodyB;
+
+    std::vector<uint32_t> m_RootIsland;       // scratch, indexed by root body
+    std::vector<uint32_t> m_ConstraintIsland; // scratch, indexed by constraint
+    std::vector<uint32_t> m_IslandStart;      // islandCount + 1 offsets into m_Order
+    std::vector<uint32_t> m_Order;            // constraint indices grouped by island
+    uint32_t m_LargestIsland = 0;
+
+    // Islands solved whole; the rest is split by colour (one bit per colour in a body's mask).
+    std::vector<uint32_t> m_PlainIslands;
+    std::vector<uint32_t> m_ColouredIslands;
+    std::vector<uint64_t> m_BodyColours;      // scratch, colours used per body
+    std::vector<uint32_t> m_ColourStart;      // colourCount + 1 offsets into m_ColourOrder
+    std::vector<uint32_t> m_ColourOrder;      // constraint indices grouped by colour
+    std::vector<uint32_t> m_Overflow;
+};
+
+template<typename Fn>
+void IslandSolver::Solve(JobSystem& jobs, Fn&& solve) const {
+    const uint32_t threads = jobs.GetThreadCount();
+    const bool inlineOnly = GetConstraintCount() < kMinParallelConstraints;
+
+    // A few ranges per thread leaves room for stealing when island sizes are uneven.
+    const uint32_t plainCount = static_cast<uint32_t>(m_PlainIslands.size());
+    const uint32_t islandGrain = inlineOnly ? plainCount : std::max(1u, plainCount / (threads * 4u));
+
+    jobs.ParallelFor(plainCount, islandGrain, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            const uint32_t island = m_PlainIslands[i];
+            for (uint32_t k = m_IslandStart[island]; k < m_IslandStart[island + 1]; ++k) solve(m_Order[k]);
+        }
+    });
+
+    // No two constraints of one colour share a dynamic body, so their order does not matter.
+    for (uint32_t colour = 0; colour < GetColourCount(); ++colour) {
+        const uint32_t first = m_ColourStart[colour];
+        const uint32_t count = m_ColourStart[colour + 1] - first;
+        const uint32_t grain = inlineOnly ? count : std::max(kMinColourGrain, count / (threads * 4u));
+
+        jobs.ParallelFor(count, grain, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t k = begin; k < end; ++k) solve(m_ColourOrder[first + k]);
+        });
+    }
+
+    for (const uint32_t c : m_Overflow) solve(c);
+}
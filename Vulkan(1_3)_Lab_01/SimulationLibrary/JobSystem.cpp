@@ -0,0 +1,126 @@
+#include "JobSystem.h"
+#include <algorithm>
+
+JobSystem::JobSystem(uint32_t threadCount) {
+    SetThreadCount(threadCount);
+}
+
+JobSystem::~JobSystem() {
+    StopWorkers();
+}
+
+void JobSystem::SetThreadCount(uint32_t threadCount) {
+    if (threadCount == 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+    if (threadCount == GetThreadCount()) return;
+
+    StopWorkers();
+    StartWorkers(threadCount);
+}
+
+void JobSystem::StartWorkers(uint32_t threadCount) {
+    m_Queues.clear();
+    for (uint32_t i = 0; i < threadCount; ++i) m_Queues.push_back(std::make_unique<Queue>());
+
+    m_Quit = false;
+    for (uint32_t i = 1; i < threadCount; ++i) {
+        m_Threads.emplace_back([this, i]() { WorkerMain(i); });
+    }
+}
+
+void JobSystem::StopWorkers() {
+    {
+        std::lock_guard<std::mutex> lock(m_WakeMutex);
+        m_Quit = true;
+    }
+    m_WakeCondition.notify_all();
+
+    for (auto& thread : m_Threads) thread.join();
+    m_Threads.clear();
+}
+
+void JobSystem::WorkerMain(uint32_t index) {
+    for (;;) {
+        if (TryRunJob(index)) continue;
+
+        std::unique_lock<std::mutex> lock(m_WakeMutex);
+        m_WakeCondition.wait(lock, [&]() { return m_Quit || m_QueuedJobs.load(std::memory_order_acquire) > 0; });
+        if (m_Quit) return;
+    }
+}
+
+void JobSystem::Push(uint32_t queue, const Job& job) {
+    {
+        std::lock_guard<std::mutex> lock(m_Queues[queue]->mutex);
+        m_Queues[queue]->jobs.push_back(job);
+    }
+    m_QueuedJobs.fetch_add(1, std::memory_order_release);
+
+    // Taking the wake mutex orders this push against a worker that is about to wait.
+    { std::lock_guard<std::mutex> lock(m_WakeMutex); }
+    m_WakeCondition.notify_one();
+}
+
+bool JobSystem::TryRunJob(uint32_t queue) {
+    Job job;
+    bool found = false;
+
+    {
+        Queue& own = *m_Queues[queue];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            job = own.jobs.back();
+            own.jobs.pop_back();
+            found = true;
+        }
+    }
+
+    const uint32_t count = GetThreadCount();
+    for (uint32_t k = 1; !found && k < count; ++k) {
+        Queue& victim = *m_Queues[(queue + k) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            job = victim.jobs.front();
+            victim.jobs.pop_front();
+            found = true;
+            m_Steals.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    if (!found) return false;
+    m_QueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+
+    // Split lazily: keep the lower half, leave the upper half for this worker or a thief.
+    Batch& batch = *job.batch;
+    while (job.end - job.begin > batch.grain) {
+        const uint32_t mid = job.begin + (job.end - job.begin) / 2;
+        Push(queue, { job.batch, mid, job.end });
+        job.end = mid;
+    }
+
+    (*batch.fn)(job.begin, job.end);
+
+    // Last touch of the batch: the caller may return as soon as this reaches zero.
+    batch.remaining.fetch_sub(job.end - job.begin, std::memory_order_acq_rel);
+    return true;
+}
+
+void JobSystem::ParallelFor(uint32_t count, uint32_t grain, const RangeFunction& fn) {
+    if (count == 0) return;
+    grain = std::max(1u, grain);
+
+    if (m_Threads.empty() || count <= grain) {
+        fn(0, count);
+        return;
+    }
+
+    Batch batch;
+    batch.fn = &fn;
+    batch.grain = grain;
+    batch.remaining.store(count, std::memory_order_relaxed);
+
+    Push(0, { &batch, 0, count });
+
+    while (batch.remaining.load(std::memory_order_acquire) != 0) {
+        if (!TryRunJob(0)) std::this_thread::yield();
+    }
+}
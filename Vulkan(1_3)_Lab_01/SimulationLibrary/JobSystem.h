@@ -0,0 +1,71 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Small work-stealing job system for the simulation stages.
+// Every thread owns a deque of range jobs; the thread calling ParallelFor() is worker 0.
+// A worker pops from the back of its own deque and splits big ranges in half as it goes,
+// pushing the upper half back. Idle workers steal from the front of other deques, which is
+// where the biggest ranges are. With one thread everything runs inline on the caller.
+class JobSystem {
+public:
+    using RangeFunction = std::function<void(uint32_t begin, uint32_t end)>;
+
+    explicit JobSystem(uint32_t threadCount = 1);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // Total thread count including the calling thread; 0 = hardware concurrency.
+    // Must not be called while a ParallelFor() is running.
+    void SetThreadCount(uint32_t threadCount);
+    uint32_t GetThreadCount() const { return static_cast<uint32_t>(m_Queues.size()); }
+
+    // Calls fn on disjoint ranges covering [0, count), each at most `grain` long (one range
+    // when single-threaded), and returns once all of them are done. Not re-entrant.
+    void ParallelFor(uint32_t count, uint32_t grain, const RangeFunction& fn);
+
+    uint64_t GetStealCount() const { return m_Steals.load(std::memory_order_relaxed); }
+
+private:
+    struct Batch {
+        const RangeFunction* fn = nullptr;
+        uint32_t grain = 1;
+        std::atomic<uint32_t> remaining{ 0 };
+    };
+
+    struct Job {
+        Batch* batch = nullptr;
+        uint32_t begin = 0;
+        uint32_t end = 0;
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    void StartWorkers(uint32_t threadCount);
+    void StopWorkers();
+    void WorkerMain(uint32_t index);
+    void Push(uint32_t queue, const Job& job);
+    bool TryRunJob(uint32_t queue);
+
+    std::vector<std::unique_ptr<Queue>> m_Queues;
+    std::vector<std::thread> m_Threads;
+
+    std::mutex m_WakeMutex;
+    std::condition_variable m_WakeCondition;
+    std::atomic<uint32_t> m_QueuedJobs{ 0 };
+    bool m_Quit = false;
+
+    std::atomic<uint64_t> m_Steals{ 0 };
+};
@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include "RigidBodyWorld.h"
+
+// Per-pair narrowphase state, keyed by the ordered body handle pair (a, b). An entry is reset when
+// either handle's slot is reused by a new body, and dropped once the pair goes untested for a while.
+//
+// Acquire() may run on several threads at once for different pairs, provided every such pair was
+// acquired earlier in the tick from one thread (so no entries are inserted concurrently).
+template <typename Data>
+class PairCache {
+public:
+    Data& Acquire(RigidBodyHandle a, RigidBodyHandle b);
+
+    // Call once per tick; drops pairs that have not been acquired for a while.
+    void NextFrame();
+    void Clear() { m_Entries.clear(); }
+
+    size_t GetEntryCount() const { return m_Entries.size(); }
+
+private:
+    struct Entry {
+        uint32_t generationA = 0;
+        uint32_t generationB = 0;
+        Data data{};
+        uint32_t lastFrame = 0;
+    };
+
+    static constexpr uint32_t kMaxIdleFrames = 30;
+
+    std::unordered_map<uint64_t, Entry> m_Entries;
+    uint32_t m_Frame = 0;
+};
+
+template <typename Data>
+Data& PairCache<Data>::Acquire(RigidBodyHandle a, RigidBodyHandle b) {
+    const uint64_t key = (static_cast<uint64_t>(a.slot) << 32) | b.slot;
+
+    // find() first: a pair acquired earlier in the tick must not touch the table structure.
+    auto it = m_Entries.find(key);
+    if (it == m_Entries.end()) it = m_Entries.emplace(key, Entry{}).first;
+    Entry& entry = it->second;
+
+    if (entry.generationA != a.generation || entry.generationB != b.generation) {
+        entry = Entry{};
+        entry.generationA = a.generation;
+        entry.generationB = b.generation;
+    }
+    entry.lastFrame = m_Frame;
+    return entry.data;
+}
+
+template <typename Data>
+void PairCache<Data>::NextFrame() {
+    ++m_Frame;
+    if ((m_Frame & 63u) != 0) return;
+
+    for (auto it = m_Entries.begin(); it != m_Entries.end();) {
+        if (m_Frame - it->second.lastFrame > kMaxIdleFrames) it = m_Entries.erase(it);
+        else ++it;
+    }
+}
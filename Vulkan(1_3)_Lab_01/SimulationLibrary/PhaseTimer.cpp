@@ -0,0 +1,27 @@
+#include "PhaseTimer.h"
+#include <cstring>
+
+void PhaseTimer::Begin() {
+    m_Phases.clear();
+    m_Last = Clock::now();
+}
+
+void PhaseTimer::Mark(const char* name) {
+    const Clock::time_point now = Clock::now();
+    const float ms = std::chrono::duration<float, std::milli>(now - m_Last).count();
+    m_Last = now;
+
+    for (Phase& phase : m_Phases) {
+        if (phase.name == name || std::strcmp(phase.name, name) == 0) {
+            phase.ms += ms;
+            return;
+        }
+    }
+    m_Phases.push_back({ name, ms });
+}
+
+float PhaseTimer::GetTotalMs() const {
+    float total = 0.0f;
+    for (const Phase& phase : m_Phases) total += phase.ms;
+    return total;
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <chrono>
+#include <vector>
+
+// Wall time of the named phases of one scenario update.
+// Begin() at the top of OnUpdate(), then Mark("phase") at the end of each phase: the time since
+// the previous mark is charged to that phase. Marking the same name again (a per-body loop, a
+// second pass) adds to the existing entry, so the list keeps the order phases first ran in.
+// Names are not copied, so pass string literals.
+class PhaseTimer {
+public:
+    struct Phase {
+        const char* name = "";
+        float ms = 0.0f;
+    };
+
+    void Begin();
+    void Mark(const char* name);
+
+    const std::vector<Phase>& GetPhases() const { return m_Phases; }
+    float GetTotalMs() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    Clock::time_point m_Last{};
+    std::vector<Phase> m_Phases;
+};
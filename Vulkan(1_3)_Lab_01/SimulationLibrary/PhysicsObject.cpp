@@ -1,20 +1,152 @@
 #include "PhysicsObject.h"
+#include "Integrators.h"
+
+PhysicsObject::PhysicsObject(const glm::mat4& transform)
+    : m_Position(transform[3]), m_Orientation(glm::normalize(glm::quat_cast(transform))) {}
+
+PhysicsObject::~PhysicsObject() {
+    DetachFromWorld();
+}
+
+PhysicsObject::PhysicsObject(PhysicsObject&& other) noexcept {
+    *this = std::move(other);
+}
+
+PhysicsObject& PhysicsObject::operator=(PhysicsObject&& other) noexcept {
+    if (this == &other) return *this;
+
+    if (m_World) {
+        m_World->DestroyBody(m_Handle);
+    }
+
+    m_Position = other.m_Position;
+    m_Orientation = other.m_Orientation;
+    m_Velocity = other.m_Velocity;
+    m_AngularVelocity = other.m_AngularVelocity;
+    m_Radius = other.m_Radius;
+    m_Restitution = other.m_Restitution;
+    m_Mass = other.m_Mass;
+    m_LocalInverseInertiaTensor = other.m_LocalInverseInertiaTensor;
+    m_InverseMass = other.m_InverseMass;
+    m_ForceAccumulator = other.m_ForceAccumulator;
+    m_Collider = other.m_Collider;
+    m_Dirty = RigidBodyWorld::kTransformDirty | RigidBodyWorld::kInertiaDirty;
+    m_World = other.m_World;
+    m_Handle = other.m_Handle;
+
+    // The world slot now belongs to this object.
+    other.m_World = nullptr;
+    other.m_Handle = {};
+    return *this;
+}
+
+void PhysicsObject::AttachToWorld(RigidBodyWorld& world) {
+    if (m_World == &world && world.IsValid(m_Handle)) return;
+    DetachFromWorld();
+
+    m_Handle = world.CreateBody(m_Position, m_Orientation);
+    world.SetVelocity(m_Handle, m_Velocity);
+    world.SetAngularVelocity(m_Handle, m_AngularVelocity);
+    world.SetInverseMass(m_Handle, m_InverseMass);
+    world.SetLocalInverseInertia(m_Handle, m_LocalInverseInertiaTensor);
+    world.AddForce(m_Handle, m_ForceAccumulator);
+    world.SetCollider(m_Handle, m_Collider);
+    m_World = &world;
+}
+
+void PhysicsObject::DetachFromWorld() {
+    if (!m_World) return;
+
+    if (m_World->IsValid(m_Handle)) {
+        // Copy the state back so the object stays usable standalone.
+        m_Position = m_World->GetPosition(m_Handle);
+        m_Orientation = m_World->GetOrientation(m_Handle);
+        m_Velocity = m_World->GetVelocity(m_Handle);
+        m_AngularVelocity = m_World->GetAngularVelocity(m_Handle);
+        m_InverseMass = m_World->GetInverseMass(m_Handle);
+        m_Collider = m_World->GetCollider(m_Handle);
+        m_Dirty = RigidBodyWorld::kTransformDirty | RigidBodyWorld::kInertiaDirty;
+        m_World->DestroyBody(m_Handle);
+    }
+
+    m_World = nullptr;
+    m_Handle = {};
+}
+
+const glm::mat4& PhysicsObject::GetTransform() const {
+    if (m_World) return m_World->GetTransform(m_Handle);
+    if (m_Dirty & RigidBodyWorld::kTransformDirty) SyncTransform();
+    return m_Transform;
+}
 
 void PhysicsObject::SetTransform(const glm::mat4& transform) {
-    m_Transform = transform;
-    SyncCollider();
+    SetOrientation(glm::quat_cast(transform));
+    SetPosition(glm::vec3(transform[3]));
+}
+
+glm::vec3 PhysicsObject::GetPosition() const {
+    if (m_World) return m_World->GetPosition(m_Handle);
+    return m_Position;
 }
 
 void PhysicsObject::SetPosition(const glm::vec3& position) {
-    m_Transform[3] = glm::vec4(position, 1.0f);
-    SyncCollider();
+    if (m_World) {
+        m_World->SetPosition(m_Handle, position);
+        return;
+    }
+    m_Position = position;
+    m_Dirty |= RigidBodyWorld::kTransformDirty;
+}
+
+glm::quat PhysicsObject::GetOrientation() const {
+    if (m_World) return m_World->GetOrientation(m_Handle);
+    return m_Orientation;
 }
 
 void PhysicsObject::SetOrientation(const glm::quat& orientation) {
-    glm::vec3 position = GetPosition();
-    m_Transform = glm::mat4_cast(glm::normalize(orientation));
-    m_Transform[3] = glm::vec4(position, 1.0f);
-    SyncCollider();
+    if (m_World) {
+        m_World->SetOrientation(m_Handle, orientation);
+        return;
+    }
+    m_Orientation = glm::normalize(orientation);
+    m_Dirty |= RigidBodyWorld::kTransformDirty | RigidBodyWorld::kInertiaDirty;
+}
+
+glm::vec3 PhysicsObject::GetAngularVelocity() const {
+    if (m_World) return m_World->GetAngularVelocity(m_Handle);
+    return m_AngularVelocity;
+}
+
+void PhysicsObject::SetAngularVelocity(const glm::vec3& angularVelocityRadiansPerSecond) {
+    if (m_World) {
+        m_World->SetAngularVelocity(m_Handle, angularVelocityRadiansPerSecond);
+        return;
+    }
+    m_AngularVelocity = angularVelocityRadiansPerSecond;
+}
+
+glm::vec3 PhysicsObject::GetVelocity() const {
+    if (m_World) return m_World->GetVelocity(m_Handle);
+    return m_Velocity;
+}
+
+void PhysicsObject::SetVelocity(const glm::vec3& velocity) {
+    if (m_World) {
+        m_World->SetVelocity(m_Handle, velocity);
+        return;
+    }
+    m_Velocity = velocity;
+}
+
+float PhysicsObject::GetInverseMass() const {
+    if (m_World) return m_World->GetInverseMass(m_Handle);
+    return m_InverseMass;
+}
+
+void PhysicsObject::SetLocalInverseInertiaTensor(const glm::mat3& invInertia) {
+    m_LocalInverseInertiaTensor = invInertia;
+    m_Dirty |= RigidBodyWorld::kInertiaDirty;
+    if (m_World) m_World->SetLocalInverseInertia(m_Handle, invInertia);
 }
 
 void PhysicsObject::SetOrientationEuler(const glm::vec3& eulerRadians) {
@@ -28,10 +160,11 @@ void PhysicsObject::ApplyAngularDisplacementEuler(const glm::vec3& deltaRadians)
 }
 
 void PhysicsObject::IntegrateAngularVelocity(float deltaTime) {
-    if (glm::length2(m_AngularVelocity) <= 0.0f) {
+    const glm::vec3 angularVelocity = GetAngularVelocity();
+    if (glm::length2(angularVelocity) <= 0.0f) {
         return;
     }
-    ApplyAngularDisplacementEuler(m_AngularVelocity * deltaTime);
+    ApplyAngularDisplacementEuler(angularVelocity * deltaTime);
 }
 
 void PhysicsObject::SetRadius(float radius) {
@@ -45,35 +178,40 @@ void PhysicsObject::SetMass(float mass) {
     if (mass <= 0.0f) {
         m_Mass = 0.0f;
         m_InverseMass = 0.0f;
-        return;
     }
-    m_Mass = mass;
-    m_InverseMass = 1.0f / mass;
+    else {
+        m_Mass = mass;
+        m_InverseMass = 1.0f / mass;
+    }
+    if (m_World) m_World->SetInverseMass(m_Handle, m_InverseMass);
 }
 
 glm::mat3 PhysicsObject::GetWorldInverseInertiaTensor() const {
-    if (m_InverseMass == 0.0f) return glm::mat3(0.0f); // Static objects don't rotate
-
-    // Convert orientation quaternion to a 3x3 rotation matrix
-    glm::mat3 R = glm::mat3_cast(GetOrientation());
-
-    // I_world^-1 = R * I_local^-1 * R^T
-    return R * m_LocalInverseInertiaTensor * glm::transpose(R);
+    if (GetInverseMass() == 0.0f) return glm::mat3(0.0f); // Static objects don't rotate
+    if (m_World) return m_World->GetWorldInverseInertia(m_Handle);
+
+    if (m_Dirty & RigidBodyWorld::kInertiaDirty) {
+        // I_world^-1 = R * I_local^-1 * R^T
+        const glm::mat3 R = glm::mat3_cast(m_Orientation);
+        m_WorldInverseInertiaTensor = R * m_LocalInverseInertiaTensor * glm::transpose(R);
+        m_Dirty &= ~RigidBodyWorld::kInertiaDirty;
+    }
+    return m_WorldInverseInertiaTensor;
 }
 
 void PhysicsObject::SetSphereInertia(float mass, float radius) {
     if (mass <= 0.0f) {
-        m_LocalInverseInertiaTensor = glm::mat3(0.0f);
+        SetLocalInverseInertiaTensor(glm::mat3(0.0f));
         return;
     }
     // Solid sphere inertia: I = 2/5 * m * r^2
     float i = (2.0f / 5.0f) * mass * (radius * radius);
-    m_LocalInverseInertiaTensor = glm::inverse(glm::mat3(i));
+    SetLocalInverseInertiaTensor(glm::inverse(glm::mat3(i)));
 }
 
 void PhysicsObject::SetCuboidInertia(float mass, const glm::vec3& halfExtents) {
     if (mass <= 0.0f) {
-        m_LocalInverseInertiaTensor = glm::mat3(0.0f);
+        SetLocalInverseInertiaTensor(glm::mat3(0.0f));
         return;
     }
     // Solid cuboid inertia: I = 1/12 * m * (w^2 + h^2)
@@ -83,10 +221,14 @@ void PhysicsObject::SetCuboidInertia(float mass, const glm::vec3& halfExtents) {
     inertia[1][1] = (1.0f / 12.0f) * mass * (size.x * size.x + size.z * size.z);
     inertia[2][2] = (1.0f / 12.0f) * mass * (size.x * size.x + size.y * size.y);
 
-    m_LocalInverseInertiaTensor = glm::inverse(inertia);
+    SetLocalInverseInertiaTensor(glm::inverse(inertia));
 }
 
 void PhysicsObject::AddForce(const glm::vec3& force) {
+    if (m_World) {
+        m_World->AddForce(m_Handle, force);
+        return;
+    }
     if (m_InverseMass == 0.0f) {
         return;
     }
@@ -94,22 +236,53 @@ void PhysicsObject::AddForce(const glm::vec3& force) {
 }
 
 void PhysicsObject::ClearForces() {
+    if (m_World) {
+        m_World->ClearForce(m_Handle);
+        return;
+    }
     m_ForceAccumulator = glm::vec3(0.0f);
 }
 
-void PhysicsObject::SetCollider(std::unique_ptr<Collider> collider) {
-    m_Collider = std::move(collider);
-    SyncCollider();
+void PhysicsObject::SetCollider(const Collider& collider) {
+    if (m_World) {
+        m_World->SetCollider(m_Handle, collider);
+        return;
+    }
+    m_Collider = collider;
+    m_Dirty |= RigidBodyWorld::kTransformDirty;
+}
+
+Collider& PhysicsObject::GetCollider() {
+    if (m_World) return m_World->GetCollider(m_Handle);
+    if (m_Dirty & RigidBodyWorld::kTransformDirty) SyncTransform();
+    return m_Collider;
 }
 
-void PhysicsObject::SyncCollider() {
-    if (m_Collider) {
-        m_Collider->SyncFromTransform(m_Transform);
-    }
+const Collider& PhysicsObject::GetCollider() const {
+    if (m_World) return m_World->GetCollider(m_Handle);
+    if (m_Dirty & RigidBodyWorld::kTransformDirty) SyncTransform();
+    return m_Collider;
+}
+
+void PhysicsObject::SyncTransform() const {
+    m_Transform = glm::mat4_cast(m_Orientation);
+    m_Transform[3] = glm::vec4(m_Position, 1.0f);
+    m_Collider.SyncFromTransform(m_Transform);
+    m_Dirty &= ~RigidBodyWorld::kTransformDirty;
 }
 
 void PhysicsObject::Update(float deltaTime, float gravity, IntegrationMethod method) {
-    IntegrateAngularVelocity(deltaTime);
+    if (m_World) {
+        m_World->IntegrateBody(m_World->GetDenseIndex(m_Handle), deltaTime, gravity, method);
+        return;
+    }
+
+    // Contact impulses produce a world-space angular velocity, so the rotation goes on the left
+    // (IntegrateAngularVelocity() keeps the body-frame behaviour OrientationScenario demonstrates).
+    const glm::vec3 angularVelocity = GetAngularVelocity();
+    if (glm::length2(angularVelocity) > 0.0f) {
+        SetOrientation(glm::normalize(glm::quat(angularVelocity * deltaTime) * GetOrientation()));
+    }
 
     if (m_InverseMass == 0.0f) {
         ClearForces();
@@ -119,20 +292,8 @@ void PhysicsObject::Update(float deltaTime, float gravity, IntegrationMethod met
     AddForce({ 0.0f, gravity * m_Mass, 0.0f });
 
     glm::vec3 position = GetPosition();
-    glm::vec3 acceleration = m_ForceAccumulator * m_InverseMass;
-
-    switch (method) {
-        case IntegrationMethod::ExplicitEuler:
-            position += m_Velocity * deltaTime;
-            m_Velocity += acceleration * deltaTime;
-            break;
-
-        case IntegrationMethod::SemiImplicitEuler:
-        default:
-            m_Velocity += acceleration * deltaTime;
-            position += m_Velocity * deltaTime;
-            break;
-    }
+    const glm::vec3 acceleration = m_ForceAccumulator * m_InverseMass;
+    SimIntegration::StepConstantAcceleration(position, m_Velocity, acceleration, deltaTime, method);
 
     SetPosition(position);
     ClearForces();
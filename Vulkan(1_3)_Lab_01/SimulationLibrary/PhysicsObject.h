@@ -3,33 +3,50 @@
 #include <glm/glm.hpp>
 #include <glm/gtx/quaternion.hpp>
 #include <glm/gtc/matrix_transform.hpp>
-#include <memory>
 #include "Collider.h"
 #include "CollisionUtil.h"
 #include "IntegrationMethod.h"
+#include "RigidBodyWorld.h"
 
+// A single rigid body. Standalone objects own their state; once AttachToWorld() is called
+// the object becomes a thin view over a RigidBodyWorld slot and every accessor forwards there.
+// Either way position + orientation are the canonical state; the transform matrix, the collider
+// and the world inverse inertia are rebuilt on first read after a change (see RigidBodyWorld).
 class PhysicsObject {
 public:
     PhysicsObject() = default;
-    explicit PhysicsObject(const glm::mat4& transform) : m_Transform(transform) {}
-
-    const glm::mat4& GetTransform() const { return m_Transform; }
+    explicit PhysicsObject(const glm::mat4& transform);
+    ~PhysicsObject();
+
+    PhysicsObject(PhysicsObject&& other) noexcept;
+    PhysicsObject& operator=(PhysicsObject&& other) noexcept;
+    PhysicsObject(const PhysicsObject&) = delete;
+    PhysicsObject& operator=(const PhysicsObject&) = delete;
+
+    // Moves this object's current state into a new body owned by 'world'.
+    void AttachToWorld(RigidBodyWorld& world);
+    void DetachFromWorld();
+    bool IsInWorld() const { return m_World != nullptr && m_World->IsValid(m_Handle); }
+    RigidBodyWorld* GetWorld() const { return m_World; }
+    RigidBodyHandle GetWorldHandle() const { return m_Handle; }
+
+    const glm::mat4& GetTransform() const;
     void SetTransform(const glm::mat4& transform);
 
-    glm::vec3 GetPosition() const { return glm::vec3(m_Transform[3]); }
+    glm::vec3 GetPosition() const;
     void SetPosition(const glm::vec3& position);
 
-    glm::quat GetOrientation() const { return glm::quat_cast(m_Transform); }
+    glm::quat GetOrientation() const;
     void SetOrientation(const glm::quat& orientation);
     void SetOrientationEuler(const glm::vec3& eulerRadians);
     void ApplyAngularDisplacementEuler(const glm::vec3& deltaRadians);
 
-    const glm::vec3& GetAngularVelocity() const { return m_AngularVelocity; }
-    void SetAngularVelocity(const glm::vec3& angularVelocityRadiansPerSecond) { m_AngularVelocity = angularVelocityRadiansPerSecond; }
+    glm::vec3 GetAngularVelocity() const;
+    void SetAngularVelocity(const glm::vec3& angularVelocityRadiansPerSecond);
     void IntegrateAngularVelocity(float deltaTime);
 
-    const glm::vec3& GetVelocity() const { return m_Velocity; }
-    void SetVelocity(const glm::vec3& velocity) { m_Velocity = velocity; }
+    glm::vec3 GetVelocity() const;
+    void SetVelocity(const glm::vec3& velocity);
 
     float GetRadius() const { return m_Radius; }
     void SetRadius(float radius);
@@ -38,11 +55,11 @@ public:
     void SetRestitution(float restitution) { m_Restitution = restitution; }
 
     float GetMass() const { return m_Mass; }
-    float GetInverseMass() const { return m_InverseMass; }
+    float GetInverseMass() const;
     void SetMass(float mass);
 
     glm::mat3 GetWorldInverseInertiaTensor() const;
-    void SetLocalInverseInertiaTensor(const glm::mat3& invInertia) { m_LocalInverseInertiaTensor = invInertia; }
+    void SetLocalInverseInertiaTensor(const glm::mat3& invInertia);
 
     void SetSphereInertia(float mass, float radius);
     void SetCuboidInertia(float mass, const glm::vec3& halfExtents);
@@ -50,20 +67,27 @@ public:
     void AddForce(const glm::vec3& force);
     void ClearForces();
 
-    void SetCollider(std::unique_ptr<Collider> collider);
-    Collider* GetCollider() const { return m_Collider.get(); }
+    // Shapes convert implicitly: SetCollider(SphereCollider(radius)).
+    void SetCollider(const Collider& collider);
+    // Attached objects keep their collider in the world's dense array, so the reference (and
+    // shape pointers taken from it) is only valid until the world creates or destroys a body.
+    Collider& GetCollider();
+    const Collider& GetCollider() const;
 
     template <typename T>
-    T* GetColliderAs() const { return dynamic_cast<T*>(m_Collider.get()); }
+    T* GetColliderAs() { return GetCollider().template As<T>(); }
+    template <typename T>
+    const T* GetColliderAs() const { return GetCollider().template As<T>(); }
 
     void Update(float deltaTime, float gravity, IntegrationMethod method);
 
     static void ResolveCollision(class PhysicsObject* objA, class PhysicsObject* objB, const SimCollision::Contact& contact);
 
 private:
-    void SyncCollider();
+    void SyncTransform() const;
 
-    glm::mat4 m_Transform{1.0f};
+    glm::vec3 m_Position{0.0f};
+    glm::quat m_Orientation{1.0f, 0.0f, 0.0f, 0.0f};
     glm::vec3 m_Velocity{0.0f};
     glm::vec3 m_AngularVelocity{0.0f}; // radians/sec
 
@@ -75,5 +99,12 @@ private:
     float m_InverseMass = 1.0f;
     glm::vec3 m_ForceAccumulator{0.0f};
 
-    std::unique_ptr<Collider> m_Collider;
-};
\ No newline at end of file
+    // Standalone caches; attached objects use the world's copies.
+    mutable glm::mat4 m_Transform{1.0f};
+    mutable glm::mat3 m_WorldInverseInertiaTensor{0.0f};
+    mutable Collider m_Collider;
+    mutable uint8_t m_Dirty = RigidBodyWorld::kTransformDirty | RigidBodyWorld::kInertiaDirty;
+
+    RigidBodyWorld* m_World = nullptr;
+    RigidBodyHandle m_Handle{};
+};
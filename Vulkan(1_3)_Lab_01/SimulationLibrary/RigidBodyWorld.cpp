@@ -0,0 +1,342 @@
+#include "RigidBodyWorld.h"
+#include "BatchIntegrator.h"
+#include "Integrators.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace {
+    template <typename... Arrays>
+    void SwapRemove(uint32_t index, Arrays&... arrays) {
+        auto removeOne = [index](auto& array) {
+            if (index + 1 != array.size()) {
+                array[index] = array.back();
+            }
+            array.pop_back();
+        };
+        (removeOne(arrays), ...);
+    }
+}
+
+RigidBodyHandle RigidBodyWorld::CreateBody(const glm::vec3& position, const glm::quat& orientation) {
+    uint32_t slot;
+    if (!m_FreeSlots.empty()) {
+        slot = m_FreeSlots.back();
+        m_FreeSlots.pop_back();
+    }
+    else {
+        slot = static_cast<uint32_t>(m_SlotToDense.size());
+        m_SlotToDense.push_back(kInvalidIndex);
+        m_SlotGeneration.push_back(0);
+    }
+
+    const uint32_t index = static_cast<uint32_t>(m_PosX.size());
+    m_SlotToDense[slot] = index;
+    m_DenseToSlot.push_back(slot);
+
+    const glm::quat q = glm::normalize(orientation);
+    m_PosX.push_back(position.x); m_PosY.push_back(position.y); m_PosZ.push_back(position.z);
+    m_VelX.push_back(0.0f); m_VelY.push_back(0.0f); m_VelZ.push_back(0.0f);
+    m_AngX.push_back(0.0f); m_AngY.push_back(0.0f); m_AngZ.push_back(0.0f);
+    m_RotX.push_back(q.x); m_RotY.push_back(q.y); m_RotZ.push_back(q.z); m_RotW.push_back(q.w);
+    m_ForceX.push_back(0.0f); m_ForceY.push_back(0.0f); m_ForceZ.push_back(0.0f);
+    m_InverseMass.push_back(1.0f);
+    m_Simulated.push_back(1);
+
+    m_LocalInverseInertia.push_back(glm::mat3(0.0f));
+    m_WorldInverseInertia.push_back(glm::mat3(0.0f));
+    m_Transform.push_back(glm::mat4(1.0f));
+    m_Collider.emplace_back();
+    m_Dirty.push_back(kTransformDirty | kInertiaDirty);
+
+    return { slot, m_SlotGeneration[slot] };
+}
+
+void RigidBodyWorld::DestroyBody(RigidBodyHandle handle) {
+    if (!IsValid(handle)) return;
+
+    const uint32_t index = m_SlotToDense[handle.slot];
+    const uint32_t last = static_cast<uint32_t>(m_PosX.size() - 1);
+
+    SwapRemove(index,
+        m_PosX, m_PosY, m_PosZ,
+        m_VelX, m_VelY, m_VelZ,
+        m_AngX, m_AngY, m_AngZ,
+        m_RotX, m_RotY, m_RotZ, m_RotW,
+        m_ForceX, m_ForceY, m_ForceZ,
+        m_InverseMass, m_Simulated,
+        m_LocalInverseInertia, m_WorldInverseInertia, m_Transform, m_Collider, m_Dirty,
+        m_DenseToSlot);
+
+    if (index != last) {
+        m_SlotToDense[m_DenseToSlot[index]] = index;
+    }
+
+    m_SlotToDense[handle.slot] = kInvalidIndex;
+    ++m_SlotGeneration[handle.slot];
+    m_FreeSlots.push_back(handle.slot);
+}
+
+void RigidBodyWorld::Clear() {
+    // Bump every live generation so outstanding handles (and PhysicsObject views) go stale.
+    for (uint32_t slot = 0; slot < m_SlotToDense.size(); ++slot) {
+        if (m_SlotToDense[slot] != kInvalidIndex) {
+            m_SlotToDense[slot] = kInvalidIndex;
+            ++m_SlotGeneration[slot];
+            m_FreeSlots.push_back(slot);
+        }
+    }
+
+    m_DenseToSlot.clear();
+    m_PosX.clear(); m_PosY.clear(); m_PosZ.clear();
+    m_VelX.clear(); m_VelY.clear(); m_VelZ.clear();
+    m_AngX.clear(); m_AngY.clear(); m_AngZ.clear();
+    m_RotX.clear(); m_RotY.clear(); m_RotZ.clear(); m_RotW.clear();
+    m_ForceX.clear(); m_ForceY.clear(); m_ForceZ.clear();
+    m_InverseMass.clear();
+    m_Simulated.clear();
+    m_LocalInverseInertia.clear();
+    m_WorldInverseInertia.clear();
+    m_Transform.clear();
+    m_Collider.clear();
+    m_Dirty.clear();
+}
+
+bool RigidBodyWorld::IsValid(RigidBodyHandle handle) const {
+    return handle.slot < m_SlotToDense.size()
+        && m_SlotGeneration[handle.slot] == handle.generation
+        && m_SlotToDense[handle.slot] != kInvalidIndex;
+}
+
+uint32_t RigidBodyWorld::GetDenseIndex(RigidBodyHandle handle) const {
+    return IsValid(handle) ? m_SlotToDense[handle.slot] : kInvalidIndex;
+}
+
+uint32_t RigidBodyWorld::DenseIndexOf(RigidBodyHandle handle) const {
+    assert(IsValid(handle) && "stale or invalid RigidBodyHandle");
+    return m_SlotToDense[handle.slot];
+}
+
+RigidBodyHandle RigidBodyWorld::GetHandle(uint32_t denseIndex) const {
+    if (denseIndex >= m_DenseToSlot.size()) return {};
+    const uint32_t slot = m_DenseToSlot[denseIndex];
+    return { slot, m_SlotGeneration[slot] };
+}
+
+glm::vec3 RigidBodyWorld::GetPosition(RigidBodyHandle handle) const {
+    const uint32_t i = DenseIndexOf(handle);
+    return { m_PosX[i], m_PosY[i], m_PosZ[i] };
+}
+
+void RigidBodyWorld::SetPosition(RigidBodyHandle handle, const glm::vec3& position) {
+    const uint32_t i = DenseIndexOf(handle);
+    m_PosX[i] = position.x; m_PosY[i] = position.y; m_PosZ[i] = position.z;
+    m_Dirty[i] |= kTransformDirty;
+}
+
+glm::quat RigidBodyWorld::GetOrientation(RigidBodyHandle handle) const {
+    const uint32_t i = DenseIndexOf(handle);
+    return glm::quat(m_RotW[i], m_RotX[i], m_RotY[i], m_RotZ[i]);
+}
+
+void RigidBodyWorld::SetOrientation(RigidBodyHandle handle, const glm::quat& orientation) {
+    const uint32_t i = DenseIndexOf(handle);
+    const glm::quat q = glm::normalize(orientation);
+    m_RotX[i] = q.x; m_RotY[i] = q.y; m_RotZ[i] = q.z; m_RotW[i] = q.w;
+    m_Dirty[i] |= kTransformDirty | kInertiaDirty;
+}
+
+glm::vec3 RigidBodyWorld::GetVelocity(RigidBodyHandle handle) const {
+    const uint32_t i = DenseIndexOf(handle);
+    return { m_VelX[i], m_VelY[i], m_VelZ[i] };
+}
+
+void RigidBodyWorld::SetVelocity(RigidBodyHandle handle, const glm::vec3& velocity) {
+    const uint32_t i = DenseIndexOf(handle);
+    m_VelX[i] = velocity.x; m_VelY[i] = velocity.y; m_VelZ[i] = velocity.z;
+}
+
+glm::vec3 RigidBodyWorld::GetAngularVelocity(RigidBodyHandle handle) const {
+    const uint32_t i = DenseIndexOf(handle);
+    return { m_AngX[i], m_AngY[i], m_AngZ[i] };
+}
+
+void RigidBodyWorld::SetAngularVelocity(RigidBodyHandle handle, const glm::vec3& angularVelocity) {
+    const uint32_t i = DenseIndexOf(handle);
+    m_AngX[i] = angularVelocity.x; m_AngY[i] = angularVelocity.y; m_AngZ[i] = angularVelocity.z;
+}
+
+float RigidBodyWorld::GetInverseMass(RigidBodyHandle handle) const {
+    return m_InverseMass[DenseIndexOf(handle)];
+}
+
+void RigidBodyWorld::SetInverseMass(RigidBodyHandle handle, float inverseMass) {
+    m_InverseMass[DenseIndexOf(handle)] = inverseMass;
+}
+
+const glm::mat3& RigidBodyWorld::GetLocalInverseInertia(RigidBodyHandle handle) const {
+    return m_LocalInverseInertia[DenseIndexOf(handle)];
+}
+
+void RigidBodyWorld::SetLocalInverseInertia(RigidBodyHandle handle, const glm::mat3& invInertia) {
+    const uint32_t i = DenseIndexOf(handle);
+    m_LocalInverseInertia[i] = invInertia;
+    m_Dirty[i] |= kInertiaDirty;
+}
+
+const glm::mat3& RigidBodyWorld::GetWorldInverseInertia(RigidBodyHandle handle) const {
+    const uint32_t i = DenseIndexOf(handle);
+    if (m_Dirty[i] & kInertiaDirty) SyncInertia(i);
+    return m_WorldInverseInertia[i];
+}
+
+void RigidBodyWorld::AddForce(RigidBodyHandle handle, const glm::vec3& force) {
+    const uint32_t i = DenseIndexOf(handle);
+    if (m_InverseMass[i] == 0.0f) return;
+    m_ForceX[i] += force.x; m_ForceY[i] += force.y; m_ForceZ[i] += force.z;
+}
+
+void RigidBodyWorld::ClearForce(RigidBodyHandle handle) {
+    const uint32_t i = DenseIndexOf(handle);
+    m_ForceX[i] = 0.0f; m_ForceY[i] = 0.0f; m_ForceZ[i] = 0.0f;
+}
+
+bool RigidBodyWorld::IsSimulated(RigidBodyHandle handle) const {
+    return m_Simulated[DenseIndexOf(handle)] != 0;
+}
+
+void RigidBodyWorld::SetSimulated(RigidBodyHandle handle, bool simulated) {
+    if (!IsValid(handle)) return;
+    m_Simulated[DenseIndexOf(handle)] = simulated ? 1 : 0;
+}
+
+void RigidBodyWorld::SetCollider(RigidBodyHandle handle, const Collider& collider) {
+    const uint32_t i = DenseIndexOf(handle);
+    m_Collider[i] = collider;
+    m_Dirty[i] |= kTransformDirty;
+}
+
+Collider& RigidBodyWorld::GetCollider(RigidBodyHandle handle) {
+    const uint32_t i = DenseIndexOf(handle);
+    if (m_Dirty[i] & kTransformDirty) SyncTransform(i);
+    return m_Collider[i];
+}
+
+const Collider& RigidBodyWorld::GetCollider(RigidBodyHandle handle) const {
+    const uint32_t i = DenseIndexOf(handle);
+    if (m_Dirty[i] & kTransformDirty) SyncTransform(i);
+    return m_Collider[i];
+}
+
+const glm::mat4& RigidBodyWorld::GetTransform(RigidBodyHandle handle) const {
+    const uint32_t i = DenseIndexOf(handle);
+    if (m_Dirty[i] & kTransformDirty) SyncTransform(i);
+    return m_Transform[i];
+}
+
+void RigidBodyWorld::SyncTransforms() {
+    const uint32_t count = static_cast<uint32_t>(m_Dirty.size());
+    for (uint32_t i = 0; i < count; ++i) {
+        if (m_Dirty[i] & kTransformDirty) SyncTransform(i);
+        if (m_Dirty[i] & kInertiaDirty) SyncInertia(i);
+    }
+}
+
+void RigidBodyWorld::SyncTransform(uint32_t index) const {
+    glm::mat4& transform = m_Transform[index];
+    transform = glm::mat4_cast(glm::quat(m_RotW[index], m_RotX[index], m_RotY[index], m_RotZ[index]));
+    transform[3] = glm::vec4(m_PosX[index], m_PosY[index], m_PosZ[index], 1.0f);
+
+    m_Collider[index].SyncFromTransform(transform);
+    m_Dirty[index] &= ~kTransformDirty;
+}
+
+void RigidBodyWorld::SyncInertia(uint32_t index) const {
+    const glm::mat3 R = glm::mat3_cast(glm::quat(m_RotW[index], m_RotX[index], m_RotY[index], m_RotZ[index]));
+    m_WorldInverseInertia[index] = R * m_LocalInverseInertia[index] * glm::transpose(R);
+    m_Dirty[index] &= ~kInertiaDirty;
+}
+
+void RigidBodyWorld::SaveState(WorldSnapshot& out) const {
+    out.Write(static_cast<uint32_t>(m_PosX.size()));
+    out.WriteArray(m_DenseToSlot);
+    for (const auto* array : { &m_PosX, &m_PosY, &m_PosZ, &m_VelX, &m_VelY, &m_VelZ, &m_AngX, &m_AngY, &m_AngZ,
+                               &m_RotX, &m_RotY, &m_RotZ, &m_RotW, &m_ForceX, &m_ForceY, &m_ForceZ, &m_InverseMass }) {
+        out.WriteArray(*array);
+    }
+    out.WriteArray(m_Simulated);
+}
+
+bool RigidBodyWorld::RestoreState(WorldSnapshot::Reader& in) {
+    constexpr size_t kFloatArrays = 17;
+    uint32_t count = 0;
+    if (!in.Read(count) || count != m_PosX.size()) return false;
+    if (in.GetRemaining() < count * (sizeof(uint32_t) + kFloatArrays * sizeof(float) + sizeof(uint8_t))) return false;
+
+    // Same bodies in the same order, or the arrays would land on the wrong ones
+    const uint8_t* slots = in.Skip(sizeof(uint32_t) * count);
+    if (!slots || (count && std::memcmp(slots, m_DenseToSlot.data(), sizeof(uint32_t) * count) != 0)) return false;
+
+    for (auto* array : { &m_PosX, &m_PosY, &m_PosZ, &m_VelX, &m_VelY, &m_VelZ, &m_AngX, &m_AngY, &m_AngZ,
+                         &m_RotX, &m_RotY, &m_RotZ, &m_RotW, &m_ForceX, &m_ForceY, &m_ForceZ, &m_InverseMass }) {
+        if (!in.ReadArray(array->data(), count)) return false;
+    }
+    if (!in.ReadArray(m_Simulated.data(), count)) return false;
+
+    std::fill(m_Dirty.begin(), m_Dirty.end(), static_cast<uint8_t>(kTransformDirty | kInertiaDirty));
+    return true;
+}
+
+void RigidBodyWorld::IntegrateOrientation(uint32_t i, float deltaTime) {
+    const glm::vec3 w{ m_AngX[i], m_AngY[i], m_AngZ[i] };
+    if (glm::length2(w) <= 0.0f) return;
+
+    const glm::quat current(m_RotW[i], m_RotX[i], m_RotY[i], m_RotZ[i]);
+    // World-space angular velocity (that is what contact impulses produce), so it goes on the left.
+    const glm::quat q = glm::normalize(glm::quat(w * deltaTime) * current);
+    m_RotX[i] = q.x; m_RotY[i] = q.y; m_RotZ[i] = q.z; m_RotW[i] = q.w;
+    m_Dirty[i] |= kTransformDirty | kInertiaDirty;
+}
+
+void RigidBodyWorld::IntegrateBody(uint32_t i, float deltaTime, float gravity, IntegrationMethod method) {
+    IntegrateOrientation(i, deltaTime);
+
+    const float invMass = m_InverseMass[i];
+    if (invMass == 0.0f) {
+        m_ForceX[i] = 0.0f; m_ForceY[i] = 0.0f; m_ForceZ[i] = 0.0f;
+        return;
+    }
+
+    // Gravity is applied as an acceleration (F = g*m, a = F/m).
+    const glm::vec3 acceleration(m_ForceX[i] * invMass, m_ForceY[i] * invMass + gravity, m_ForceZ[i] * invMass);
+    glm::vec3 position(m_PosX[i], m_PosY[i], m_PosZ[i]);
+    glm::vec3 velocity(m_VelX[i], m_VelY[i], m_VelZ[i]);
+    SimIntegration::StepConstantAcceleration(position, velocity, acceleration, deltaTime, method);
+
+    m_PosX[i] = position.x; m_PosY[i] = position.y; m_PosZ[i] = position.z;
+    m_VelX[i] = velocity.x; m_VelY[i] = velocity.y; m_VelZ[i] = velocity.z;
+    m_ForceX[i] = 0.0f; m_ForceY[i] = 0.0f; m_ForceZ[i] = 0.0f;
+    m_Dirty[i] |= kTransformDirty;
+}
+
+void RigidBodyWorld::Integrate(float deltaTime, float gravity, IntegrationMethod method) {
+    const uint32_t count = static_cast<uint32_t>(m_PosX.size());
+
+    for (uint32_t i = 0; i < count; ++i) {
+        if (!m_Simulated[i]) continue;
+        IntegrateOrientation(i, deltaTime);
+    }
+
+    SimIntegration::LinearStreams streams;
+    streams.posX = m_PosX.data(); streams.posY = m_PosY.data(); streams.posZ = m_PosZ.data();
+    streams.velX = m_VelX.data(); streams.velY = m_VelY.data(); streams.velZ = m_VelZ.data();
+    streams.forceX = m_ForceX.data(); streams.forceY = m_ForceY.data(); streams.forceZ = m_ForceZ.data();
+    streams.inverseMass = m_InverseMass.data();
+    streams.simulated = m_Simulated.data();
+    streams.count = count;
+    SimIntegration::IntegrateLinear(streams, deltaTime, gravity, method, m_SimdLevel);
+
+    for (uint32_t i = 0; i < count; ++i) {
+        if (m_Simulated[i] && m_InverseMass[i] != 0.0f) m_Dirty[i] |= kTransformDirty;
+    }
+}
@@ -0,0 +1,145 @@
+#pragma once
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/glm.hpp>
+#include <glm/gtx/quaternion.hpp>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "IntegrationMethod.h"
+#include "BatchIntegrator.h"
+#include "Collider.h"
+#include "WorldSnapshot.h"
+
+// Stable reference to a body inside a RigidBodyWorld. The slot index never moves;
+// the generation is bumped on destroy so stale handles are rejected.
+struct RigidBodyHandle {
+    uint32_t slot = std::numeric_limits<uint32_t>::max();
+    uint32_t generation = 0;
+
+    bool IsNull() const { return slot == std::numeric_limits<uint32_t>::max(); }
+    bool operator==(const RigidBodyHandle& other) const { return slot == other.slot && generation == other.generation; }
+    bool operator!=(const RigidBodyHandle& other) const { return !(*this == other); }
+};
+
+// Structure-of-arrays storage for rigid body state.
+// Hot integration fields (position, velocity, orientation, inverse mass, forces) live in
+// per-component float arrays so one pass over the world only streams what it touches.
+// Cold data (render transform, collider, inertia) sits in separate arrays.
+//
+// Position and orientation are the canonical state. The render transform, the collider and the
+// world-space inverse inertia are derived from them and rebuilt lazily: setters and Integrate()
+// only raise dirty flags, and the first read afterwards (or SyncTransforms()) does the rebuild.
+// A lazy rebuild writes the cache, so two threads must not read the same dirty body; call
+// SyncTransforms() before a parallel stage that shares bodies between threads.
+class RigidBodyWorld {
+public:
+    static constexpr uint32_t kInvalidIndex = std::numeric_limits<uint32_t>::max();
+
+    // Dirty bits, shared with standalone PhysicsObjects
+    static constexpr uint8_t kTransformDirty = 1u << 0; // render transform + collider
+    static constexpr uint8_t kInertiaDirty = 1u << 1;   // world inverse inertia
+
+    RigidBodyHandle CreateBody(const glm::vec3& position = glm::vec3(0.0f), const glm::quat& orientation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+    void DestroyBody(RigidBodyHandle handle);
+    void Clear();
+
+    bool IsValid(RigidBodyHandle handle) const;
+    uint32_t GetDenseIndex(RigidBodyHandle handle) const;
+    RigidBodyHandle GetHandle(uint32_t denseIndex) const;
+    size_t GetBodyCount() const { return m_PosX.size(); }
+
+    glm::vec3 GetPosition(RigidBodyHandle handle) const;
+    void SetPosition(RigidBodyHandle handle, const glm::vec3& position);
+
+    glm::quat GetOrientation(RigidBodyHandle handle) const;
+    void SetOrientation(RigidBodyHandle handle, const glm::quat& orientation);
+
+    glm::vec3 GetVelocity(RigidBodyHandle handle) const;
+    void SetVelocity(RigidBodyHandle handle, const glm::vec3& velocity);
+
+    glm::vec3 GetAngularVelocity(RigidBodyHandle handle) const;
+    void SetAngularVelocity(RigidBodyHandle handle, const glm::vec3& angularVelocity);
+
+    float GetInverseMass(RigidBodyHandle handle) const;
+    void SetInverseMass(RigidBodyHandle handle, float inverseMass);
+
+    const glm::mat3& GetLocalInverseInertia(RigidBodyHandle handle) const;
+    void SetLocalInverseInertia(RigidBodyHandle handle, const glm::mat3& invInertia);
+    // R * I_local^-1 * R^T, cached until the orientation or local tensor changes
+    const glm::mat3& GetWorldInverseInertia(RigidBodyHandle handle) const;
+
+    void AddForce(RigidBodyHandle handle, const glm::vec3& force);
+    void ClearForce(RigidBodyHandle handle);
+
+    // Bodies that are not simulated (e.g. remote replicas, static obstacles) are skipped by Integrate().
+    bool IsSimulated(RigidBodyHandle handle) const;
+    void SetSimulated(RigidBodyHandle handle, bool simulated);
+
+    // Colliders are stored by value in a dense array next to the transforms and re-synced
+    // whenever a body's transform is rebuilt. References are invalidated by CreateBody() and
+    // DestroyBody(), like any other dense element.
+    void SetCollider(RigidBodyHandle handle, const Collider& collider);
+    Collider& GetCollider(RigidBodyHandle handle);
+    const Collider& GetCollider(RigidBodyHandle handle) const;
+
+    const glm::mat4& GetTransform(RigidBodyHandle handle) const;
+    // Rebuilds every dirty body now.
+    void SyncTransforms();
+
+    // Advances one body / every simulated body. Integrate() walks the hot arrays only
+    // (orientation, then a batched SIMD linear pass); transforms and colliders follow lazily.
+    void IntegrateBody(uint32_t denseIndex, float deltaTime, float gravity, IntegrationMethod method);
+    void Integrate(float deltaTime, float gravity, IntegrationMethod method);
+
+    // Vector width requested for Integrate()'s linear pass. Stored as given; Integrate() falls
+    // back to what the CPU supports.
+    SimSimd::SimdLevel GetSimdLevel() const { return m_SimdLevel; }
+    void SetSimdLevel(SimSimd::SimdLevel level) { m_SimdLevel = level; }
+
+    // Appends / reads back the hot state of every body (position, orientation, velocities,
+    // forces, inverse mass, simulated flag) as whole arrays. Restore only succeeds on the same
+    // set of bodies in the same dense order, i.e. none created or destroyed since the save;
+    // caches are marked dirty and colliders / inertia tensors are left as they are.
+    void SaveState(WorldSnapshot& out) const;
+    bool RestoreState(WorldSnapshot::Reader& in);
+
+    // Raw access for batch passes.
+    float* PositionX() { return m_PosX.data(); }
+    float* PositionY() { return m_PosY.data(); }
+    float* PositionZ() { return m_PosZ.data(); }
+    float* VelocityX() { return m_VelX.data(); }
+    float* VelocityY() { return m_VelY.data(); }
+    float* VelocityZ() { return m_VelZ.data(); }
+    const float* InverseMasses() const { return m_InverseMass.data(); }
+
+private:
+    // Dense index of a live handle, for the per-body accessors; asserts on stale handles.
+    uint32_t DenseIndexOf(RigidBodyHandle handle) const;
+    void SyncTransform(uint32_t index) const;
+    void SyncInertia(uint32_t index) const;
+    void IntegrateOrientation(uint32_t index, float deltaTime);
+
+    // slot -> dense index (+ generation), dense index -> slot
+    std::vector<uint32_t> m_SlotToDense;
+    std::vector<uint32_t> m_SlotGeneration;
+    std::vector<uint32_t> m_FreeSlots;
+    std::vector<uint32_t> m_DenseToSlot;
+
+    // Hot
+    std::vector<float> m_PosX, m_PosY, m_PosZ;
+    std::vector<float> m_VelX, m_VelY, m_VelZ;
+    std::vector<float> m_AngX, m_AngY, m_AngZ;
+    std::vector<float> m_RotX, m_RotY, m_RotZ, m_RotW;
+    std::vector<float> m_ForceX, m_ForceY, m_ForceZ;
+    std::vector<float> m_InverseMass;
+    std::vector<uint8_t> m_Simulated;
+
+    // Cold; everything mutable is a cache rebuilt from the hot state on read.
+    std::vector<glm::mat3> m_LocalInverseInertia;
+    mutable std::vector<glm::mat3> m_WorldInverseInertia;
+    mutable std::vector<glm::mat4> m_Transform;
+    mutable std::vector<Collider> m_Collider;
+    mutable std::vector<uint8_t> m_Dirty;
+
+    SimSimd::SimdLevel m_SimdLevel = SimSimd::GetBestSimdLevel();
+};
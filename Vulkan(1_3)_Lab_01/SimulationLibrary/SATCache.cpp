@@ -0,0 +1,37 @@
+#include "SATCache.h"
+
+void SATCache::Prepare(RigidBodyHandle a, RigidBodyHandle b) {
+    m_Pairs.Acquire(a, b);
+}
+
+bool SATCache::Test(RigidBodyHandle a, RigidBodyHandle b, const SimCollision::OBB& A, const SimCollision::OBB& B, SimCollision::Contact& out) {
+    m_Lookups.fetch_add(1, std::memory_order_relaxed);
+
+    PairState& entry = m_Pairs.Acquire(a, b);
+
+    if (entry.axis != SimCollision::kNoSATAxis) {
+        m_CacheHits.fetch_add(1, std::memory_order_relaxed);
+        if (SimCollision::OBBSeparatedOnAxis(A, B, entry.axis)) {
+            m_EarlyOuts.fetch_add(1, std::memory_order_relaxed);
+            out = {};
+            return false;
+        }
+    }
+
+    return SimCollision::OBBVsOBB(A, B, out, entry.axis);
+}
+
+void SATCache::NextFrame() {
+    m_LastLookups = m_Lookups.exchange(0, std::memory_order_relaxed);
+    m_LastCacheHits = m_CacheHits.exchange(0, std::memory_order_relaxed);
+    m_LastEarlyOuts = m_EarlyOuts.exchange(0, std::memory_order_relaxed);
+    m_Pairs.NextFrame();
+}
+
+void SATCache::Clear() {
+    m_Pairs.Clear();
+    m_Lookups = 0;
+    m_CacheHits = 0;
+    m_EarlyOuts = 0;
+    m_LastLookups = m_LastCacheHits = m_LastEarlyOuts = 0;
+}
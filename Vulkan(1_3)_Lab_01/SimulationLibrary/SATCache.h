@@ -0,0 +1,40 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include "CollisionUtil.h"
+#include "PairCache.h"
+
+// Temporal-coherence cache for OBB-vs-OBB SAT tests, keyed by body handle pair.
+// Each entry remembers the axis that decided the last test (separating axis, or the
+// minimum-overlap axis if the boxes touched). That axis is checked first next tick and,
+// if it still separates the pair, the full 15-axis test is skipped.
+// Threading follows PairCache, with Prepare() as the single-threaded acquire.
+class SATCache {
+public:
+    bool Test(RigidBodyHandle a, RigidBodyHandle b, const SimCollision::OBB& A, const SimCollision::OBB& B, SimCollision::Contact& out);
+    void Prepare(RigidBodyHandle a, RigidBodyHandle b);
+
+    // Call once per tick; drops pairs that have not been tested for a while.
+    void NextFrame();
+    void Clear();
+
+    size_t GetEntryCount() const { return m_Pairs.GetEntryCount(); }
+    uint64_t GetLastLookups() const { return m_LastLookups; }
+    uint64_t GetLastCacheHits() const { return m_LastCacheHits; }
+    uint64_t GetLastEarlyOuts() const { return m_LastEarlyOuts; }
+
+private:
+    struct PairState {
+        int axis = SimCollision::kNoSATAxis;
+    };
+
+    // Ordered pairs: (a, b) and (b, a) use different axis numbering, so they are separate entries.
+    PairCache<PairState> m_Pairs;
+
+    std::atomic<uint64_t> m_Lookups{ 0 };
+    std::atomic<uint64_t> m_CacheHits{ 0 };
+    std::atomic<uint64_t> m_EarlyOuts{ 0 };
+    uint64_t m_LastLookups = 0;
+    uint64_t m_LastCacheHits = 0;
+    uint64_t m_LastEarlyOuts = 0;
+};
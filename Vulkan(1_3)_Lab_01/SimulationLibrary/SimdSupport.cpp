@@ -0,0 +1,57 @@
+#include "SimdSupport.h"
+
+#if SIM_HAS_X86 && defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+namespace SimSimd
+{
+    namespace
+    {
+#if SIM_HAS_X86
+        bool CpuSupportsAVX2()
+        {
+#ifdef _MSC_VER
+            int info[4] = {};
+            __cpuid(info, 0);
+            if (info[0] < 7) return false;
+
+            __cpuid(info, 1);
+            const bool osxsave = (info[2] & (1 << 27)) != 0;
+            const bool avx = (info[2] & (1 << 28)) != 0;
+            if (!osxsave || !avx) return false;
+
+            // OS must save YMM state
+            if ((_xgetbv(0) & 0x6) != 0x6) return false;
+
+            __cpuidex(info, 7, 0);
+            return (info[1] & (1 << 5)) != 0;
+#else
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2");
+#endif
+        }
+#endif
+    }
+
+    SimdLevel GetBestSimdLevel()
+    {
+#if SIM_HAS_X86
+        static const SimdLevel level = CpuSupportsAVX2() ? SimdLevel::AVX2 : SimdLevel::SSE2;
+        return level;
+#else
+        return SimdLevel::Scalar;
+#endif
+    }
+
+    const char* GetSimdLevelName(SimdLevel level)
+    {
+        switch (level) {
+        case SimdLevel::AVX2: return "AVX2 (8-wide)";
+        case SimdLevel::SSE2: return "SSE2 (4-wide)";
+        case SimdLevel::Scalar:
+        default: return "Scalar";
+        }
+    }
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+// x86 SIMD availability. Intrinsics headers are only included by the .cpp files that need them.
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define SIM_HAS_X86 1
+#else
+#define SIM_HAS_X86 0
+#endif
+
+// MSVC accepts AVX2 intrinsics anywhere; GCC/Clang need the function to opt in.
+#if defined(_MSC_VER)
+#define SIM_TARGET_AVX2
+#else
+#define SIM_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace SimSimd
+{
+    enum class SimdLevel {
+        Scalar = 0,
+        SSE2 = 1,
+        AVX2 = 2
+    };
+
+    // Highest level supported by both the build and the running CPU (queried once).
+    SimdLevel GetBestSimdLevel();
+    const char* GetSimdLevelName(SimdLevel level);
+}
@@ -0,0 +1,150 @@
+#include "SleepIslands.h"
+#include <algorithm>
+
+void SleepIslands::Begin(size_t bodyCount) {
+    m_Bodies.assign(bodyCount, Body{});
+    m_Parent.resize(bodyCount);
+    m_Rank.assign(bodyCount, 0);
+    for (uint32_t i = 0; i < static_cast<uint32_t>(bodyCount); ++i) m_Parent[i] = i;
+}
+
+void SleepIslands::SetBody(uint32_t index, SleepState* state, const glm::vec3& velocity, const glm::vec3& angularVelocity) {
+    Body& body = m_Bodies[index];
+    body.state = state;
+    body.linearSpeed2 = glm::dot(velocity, velocity);
+    body.angularSpeed2 = glm::dot(angularVelocity, angularVelocity);
+}
+
+uint32_t SleepIslands::Find(uint32_t index) {
+    // Path halving
+    while (m_Parent[index] != index) {
+        m_Parent[index] = m_Parent[m_Parent[index]];
+        index = m_Parent[index];
+    }
+    return index;
+}
+
+void SleepIslands::AddContact(uint32_t a, uint32_t b) {
+    uint32_t ra = Find(a);
+    uint32_t rb = Find(b);
+    if (ra == rb) return;
+
+    if (m_Rank[ra] < m_Rank[rb]) std::swap(ra, rb);
+    m_Parent[rb] = ra;
+    if (m_Rank[ra] == m_Rank[rb]) ++m_Rank[ra];
+}
+
+void SleepIslands::Wake(uint32_t index) {
+    SleepState& state = *m_Bodies[index].state;
+    if (state.asleep) m_WokenUp.push_back(index);
+    state.asleep = false;
+    state.timer = 0.0f;
+}
+
+void SleepIslands::WakeBody(SleepState& state) {
+    state.timer = 0.0f;
+    if (state.island != 0) m_PendingWakeIslands.push_back(state.island);
+    else state.asleep = false;
+}
+
+void SleepIslands::WakePendingIslands() {
+    if (m_PendingWakeIslands.empty()) return;
+
+    std::sort(m_PendingWakeIslands.begin(), m_PendingWakeIslands.end());
+    for (uint32_t i = 0; i < static_cast<uint32_t>(m_Bodies.size()); ++i) {
+        const uint32_t island = m_Bodies[i].state->island;
+        if (island != 0 && std::binary_search(m_PendingWakeIslands.begin(), m_PendingWakeIslands.end(), island)) Wake(i);
+    }
+    m_PendingWakeIslands.clear();
+}
+
+void SleepIslands::Update(float deltaTime) {
+    m_FellAsleep.clear();
+    m_WokenUp.clear();
+    m_IslandCount = 0;
+    m_SleepingCount = 0;
+
+    const uint32_t count = static_cast<uint32_t>(m_Bodies.size());
+
+    WakePendingIslands();
+
+    if (!m_Settings.enabled) {
+        for (uint32_t i = 0; i < count; ++i) Wake(i);
+        return;
+    }
+
+    const float linear2 = m_Settings.linearThreshold * m_Settings.linearThreshold;
+    const float angular2 = m_Settings.angularThreshold * m_Settings.angularThreshold;
+
+    m_IslandCanSleep.assign(count, 1);
+    m_IslandHasAwake.assign(count, 0);
+    m_IslandId.assign(count, 0);
+
+    for (uint32_t i = 0; i < count; ++i) {
+        const Body& body = m_Bodies[i];
+        SleepState& state = *body.state;
+        if (state.asleep) continue;
+
+        if (body.linearSpeed2 > linear2 || body.angularSpeed2 > angular2) state.timer = 0.0f;
+        else state.timer += deltaTime;
+
+        const uint32_t root = Find(i);
+        m_IslandHasAwake[root] = 1;
+        if (state.timer < m_Settings.timeToSleep) m_IslandCanSleep[root] = 0;
+    }
+
+    // Sleepers touched by a moving island wake up with everything they fell asleep with:
+    // contacts between two sleepers are not reported, so those would otherwise be left hanging.
+    for (uint32_t i = 0; i < count; ++i) {
+        const SleepState& state = *m_Bodies[i].state;
+        const uint32_t root = Find(i);
+        if (state.asleep && m_IslandHasAwake[root] && !m_IslandCanSleep[root]) m_PendingWakeIslands.push_back(state.island);
+    }
+    if (!m_PendingWakeIslands.empty()) {
+        const size_t firstWoken = m_WokenUp.size();
+        WakePendingIslands();
+        for (size_t k = firstWoken; k < m_WokenUp.size(); ++k) {
+            const uint32_t root = Find(m_WokenUp[k]);
+            m_IslandHasAwake[root] = 1;
+            m_IslandCanSleep[root] = 0;
+        }
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+        SleepState& state = *m_Bodies[i].state;
+        const uint32_t root = Find(i);
+
+        // Islands made only of sleepers keep their old ids so WakeBody() can still find them.
+        if (!m_IslandHasAwake[root]) {
+            if (state.asleep) ++m_SleepingCount;
+            continue;
+        }
+
+        if (m_IslandId[root] == 0) {
+            m_IslandId[root] = m_NextIslandId++;
+            if (m_NextIslandId == 0) m_NextIslandId = 1;
+            ++m_IslandCount;
+        }
+        state.island = m_IslandId[root];
+
+        if (m_IslandCanSleep[root]) {
+            if (!state.asleep) m_FellAsleep.push_back(i);
+            state.asleep = true;
+            ++m_SleepingCount;
+        }
+        else if (state.asleep) {
+            Wake(i);
+        }
+    }
+}
+
+void SleepIslands::Clear() {
+    m_Bodies.clear();
+    m_Parent.clear();
+    m_Rank.clear();
+    m_PendingWakeIslands.clear();
+    m_FellAsleep.clear();
+    m_WokenUp.clear();
+    m_IslandCount = 0;
+    m_SleepingCount = 0;
+}
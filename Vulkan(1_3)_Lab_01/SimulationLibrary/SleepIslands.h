@@ -0,0 +1,84 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+// Per-body sleep bookkeeping. Lives with the body (instance struct) so it survives the
+// caller re-numbering its bodies between ticks.
+struct SleepState {
+    float timer = 0.0f;      // time spent below the velocity thresholds
+    uint32_t island = 0;     // island id from the last tick that had an awake member (0 = none)
+    bool asleep = false;
+};
+
+// Island detection and sleeping.
+// Every tick the caller registers its dynamic bodies under dense indices, links the pairs
+// that touched, and calls Update(). Islands are the connected components of that contact
+// graph (union-find). An island falls asleep once every body in it has been below the
+// linear/angular thresholds for timeToSleep; if any member is still moving, sleeping
+// members it touched are woken. Static bodies must not be linked: they would merge
+// everything resting on the same floor into one island.
+class SleepIslands {
+public:
+    struct Settings {
+        bool enabled = true;
+        float linearThreshold = 0.08f;  // m/s
+        float angularThreshold = 0.1f;  // rad/s
+        float timeToSleep = 0.5f;       // seconds
+    };
+
+    Settings& GetSettings() { return m_Settings; }
+    const Settings& GetSettings() const { return m_Settings; }
+
+    // Starts a tick. Indices [0, bodyCount) must all be given a state with SetBody().
+    void Begin(size_t bodyCount);
+    void SetBody(uint32_t index, SleepState* state, const glm::vec3& velocity, const glm::vec3& angularVelocity);
+    void AddContact(uint32_t a, uint32_t b);
+
+    // Advances sleep timers and makes the per-island sleep/wake decision.
+    // Bodies whose state changed are listed in GetFellAsleep() / GetWokenUp().
+    void Update(float deltaTime);
+
+    // Wakes a body (e.g. it was moved by hand) together with the rest of its last island on the
+    // next Update(), so nothing is left hanging where it used to rest.
+    void WakeBody(SleepState& state);
+    void Clear();
+
+    const std::vector<uint32_t>& GetFellAsleep() const { return m_FellAsleep; }
+    const std::vector<uint32_t>& GetWokenUp() const { return m_WokenUp; }
+
+    // Islands with at least one awake body in the last Update()
+    uint32_t GetIslandCount() const { return m_IslandCount; }
+    uint32_t GetSleepingCount() const { return m_SleepingCount; }
+    size_t GetBodyCount() const { return m_Bodies.size(); }
+
+private:
+    struct Body {
+        SleepState* state = nullptr;
+        float linearSpeed2 = 0.0f;
+        float angularSpeed2 = 0.0f;
+    };
+
+    uint32_t Find(uint32_t index);
+    void Wake(uint32_t index);
+    void WakePendingIslands();
+
+    Settings m_Settings;
+
+    std::vector<Body> m_Bodies;
+    std::vector<uint32_t> m_Parent;
+    std::vector<uint32_t> m_Rank;
+    std::vector<uint32_t> m_PendingWakeIslands;
+
+    // Per-root scratch, indexed by the root's body index
+    std::vector<uint8_t> m_IslandCanSleep;
+    std::vector<uint8_t> m_IslandHasAwake;
+    std::vector<uint32_t> m_IslandId;
+
+    std::vector<uint32_t> m_FellAsleep;
+    std::vector<uint32_t> m_WokenUp;
+
+    uint32_t m_NextIslandId = 1;
+    uint32_t m_IslandCount = 0;
+    uint32_t m_SleepingCount = 0;
+};
@@ -0,0 +1,156 @@
+#include "StaticWorld.h"
+
+#if SIM_HAS_X86
+#include <immintrin.h>
+#endif
+
+void StaticWorld::Clear() {
+    m_PlaneNX.clear();
+    m_PlaneNY.clear();
+    m_PlaneNZ.clear();
+    m_PlaneD.clear();
+    m_PlaneUserData.clear();
+
+    m_Shapes.clear();
+    m_CellStart.clear();
+    m_CellItems.clear();
+    m_Dims = glm::ivec3(0);
+    m_Built = false;
+}
+
+uint32_t StaticWorld::AddPlane(const glm::vec3& normal, const glm::vec3& point, uint32_t userData) {
+    const uint32_t index = static_cast<uint32_t>(m_PlaneUserData.size());
+    if (index % kPlaneGroup == 0) {
+        // Padding planes: n = 0, d = -max, so the separation is always huge and positive.
+        const size_t padded = index + kPlaneGroup;
+        m_PlaneNX.resize(padded, 0.0f);
+        m_PlaneNY.resize(padded, 0.0f);
+        m_PlaneNZ.resize(padded, 0.0f);
+        m_PlaneD.resize(padded, -std::numeric_limits<float>::max());
+    }
+
+    m_PlaneUserData.push_back(userData);
+    SetPlane(index, normal, point);
+    return index;
+}
+
+void StaticWorld::SetPlane(uint32_t index, const glm::vec3& normal, const glm::vec3& point) {
+    const glm::vec3 n = SimCollision::SafeNormalize(normal, { 0,1,0 });
+    m_PlaneNX[index] = n.x;
+    m_PlaneNY[index] = n.y;
+    m_PlaneNZ[index] = n.z;
+    m_PlaneD[index] = glm::dot(n, point);
+}
+
+uint32_t StaticWorld::AddShape(const SimCollision::AABB& bounds, uint32_t userData) {
+    Shape shape{};
+    shape.bounds = bounds;
+    shape.userData = userData;
+    m_Shapes.push_back(shape);
+    m_Built = false;
+    return static_cast<uint32_t>(m_Shapes.size() - 1);
+}
+
+glm::ivec3 StaticWorld::CellOf(const glm::vec3& p) const {
+    // Clamped in float first so far-away or infinite bounds cannot overflow the int conversion.
+    const glm::vec3 cell = glm::floor((p - m_Origin) / m_CellSize);
+    const glm::vec3 clamped = glm::clamp(cell, glm::vec3(-1.0f), glm::vec3(m_Dims));
+    return glm::ivec3(clamped);
+}
+
+void StaticWorld::Build() {
+    m_CellStart.clear();
+    m_CellItems.clear();
+    m_Dims = glm::ivec3(0);
+    m_Built = true;
+    if (m_Shapes.empty()) return;
+
+    SimCollision::AABB world = m_Shapes[0].bounds;
+    float extentSum = 0.0f;
+    for (const Shape& shape : m_Shapes) {
+        world.min = glm::min(world.min, shape.bounds.min);
+        world.max = glm::max(world.max, shape.bounds.max);
+        const glm::vec3 size = shape.bounds.max - shape.bounds.min;
+        extentSum += std::max({ size.x, size.y, size.z });
+    }
+
+    // Cells about twice the average shape, so most shapes land in one to eight cells.
+    m_CellSize = m_Settings.cellSize > 0.0f ? m_Settings.cellSize : std::max(2.0f * extentSum / static_cast<float>(m_Shapes.size()), 1e-3f);
+    const glm::vec3 worldSize = world.max - world.min;
+    for (;;) {
+        m_Dims = glm::max(glm::ivec3(glm::ceil(worldSize / m_CellSize)), glm::ivec3(1));
+        const uint64_t cells = static_cast<uint64_t>(m_Dims.x) * m_Dims.y * m_Dims.z;
+        if (cells <= std::max(m_Settings.maxCells, 1u)) break;
+        m_CellSize *= 2.0f;
+    }
+    m_Origin = world.min;
+
+    const uint32_t cellCount = static_cast<uint32_t>(m_Dims.x * m_Dims.y * m_Dims.z);
+    auto forEachCell = [&](const Shape& shape, auto&& fn)
+    {
+        const glm::ivec3 lo = glm::max(CellOf(shape.bounds.min), glm::ivec3(0));
+        const glm::ivec3 hi = glm::min(CellOf(shape.bounds.max), m_Dims - 1);
+        for (int z = lo.z; z <= hi.z; ++z)
+            for (int y = lo.y; y <= hi.y; ++y)
+                for (int x = lo.x; x <= hi.x; ++x)
+                    fn(static_cast<uint32_t>((z * m_Dims.y + y) * m_Dims.x + x));
+    };
+
+    // Counting pass, prefix sum, fill pass.
+    m_CellStart.assign(cellCount + 1, 0);
+    for (Shape& shape : m_Shapes) {
+        shape.minCell = glm::max(CellOf(shape.bounds.min), glm::ivec3(0));
+        forEachCell(shape, [&](uint32_t cell) { ++m_CellStart[cell + 1]; });
+    }
+    for (uint32_t c = 0; c < cellCount; ++c) m_CellStart[c + 1] += m_CellStart[c];
+
+    m_CellItems.resize(m_CellStart[cellCount]);
+    std::vector<uint32_t> cursor(m_CellStart.begin(), m_CellStart.end() - 1);
+    for (uint32_t i = 0; i < static_cast<uint32_t>(m_Shapes.size()); ++i) {
+        forEachCell(m_Shapes[i], [&](uint32_t cell) { m_CellItems[cursor[cell]++] = i; });
+    }
+}
+
+uint64_t StaticWorld::TouchedPlanes(uint32_t first, const glm::vec3& center, const glm::vec3& halfExtents, float radius) const {
+    // separation = dot(n, c) - d - dot(|n|, e) - r; the query touches the plane when <= 0.
+    const float* nx = m_PlaneNX.data() + first;
+    const float* ny = m_PlaneNY.data() + first;
+    const float* nz = m_PlaneNZ.data() + first;
+    const float* d = m_PlaneD.data() + first;
+    const uint32_t count = std::min<uint32_t>(kPlaneGroup, static_cast<uint32_t>(m_PlaneUserData.size()) - first);
+
+    uint64_t mask = 0;
+#if SIM_HAS_X86
+    const __m128 cx = _mm_set1_ps(center.x), cy = _mm_set1_ps(center.y), cz = _mm_set1_ps(center.z);
+    const __m128 ex = _mm_set1_ps(halfExtents.x), ey = _mm_set1_ps(halfExtents.y), ez = _mm_set1_ps(halfExtents.z);
+    const __m128 r = _mm_set1_ps(radius);
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+    const __m128 zero = _mm_setzero_ps();
+
+    // Arrays are padded to kPlaneGroup, so whole groups of four are always readable.
+    for (uint32_t i = 0; i < count; i += 4) {
+        const __m128 x = _mm_loadu_ps(nx + i);
+        const __m128 y = _mm_loadu_ps(ny + i);
+        const __m128 z = _mm_loadu_ps(nz + i);
+
+        const __m128 dist = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, cx), _mm_mul_ps(y, cy)), _mm_mul_ps(z, cz)), _mm_loadu_ps(d + i));
+        const __m128 reach = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+            _mm_mul_ps(_mm_andnot_ps(signBit, x), ex),
+            _mm_mul_ps(_mm_andnot_ps(signBit, y), ey)),
+            _mm_mul_ps(_mm_andnot_ps(signBit, z), ez)), r);
+
+        const int touched = _mm_movemask_ps(_mm_cmple_ps(_mm_sub_ps(dist, reach), zero));
+        mask |= static_cast<uint64_t>(touched) << i;
+    }
+#else
+    for (uint32_t i = 0; i < count; ++i) {
+        const float dist = nx[i] * center.x + ny[i] * center.y + nz[i] * center.z - d[i];
+        const float reach = std::abs(nx[i]) * halfExtents.x + std::abs(ny[i]) * halfExtents.y + std::abs(nz[i]) * halfExtents.z + radius;
+        if (dist - reach <= 0.0f) mask |= 1ull << i;
+    }
+#endif
+
+    // Padding lanes never touch, but a group of four can straddle the real count.
+    if (count < kPlaneGroup) mask &= (1ull << count) - 1;
+    return mask;
+}
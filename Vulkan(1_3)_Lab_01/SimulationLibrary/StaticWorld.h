@@ -0,0 +1,135 @@
+#pragma once
+#include <bit>
+#include <cstdint>
+#include <vector>
+#include "CollisionUtil.h"
+
+// Prebuilt index of the geometry that never moves, built once per scene/preset load and then
+// queried by every dynamic body each tick.
+// Planes are stored as half-space arrays (n and d, with dot(n, p) = d on the surface) padded to
+// whole SIMD groups, so a query tests every plane in a handful of vector instructions.
+// Bounded shapes are binned into a uniform grid over their combined bounds; a query only visits
+// the cells its AABB covers, so its cost does not depend on how many obstacles the scene has.
+// Queries keep no scratch state and may run on several threads at once.
+class StaticWorld {
+public:
+    struct Settings {
+        float cellSize = 0.0f;         // 0 = twice the average shape extent
+        uint32_t maxCells = 1u << 18;  // the cell size grows until the grid fits
+    };
+
+    Settings& GetSettings() { return m_Settings; }
+    const Settings& GetSettings() const { return m_Settings; }
+
+    void Clear();
+
+    // Return the plane / shape index. Planes are live at once; shapes only after Build().
+    uint32_t AddPlane(const glm::vec3& normal, const glm::vec3& point, uint32_t userData);
+    uint32_t AddShape(const SimCollision::AABB& bounds, uint32_t userData);
+
+    // Moves a plane in place (no rebuild needed; planes are not in the grid).
+    void SetPlane(uint32_t index, const glm::vec3& normal, const glm::vec3& point);
+
+    void Build();
+    bool IsBuilt() const { return m_Built; }
+
+    // Calls callback(userData) for every plane whose back half-space 'bounds' reaches, then for
+    // every shape whose bounds overlap 'bounds'. Planes come in insertion order, each shape once.
+    template <typename Callback>
+    void Query(const SimCollision::AABB& bounds, Callback&& callback) const;
+
+    // Same, but planes are tested against the sphere itself (exactly the SphereVsPlane condition).
+    template <typename Callback>
+    void QuerySphere(const glm::vec3& center, float radius, Callback&& callback) const;
+
+    size_t GetPlaneCount() const { return m_PlaneUserData.size(); }
+    size_t GetShapeCount() const { return m_Shapes.size(); }
+    size_t GetCellCount() const { return m_CellStart.empty() ? 0 : m_CellStart.size() - 1; }
+    glm::ivec3 GetGridDimensions() const { return m_Dims; }
+    float GetCellSize() const { return m_CellSize; }
+
+private:
+    static constexpr uint32_t kPlaneGroup = 64; // planes per mask word
+
+    struct Shape {
+        SimCollision::AABB bounds{};
+        glm::ivec3 minCell{ 0 };
+        uint32_t userData = 0;
+    };
+
+    // Bit i is set when plane (first + i) is touched by a box of half extents 'halfExtents'
+    // grown by 'radius' around 'center'. 'first' is a multiple of kPlaneGroup.
+    uint64_t TouchedPlanes(uint32_t first, const glm::vec3& center, const glm::vec3& halfExtents, float radius) const;
+
+    template <typename Callback>
+    void QueryPlanes(const glm::vec3& center, const glm::vec3& halfExtents, float radius, Callback&& callback) const;
+
+    template <typename Callback>
+    void QueryShapes(const SimCollision::AABB& bounds, Callback&& callback) const;
+
+    glm::ivec3 CellOf(const glm::vec3& p) const;
+
+    Settings m_Settings;
+
+    // Planes, SoA. Padded to a multiple of kPlaneGroup with planes nothing can touch.
+    std::vector<float> m_PlaneNX, m_PlaneNY, m_PlaneNZ, m_PlaneD;
+    std::vector<uint32_t> m_PlaneUserData;
+
+    // Grid, CSR layout: shapes of cell c are m_CellItems[m_CellStart[c] .. m_CellStart[c + 1]).
+    std::vector<Shape> m_Shapes;
+    std::vector<uint32_t> m_CellStart;
+    std::vector<uint32_t> m_CellItems;
+    glm::vec3 m_Origin{ 0.0f };
+    glm::ivec3 m_Dims{ 0 };
+    float m_CellSize = 1.0f;
+    bool m_Built = false;
+};
+
+template <typename Callback>
+void StaticWorld::Query(const SimCollision::AABB& bounds, Callback&& callback) const {
+    QueryPlanes((bounds.min + bounds.max) * 0.5f, (bounds.max - bounds.min) * 0.5f, 0.0f, callback);
+    QueryShapes(bounds, callback);
+}
+
+template <typename Callback>
+void StaticWorld::QuerySphere(const glm::vec3& center, float radius, Callback&& callback) const {
+    QueryPlanes(center, glm::vec3(0.0f), radius, callback);
+    QueryShapes(SimCollision::SphereBounds(center, radius), callback);
+}
+
+template <typename Callback>
+void StaticWorld::QueryPlanes(const glm::vec3& center, const glm::vec3& halfExtents, float radius, Callback&& callback) const {
+    const uint32_t planeCount = static_cast<uint32_t>(m_PlaneUserData.size());
+    for (uint32_t first = 0; first < planeCount; first += kPlaneGroup) {
+        uint64_t mask = TouchedPlanes(first, center, halfExtents, radius);
+        while (mask) {
+            const uint32_t bit = static_cast<uint32_t>(std::countr_zero(mask));
+            mask &= mask - 1;
+            callback(m_PlaneUserData[first + bit]);
+        }
+    }
+}
+
+template <typename Callback>
+void StaticWorld::QueryShapes(const SimCollision::AABB& bounds, Callback&& callback) const {
+    if (!m_Built || m_Shapes.empty()) return;
+
+    const glm::ivec3 lo = glm::max(CellOf(bounds.min), glm::ivec3(0));
+    const glm::ivec3 hi = glm::min(CellOf(bounds.max), m_Dims - 1);
+    if (lo.x > hi.x || lo.y > hi.y || lo.z > hi.z) return;
+
+    for (int z = lo.z; z <= hi.z; ++z) {
+        for (int y = lo.y; y <= hi.y; ++y) {
+            for (int x = lo.x; x <= hi.x; ++x) {
+                const uint32_t cell = static_cast<uint32_t>((z * m_Dims.y + y) * m_Dims.x + x);
+                for (uint32_t k = m_CellStart[cell]; k < m_CellStart[cell + 1]; ++k) {
+                    const Shape& shape = m_Shapes[m_CellItems[k]];
+                    // A shape spanning several cells is reported from the first one this query visits.
+                    const glm::ivec3 first = glm::max(shape.minCell, lo);
+                    if (first.x != x || first.y != y || first.z != z) continue;
+                    if (SimCollision::AABBOverlap(shape.bounds, bounds)) callback(shape.userData);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,97 @@
+#include "StepController.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    constexpr float kDilationSmoothing = 0.1f;
+}
+
+void StepController::BeginTick(float& accumulator, float elapsed, float timeStep) {
+    m_TickRequested = elapsed;
+    m_TickDropped = 0.0f;
+    m_TickUpdates = 0;
+    m_TickSubsteps = 0;
+    m_TickFixedSteps = 0;
+
+    accumulator += elapsed;
+
+    const float cap = static_cast<float>(std::max(m_Settings.maxCatchUpSteps, 1u)) * timeStep;
+    if (accumulator > cap) {
+        Drop(accumulator - cap);
+        accumulator = cap;
+    }
+}
+
+StepController::Plan StepController::PlanUpdate(const StepActivity& activity, float timeStep) const {
+    Plan plan;
+    plan.substepDt = timeStep;
+    if (!m_Settings.adaptive || !activity.valid) return plan;
+
+    // Substeps keep the fastest body under the travel limit and react to deep overlaps.
+    const float travel = activity.maxSpeed * timeStep;
+    const float maxTravel = std::max(m_Settings.maxTravelPerStep, 1e-4f);
+    uint32_t substeps = static_cast<uint32_t>(std::ceil(travel / maxTravel));
+    if (m_Settings.penetrationPerSubstep > 0.0f) {
+        substeps = std::max(substeps, 1u + static_cast<uint32_t>(activity.maxPenetration / m_Settings.penetrationPerSubstep));
+    }
+    substeps = std::clamp(substeps, 1u, std::max(m_Settings.maxSubsteps, 1u));
+
+    if (substeps > 1) {
+        plan.substeps = substeps;
+        plan.substepDt = timeStep / static_cast<float>(substeps);
+        return plan;
+    }
+
+    // Calm: merge fixed steps while the merged step still respects the travel limit and nothing
+    // is sinking into static geometry.
+    if (activity.maxPenetration <= 0.5f * m_Settings.penetrationPerSubstep) {
+        const uint32_t byTravel = travel > 0.0f ? static_cast<uint32_t>(maxTravel / travel) : m_Settings.maxCoarseSteps;
+        plan.fixedSteps = std::clamp(byTravel, 1u, std::max(m_Settings.maxCoarseSteps, 1u));
+        plan.substepDt = timeStep * static_cast<float>(plan.fixedSteps);
+    }
+    return plan;
+}
+
+bool StepController::EndUpdate(const Plan& plan, float& accumulator, float timeStep, float elapsedMs) {
+    accumulator -= static_cast<float>(plan.fixedSteps) * timeStep;
+    ++m_TickUpdates;
+    m_TickSubsteps = std::max(m_TickSubsteps, plan.substeps);
+    m_TickFixedSteps = std::max(m_TickFixedSteps, plan.fixedSteps);
+
+    if (m_Settings.updateBudgetMs <= 0.0f || elapsedMs < m_Settings.updateBudgetMs) return true;
+
+    // Out of budget: keep the fraction of a step, drop the rest.
+    if (accumulator >= timeStep) {
+        const float keep = std::fmod(accumulator, timeStep);
+        Drop(accumulator - keep);
+        accumulator = keep;
+    }
+    return false;
+}
+
+void StepController::EndTick() {
+    if (m_TickUpdates > 0) {
+        m_LastSubsteps = m_TickSubsteps;
+        m_LastFixedSteps = m_TickFixedSteps;
+    }
+    m_LastUpdates = m_TickUpdates;
+
+    if (m_TickRequested > 0.0f) {
+        const float ratio = 1.0f - std::min(m_TickDropped / m_TickRequested, 1.0f);
+        m_TimeDilation += (ratio - m_TimeDilation) * kDilationSmoothing;
+    }
+}
+
+void StepController::Reset() {
+    m_LastSubsteps = 1;
+    m_LastFixedSteps = 1;
+    m_LastUpdates = 0;
+    m_DroppedTime = 0.0;
+    m_TimeDilation = 1.0f;
+}
+
+void StepController::Drop(float seconds) {
+    m_TickDropped += seconds;
+    m_DroppedTime += seconds;
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <cstdint>
+
+// What a scenario reports about its current state so the step controller can size the next step.
+struct StepActivity {
+    bool valid = false;           // false: no hints, every update is one fixed step
+    float maxSpeed = 0.0f;        // fastest simulated body, m/s
+    float maxPenetration = 0.0f;  // deepest overlap with static geometry, m
+};
+
+// Decides how the simulation worker spends its accumulated time.
+// Each update consumes one fixed step split into substeps when bodies move fast or sink into
+// static geometry, or several fixed steps merged into one coarse update when the scene is calm.
+// Coarse updates may run the clock up to (maxCoarseSteps - 1) steps ahead; the accumulator then
+// goes negative and the worker idles until real time catches up.
+// Catch-up is bounded: the backlog is capped at maxCatchUpSteps per worker wake and whatever is
+// left when the wall-clock budget runs out is dropped, so an overloaded peer slows down
+// (time dilation) instead of falling further and further behind.
+class StepController {
+public:
+    struct Settings {
+        bool adaptive = true;
+        uint32_t maxSubsteps = 4;
+        uint32_t maxCoarseSteps = 2;
+        float maxTravelPerStep = 0.2f;       // fastest body should move at most this far per update, m
+        float penetrationPerSubstep = 0.05f; // every multiple of this depth adds a substep, m
+        uint32_t maxCatchUpSteps = 4;        // backlog kept per wake, in fixed steps
+        float updateBudgetMs = 12.0f;        // wall-clock budget per wake; 0 disables it
+    };
+
+    struct Plan {
+        uint32_t fixedSteps = 1; // fixed steps consumed by this update
+        uint32_t substeps = 1;   // OnUpdate() calls the update is split into
+        float substepDt = 0.0f;
+    };
+
+    Settings& GetSettings() { return m_Settings; }
+    const Settings& GetSettings() const { return m_Settings; }
+
+    // Starts a worker wake: adds the elapsed scaled time and trims the backlog to the cap.
+    void BeginTick(float& accumulator, float elapsed, float timeStep);
+    Plan PlanUpdate(const StepActivity& activity, float timeStep) const;
+    // Records a finished update; returns false once the wake's budget is spent, after dropping
+    // whatever whole steps are still queued.
+    bool EndUpdate(const Plan& plan, float& accumulator, float timeStep, float elapsedMs);
+    void EndTick();
+    void Reset();
+
+    // Stats for the last wake that ran an update
+    uint32_t GetLastSubsteps() const { return m_LastSubsteps; }
+    uint32_t GetLastFixedSteps() const { return m_LastFixedSteps; }
+    uint32_t GetLastUpdateCount() const { return m_LastUpdates; }
+    double GetDroppedTime() const { return m_DroppedTime; }  // seconds of sim time dropped, total
+    float GetTimeDilation() const { return m_TimeDilation; } // simulated / requested time, smoothed
+
+private:
+    void Drop(float seconds);
+
+    Settings m_Settings;
+
+    float m_TickRequested = 0.0f;
+    float m_TickDropped = 0.0f;
+    uint32_t m_TickUpdates = 0;
+    uint32_t m_TickSubsteps = 0;
+    uint32_t m_TickFixedSteps = 0;
+
+    uint32_t m_LastSubsteps = 1;
+    uint32_t m_LastFixedSteps = 1;
+    uint32_t m_LastUpdates = 0;
+    double m_DroppedTime = 0.0;
+    float m_TimeDilation = 1.0f;
+};
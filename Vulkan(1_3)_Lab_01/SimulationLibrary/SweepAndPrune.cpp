@@ -0,0 +1,138 @@
+#include "SweepAndPrune.h"
+#include <algorithm>
+
+uint32_t SweepAndPrune::CreateProxy(const SimCollision::AABB& bounds, uint32_t userData) {
+    uint32_t id;
+    if (!m_FreeProxies.empty()) {
+        id = m_FreeProxies.back();
+        m_FreeProxies.pop_back();
+    }
+    else {
+        id = static_cast<uint32_t>(m_Proxies.size());
+        m_Proxies.emplace_back();
+    }
+
+    Proxy& p = m_Proxies[id];
+    p.bounds = bounds;
+    p.userData = userData;
+    p.alive = true;
+
+    // Appended unsorted; the next FindPairs() insertion sort moves it into place.
+    m_Entries.push_back({ bounds.min[m_Axis], bounds.max[m_Axis], id });
+    return id;
+}
+
+void SweepAndPrune::DestroyProxy(uint32_t proxy) {
+    if (proxy >= m_Proxies.size() || !m_Proxies[proxy].alive) return;
+    // The id is only reused after FindPairs() drops its entry; reusing it now would leave the
+    // stale entry alive again and put the proxy on the axis twice.
+    m_Proxies[proxy].alive = false;
+    m_PendingFree.push_back(proxy);
+    m_NeedsCompact = true;
+}
+
+void SweepAndPrune::UpdateProxy(uint32_t proxy, const SimCollision::AABB& bounds) {
+    if (proxy >= m_Proxies.size() || !m_Proxies[proxy].alive) return;
+    m_Proxies[proxy].bounds = bounds;
+}
+
+void SweepAndPrune::Clear() {
+    m_Proxies.clear();
+    m_FreeProxies.clear();
+    m_PendingFree.clear();
+    m_Entries.clear();
+    m_NeedsCompact = false;
+    m_LastSwaps = 0;
+}
+
+int SweepAndPrune::ChooseAxis() const {
+    if (m_Entries.size() < 2) return m_Axis;
+
+    glm::vec3 sum(0.0f), sum2(0.0f);
+    for (const Entry& e : m_Entries) {
+        const SimCollision::AABB& b = m_Proxies[e.proxy].bounds;
+        const glm::vec3 c = (b.min + b.max) * 0.5f;
+        sum += c;
+        sum2 += c * c;
+    }
+
+    const float n = static_cast<float>(m_Entries.size());
+    const glm::vec3 variance = sum2 / n - (sum / n) * (sum / n);
+
+    // Small hysteresis so the axis does not flip every frame (each flip costs a full sort).
+    int best = m_Axis;
+    for (int axis = 0; axis < 3; ++axis) {
+        if (variance[axis] > variance[best] * 1.2f) best = axis;
+    }
+    return best;
+}
+
+void SweepAndPrune::RefreshKeys() {
+    for (Entry& e : m_Entries) {
+        const SimCollision::AABB& b = m_Proxies[e.proxy].bounds;
+        e.min = b.min[m_Axis];
+        e.max = b.max[m_Axis];
+    }
+}
+
+void SweepAndPrune::FindPairs(std::vector<Pair>& outPairs) {
+    outPairs.clear();
+    m_LastSwaps = 0;
+
+    if (m_NeedsCompact) {
+        m_Entries.erase(std::remove_if(m_Entries.begin(), m_Entries.end(),
+            [this](const Entry& e) { return !m_Proxies[e.proxy].alive; }), m_Entries.end());
+        m_FreeProxies.insert(m_FreeProxies.end(), m_PendingFree.begin(), m_PendingFree.end());
+        m_PendingFree.clear();
+        m_NeedsCompact = false;
+    }
+
+    const int axis = ChooseAxis();
+    const bool axisChanged = (axis != m_Axis);
+    m_Axis = axis;
+    RefreshKeys();
+
+    auto byMin = [](const Entry& a, const Entry& b) { return a.min < b.min; };
+
+    if (axisChanged) {
+        std::sort(m_Entries.begin(), m_Entries.end(), byMin);
+    }
+    else {
+        for (size_t i = 1; i < m_Entries.size(); ++i) {
+            const Entry key = m_Entries[i];
+            size_t j = i;
+            while (j > 0 && byMin(key, m_Entries[j - 1])) {
+                m_Entries[j] = m_Entries[j - 1];
+                --j;
+                ++m_LastSwaps;
+            }
+            m_Entries[j] = key;
+        }
+    }
+
+    const int axisB = (m_Axis + 1) % 3;
+    const int axisC = (m_Axis + 2) % 3;
+
+    for (size_t i = 0; i < m_Entries.size(); ++i) {
+        const Entry& ei = m_Entries[i];
+        const Proxy& pi = m_Proxies[ei.proxy];
+
+        for (size_t j = i + 1; j < m_Entries.size(); ++j) {
+            const Entry& ej = m_Entries[j];
+            if (ej.min > ei.max) break;
+
+            const Proxy& pj = m_Proxies[ej.proxy];
+            if (pi.bounds.min[axisB] > pj.bounds.max[axisB] || pi.bounds.max[axisB] < pj.bounds.min[axisB]) continue;
+            if (pi.bounds.min[axisC] > pj.bounds.max[axisC] || pi.bounds.max[axisC] < pj.bounds.min[axisC]) continue;
+
+            Pair pair;
+            pair.a = std::min(pi.userData, pj.userData);
+            pair.b = std::max(pi.userData, pj.userData);
+            outPairs.push_back(pair);
+        }
+    }
+
+    std::sort(outPairs.begin(), outPairs.end(), [](const Pair& x, const Pair& y) {
+        return x.a != y.a ? x.a < y.a : x.b < y.b;
+    });
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "CollisionUtil.h"
+
+// Incremental sort-and-sweep broadphase.
+// Proxies keep their intervals sorted by min along one axis (the axis with the largest
+// spread of centers). Between frames bodies move only a little, so the list is repaired
+// with an insertion sort, which is close to O(n) for nearly sorted input.
+class SweepAndPrune {
+public:
+    static constexpr uint32_t kInvalidProxy = 0xFFFFFFFFu;
+
+    using Pair = SimCollision::BroadphasePair;
+
+    uint32_t CreateProxy(const SimCollision::AABB& bounds, uint32_t userData);
+    void DestroyProxy(uint32_t proxy);
+    void UpdateProxy(uint32_t proxy, const SimCollision::AABB& bounds);
+    void Clear();
+
+    // Re-sorts and sweeps; overlapping pairs are written to outPairs ordered by (a, b)
+    // so the narrowphase visits them in the same order on every peer.
+    void FindPairs(std::vector<Pair>& outPairs);
+
+    size_t GetProxyCount() const { return m_Entries.size(); }
+    int GetSweepAxis() const { return m_Axis; }
+    uint64_t GetLastSwapCount() const { return m_LastSwaps; }
+
+private:
+    struct Proxy {
+        SimCollision::AABB bounds{};
+        uint32_t userData = 0;
+        bool alive = false;
+    };
+
+    struct Entry {
+        float min = 0.0f;
+        float max = 0.0f;
+        uint32_t proxy = kInvalidProxy;
+    };
+
+    int ChooseAxis() const;
+    void RefreshKeys();
+
+    std::vector<Proxy> m_Proxies;
+    std::vector<uint32_t> m_FreeProxies;
+    std::vector<uint32_t> m_PendingFree; // destroyed ids whose entries are not compacted out yet
+    std::vector<Entry> m_Entries;
+
+    int m_Axis = 0;
+    bool m_NeedsCompact = false;
+    uint64_t m_LastSwaps = 0;
+};
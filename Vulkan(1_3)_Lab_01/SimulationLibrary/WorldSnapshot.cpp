@@ -0,0 +1,60 @@
+#include "WorldSnapshot.h"
+#include <algorithm>
+
+uint8_t* WorldSnapshot::Grow(size_t bytes) {
+    const size_t offset = m_Bytes.size();
+    m_Bytes.resize(offset + bytes);
+    return m_Bytes.data() + offset;
+}
+
+const uint8_t* WorldSnapshot::Reader::Skip(size_t bytes) {
+    const auto& data = m_Snapshot->m_Bytes;
+    if (bytes > data.size() - m_Offset) return nullptr;
+    const uint8_t* start = data.data() + m_Offset;
+    m_Offset += bytes;
+    return start;
+}
+
+void SnapshotRing::SetCapacity(size_t capacity) {
+    m_Slots.resize(capacity);
+    m_Newest = 0;
+    m_Count = 0;
+}
+
+WorldSnapshot& SnapshotRing::Push(uint32_t tick) {
+    if (m_Slots.empty()) m_Slots.resize(1);
+
+    m_Newest = m_Count == 0 ? 0 : (m_Newest + 1) % m_Slots.size();
+    m_Count = std::min(m_Count + 1, m_Slots.size());
+
+    WorldSnapshot& snapshot = m_Slots[m_Newest];
+    snapshot.Clear();
+    snapshot.SetTick(tick);
+    return snapshot;
+}
+
+const WorldSnapshot* SnapshotRing::GetNewest(size_t age) const {
+    if (age >= m_Count) return nullptr;
+    return &m_Slots[(m_Newest + m_Slots.size() - age) % m_Slots.size()];
+}
+
+const WorldSnapshot* SnapshotRing::FindAtOrBefore(uint32_t tick) const {
+    for (size_t age = 0; age < m_Count; ++age) {
+        const WorldSnapshot* snapshot = GetNewest(age);
+        if (snapshot->GetTick() <= tick) return snapshot;
+    }
+    return nullptr;
+}
+
+void SnapshotRing::DiscardAfter(uint32_t tick) {
+    while (m_Count > 0 && GetNewest()->GetTick() > tick) {
+        m_Newest = (m_Newest + m_Slots.size() - 1) % m_Slots.size();
+        --m_Count;
+    }
+}
+
+size_t SnapshotRing::GetByteSize() const {
+    size_t bytes = 0;
+    for (size_t age = 0; age < m_Count; ++age) bytes += GetNewest(age)->GetByteSize();
+    return bytes;
+}
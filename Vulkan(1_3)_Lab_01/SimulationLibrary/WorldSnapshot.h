@@ -0,0 +1,113 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+// Flat binary copy of a simulation's dynamic state, for save/restore and rollback.
+// Values and whole arrays are appended with memcpy and read back in the same order, so saving
+// and restoring cost about as much as copying the bytes. Nothing is versioned or endian-swapped:
+// a snapshot is only meant to be restored by the build (and the scene) that took it.
+// Clear() keeps the buffer's capacity, so a snapshot reused every tick stops allocating once it
+// has seen the largest state.
+class WorldSnapshot {
+public:
+    class Reader {
+    public:
+        explicit Reader(const WorldSnapshot& snapshot) : m_Snapshot(&snapshot) {}
+
+        template <typename T>
+        bool Read(T& out);
+        template <typename T>
+        bool ReadArray(T* out, size_t count);
+        // Advances past 'bytes' bytes and returns where they start (no copy); nullptr past the end.
+        const uint8_t* Skip(size_t bytes);
+
+        size_t GetRemaining() const { return m_Snapshot->m_Bytes.size() - m_Offset; }
+        bool AtEnd() const { return GetRemaining() == 0; }
+
+    private:
+        const WorldSnapshot* m_Snapshot;
+        size_t m_Offset = 0;
+    };
+
+    void Clear() { m_Bytes.clear(); m_Tick = 0; }
+
+    template <typename T>
+    void Write(const T& value);
+    template <typename T>
+    void WriteArray(const T* data, size_t count);
+    template <typename T>
+    void WriteArray(const std::vector<T>& values) { WriteArray(values.data(), values.size()); }
+
+    // Update the state was taken after; set by whoever owns the snapshot.
+    uint32_t GetTick() const { return m_Tick; }
+    void SetTick(uint32_t tick) { m_Tick = tick; }
+
+    bool IsEmpty() const { return m_Bytes.empty(); }
+    size_t GetByteSize() const { return m_Bytes.size(); }
+    const uint8_t* GetData() const { return m_Bytes.data(); }
+
+private:
+    uint8_t* Grow(size_t bytes);
+
+    std::vector<uint8_t> m_Bytes;
+    uint32_t m_Tick = 0;
+};
+
+// The last N snapshots, oldest overwritten first. Push() hands out a cleared buffer to fill, so a
+// ring captured every tick reuses the same N allocations.
+class SnapshotRing {
+public:
+    explicit SnapshotRing(size_t capacity = 0) { SetCapacity(capacity); }
+
+    // Drops every snapshot.
+    void SetCapacity(size_t capacity);
+    size_t GetCapacity() const { return m_Slots.size(); }
+    size_t GetCount() const { return m_Count; }
+    void Clear() { m_Count = 0; }
+
+    // Buffer for a new snapshot of 'tick', replacing the oldest when full. Ticks must not go
+    // backwards; after a rollback, DiscardAfter() the restored tick first.
+    WorldSnapshot& Push(uint32_t tick);
+
+    // age 0 = newest. nullptr when there are not that many snapshots.
+    const WorldSnapshot* GetNewest(size_t age = 0) const;
+    // Newest snapshot taken at or before 'tick'.
+    const WorldSnapshot* FindAtOrBefore(uint32_t tick) const;
+    // Forgets snapshots newer than 'tick' (a future that a rollback abandoned).
+    void DiscardAfter(uint32_t tick);
+
+    size_t GetByteSize() const;
+
+private:
+    std::vector<WorldSnapshot> m_Slots;
+    size_t m_Newest = 0; // slot of the newest snapshot
+    size_t m_Count = 0;
+};
+
+template <typename T>
+void WorldSnapshot::Write(const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>, "snapshots copy values byte for byte");
+    std::memcpy(Grow(sizeof(T)), &value, sizeof(T));
+}
+
+template <typename T>
+void WorldSnapshot::WriteArray(const T* data, size_t count) {
+    static_assert(std::is_trivially_copyable_v<T>, "snapshots copy values byte for byte");
+    if (count) std::memcpy(Grow(sizeof(T) * count), data, sizeof(T) * count);
+}
+
+template <typename T>
+bool WorldSnapshot::Reader::Read(T& out) {
+    return ReadArray(&out, 1);
+}
+
+template <typename T>
+bool WorldSnapshot::Reader::ReadArray(T* out, size_t count) {
+    static_assert(std::is_trivially_copyable_v<T>, "snapshots copy values byte for byte");
+    const uint8_t* bytes = Skip(sizeof(T) * count);
+    if (!bytes) return false;
+    if (count) std::memcpy(out, bytes, sizeof(T) * count);
+    return true;
+}
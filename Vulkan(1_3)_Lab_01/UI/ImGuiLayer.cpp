@@ -9,6 +9,17 @@
 #include <stdexcept>
 #include <unordered_map>
 
+namespace {
+    // Labels come from GetIntegrationMethodName, so the combo follows the enum.
+    void IntegratorCombo(SandboxApplication* app) {
+        int current = static_cast<int>(app->GetIntegrationMethod());
+        auto label = [](void*, int index) { return GetIntegrationMethodName(static_cast<IntegrationMethod>(index)); };
+        if (ImGui::Combo("Integrator", &current, label, nullptr, kIntegrationMethodCount)) {
+            app->SetIntegrationMethod(static_cast<IntegrationMethod>(current));
+        }
+    }
+}
+
 void ImGuiLayer::Init(GLFWwindow* window, VkInstance instance, VkPhysicalDevice physicalDevice,
                       VkDevice device, uint32_t graphicsQueueFamily, VkQueue graphicsQueue,
                       VkFormat swapChainFormat) {
@@ -157,11 +168,7 @@ void ImGuiLayer::RenderMainMenuBar(SandboxApplication* app) {
             app->SetTimeStep(timeStep);
         }
 
-        const char* methods[] = { "Explicit Euler", "Semi-Implicit Euler" };
-        int current = static_cast<int>(app->GetIntegrationMethod());
-        if (ImGui::Combo("Integrator", &current, methods, IM_ARRAYSIZE(methods))) {
-            app->SetIntegrationMethod(static_cast<IntegrationMethod>(current));
-        }
+        IntegratorCombo(app);
 
         ImGui::EndMenu();
     }
@@ -230,6 +237,36 @@ void ImGuiLayer::RenderControlPanel(SandboxApplication* app) {
 
     ImGui::Text("Measured Sim Tick Hz: %.1f", app->GetMeasuredSimulationTickHz());
 
+    StepController::Settings stepping = app->GetStepControllerSettings();
+    bool steppingChanged = ImGui::Checkbox("Adaptive Substeps", &stepping.adaptive);
+    if (stepping.adaptive) {
+        int maxSubsteps = static_cast<int>(stepping.maxSubsteps);
+        if (ImGui::SliderInt("Max Substeps", &maxSubsteps, 1, 16)) {
+            stepping.maxSubsteps = static_cast<uint32_t>(maxSubsteps);
+            steppingChanged = true;
+        }
+        int maxCoarseSteps = static_cast<int>(stepping.maxCoarseSteps);
+        if (ImGui::SliderInt("Max Coarse Steps", &maxCoarseSteps, 1, 4)) {
+            stepping.maxCoarseSteps = static_cast<uint32_t>(maxCoarseSteps);
+            steppingChanged = true;
+        }
+        steppingChanged |= ImGui::SliderFloat("Max Travel Per Step (m)", &stepping.maxTravelPerStep, 0.02f, 1.0f, "%.2f");
+        steppingChanged |= ImGui::SliderFloat("Penetration Per Substep (m)", &stepping.penetrationPerSubstep, 0.0f, 0.2f, "%.3f");
+    }
+    int maxCatchUpSteps = static_cast<int>(stepping.maxCatchUpSteps);
+    if (ImGui::SliderInt("Max Catch-Up Steps", &maxCatchUpSteps, 1, 16)) {
+        stepping.maxCatchUpSteps = static_cast<uint32_t>(maxCatchUpSteps);
+        steppingChanged = true;
+    }
+    steppingChanged |= ImGui::SliderFloat("Update Budget (ms)", &stepping.updateBudgetMs, 0.0f, 50.0f, "%.1f");
+    if (steppingChanged) {
+        app->SetStepControllerSettings(stepping);
+    }
+
+    ImGui::Text("Substeps: %u, coarse steps: %u, time dilation: %.2f, dropped: %.2f s",
+        app->GetSimulationSubsteps(), app->GetSimulationCoarseSteps(),
+        app->GetSimulationTimeDilation(), app->GetDroppedSimulationTime());
+
     float renderTickHz = app->GetRenderTickHz();
     if (ImGui::SliderFloat("Render Tick Hz", &renderTickHz, 10.0f, 240.0f, "%.1f")) {
         app->SetRenderTickHz(renderTickHz);
@@ -239,11 +276,7 @@ void ImGuiLayer::RenderControlPanel(SandboxApplication* app) {
     ImGui::Text("Render CPU Index: %d (expected 0)", app->GetLastRenderCpu());
     ImGui::Text("Sim CPU Index: %d (expected >=3)", app->GetLastSimulationCpu());
 
-    const char* methods[] = { "Explicit Euler", "Semi-Implicit Euler" };
-    int current = static_cast<int>(app->GetIntegrationMethod());
-    if (ImGui::Combo("Integrator", &current, methods, IM_ARRAYSIZE(methods))) {
-        app->SetIntegrationMethod(static_cast<IntegrationMethod>(current));
-    }
+    IntegratorCombo(app);
 
     ImGui::Separator();
     ImGui::Text("Stats");
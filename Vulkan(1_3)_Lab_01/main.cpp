@@ -1,8 +1,24 @@
 #include "Application/SandboxApplication.h"
 #include <iostream>
 
-int main() {
+int main(int argc, char** argv) {
     SandboxApplication app;
+
+    HeadlessBenchmark::Settings benchmark;
+    std::string argumentError;
+    if (HeadlessBenchmark::ParseArguments(argc, argv, benchmark, argumentError)) {
+        if (!argumentError.empty()) {
+            std::cerr << "Error: " << argumentError << std::endl;
+            return EXIT_FAILURE;
+        }
+        try {
+            return app.RunBenchmark(benchmark);
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
     
     try {
         app.Run();